@@ -0,0 +1,79 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+#define ELEMENTS 20000
+
+typedef struct
+{
+    cjson_bool_t indexed;
+    cjson_bool_t from_front;
+} delete_context;
+
+/* build an array and delete all of its elements one at a time, by index */
+static void build_and_delete(void *context)
+{
+    const delete_context *settings = (const delete_context*)context;
+    cjson_t *array = cjson_create_array();
+    int i = 0;
+
+    for (i = 0; i < ELEMENTS; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+    }
+    if (!settings->indexed)
+    {
+        free_index(array);
+    }
+
+    for (i = ELEMENTS - 1; i >= 0; i--)
+    {
+        cjson_delete_item_from_array(array, settings->from_front ? 0 : i);
+    }
+    if (array->child != NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    cjson_delete(array);
+}
+
+int CJSON_CDECL main(void)
+{
+    delete_context context = { false, false };
+
+    printf("building and emptying an array of %d elements (MB/s: million elements per second)\n", ELEMENTS);
+    context.indexed = true;
+    context.from_front = true;
+    run_benchmark("indexed, delete from the front", build_and_delete, &context, ELEMENTS);
+    context.from_front = false;
+    run_benchmark("indexed, delete from the back", build_and_delete, &context, ELEMENTS);
+    context.indexed = false;
+    context.from_front = true;
+    run_benchmark("list only, delete from the front", build_and_delete, &context, ELEMENTS);
+    context.from_front = false;
+    run_benchmark("list only, delete from the back", build_and_delete, &context, ELEMENTS);
+
+    return EXIT_SUCCESS;
+}
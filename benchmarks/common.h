@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#ifndef CJSON_BENCHMARKS_COMMON_H
+#define CJSON_BENCHMARKS_COMMON_H
+
+#include <time.h>
+
+/* benchmarks include the implementation like the tests do, so they can measure internal functions */
+#include "../cjson.c"
+
+/* every measurement is repeated for at least this long */
+#define BENCHMARK_MIN_SECONDS 0.5
+
+typedef void (*benchmark_function)(void *context);
+
+/* Run function repeatedly and print the time per call and the throughput for
+ * input_size bytes processed per call. Returns the time per call in seconds. */
+double run_benchmark(const char *name, benchmark_function function, void *context, size_t input_size);
+double run_benchmark(const char *name, benchmark_function function, void *context, size_t input_size)
+{
+    clock_t start = clock();
+    double elapsed = 0;
+    double calls = 0;
+
+    do
+    {
+        function(context);
+        calls++;
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    }
+    while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    printf("%-48s %12.2f us/call %10.1f MB/s\n", name, elapsed * 1e6 / calls, ((double)input_size * calls) / elapsed / 1e6);
+
+    return elapsed / calls;
+}
+
+/* deterministic pseudo random numbers, so every run benchmarks the same documents */
+unsigned long benchmark_random(void);
+unsigned long benchmark_random(void)
+{
+    static unsigned long state = 12345;
+    state = (state * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+
+    return state >> 8;
+}
+
+#endif
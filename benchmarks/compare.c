@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    cjson_t *a;
+    cjson_t *b;
+} compare_context;
+
+static void compare_objects_benchmark(void *context)
+{
+    const compare_context *objects = (const compare_context*)context;
+
+    if (!cjson_compare(objects->a, objects->b, true))
+    {
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* an object with the same members in a different order, built without an index */
+static cjson_t *create_shuffled(const cjson_t *object, int size)
+{
+    cjson_t *shuffled = cjson_create_object();
+    cjson_t **members = (cjson_t**)malloc((size_t)size * sizeof(cjson_t*));
+    int i = 0;
+
+    if ((shuffled == NULL) || (members == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < size; i++)
+    {
+        members[i] = cjson_get_array_item(object, i);
+    }
+    for (i = size - 1; i > 0; i--)
+    {
+        const int other = (int)(benchmark_random() % (unsigned long)(i + 1));
+        cjson_t *swap = members[i];
+        members[i] = members[other];
+        members[other] = swap;
+    }
+    for (i = 0; i < size; i++)
+    {
+        cjson_add_item_to_object(shuffled, members[i]->string, cjson_duplicate(members[i], true));
+    }
+
+    free(members);
+    return shuffled;
+}
+
+static void benchmark_size(int size)
+{
+    compare_context context;
+    cjson_t *object = cjson_create_object();
+    char name[96];
+    char *json = NULL;
+    int i = 0;
+
+    if (object == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < size; i++)
+    {
+        char key[32];
+        sprintf(key, "setting_%lu_%d", benchmark_random(), i);
+        cjson_add_number_to_object(object, key, i);
+    }
+    json = cjson_print_unformatted(object);
+
+    context.a = cjson_parse(json);
+    context.b = cjson_parse(json);
+    if (!cjson_build_indexes(context.a) || !cjson_build_indexes(context.b))
+    {
+        exit(EXIT_FAILURE);
+    }
+    sprintf(name, "%d keys, indexed", size);
+    run_benchmark(name, compare_objects_benchmark, &context, 0);
+    cjson_delete(context.b);
+
+    context.b = create_shuffled(context.a, size);
+    sprintf(name, "%d keys, shuffled without index", size);
+    run_benchmark(name, compare_objects_benchmark, &context, 0);
+
+    cjson_delete(context.a);
+    cjson_delete(context.b);
+    cjson_free(json);
+    cjson_delete(object);
+}
+
+int CJSON_CDECL main(void)
+{
+    printf("time to compare two equal objects\n");
+    benchmark_size(10);
+    benchmark_size(100);
+    benchmark_size(1000);
+    benchmark_size(10000);
+    benchmark_size(100000);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+static const char *const tags[] = { "a", "b" };
+/* keeps the hash of the printed text from being optimized away */
+static unsigned long text_hash = 0;
+
+/* a document of records with a few members each, about the size of a typical payload batch */
+static cjson_t *create_document(int records)
+{
+    cjson_t *document = cjson_create_array();
+    int i = 0;
+
+    for (i = 0; i < records; i++)
+    {
+        cjson_t *record = cjson_create_object();
+        char text[32];
+        sprintf(text, "user-%lu", benchmark_random());
+        cjson_add_number_to_object(record, "id", i);
+        cjson_add_string_to_object(record, "name", text);
+        cjson_add_number_to_object(record, "score", (double)benchmark_random() / 1000.0);
+        cjson_add_true_to_object(record, "active");
+        cjson_add_item_to_object(record, "tags", cjson_create_string_array(tags, 2));
+        cjson_add_item_to_array(document, record);
+    }
+
+    return document;
+}
+
+static void print_and_hash(void *context)
+{
+    char *printed = cjson_print_unformatted((const cjson_t*)context);
+    unsigned long hash = 2166136261UL;
+    const char *character = NULL;
+
+    if (printed == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (character = printed; *character != '\0'; character++)
+    {
+        hash = ((hash ^ (unsigned char)*character) * 16777619UL) & 0xffffffffUL;
+    }
+    text_hash ^= hash;
+    cjson_free(printed);
+}
+
+static void hash_uncached(void *context)
+{
+    cjson_hash((cjson_t*)context, 0);
+}
+
+static void hash_after_change(void *context)
+{
+    cjson_t *document = (cjson_t*)context;
+    cjson_t *record = cjson_get_array_item(document, (int)(benchmark_random() % 1000));
+
+    CJSON_SET_NUMBER_VALUE(cjson_get_object_item(record, "score"), 1);
+    cjson_hash(document, CJSON_HASH_CACHE);
+}
+
+int CJSON_CDECL main(void)
+{
+    cjson_t *document = create_document(1000);
+
+    printf("time to hash 1000 records\n");
+    run_benchmark("print and hash the text", print_and_hash, document, 0);
+    run_benchmark("cjson_hash", hash_uncached, document, 0);
+    cjson_hash(document, CJSON_HASH_CACHE);
+    run_benchmark("cjson_hash, cached, one record changed", hash_after_change, document, 0);
+
+    cjson_delete(document);
+
+    return EXIT_SUCCESS;
+}
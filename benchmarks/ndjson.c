@@ -0,0 +1,117 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+#define RECORDS 10000
+
+typedef struct
+{
+    char *text;
+    size_t length;
+    cjson_arena_t *arena;
+} ndjson_input;
+
+/* log lines with a handful of members each */
+static void create_records(ndjson_input *input)
+{
+    size_t size = (size_t)RECORDS * 160;
+    int i = 0;
+
+    input->text = (char*)malloc(size);
+    if (input->text == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    input->length = 0;
+    for (i = 0; i < RECORDS; i++)
+    {
+        input->length += (size_t)sprintf(input->text + input->length,
+            "{\"ts\": %d, \"level\": \"info\", \"host\": \"web-%lu\", \"latency\": %lu.%lu, \"ok\": true, \"path\": \"/api/v1/items\"}\n",
+            1700000000 + i, benchmark_random() % 64, benchmark_random() % 1000, benchmark_random() % 100);
+    }
+}
+
+static void parse_with_opts_loop(void *context)
+{
+    const ndjson_input *input = (const ndjson_input*)context;
+    const char *position = input->text;
+    const char *end = NULL;
+    cjson_t *item = NULL;
+
+    while ((item = cjson_parse_with_opts(position, &end, false)) != NULL)
+    {
+        cjson_delete(item);
+        position = end;
+    }
+}
+
+static void parse_with_length_opts_loop(void *context)
+{
+    const ndjson_input *input = (const ndjson_input*)context;
+    const char *position = input->text;
+    const char *end = NULL;
+    cjson_t *item = NULL;
+
+    while ((item = cjson_parse_with_length_opts(position, input->length - (size_t)(position - input->text), &end, false)) != NULL)
+    {
+        cjson_delete(item);
+        position = end;
+    }
+}
+
+static void ndjson_iterator(void *context)
+{
+    const ndjson_input *input = (const ndjson_input*)context;
+    cjson_ndjson_iter_t iter;
+    cjson_t *item = NULL;
+
+    cjson_ndjson_iter_init(&iter, input->text, input->length, input->arena);
+    while (cjson_ndjson_next(&iter, &item, NULL))
+    {
+        if (input->arena == NULL)
+        {
+            cjson_delete(item);
+        }
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    ndjson_input input;
+
+    create_records(&input);
+    input.arena = NULL;
+
+    printf("time to read %d records\n", RECORDS);
+    run_benchmark("cjson_parse_with_opts loop", parse_with_opts_loop, &input, input.length);
+    run_benchmark("cjson_parse_with_length_opts loop", parse_with_length_opts_loop, &input, input.length);
+    run_benchmark("cjson_ndjson_next", ndjson_iterator, &input, input.length);
+    input.arena = cjson_arena_create(0);
+    run_benchmark("cjson_ndjson_next with an arena", ndjson_iterator, &input, input.length);
+
+    cjson_arena_delete(input.arena);
+    free(input.text);
+
+    return EXIT_SUCCESS;
+}
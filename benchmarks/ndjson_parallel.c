@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+/* for clock_gettime, clock() adds up the time of all threads */
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+
+#include "common.h"
+
+#define RECORDS 200000
+
+typedef struct
+{
+    char *text;
+    size_t length;
+    int threads;
+    int flags;
+} ndjson_input;
+
+/* log lines with a handful of members each */
+static void create_records(ndjson_input *input)
+{
+    size_t size = (size_t)RECORDS * 160;
+    int i = 0;
+
+    input->text = (char*)malloc(size);
+    if (input->text == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    input->length = 0;
+    for (i = 0; i < RECORDS; i++)
+    {
+        input->length += (size_t)sprintf(input->text + input->length,
+            "{\"ts\": %d, \"level\": \"info\", \"host\": \"web-%lu\", \"latency\": %lu.%lu, \"ok\": true, \"path\": \"/api/v1/items\"}\n",
+            1700000000 + i, benchmark_random() % 64, benchmark_random() % 1000, benchmark_random() % 100);
+    }
+}
+
+static cjson_bool_t consume_record(cjson_t *item, const cjson_error_t *error, void *user)
+{
+    (void)user;
+
+    return (item != NULL) && (error->kind == CJSON_ERROR_NONE);
+}
+
+static double wall_seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
+
+/* like run_benchmark, but with the wall clock time */
+static void run_parallel_benchmark(const char *name, const ndjson_input *input)
+{
+    const double start = wall_seconds();
+    double elapsed = 0;
+    double calls = 0;
+
+    do
+    {
+        if (!cjson_parse_ndjson_parallel(input->text, input->length, input->threads, consume_record, NULL, input->flags))
+        {
+            exit(EXIT_FAILURE);
+        }
+        calls++;
+        elapsed = wall_seconds() - start;
+    }
+    while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    printf("%-48s %12.2f us/call %10.1f MB/s\n", name, elapsed * 1e6 / calls, ((double)input->length * calls) / elapsed / 1e6);
+}
+
+int CJSON_CDECL main(void)
+{
+    ndjson_input input;
+    int threads[] = { 1, 2, 4, 8 };
+    size_t i = 0;
+
+    create_records(&input);
+
+    printf("wall clock time to read %d records\n", RECORDS);
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        char name[64];
+
+        input.threads = threads[i];
+        input.flags = 0;
+        sprintf(name, "%d threads, ordered", threads[i]);
+        run_parallel_benchmark(name, &input);
+
+        input.flags = CJSON_NDJSON_UNORDERED;
+        sprintf(name, "%d threads, unordered", threads[i]);
+        run_parallel_benchmark(name, &input);
+    }
+
+    free(input.text);
+
+    return EXIT_SUCCESS;
+}
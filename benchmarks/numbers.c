@@ -0,0 +1,121 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+} document;
+
+/* an array of telemetry samples, each an object with a timestamp, integers and measured values */
+static document create_telemetry_array(void)
+{
+    document result = { NULL, 0 };
+    size_t capacity = 8 * 1024 * 1024;
+    size_t used = 0;
+    int i = 0;
+
+    result.json = (char*)malloc(capacity);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.json[used++] = '[';
+    for (i = 0; i < 50000; i++)
+    {
+        used += (size_t)sprintf(result.json + used, "%s{\"t\":%lu,\"seq\":%d,\"temp\":%.4f,\"volt\":%.17g,\"lat\":%.7f,\"err\":%.3e}",
+                (i == 0) ? "" : ",",
+                1700000000UL + (unsigned long)i,
+                i,
+                20.0 + ((double)(benchmark_random() % 10000) / 1000.0),
+                (double)benchmark_random() / 1048576.0,
+                -90.0 + ((double)benchmark_random() / 11930464.0),
+                (double)(benchmark_random() % 1000) * 1e-9);
+    }
+    result.json[used++] = ']';
+    result.json[used++] = '\0';
+    result.length = used;
+
+    return result;
+}
+
+/* nanosecond timestamps and event ids, all 64 bit integers */
+static document create_integer_array(void)
+{
+    document result = { NULL, 0 };
+    size_t capacity = 8 * 1024 * 1024;
+    size_t used = 0;
+    int i = 0;
+
+    result.json = (char*)malloc(capacity);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.json[used++] = '[';
+    for (i = 0; i < 200000; i++)
+    {
+        used += (size_t)sprintf(result.json + used, "%s1700000%06lu%06lu", (i == 0) ? "" : ",", benchmark_random() % 1000000, benchmark_random() % 1000000);
+    }
+    result.json[used++] = ']';
+    result.json[used++] = '\0';
+    result.length = used;
+
+    return result;
+}
+
+static void parse_document(void *context)
+{
+    const document *input = (const document*)context;
+    cjson_delete(cjson_parse_with_length(input->json, input->length));
+}
+
+static void print_document(void *context)
+{
+    cjson_free(cjson_print_unformatted((const cjson_t*)context));
+}
+
+int CJSON_CDECL main(void)
+{
+    document telemetry = create_telemetry_array();
+    document integers = create_integer_array();
+    cjson_t *parsed_telemetry = NULL;
+    cjson_t *parsed_integers = NULL;
+
+    run_benchmark("parse, telemetry numbers", parse_document, &telemetry, telemetry.length);
+    run_benchmark("parse, 64 bit integers", parse_document, &integers, integers.length);
+
+    parsed_telemetry = cjson_parse_with_length(telemetry.json, telemetry.length);
+    parsed_integers = cjson_parse_with_length(integers.json, integers.length);
+    run_benchmark("print, telemetry numbers", print_document, parsed_telemetry, telemetry.length);
+    run_benchmark("print, 64 bit integers", print_document, parsed_integers, integers.length);
+
+    cjson_delete(parsed_telemetry);
+    cjson_delete(parsed_integers);
+    free(telemetry.json);
+    free(integers.json);
+
+    return EXIT_SUCCESS;
+}
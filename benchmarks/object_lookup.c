@@ -0,0 +1,205 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+#define LOOKUPS_PER_CALL 1000
+
+typedef struct
+{
+    cjson_t *object;
+    char **keys; /* the keys that are looked up, in random order */
+    cjson_bool_t case_sensitive;
+} lookup_context;
+
+static void lookup_keys(void *context)
+{
+    const lookup_context *lookups = (const lookup_context*)context;
+    int i = 0;
+
+    for (i = 0; i < LOOKUPS_PER_CALL; i++)
+    {
+        cjson_t *item = lookups->case_sensitive ? cjson_get_object_item_case_sensitive(lookups->object, lookups->keys[i]) : cjson_get_object_item(lookups->object, lookups->keys[i]);
+        if (item == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+static void parse_object_text(void *context)
+{
+    cjson_delete(cjson_parse((const char*)context));
+}
+
+static void parse_and_index_object_text(void *context)
+{
+    cjson_t *object = cjson_parse((const char*)context);
+
+    cjson_build_indexes(object);
+    cjson_delete(object);
+}
+
+static void benchmark_size(int size)
+{
+    lookup_context context;
+    char name[96];
+    char *json = NULL;
+    int i = 0;
+
+    context.object = cjson_create_object();
+    context.keys = (char**)malloc(LOOKUPS_PER_CALL * sizeof(char*));
+    if ((context.object == NULL) || (context.keys == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < size; i++)
+    {
+        char key[32];
+        sprintf(key, "field_%lu_%d", benchmark_random(), i);
+        cjson_add_number_to_object(context.object, key, i);
+    }
+    for (i = 0; i < LOOKUPS_PER_CALL; i++)
+    {
+        context.keys[i] = cjson_get_array_item(context.object, (int)(benchmark_random() % (unsigned long)size))->string;
+    }
+
+    /* objects built past the threshold are indexed already, start out with the list */
+    free_index(context.object);
+    context.case_sensitive = true;
+    sprintf(name, "%d keys, list, case sensitive", size);
+    run_benchmark(name, lookup_keys, &context, 0);
+    context.case_sensitive = false;
+    sprintf(name, "%d keys, list, case insensitive", size);
+    run_benchmark(name, lookup_keys, &context, 0);
+
+    if (!cjson_object_build_index(context.object))
+    {
+        exit(EXIT_FAILURE);
+    }
+    context.case_sensitive = true;
+    sprintf(name, "%d keys, index, case sensitive", size);
+    run_benchmark(name, lookup_keys, &context, 0);
+    context.case_sensitive = false;
+    sprintf(name, "%d keys, index, case insensitive", size);
+    run_benchmark(name, lookup_keys, &context, 0);
+
+    /* what building the index adds to parsing */
+    json = cjson_print_unformatted(context.object);
+    sprintf(name, "%d keys, parse", size);
+    run_benchmark(name, parse_object_text, json, strlen(json));
+    sprintf(name, "%d keys, parse and index", size);
+    run_benchmark(name, parse_and_index_object_text, json, strlen(json));
+
+    cjson_free(json);
+    free(context.keys);
+    cjson_delete(context.object);
+}
+
+/* the same few keys looked up in many small records */
+#define RECORDS 100000
+static const char *const record_keys[] = { "id", "ts", "type", "tags", "payload_hash", "payload_size", "payload", "source" };
+#define RECORD_KEY_COUNT (sizeof(record_keys) / sizeof(record_keys[0]))
+
+typedef struct
+{
+    cjson_t *records;
+    cjson_key_t keys[RECORD_KEY_COUNT];
+} records_context;
+
+static void lookup_record_strings(void *context)
+{
+    const records_context *records = (const records_context*)context;
+    const cjson_t *record = NULL;
+
+    CJSON_ARRAY_FOREACH(record, records->records)
+    {
+        if ((cjson_get_object_item_case_sensitive(record, "id") == NULL)
+            || (cjson_get_object_item_case_sensitive(record, "ts") == NULL)
+            || (cjson_get_object_item_case_sensitive(record, "payload") == NULL))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+static void lookup_record_keys(void *context)
+{
+    const records_context *records = (const records_context*)context;
+    const cjson_t *record = NULL;
+
+    CJSON_ARRAY_FOREACH(record, records->records)
+    {
+        if ((cjson_get_object_item_by_key(record, records->keys[0]) == NULL)
+            || (cjson_get_object_item_by_key(record, records->keys[1]) == NULL)
+            || (cjson_get_object_item_by_key(record, records->keys[6]) == NULL))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+static void benchmark_records(void)
+{
+    records_context context;
+    size_t key = 0;
+    int i = 0;
+
+    context.records = cjson_create_array();
+    if (context.records == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < RECORDS; i++)
+    {
+        cjson_t *record = cjson_create_object();
+        for (key = 0; key < RECORD_KEY_COUNT; key++)
+        {
+            cjson_add_number_to_object(record, record_keys[key], i);
+        }
+        cjson_add_item_to_array(context.records, record);
+    }
+    for (key = 0; key < RECORD_KEY_COUNT; key++)
+    {
+        context.keys[key] = cjson_key_make(record_keys[key]);
+    }
+
+    printf("time for 3 lookups in each of %d records\n", RECORDS);
+    run_benchmark("records, string keys", lookup_record_strings, &context, 0);
+    run_benchmark("records, prepared keys", lookup_record_keys, &context, 0);
+
+    cjson_delete(context.records);
+}
+
+int CJSON_CDECL main(void)
+{
+    printf("time for %d lookups of random keys\n", LOOKUPS_PER_CALL);
+    benchmark_size(10);
+    benchmark_size(100);
+    benchmark_size(1000);
+    benchmark_size(10000);
+    benchmark_size(100000);
+    benchmark_records();
+
+    return EXIT_SUCCESS;
+}
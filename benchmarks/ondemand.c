@@ -0,0 +1,125 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+    double checksum; /* keeps the reads from being optimized away */
+} document;
+
+/* about 20 KB: a few fields around a large array of records, of which a handler reads four fields */
+static document create_document(void)
+{
+    document result = { NULL, 0, 0 };
+    cjson_t *root = cjson_create_object();
+    cjson_t *user = cjson_create_object();
+    cjson_t *items = cjson_create_array();
+    int i = 0;
+
+    cjson_add_number_to_object(root, "id", 123456);
+    cjson_add_number_to_object(user, "score", 99.5);
+    cjson_add_string_to_object(user, "name", "someone");
+    cjson_add_item_to_object(root, "user", user);
+    for (i = 0; i < 280; i++)
+    {
+        cjson_t *item = cjson_create_object();
+        char text[32];
+        sprintf(text, "item-%lu", benchmark_random());
+        cjson_add_number_to_object(item, "sku", (double)benchmark_random());
+        cjson_add_string_to_object(item, "title", text);
+        cjson_add_number_to_object(item, "price", (double)benchmark_random() / 100.0);
+        cjson_add_true_to_object(item, "available");
+        cjson_add_item_to_array(items, item);
+    }
+    cjson_add_item_to_object(root, "items", items);
+    cjson_add_number_to_object(root, "total", 4711.25);
+    cjson_add_number_to_object(root, "status", 200);
+
+    result.json = cjson_print_unformatted(root);
+    cjson_delete(root);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.length = strlen(result.json);
+
+    return result;
+}
+
+static void read_from_tree(void *context)
+{
+    document *input = (document*)context;
+    cjson_t *root = cjson_parse_with_length(input->json, input->length);
+
+    input->checksum += cjson_get_number_value(cjson_get_object_item(root, "id"));
+    input->checksum += cjson_get_number_value(cjson_get_object_item(cjson_get_object_item(root, "user"), "score"));
+    input->checksum += cjson_get_number_value(cjson_get_object_item(root, "total"));
+    input->checksum += cjson_get_number_value(cjson_get_object_item(root, "status"));
+    cjson_delete(root);
+}
+
+static void read_on_demand(void *context)
+{
+    document *input = (document*)context;
+    cjson_ondemand_t ondemand;
+    cjson_od_value_t root;
+    cjson_od_value_t user;
+    cjson_od_value_t value;
+    double number = 0;
+
+    if (!cjson_ondemand_init(&ondemand, input->json, input->length, &root))
+    {
+        exit(EXIT_FAILURE);
+    }
+    if (cjson_od_find_field(&root, "id", &value) && cjson_od_get_double(&value, &number))
+    {
+        input->checksum += number;
+    }
+    if (cjson_od_find_field(&root, "user", &user) && cjson_od_find_field(&user, "score", &value) && cjson_od_get_double(&value, &number))
+    {
+        input->checksum += number;
+    }
+    if (cjson_od_find_field(&root, "total", &value) && cjson_od_get_double(&value, &number))
+    {
+        input->checksum += number;
+    }
+    if (cjson_od_find_field(&root, "status", &value) && cjson_od_get_double(&value, &number))
+    {
+        input->checksum += number;
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    document input = create_document();
+
+    printf("reading 4 fields from a %lu byte document\n", (unsigned long)input.length);
+    run_benchmark("parse the tree, look the fields up", read_from_tree, &input, input.length);
+    run_benchmark("on demand", read_on_demand, &input, input.length);
+
+    cjson_free(input.json);
+
+    return (input.checksum > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+} document;
+
+static const char *const words[] = {
+    "GET", "/api/v1/users", "200", "upstream", "timeout", "connection", "reset", "by", "peer",
+    "request_id=7f3a9c", "latency_ms=12", "user-agent:", "Mozilla/5.0", "(X11; Linux x86_64)"
+};
+
+/* fill line with about length bytes of log text, optionally with characters that need escaping */
+static void fill_log_line(char *line, size_t length, int escaped)
+{
+    size_t used = 0;
+
+    while (used < length)
+    {
+        const char *word = words[benchmark_random() % (sizeof(words) / sizeof(words[0]))];
+        size_t word_length = strlen(word);
+        if ((used + word_length + 1) >= length)
+        {
+            break;
+        }
+        memcpy(line + used, word, word_length);
+        used += word_length;
+        line[used++] = ' ';
+    }
+    if (escaped && (used > 8))
+    {
+        line[2] = '\"';
+        line[used / 2] = '\t';
+    }
+    line[used] = '\0';
+}
+
+static document create_log_array(size_t line_length, int escape_every)
+{
+    document result = { NULL, 0 };
+    cjson_t *array = cjson_create_array();
+    char *line = (char*)malloc(line_length + 1);
+    int i = 0;
+
+    if ((array == NULL) || (line == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < 20000; i++)
+    {
+        fill_log_line(line, line_length, (escape_every > 0) && ((i % escape_every) == 0));
+        cjson_add_item_to_array(array, cjson_create_string(line));
+    }
+    free(line);
+
+    result.json = cjson_print_unformatted(array);
+    cjson_delete(array);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.length = strlen(result.json) + 1;
+
+    return result;
+}
+
+static void parse_document(void *context)
+{
+    const document *input = (const document*)context;
+    cjson_delete(cjson_parse_with_length(input->json, input->length));
+}
+
+static void parse_document_views(void *context)
+{
+    const document *input = (const document*)context;
+    cjson_delete(cjson_parse_with_views(input->json, input->length, NULL));
+}
+
+int CJSON_CDECL main(void)
+{
+    document short_lines = create_log_array(24, 0);
+    document long_lines = create_log_array(400, 0);
+    document escaped_lines = create_log_array(400, 4);
+
+#if defined(CJSON_USE_AVX2)
+    printf("string scanning: AVX2\n");
+#elif defined(CJSON_USE_SSE2)
+    printf("string scanning: SSE2\n");
+#else
+    printf("string scanning: scalar\n");
+#endif
+
+    run_benchmark("parse, 24 byte strings", parse_document, &short_lines, short_lines.length);
+    run_benchmark("parse, 400 byte strings", parse_document, &long_lines, long_lines.length);
+    run_benchmark("parse, 400 byte strings, 1/4 with escapes", parse_document, &escaped_lines, escaped_lines.length);
+    run_benchmark("parse views, 24 byte strings", parse_document_views, &short_lines, short_lines.length);
+    run_benchmark("parse views, 400 byte strings", parse_document_views, &long_lines, long_lines.length);
+    run_benchmark("parse views, 400 byte strings, 1/4 with escapes", parse_document_views, &escaped_lines, escaped_lines.length);
+
+    cjson_free(short_lines.json);
+    cjson_free(long_lines.json);
+    cjson_free(escaped_lines.json);
+
+    return EXIT_SUCCESS;
+}
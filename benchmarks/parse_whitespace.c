@@ -0,0 +1,159 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+} document;
+
+/* nested objects with arrays, so pretty printing produces deep indentation */
+static cjson_t *create_tree(int depth)
+{
+    cjson_t *object = cjson_create_object();
+    cjson_t *values = NULL;
+    int i = 0;
+
+    cjson_add_number_to_object(object, "id", (double)benchmark_random());
+    cjson_add_string_to_object(object, "name", "indented");
+    cjson_add_bool_to_object(object, "enabled", (benchmark_random() % 2) == 0);
+    values = cjson_add_array_to_object(object, "values");
+    for (i = 0; i < 4; i++)
+    {
+        cjson_add_item_to_array(values, cjson_create_number((double)(benchmark_random() % 1000)));
+    }
+
+    if (depth > 0)
+    {
+        cjson_t *children = cjson_add_array_to_object(object, "children");
+        for (i = 0; i < 3; i++)
+        {
+            cjson_add_item_to_array(children, create_tree(depth - 1));
+        }
+    }
+
+    return object;
+}
+
+/* replace every tab with four spaces like most pretty printers indent */
+static document indent_with_spaces(const char *json)
+{
+    document indented = { NULL, 0 };
+    size_t tabs = 0;
+    const char *input = NULL;
+    char *output = NULL;
+
+    for (input = json; *input != '\0'; input++)
+    {
+        tabs += (*input == '\t') ? 1 : 0;
+    }
+
+    indented.json = (char*)malloc(strlen(json) + (3 * tabs) + 1);
+    if (indented.json == NULL)
+    {
+        return indented;
+    }
+    for (input = json, output = indented.json; *input != '\0'; input++)
+    {
+        if (*input == '\t')
+        {
+            memcpy(output, "    ", 4);
+            output += 4;
+            continue;
+        }
+        *output++ = *input;
+    }
+    *output = '\0';
+    indented.length = (size_t)(output - indented.json) + 1;
+
+    return indented;
+}
+
+static void parse_document(void *context)
+{
+    const document *input = (const document*)context;
+    cjson_delete(cjson_parse_with_length(input->json, input->length));
+}
+
+/* only the whitespace skipping the parser does between tokens */
+static void skip_all_whitespace(void *context)
+{
+    const document *input = (const document*)context;
+    parse_buffer buffer;
+
+    /* zeroed rather than initialized field by field, so new fields don't need to be added here */
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.content = (const unsigned char*)input->json;
+    buffer.length = input->length;
+
+    while ((buffer.offset + 1) < buffer.length)
+    {
+        buffer_skip_whitespace(&buffer);
+        buffer.offset++;
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    cjson_t *tree = create_tree(7);
+    document tabs = { NULL, 0 };
+    document spaces = { NULL, 0 };
+    document minified = { NULL, 0 };
+
+#if defined(CJSON_USE_AVX2)
+    printf("whitespace skipping: AVX2\n");
+#elif defined(CJSON_USE_SSE2)
+    printf("whitespace skipping: SSE2\n");
+#else
+    printf("whitespace skipping: scalar\n");
+#endif
+
+    tabs.json = cjson_print(tree);
+    minified.json = cjson_print_unformatted(tree);
+    cjson_delete(tree);
+    if ((tabs.json == NULL) || (minified.json == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+    tabs.length = strlen(tabs.json) + 1;
+    minified.length = strlen(minified.json) + 1;
+    spaces = indent_with_spaces(tabs.json);
+    if (spaces.json == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    run_benchmark("skip whitespace, tab indented", skip_all_whitespace, &tabs, tabs.length);
+    run_benchmark("skip whitespace, 4 space indented", skip_all_whitespace, &spaces, spaces.length);
+    run_benchmark("parse, tab indented", parse_document, &tabs, tabs.length);
+    run_benchmark("parse, 4 space indented", parse_document, &spaces, spaces.length);
+    run_benchmark("parse, minified", parse_document, &minified, minified.length);
+
+    cjson_free(tabs.json);
+    cjson_free(minified.json);
+    free(spaces.json);
+
+    return EXIT_SUCCESS;
+}
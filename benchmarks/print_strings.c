@@ -0,0 +1,160 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+static const char *const words[] = {
+    "GET", "/api/v1/users", "200", "upstream", "timeout", "connection", "reset", "by", "peer",
+    "request_id=7f3a9c", "latency_ms=12", "user-agent:", "Mozilla/5.0", "(X11; Linux x86_64)"
+};
+
+/* an object with count string values of about length bytes each */
+static cjson_t *create_document(size_t length, int count)
+{
+    cjson_t *object = cjson_create_object();
+    char *value = (char*)malloc(length + 1);
+    char key[32];
+    int i = 0;
+
+    if ((object == NULL) || (value == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < count; i++)
+    {
+        size_t used = 0;
+        while (used < length)
+        {
+            const char *word = words[benchmark_random() % (sizeof(words) / sizeof(words[0]))];
+            size_t word_length = strlen(word);
+            if ((used + word_length + 1) >= length)
+            {
+                break;
+            }
+            memcpy(value + used, word, word_length);
+            used += word_length;
+            value[used++] = ' ';
+        }
+        value[used] = '\0';
+
+        sprintf(key, "field%d", i);
+        cjson_add_string_to_object(object, key, value);
+    }
+    free(value);
+
+    return object;
+}
+
+static void print_unformatted(void *context)
+{
+    cjson_free(cjson_print_unformatted((const cjson_t*)context));
+}
+
+static void print_formatted(void *context)
+{
+    cjson_free(cjson_print((const cjson_t*)context));
+}
+
+/* grows the output buffer from a small guess */
+static void print_buffered(void *context)
+{
+    cjson_free(cjson_print_buffered((const cjson_t*)context, 64, false));
+}
+
+static size_t printed_length(const cjson_t *document)
+{
+    char *printed = cjson_print_unformatted(document);
+    size_t length = 0;
+
+    if (printed == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    length = strlen(printed);
+    cjson_free(printed);
+
+    return length;
+}
+
+/* hooks without realloc, every growth of the output buffer is an allocate + copy + free */
+static void *CJSON_CDECL custom_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void CJSON_CDECL custom_free(void *pointer)
+{
+    free(pointer);
+}
+
+static void *CJSON_CDECL allocator_malloc(size_t size, void *user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void CJSON_CDECL allocator_free(void *pointer, void *user)
+{
+    (void)user;
+    free(pointer);
+}
+
+static void *CJSON_CDECL allocator_realloc(void *pointer, size_t size, void *user)
+{
+    (void)user;
+    return realloc(pointer, size);
+}
+
+int CJSON_CDECL main(void)
+{
+    cjson_t *small_strings = create_document(24, 50000);
+    cjson_t *large_strings = create_document(4096, 2000);
+    cjson_t *huge_strings = create_document(1024 * 1024, 8);
+
+    run_benchmark("print, 24 byte strings", print_unformatted, small_strings, printed_length(small_strings));
+    run_benchmark("print, 4 KiB strings", print_unformatted, large_strings, printed_length(large_strings));
+    run_benchmark("print, 1 MiB strings", print_unformatted, huge_strings, printed_length(huge_strings));
+    run_benchmark("print formatted, 1 MiB strings", print_formatted, huge_strings, printed_length(huge_strings));
+
+    {
+        cjson_hooks_t hooks = { custom_malloc, custom_free };
+        cjson_init_hooks(&hooks);
+        run_benchmark("print, 4 KiB strings, custom hooks", print_unformatted, large_strings, printed_length(large_strings));
+        run_benchmark("print, 1 MiB strings, custom hooks", print_unformatted, huge_strings, printed_length(huge_strings));
+        run_benchmark("print buffered, 1 MiB strings, custom hooks", print_buffered, huge_strings, printed_length(huge_strings));
+        cjson_init_hooks(NULL);
+    }
+
+    {
+        cjson_allocator_t allocator = { allocator_malloc, allocator_free, allocator_realloc, NULL };
+        cjson_init_allocator(&allocator);
+        run_benchmark("print buffered, 1 MiB strings, realloc hook", print_buffered, huge_strings, printed_length(huge_strings));
+        cjson_init_hooks(NULL);
+    }
+
+    cjson_delete(small_strings);
+    cjson_delete(large_strings);
+    cjson_delete(huge_strings);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+    double checksum; /* keeps the reads from being optimized away */
+} document;
+
+static const char *paths[] = { "/id", "/customer/country" };
+
+/* an ETL style record of about 2 KB of which two fields are wanted */
+static document create_document(void)
+{
+    document result = { NULL, 0, 0 };
+    cjson_t *root = cjson_create_object();
+    cjson_t *customer = cjson_create_object();
+    cjson_t *lines = cjson_create_array();
+    int i = 0;
+
+    cjson_add_number_to_object(root, "id", 123456);
+    cjson_add_string_to_object(customer, "name", "someone with a name");
+    cjson_add_string_to_object(customer, "email", "someone@example.com");
+    cjson_add_string_to_object(customer, "country", "NZ");
+    cjson_add_item_to_object(root, "customer", customer);
+    for (i = 0; i < 20; i++)
+    {
+        cjson_t *line = cjson_create_object();
+        char text[32];
+        sprintf(text, "sku-%lu", benchmark_random());
+        cjson_add_string_to_object(line, "sku", text);
+        cjson_add_number_to_object(line, "quantity", (double)(benchmark_random() % 10));
+        cjson_add_number_to_object(line, "price", (double)benchmark_random() / 100.0);
+        cjson_add_false_to_object(line, "gift");
+        cjson_add_item_to_array(lines, line);
+    }
+    cjson_add_item_to_object(root, "lines", lines);
+    cjson_add_string_to_object(root, "note", "leave at the door, the dog is friendly");
+
+    result.json = cjson_print_unformatted(root);
+    cjson_delete(root);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.length = strlen(result.json);
+
+    return result;
+}
+
+static void read_from_tree(void *context)
+{
+    document *input = (document*)context;
+    cjson_t *root = cjson_parse_with_length(input->json, input->length);
+
+    input->checksum += cjson_get_number_value(cjson_get_object_item(root, "id"));
+    input->checksum += (double)strlen(cjson_get_string_value(cjson_get_object_item(cjson_get_object_item(root, "customer"), "country")));
+    cjson_delete(root);
+}
+
+static void read_projected(void *context)
+{
+    document *input = (document*)context;
+    cjson_t *root = cjson_parse_projected(input->json, input->length, paths, sizeof(paths) / sizeof(paths[0]));
+
+    input->checksum += cjson_get_number_value(cjson_get_object_item(root, "id"));
+    input->checksum += (double)strlen(cjson_get_string_value(cjson_get_object_item(cjson_get_object_item(root, "customer"), "country")));
+    cjson_delete(root);
+}
+
+int CJSON_CDECL main(void)
+{
+    document input = create_document();
+
+    printf("reading 2 fields from a %lu byte record\n", (unsigned long)input.length);
+    run_benchmark("parse the tree, look the fields up", read_from_tree, &input, input.length);
+    run_benchmark("cjson_parse_projected", read_projected, &input, input.length);
+
+    cjson_free(input.json);
+
+    return (input.checksum > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
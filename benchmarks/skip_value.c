@@ -0,0 +1,131 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "common.h"
+
+typedef struct
+{
+    char *json;
+    size_t length;
+    size_t checksum; /* keeps the results from being optimized away */
+} document;
+
+/* records with numbers, strings and a small array each, nested levels deep: every record holds the next level */
+static cjson_t *create_level(int level)
+{
+    cjson_t *records = cjson_create_array();
+    int i = 0;
+
+    for (i = 0; i < 12; i++)
+    {
+        cjson_t *record = cjson_create_object();
+        cjson_t *tags = cjson_create_array();
+        char text[48];
+        sprintf(text, "record-%lu with a [bracket] in it", benchmark_random());
+        cjson_add_number_to_object(record, "id", (double)benchmark_random());
+        cjson_add_string_to_object(record, "name", text);
+        cjson_add_number_to_object(record, "ratio", (double)benchmark_random() / 1000.0);
+        cjson_add_item_to_array(tags, cjson_create_string("a"));
+        cjson_add_item_to_array(tags, cjson_create_number(42));
+        cjson_add_item_to_array(tags, cjson_create_false());
+        cjson_add_item_to_object(record, "tags", tags);
+        if (level > 0)
+        {
+            cjson_add_item_to_object(record, "children", (i < 2) ? create_level(level - 1) : cjson_create_array());
+        }
+        cjson_add_item_to_array(records, record);
+    }
+
+    return records;
+}
+
+static document create_document(const int levels, const cjson_bool_t format)
+{
+    document result = { NULL, 0, 0 };
+    cjson_t *root = create_level(levels);
+
+    result.json = format ? cjson_print(root) : cjson_print_unformatted(root);
+    cjson_delete(root);
+    if (result.json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    result.length = strlen(result.json);
+
+    return result;
+}
+
+static void parse_and_delete(void *context)
+{
+    document *input = (document*)context;
+    parse_buffer buffer;
+    cjson_t *item = NULL;
+
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.content = (const unsigned char*)input->json;
+    buffer.length = input->length;
+    buffer.hooks = global_hooks;
+
+    item = parse_new_item(&buffer);
+    if ((item == NULL) || !parse_value(item, &buffer))
+    {
+        exit(EXIT_FAILURE);
+    }
+    input->checksum += buffer.offset;
+    cjson_delete(item);
+}
+
+static void skip(void *context)
+{
+    document *input = (document*)context;
+    const char *end = NULL;
+
+    if (!cjson_skip_value(input->json, input->length, &end))
+    {
+        exit(EXIT_FAILURE);
+    }
+    input->checksum += (size_t)(end - input->json);
+}
+
+int CJSON_CDECL main(void)
+{
+    document inputs[2];
+    size_t i = 0;
+
+    inputs[0] = create_document(7, false);
+    inputs[1] = create_document(7, true);
+
+    for (i = 0; i < (sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        printf("%s document of %lu bytes\n", (i == 0) ? "unformatted" : "formatted", (unsigned long)inputs[i].length);
+        run_benchmark("parse_value, cjson_delete", parse_and_delete, &inputs[i], inputs[i].length);
+        run_benchmark("cjson_skip_value", skip, &inputs[i], inputs[i].length);
+        if ((inputs[i].checksum % inputs[i].length) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+        cjson_free(inputs[i].json);
+    }
+
+    return EXIT_SUCCESS;
+}
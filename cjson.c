@@ -49,6 +49,33 @@
 #include <locale.h>
 #endif
 
+/* raw file descriptor output for cjson_write_to_fd */
+#if defined(_WIN32)
+#define CJSON_FD_WRITE_WIN32
+#include <io.h>
+#elif defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define CJSON_FD_WRITE_POSIX
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+/* threads for cjson_parse_ndjson_parallel, CMake defines this when pthreads are available */
+#ifdef CJSON_USE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* Vectorized scanning is used when the compiler targets SSE2 (always the case on x86-64) or AVX2,
+ * define CJSON_DISABLE_SIMD to force the portable byte-by-byte code paths. */
+#if !defined(CJSON_DISABLE_SIMD) && defined(__AVX2__)
+#define CJSON_USE_AVX2
+#define CJSON_USE_SSE2
+#include <immintrin.h>
+#elif !defined(CJSON_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CJSON_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning (pop)
 #endif
@@ -85,11 +112,15 @@
 #endif
 #endif
 
+#define uint64_constant(high, low) (((cjson_uint64_t)(high) << 32) | (cjson_uint64_t)(low))
+/* 2^63, the magnitude of the smallest cjson_int64_t */
+#define int64_magnitude_limit uint64_constant(0x80000000, 0)
+
 typedef struct {
     const unsigned char *json;
     size_t position;
-} error;
-static error global_error = { NULL, 0 };
+} error_position;
+static error_position global_error = { NULL, 0 };
 
 CJSON_PUBLIC(const char *) cjson_get_error_ptr(void)
 {
@@ -98,11 +129,44 @@ CJSON_PUBLIC(const char *) cjson_get_error_ptr(void)
 
 CJSON_PUBLIC(char *) cjson_get_string_value(const cjson_t * const item)
 {
+    if (!cjson_is_string(item) || (item->type & CJSON_STRING_IS_VIEW))
+    {
+        return NULL;
+    }
+
+    return item->valuestring;
+}
+
+/* length of the valuestring of an item, which isn't terminated for views */
+static size_t value_length(const cjson_t * const item)
+{
+    if (item->valuestring == NULL)
+    {
+        return 0;
+    }
+    if (item->type & CJSON_STRING_IS_VIEW)
+    {
+        return item->valuestring_length;
+    }
+
+    return strlen(item->valuestring);
+}
+
+CJSON_PUBLIC(const char *) cjson_get_string_view(const cjson_t * const item, size_t *length)
+{
+    size_t local_length = 0;
+
+    if (length == NULL)
+    {
+        length = &local_length;
+    }
     if (!cjson_is_string(item))
     {
+        *length = 0;
         return NULL;
     }
 
+    *length = value_length(item);
     return item->valuestring;
 }
 
@@ -116,6 +180,100 @@ CJSON_PUBLIC(double) cjson_get_number_value(const cjson_t * const item)
     return item->valuedouble;
 }
 
+/* Check whether valueint64 holds the exact number. The setters clear the integer flags, but an application
+ * that assigns valuedouble directly leaves a stale valueint64 behind, which is detected here. */
+static cjson_bool_t has_exact_integer(const cjson_t * const item)
+{
+    if (item->type & CJSON_NUMBER_IS_UINT64)
+    {
+        return (double)(cjson_uint64_t)item->valueint64 == item->valuedouble;
+    }
+    if (item->type & CJSON_NUMBER_IS_INT64)
+    {
+        return (double)item->valueint64 == item->valuedouble;
+    }
+
+    return false;
+}
+
+/* magnitude and sign of an exact integer */
+static cjson_uint64_t exact_integer_magnitude(const cjson_t * const item, cjson_bool_t * const negative)
+{
+    *negative = false;
+    if (item->type & CJSON_NUMBER_IS_UINT64)
+    {
+        return (cjson_uint64_t)item->valueint64;
+    }
+    if (item->valueint64 < 0)
+    {
+        *negative = true;
+        /* written this way to avoid overflowing on the smallest cjson_int64_t */
+        return (cjson_uint64_t)(-(item->valueint64 + 1)) + 1;
+    }
+
+    return (cjson_uint64_t)item->valueint64;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_get_int64(const cjson_t * const item, cjson_int64_t * const value)
+{
+    double number = 0;
+
+    if (!cjson_is_number(item) || (value == NULL))
+    {
+        return false;
+    }
+
+    if (has_exact_integer(item))
+    {
+        if (item->type & CJSON_NUMBER_IS_UINT64)
+        {
+            return false;
+        }
+        *value = item->valueint64;
+        return true;
+    }
+
+    /* integral doubles in [-2^63, 2^63), this also rejects NaN */
+    number = item->valuedouble;
+    if (!(number >= -9223372036854775808.0) || !(number < 9223372036854775808.0) || (floor(number) != number))
+    {
+        return false;
+    }
+    *value = (cjson_int64_t)number;
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_get_uint64(const cjson_t * const item, cjson_uint64_t * const value)
+{
+    double number = 0;
+
+    if (!cjson_is_number(item) || (value == NULL))
+    {
+        return false;
+    }
+
+    if (has_exact_integer(item))
+    {
+        if (!(item->type & CJSON_NUMBER_IS_UINT64) && (item->valueint64 < 0))
+        {
+            return false;
+        }
+        *value = (cjson_uint64_t)item->valueint64;
+        return true;
+    }
+
+    /* integral doubles in [0, 2^64), this also rejects NaN */
+    number = item->valuedouble;
+    if (!(number >= 0) || !(number < 18446744073709551616.0) || (floor(number) != number))
+    {
+        return false;
+    }
+    *value = (cjson_uint64_t)number;
+
+    return true;
+}
+
 /* This is a safeguard to prevent copy-pasters from using incompatible C and header files */
 #if (CJSON_VERSION_MAJOR != 1) || (CJSON_VERSION_MINOR != 7) || (CJSON_VERSION_PATCH != 16)
     #error cJSON.h and cJSON.c have different versions. Make sure that both have the same.
@@ -153,11 +311,13 @@ static int case_insensitive_strcmp(const unsigned char *string1, const unsigned
     return tolower(*string1) - tolower(*string2);
 }
 
+/* same layout as cjson_allocator_t, so per-call allocators are used as they are */
 typedef struct internal_hooks
 {
-    void *(CJSON_CDECL *allocate)(size_t size);
-    void (CJSON_CDECL *deallocate)(void *pointer);
-    void *(CJSON_CDECL *reallocate)(void *pointer, size_t size);
+    void *(CJSON_CDECL *allocate)(size_t size, void *user);
+    void (CJSON_CDECL *deallocate)(void *pointer, void *user);
+    void *(CJSON_CDECL *reallocate)(void *pointer, size_t size, void *user);
+    void *user;
 } internal_hooks;
 
 #if defined(_MSC_VER)
@@ -180,10 +340,27 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 #define internal_realloc realloc
 #endif
 
+/* The functions of cjson_init_hooks don't take a context, global_hooks passes them as user to these. */
+static void * CJSON_CDECL global_allocate(size_t size, void *user)
+{
+    return ((const cjson_hooks_t*)user)->malloc_fn(size);
+}
+static void CJSON_CDECL global_deallocate(void *pointer, void *user)
+{
+    ((const cjson_hooks_t*)user)->free_fn(pointer);
+}
+/* only installed while the cjson_init_hooks functions are malloc and free */
+static void * CJSON_CDECL global_reallocate(void *pointer, size_t size, void *user)
+{
+    (void)user;
+    return internal_realloc(pointer, size);
+}
+
 /* strlen of character literals resolved at compile time */
 #define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
 
-static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
+static cjson_hooks_t global_functions = { internal_malloc, internal_free };
+static internal_hooks global_hooks = { global_allocate, global_deallocate, global_reallocate, &global_functions };
 
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
@@ -196,7 +373,7 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
     }
 
     length = strlen((const char*)string) + sizeof("");
-    copy = (unsigned char*)hooks->allocate(length);
+    copy = (unsigned char*)hooks->allocate(length, hooks->user);
     if (copy == NULL)
     {
         return NULL;
@@ -208,39 +385,63 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
 
 CJSON_PUBLIC(void) cjson_init_hooks(cjson_hooks_t* hooks)
 {
+    global_hooks.allocate = global_allocate;
+    global_hooks.deallocate = global_deallocate;
+    global_hooks.reallocate = global_reallocate;
+    global_hooks.user = &global_functions;
+
     if (hooks == NULL)
     {
         /* Reset hooks */
-        global_hooks.allocate = malloc;
-        global_hooks.deallocate = free;
-        global_hooks.reallocate = realloc;
+        global_functions.malloc_fn = malloc;
+        global_functions.free_fn = free;
         return;
     }
 
-    global_hooks.allocate = malloc;
+    global_functions.malloc_fn = malloc;
     if (hooks->malloc_fn != NULL)
     {
-        global_hooks.allocate = hooks->malloc_fn;
+        global_functions.malloc_fn = hooks->malloc_fn;
     }
 
-    global_hooks.deallocate = free;
+    global_functions.free_fn = free;
     if (hooks->free_fn != NULL)
     {
-        global_hooks.deallocate = hooks->free_fn;
+        global_functions.free_fn = hooks->free_fn;
     }
 
     /* use realloc only if both free and malloc are used */
-    global_hooks.reallocate = NULL;
-    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    if ((global_functions.malloc_fn != malloc) || (global_functions.free_fn != free))
+    {
+        global_hooks.reallocate = NULL;
+    }
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_init_allocator(const cjson_allocator_t *allocator)
+{
+    if (allocator == NULL)
+    {
+        cjson_init_hooks(NULL);
+        return true;
+    }
+
+    if ((allocator->malloc_fn == NULL) || (allocator->free_fn == NULL))
     {
-        global_hooks.reallocate = realloc;
+        return false;
     }
+
+    global_hooks.allocate = allocator->malloc_fn;
+    global_hooks.deallocate = allocator->free_fn;
+    global_hooks.reallocate = allocator->realloc_fn;
+    global_hooks.user = allocator->user;
+
+    return true;
 }
 
 /* Internal constructor. */
 static cjson_t *cJSON_New_Item(const internal_hooks * const hooks)
 {
-    cjson_t* node = (cjson_t*)hooks->allocate(sizeof(cjson_t));
+    cjson_t* node = (cjson_t*)hooks->allocate(sizeof(cjson_t), hooks->user);
     if (node)
     {
         memset(node, '\0', sizeof(cjson_t));
@@ -249,8 +450,10 @@ static cjson_t *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cjson_delete(cjson_t *item)
+static void delete_index(struct cjson_index_t * const index);
+
+/* Delete a cJSON structure with the hooks it was allocated with. */
+static void delete_item(cjson_t *item, const internal_hooks * const hooks)
 {
     cjson_t *next = NULL;
     while (item != NULL)
@@ -258,1209 +461,6998 @@ CJSON_PUBLIC(void) cjson_delete(cjson_t *item)
         next = item->next;
         if (!(item->type & CJSON_IS_REFERENCE) && (item->child != NULL))
         {
-            cjson_delete(item->child);
+            delete_item(item->child, hooks);
+        }
+        if (item->index != NULL)
+        {
+            delete_index(item->index);
+            item->index = NULL;
         }
         if (!(item->type & CJSON_IS_REFERENCE) && (item->valuestring != NULL))
         {
-            global_hooks.deallocate(item->valuestring);
+            hooks->deallocate(item->valuestring, hooks->user);
         }
         if (!(item->type & CJSON_STRING_IS_CONST) && (item->string != NULL))
         {
-            global_hooks.deallocate(item->string);
+            hooks->deallocate(item->string, hooks->user);
+        }
+        if (!(item->type & CJSON_IN_ARENA))
+        {
+            hooks->deallocate(item, hooks->user);
         }
-        global_hooks.deallocate(item);
         item = next;
     }
 }
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cjson_delete(cjson_t *item)
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
+    delete_item(item, &global_hooks);
 }
 
-typedef struct
+CJSON_PUBLIC(void) cjson_delete_with_allocator(cjson_t *item, const cjson_allocator_t *allocator)
 {
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    if (allocator == NULL)
+    {
+        delete_item(item, &global_hooks);
+        return;
+    }
+
+    if (allocator->free_fn != NULL)
+    {
+        internal_hooks hooks = { 0, 0, 0, 0 };
+        hooks.deallocate = allocator->free_fn;
+        hooks.user = allocator->user;
+        delete_item(item, &hooks);
+    }
+}
+
+/* Arena blocks are kept in a singly linked list, the block that is currently bump-allocated from comes first. */
+typedef struct arena_block
+{
+    struct arena_block *next;
+    size_t size; /* usable bytes after the header */
+    size_t used;
+} arena_block;
+
+struct cjson_arena_t
+{
+    arena_block *blocks;
+    size_t block_size;
     internal_hooks hooks;
-} parse_buffer;
+};
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+/* Items parsed into an arena remember it, so their strings can be replaced from the same arena. */
+typedef struct
+{
+    cjson_t item;
+    cjson_arena_t *arena;
+} arena_item;
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cjson_bool_t parse_number(cjson_t * const item, parse_buffer * const input_buffer)
+/* every allocation from an arena is aligned like the most demanding member of this union */
+typedef union
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    double number;
+    void *pointer;
+    long integer;
+} arena_alignment;
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
-    {
-        return false;
-    }
+static size_t arena_align_size(size_t size)
+{
+    return ((size + sizeof(arena_alignment) - 1) / sizeof(arena_alignment)) * sizeof(arena_alignment);
+}
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
+#define arena_block_data(block) ((unsigned char*)(block) + arena_align_size(sizeof(arena_block)))
 
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
+static arena_block *arena_new_block(const cjson_arena_t * const arena, size_t size)
+{
+    arena_block *block = NULL;
+    size_t header_size = arena_align_size(sizeof(arena_block));
 
-            default:
-                goto loop_end;
-        }
+    if (size > ((size_t)-1 - header_size))
+    {
+        return NULL;
     }
-loop_end:
-    number_c_string[i] = '\0';
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    block = (arena_block*)arena->hooks.allocate(header_size + size, arena->hooks.user);
+    if (block == NULL)
     {
-        return false; /* parse_error */
+        return NULL;
     }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
 
-    item->valuedouble = number;
+    return block;
+}
 
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+static void *arena_allocate(cjson_arena_t * const arena, size_t size)
+{
+    arena_block *block = arena->blocks;
+    void *allocation = NULL;
+
+    if (size > ((size_t)-1 - sizeof(arena_alignment)))
     {
-        item->valueint = INT_MAX;
+        return NULL;
     }
-    else if (number <= (double)INT_MIN)
+    size = arena_align_size(size);
+
+    if ((block != NULL) && ((block->size - block->used) >= size))
     {
-        item->valueint = INT_MIN;
+        allocation = arena_block_data(block) + block->used;
+        block->used += size;
+
+        return allocation;
     }
-    else
+
+    if (size > (arena->block_size / 2))
     {
-        item->valueint = (int)number;
+        /* large allocations get a block of their own, so the current block keeps being used */
+        arena_block *large_block = arena_new_block(arena, size);
+        if (large_block == NULL)
+        {
+            return NULL;
+        }
+        large_block->used = size;
+        if (block != NULL)
+        {
+            large_block->next = block->next;
+            block->next = large_block;
+        }
+        else
+        {
+            arena->blocks = large_block;
+        }
+
+        return arena_block_data(large_block);
     }
 
-    item->type = CJSON_NUMBER;
+    block = arena_new_block(arena, arena->block_size);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->next = arena->blocks;
+    arena->blocks = block;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    return true;
+    block->used = size;
+    return arena_block_data(block);
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cjson_set_number_helper(cjson_t *object, double number)
+/* Resize the latest allocation from the current block in place, false if it isn't that or the block is too small. */
+static cjson_bool_t arena_resize(cjson_arena_t * const arena, const unsigned char * const pointer, const size_t old_size, const size_t new_size)
 {
-    if (number >= INT_MAX)
+    arena_block *block = arena->blocks;
+    size_t offset = 0;
+
+    if ((block == NULL) || (pointer < arena_block_data(block)) || (pointer >= (arena_block_data(block) + block->used)))
     {
-        object->valueint = INT_MAX;
+        return false;
     }
-    else if (number <= (double)INT_MIN)
+    offset = (size_t)(pointer - arena_block_data(block));
+    if (((offset + arena_align_size(old_size)) != block->used) || (new_size > (block->size - offset)))
     {
-        object->valueint = INT_MIN;
+        return false;
     }
-    else
+    block->used = offset + arena_align_size(new_size);
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_arena_t *) cjson_arena_create(size_t block_size)
+{
+    static const size_t default_block_size = 64 * 1024;
+    cjson_arena_t *arena = NULL;
+
+    arena = (cjson_arena_t*)global_hooks.allocate(sizeof(cjson_arena_t), global_hooks.user);
+    if (arena == NULL)
     {
-        object->valueint = (int)number;
+        return NULL;
     }
 
-    return object->valuedouble = number;
+    arena->blocks = NULL;
+    arena->block_size = (block_size == 0) ? default_block_size : arena_align_size(block_size);
+    arena->hooks = global_hooks;
+
+    return arena;
 }
 
-CJSON_PUBLIC(char*) cjson_set_value_string(cjson_t *object, const char *valuestring)
+CJSON_PUBLIC(void) cjson_arena_reset(cjson_arena_t *arena)
 {
-    char *copy = NULL;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if (!(object->type & CJSON_STRING) || (object->type & CJSON_IS_REFERENCE))
+    arena_block *block = NULL;
+    arena_block *kept = NULL;
+
+    if (arena == NULL)
     {
-        return NULL;
+        return;
     }
-    if (strlen(valuestring) <= strlen(object->valuestring))
+
+    block = arena->blocks;
+    while (block != NULL)
     {
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        arena_block *next = block->next;
+        if ((kept == NULL) && (block->size == arena->block_size))
+        {
+            kept = block;
+        }
+        else
+        {
+            arena->hooks.deallocate(block, arena->hooks.user);
+        }
+        block = next;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+
+    if (kept != NULL)
     {
-        return NULL;
+        kept->next = NULL;
+        kept->used = 0;
     }
-    if (object->valuestring != NULL)
+    arena->blocks = kept;
+}
+
+CJSON_PUBLIC(void) cjson_arena_delete(cjson_arena_t *arena)
+{
+    if (arena == NULL)
     {
-        cjson_free(object->valuestring);
+        return;
     }
-    object->valuestring = copy;
 
-    return copy;
+    cjson_arena_reset(arena);
+    if (arena->blocks != NULL)
+    {
+        arena->hooks.deallocate(arena->blocks, arena->hooks.user);
+    }
+    arena->hooks.deallocate(arena, arena->hooks.user);
 }
 
+/* Index of the children of large arrays and objects.
+ * Arrays keep a vector of their elements in order, which makes the size and indexed access O(1).
+ * Objects keep a hash table, open addressing with linear probing. Keys are hashed case insensitively, so case
+ * sensitive and insensitive lookups can share it. Removed members leave their slot marked, and new members
+ * always go to the first empty slot, which keeps members with the same key in the probe sequence in the order
+ * of the list: the first match found is the one a linear search would find. */
 typedef struct
 {
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cjson_bool_t noalloc;
-    cjson_bool_t format; /* is this print a formatted print */
+    cjson_t *item; /* NULL for free slots */
+    unsigned long hash;
+} index_slot;
+
+typedef struct cjson_index_t cjson_index_t;
+struct cjson_index_t
+{
     internal_hooks hooks;
-} printbuffer;
+    index_slot *slots; /* objects only */
+    cjson_t **items; /* arrays only */
+    size_t capacity; /* of slots or items, a power of two */
+    size_t used; /* taken slots, including those of removed members */
+    size_t count; /* number of children */
+    cjson_bool_t in_arena; /* allocated from an arena, so never freed */
+    size_t first; /* arrays only: position of the first element in items, taking it out only moves this */
+    cjson_digest_t digest; /* cached by cjson_hash, all zero if there is none */
+};
+
+/* Only arrays and objects cache their digest. Those without a lookup table (slots or items) get an index just for it. */
+static cjson_bool_t has_lookup_table(const cjson_index_t * const index)
+{
+    return (index != NULL) && ((index->slots != NULL) || (index->items != NULL));
+}
 
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
+static const cjson_digest_t *cached_digest(const cjson_t * const item)
 {
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
+    return ((item->index != NULL) && (item->index->digest.low != 0)) ? &item->index->digest : NULL;
+}
 
-    if ((p == NULL) || (p->buffer == NULL))
+/* Drop the cached digests of item and its parents. Caching stores the digests of whole subtrees, so once an array or
+ * object without a digest is reached, its parents don't have one either. */
+static void invalidate_digests(cjson_t *item)
+{
+    if ((item != NULL) && !(item->type & (CJSON_ARRAY | CJSON_OBJECT)))
     {
-        return NULL;
+        item = item->parent;
+    }
+    for (; (item != NULL) && (cached_digest(item) != NULL); item = item->parent)
+    {
+        item->index->digest.low = 0;
+        item->index->digest.high = 0;
     }
+}
 
-    if ((p->length > 0) && (p->offset >= p->length))
+/* Store the digest of an array or object in its index, creating one without a lookup table if it has none.
+ * Without memory for it, the digest just isn't cached. */
+static void cache_digest(cjson_t * const item, const cjson_digest_t digest)
+{
+    cjson_index_t *index = item->index;
+
+    if (index == NULL)
     {
-        /* make sure that offset is valid */
-        return NULL;
+        if (item->type & CJSON_IN_ARENA)
+        {
+            index = (cjson_index_t*)arena_allocate(((arena_item*)item)->arena, sizeof(cjson_index_t));
+        }
+        else
+        {
+            index = (cjson_index_t*)global_hooks.allocate(sizeof(cjson_index_t), global_hooks.user);
+        }
+        if (index == NULL)
+        {
+            return;
+        }
+        memset(index, '\0', sizeof(cjson_index_t));
+        index->hooks = global_hooks;
+        index->in_arena = ((item->type & CJSON_IN_ARENA) != 0);
+        item->index = index;
     }
+    index->digest = digest;
+}
 
-    if (needed > INT_MAX)
+/* marks the slots of removed members */
+static cjson_t removed_index_item;
+
+/* FNV-1a over the lower case bytes */
+static unsigned long key_hash(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+
+    for (; *key != '\0'; key++)
     {
-        /* sizes bigger than INT_MAX are currently not supported */
-        return NULL;
+        hash ^= (unsigned long)tolower(*key);
+        hash = (hash * 16777619UL) & 0xffffffffUL;
     }
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+    return hash;
+}
+
+/* the hash of the key of an item, which is stored in it when it is linked into an object */
+static unsigned long item_key_hash(const cjson_t * const item)
+{
+    return (item->string_hash != 0) ? item->string_hash : key_hash((const unsigned char*)item->string);
+}
+
+/* store the hash of the key of an item, 0 means it is unknown */
+static void hash_item_key(cjson_t * const item)
+{
+    item->string_hash = (item->string != NULL) ? key_hash((const unsigned char*)item->string) : 0;
+}
+
+static void delete_index(cjson_index_t * const index)
+{
+    if ((index == NULL) || index->in_arena)
     {
-        return p->buffer + p->offset;
+        return;
     }
 
-    if (p->noalloc) {
-        return NULL;
+    if (index->items != NULL)
+    {
+        index->hooks.deallocate(index->items, index->hooks.user);
+    }
+    else if (index->slots != NULL)
+    {
+        index->hooks.deallocate(index->slots, index->hooks.user);
     }
+    index->hooks.deallocate(index, index->hooks.user);
+}
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+/* Drop the index of an item that stays around. Without its cached digest, the digests of the parents can't be kept. */
+static void free_index(cjson_t * const object)
+{
+    cjson_index_t *index = object->index;
+
+    if (cached_digest(object) != NULL)
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
-        {
-            newsize = INT_MAX;
-        }
-        else
-        {
-            return NULL;
-        }
+        invalidate_digests(object);
     }
-    else
+    object->index = NULL;
+    delete_index(index);
+}
+
+/* Replace the index of an item by a new one, which takes over the cached digest. NULL drops the index. */
+static cjson_bool_t attach_index(cjson_t * const item, cjson_index_t * const index)
+{
+    if (index == NULL)
     {
-        newsize = needed * 2;
+        free_index(item);
+        return false;
+    }
+    if (item->index != NULL)
+    {
+        index->digest = item->index->digest;
+        delete_index(item->index);
     }
+    item->index = index;
 
-    if (p->hooks.reallocate != NULL)
+    return true;
+}
+
+static void index_insert(cjson_index_t * const index, cjson_t * const item, const unsigned long hash)
+{
+    const size_t mask = index->capacity - 1;
+    size_t slot = 0;
+
+    for (slot = hash & mask; index->slots[slot].item != NULL; slot = (slot + 1) & mask)
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
+    }
+    index->slots[slot].item = item;
+    index->slots[slot].hash = hash;
+    index->used++;
+}
+
+/* allocate an index with a table of table_size bytes, which ends up in *table */
+static cjson_index_t *allocate_index(const internal_hooks * const hooks, cjson_arena_t * const arena, const size_t table_size, void **table)
+{
+    cjson_index_t *index = NULL;
 
+    if (arena != NULL)
+    {
+        index = (cjson_index_t*)arena_allocate(arena, sizeof(cjson_index_t));
+        *table = arena_allocate(arena, table_size);
+        if ((index == NULL) || (*table == NULL))
+        {
             return NULL;
         }
     }
     else
     {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
+        index = (cjson_index_t*)hooks->allocate(sizeof(cjson_index_t), hooks->user);
+        if (index == NULL)
         {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
             return NULL;
         }
-
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
+        *table = hooks->allocate(table_size, hooks->user);
+        if (*table == NULL)
+        {
+            hooks->deallocate(index, hooks->user);
+            return NULL;
+        }
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
 
-    return newbuffer + p->offset;
+    memset(index, '\0', sizeof(cjson_index_t));
+    index->hooks = *hooks;
+    index->in_arena = (arena != NULL);
+
+    return index;
 }
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+/* Create an index of the members of an object without attaching it. Fails for members without a key. */
+static cjson_index_t *create_object_index(const cjson_t * const object, const internal_hooks * const hooks, cjson_arena_t * const arena)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    cjson_index_t *index = NULL;
+    cjson_t *child = NULL;
+    void *slots = NULL;
+    size_t count = 0;
+    size_t capacity = 16;
+
+    for (child = object->child; child != NULL; child = child->next)
     {
-        return;
+        if (child->string == NULL)
+        {
+            return NULL;
+        }
+        count++;
+    }
+    /* keep at least half of the slots free */
+    while (capacity < (count * 2))
+    {
+        capacity *= 2;
+    }
+
+    index = allocate_index(hooks, arena, capacity * sizeof(index_slot), &slots);
+    if (index == NULL)
+    {
+        return NULL;
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
+    index->slots = (index_slot*)slots;
+    memset(index->slots, '\0', capacity * sizeof(index_slot));
+    index->capacity = capacity;
+    index->count = count;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        index_insert(index, child, item_key_hash(child));
+    }
+
+    return index;
 }
 
-/* securely comparison of floating-point variables */
-static cjson_bool_t compare_double(double a, double b)
+/* (Re)build the index of an object from its list of members. Fails for members without a key. */
+static cjson_bool_t build_object_index(cjson_t * const object, const internal_hooks * const object_hooks, cjson_arena_t * const arena)
 {
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    /* object_hooks may belong to the index that is replaced */
+    const internal_hooks hooks_copy = *object_hooks;
+
+    return attach_index(object, create_object_index(object, &hooks_copy, arena));
 }
 
-/* Render the number nicely from the given item into a string. */
-static cjson_bool_t print_number(const cjson_t * const item, printbuffer * const output_buffer)
+/* (Re)build the element vector of an array from its list of elements. */
+static cjson_bool_t build_array_index(cjson_t * const array, const internal_hooks * const array_hooks, cjson_arena_t * const arena)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    /* array_hooks may belong to the index that is replaced */
+    const internal_hooks hooks_copy = *array_hooks;
+    cjson_index_t *index = NULL;
+    cjson_t *child = NULL;
+    void *items = NULL;
+    size_t count = 0;
+    size_t capacity = 16;
 
-    if (output_buffer == NULL)
+    for (child = array->child; child != NULL; child = child->next)
     {
-        return false;
+        count++;
     }
-
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    while (capacity < count)
     {
-        length = sprintf((char*)number_buffer, "null");
+        capacity *= 2;
     }
-	else if(d == (double)item->valueint)
-	{
-		length = sprintf((char*)number_buffer, "%d", item->valueint);
-	}
-    else
-    {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
+    index = allocate_index(&hooks_copy, arena, capacity * sizeof(cjson_t*), &items);
+    if (index == NULL)
+    {
+        return attach_index(array, NULL);
     }
+    index->items = (cjson_t**)items;
+    index->capacity = capacity;
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    for (child = array->child; child != NULL; child = child->next)
     {
-        return false;
+        index->items[index->count++] = child;
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+    return attach_index(array, index);
+}
+
+static cjson_bool_t build_index(cjson_t * const item, const internal_hooks * const hooks, cjson_arena_t * const arena)
+{
+    if (cjson_is_array(item))
     {
-        return false;
+        return build_array_index(item, hooks, arena);
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
-    {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
+    return build_object_index(item, hooks, arena);
+}
 
-        output_pointer[i] = number_buffer[i];
+/* Rebuild an index that can't be updated in place, an arena index can only be dropped. */
+static void rebuild_index(cjson_t * const item)
+{
+    if (item->index->in_arena)
+    {
+        free_index(item);
+        return;
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
 
-    return true;
+    build_index(item, &item->index->hooks, NULL);
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+static cjson_t *index_lookup(const cjson_index_t * const index, const char * const name, const unsigned long hash, const cjson_bool_t case_sensitive)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    const size_t mask = index->capacity - 1;
+    size_t slot = 0;
 
-    for (i = 0; i < 4; i++)
+    for (slot = hash & mask; index->slots[slot].item != NULL; slot = (slot + 1) & mask)
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
-        {
-            h += (unsigned int) input[i] - '0';
-        }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        const cjson_t *candidate = index->slots[slot].item;
+        if ((index->slots[slot].hash != hash) || (candidate == &removed_index_item))
         {
-            h += (unsigned int) 10 + input[i] - 'A';
-        }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
-        {
-            h += (unsigned int) 10 + input[i] - 'a';
+            continue;
         }
-        else /* invalid */
+        if (case_sensitive ? (strcmp(name, candidate->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)candidate->string) == 0))
         {
-            return 0;
+            return index->slots[slot].item;
         }
+    }
 
-        if (i < 3)
+    return NULL;
+}
+
+/* find the slot of a member, NULL if the index doesn't know it */
+static index_slot *index_find_item(const cjson_index_t * const index, const cjson_t * const item)
+{
+    const size_t mask = index->capacity - 1;
+    size_t slot = 0;
+
+    if (item->string == NULL)
+    {
+        return NULL;
+    }
+
+    for (slot = item_key_hash(item) & mask; index->slots[slot].item != NULL; slot = (slot + 1) & mask)
+    {
+        if (index->slots[slot].item == item)
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            return &index->slots[slot];
         }
     }
 
-    return h;
+    return NULL;
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+/* keep the index up to date after item was appended to the members of object */
+static void index_append(cjson_t * const object, cjson_t * const item)
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
+    cjson_index_t *index = object->index;
 
-    if ((input_end - first_sequence) < 6)
+    if (item->string == NULL)
     {
-        /* input ends unexpectedly */
-        goto fail;
+        /* members without a key can't be indexed */
+        free_index(object);
+        return;
     }
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
-
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    if (((index->used + 1) * 2) > index->capacity)
     {
-        goto fail;
+        /* the list already contains item */
+        rebuild_index(object);
+        return;
     }
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
-    {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
-
-        if ((input_end - second_sequence) < 6)
-        {
-            /* input ends unexpectedly */
-            goto fail;
-        }
-
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
-        {
-            /* missing second half of the surrogate pair */
-            goto fail;
-        }
-
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
-        {
-            /* invalid second half of the surrogate pair */
-            goto fail;
-        }
-
+    index_insert(index, item, item_key_hash(item));
+    index->count++;
+}
 
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
-    }
-    else
-    {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
-    }
+/* make room for one more element at the end of the vector of an array, an arena vector can only be dropped */
+static cjson_bool_t array_index_reserve(cjson_t * const array)
+{
+    cjson_index_t *index = array->index;
+    const size_t new_size = index->capacity * 2 * sizeof(cjson_t*);
+    cjson_t **items = NULL;
 
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
-    {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
-    }
-    else if (codepoint < 0x800)
-    {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
-    }
-    else if (codepoint < 0x10000)
+    if ((index->first + index->count) < index->capacity)
     {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
+        return true;
     }
-    else if (codepoint <= 0x10FFFF)
+    if (index->first >= index->count)
     {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
+        /* at least half of the vector was freed at the front, moving the elements back pays for itself */
+        memmove(index->items, index->items + index->first, index->count * sizeof(cjson_t*));
+        index->first = 0;
+        return true;
     }
-    else
+
+    if (index->in_arena)
     {
-        /* invalid unicode codepoint */
-        goto fail;
+        free_index(array);
+        return false;
     }
 
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    if (index->hooks.reallocate != NULL)
     {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
+        items = (cjson_t**)index->hooks.reallocate(index->items, new_size, index->hooks.user);
     }
-    /* encode first byte */
-    if (utf8_length > 1)
+    else
     {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+        items = (cjson_t**)index->hooks.allocate(new_size, index->hooks.user);
+        if (items != NULL)
+        {
+            memcpy(items, index->items, (index->first + index->count) * sizeof(cjson_t*));
+            index->hooks.deallocate(index->items, index->hooks.user);
+        }
     }
-    else
+    if (items == NULL)
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        /* the old vector is still there, without room the index is dropped */
+        free_index(array);
+        return false;
     }
 
-    *output_pointer += utf8_length;
-
-    return sequence_length;
+    index->items = items;
+    index->capacity *= 2;
 
-fail:
-    return 0;
+    return true;
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cjson_bool_t parse_string(cjson_t * const item, parse_buffer * const input_buffer)
+/* keep the vector of an array up to date after item was linked in at position */
+static void array_index_insert(cjson_t * const array, const size_t position, cjson_t * const item)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    cjson_index_t *index = NULL;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    if (!array_index_reserve(array))
     {
-        goto fail;
+        return;
     }
 
-    {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
-        {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
-            {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
-            }
-            input_end++;
-        }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
-        {
-            goto fail; /* string ended unexpectedly */
-        }
+    index = array->index;
+    memmove(index->items + index->first + position + 1, index->items + index->first + position, (index->count - position) * sizeof(cjson_t*));
+    index->items[index->first + position] = item;
+    index->count++;
+}
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
+/* Keep the vector of an array up to date before item is unlinked. The first and the last element are removed in place,
+ * taking out any other would mean finding it first. Returns false then, and the vector has to be refilled once item is
+ * unlinked. */
+static cjson_bool_t array_index_remove(cjson_index_t * const index, const cjson_t * const item)
+{
+    if (index->items[index->first + index->count - 1] == item)
+    {
+        index->count--;
+        return true;
+    }
+    if (index->items[index->first] == item)
+    {
+        index->first++;
+        index->count--;
+        return true;
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
+    return false;
+}
+
+/* like array_index_remove, the first and last element are replaced in place */
+static cjson_bool_t array_index_replace(cjson_index_t * const index, const cjson_t * const item, cjson_t * const replacement)
+{
+    if (index->count > 0)
     {
-        if (*input_pointer != '\\')
+        if (index->items[index->first] == item)
         {
-            *output_pointer++ = *input_pointer++;
+            index->items[index->first] = replacement;
+            return true;
         }
-        /* escape sequence */
-        else
+        if (index->items[index->first + index->count - 1] == item)
         {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
+            index->items[index->first + index->count - 1] = replacement;
+            return true;
+        }
+    }
 
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
+    return false;
+}
 
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
+/* Refill the vector from the list of elements starting at child after an element in the middle was removed or
+ * replaced. The list isn't longer than the vector was before, so it always fits. */
+static void array_index_refill(cjson_index_t * const index, cjson_t *child)
+{
+    size_t count = 0;
 
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
-        }
+    /* a list that was linked by hand can be longer, its index has to be rebuilt anyway */
+    for (; (child != NULL) && (count < index->capacity); child = child->next)
+    {
+        index->items[count++] = child;
     }
+    index->first = 0;
+    index->count = count;
+}
 
-    /* zero terminate the output */
-    *output_pointer = '\0';
-
-    item->type = CJSON_STRING;
-    item->valuestring = (char*)output;
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
+{
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
+}
 
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    cjson_arena_t *arena; /* if not NULL, nodes and strings are allocated from here instead of hooks */
+    cjson_error_kind_t error; /* set where a parse fails for a reason the failure position can't tell */
+    unsigned char *insitu; /* writable alias of content if strings are unescaped in place, NULL otherwise */
+    cjson_bool_t views; /* string values without escape sequences are left in content as views */
+} parse_buffer;
 
-    return true;
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
-fail:
-    if (output != NULL)
+#ifdef CJSON_USE_SSE2
+/* index of the lowest set bit, mask must not be 0 */
+static unsigned int lowest_bit_index(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int index = 0;
+    while ((mask & 1) == 0)
     {
-        input_buffer->hooks.deallocate(output);
+        mask >>= 1;
+        index++;
     }
 
-    if (input_pointer != NULL)
+    return index;
+#endif
+}
+#endif
+
+static void *parse_allocate(parse_buffer * const buffer, size_t size)
+{
+    void *allocation = NULL;
+
+    if (buffer->arena != NULL)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        allocation = arena_allocate(buffer->arena, size);
+    }
+    else
+    {
+        allocation = buffer->hooks.allocate(size, buffer->hooks.user);
+    }
+    if (allocation == NULL)
+    {
+        buffer->error = CJSON_ERROR_OUT_OF_MEMORY;
     }
 
-    return false;
+    return allocation;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cjson_bool_t print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+/* memory from an arena is only ever released as a whole */
+static void parse_deallocate(const parse_buffer * const buffer, void *pointer)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
-
-    if (output_buffer == NULL)
+    if (buffer->arena == NULL)
     {
-        return false;
+        buffer->hooks.deallocate(pointer, buffer->hooks.user);
     }
+}
 
-    /* empty string */
-    if (input == NULL)
+static cjson_t *parse_new_item(parse_buffer * const buffer)
+{
+    cjson_t *node = NULL;
+
+    if (buffer->arena != NULL)
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        arena_item *item = (arena_item*)parse_allocate(buffer, sizeof(arena_item));
+        if (item == NULL)
         {
-            return false;
+            return NULL;
         }
-        strcpy((char*)output, "\"\"");
+        memset(&item->item, '\0', sizeof(cjson_t));
+        item->arena = buffer->arena;
 
-        return true;
+        return &item->item;
     }
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    node = (cjson_t*)parse_allocate(buffer, sizeof(cjson_t));
+    if (node != NULL)
     {
-        switch (*input_pointer)
-        {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
-        }
+        memset(node, '\0', sizeof(cjson_t));
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
+    return node;
+}
+
+/* Flag a parsed item whose strings may not be freed individually: they were allocated from an arena
+ * (and so was the item) or live in the input buffer of an in situ parse. */
+static void mark_parsed_item(const parse_buffer * const buffer, cjson_t * const item)
+{
+    if ((buffer->arena == NULL) && (buffer->insitu == NULL))
     {
-        return false;
+        return;
     }
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
+    item->type |= (buffer->arena != NULL) ? CJSON_IN_ARENA : CJSON_IN_SITU;
+    if (item->valuestring != NULL)
     {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
+        item->type |= CJSON_IS_REFERENCE;
+    }
+    if (item->string != NULL)
+    {
+        item->type |= CJSON_STRING_IS_CONST;
+    }
+}
 
-        return true;
+/* a failed in situ parse leaves items that aren't marked yet, but none of their strings were allocated */
+static void forget_insitu_strings(cjson_t *item)
+{
+    while (item != NULL)
+    {
+        forget_insitu_strings(item->child);
+        item->valuestring = NULL;
+        item->string = NULL;
+        item = item->next;
     }
+}
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+/* free the partial result of a failed parse */
+static void parse_delete(const parse_buffer * const buffer, cjson_t *item)
+{
+    if (buffer->arena == NULL)
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        if (buffer->insitu != NULL)
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            forget_insitu_strings(item);
         }
-        else
-        {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
+        delete_item(item, &buffer->hooks);
+    }
+}
+
+/* Numbers are converted without strtod whenever possible: the digits are read straight from the
+ * input and converted with the Eisel-Lemire algorithm, which either produces the correctly rounded
+ * double or reports that it can't decide, in which case strtod takes over. Doubles are printed with
+ * the Ryu algorithm instead of sprintf. This needs IEEE 754 doubles. */
+#if (FLT_RADIX == 2) && (DBL_MANT_DIG == 53) && (DBL_MAX_EXP == 1024)
+#define CJSON_FAST_NUMBERS
+#endif
+
+#ifdef CJSON_FAST_NUMBERS
+/* 128 bit approximations (rounded down, most significant bit set) of the powers of ten
+ * between 1e-348 and 1e347, as { high 64 bits, low 64 bits } */
+#define smallest_power_of_ten (-348)
+#define largest_power_of_ten 347
+static const cjson_uint64_t powers_of_ten[][2] =
+{
+    { uint64_constant(0xfa8fd5a0, 0x081c0288), uint64_constant(0x1732c869, 0xcd60e453) }, /* 1e-348 */
+    { uint64_constant(0x9c99e584, 0x05118195), uint64_constant(0x0e7fbd42, 0x205c8eb4) }, /* 1e-347 */
+    { uint64_constant(0xc3c05ee5, 0x0655e1fa), uint64_constant(0x521fac92, 0xa873b261) }, /* 1e-346 */
+    { uint64_constant(0xf4b0769e, 0x47eb5a78), uint64_constant(0xe6a797b7, 0x52909ef9) }, /* 1e-345 */
+    { uint64_constant(0x98ee4a22, 0xecf3188b), uint64_constant(0x9028bed2, 0x939a635c) }, /* 1e-344 */
+    { uint64_constant(0xbf29dcab, 0xa82fdeae), uint64_constant(0x7432ee87, 0x3880fc33) }, /* 1e-343 */
+    { uint64_constant(0xeef453d6, 0x923bd65a), uint64_constant(0x113faa29, 0x06a13b3f) }, /* 1e-342 */
+    { uint64_constant(0x9558b466, 0x1b6565f8), uint64_constant(0x4ac7ca59, 0xa424c507) }, /* 1e-341 */
+    { uint64_constant(0xbaaee17f, 0xa23ebf76), uint64_constant(0x5d79bcf0, 0x0d2df649) }, /* 1e-340 */
+    { uint64_constant(0xe95a99df, 0x8ace6f53), uint64_constant(0xf4d82c2c, 0x107973dc) }, /* 1e-339 */
+    { uint64_constant(0x91d8a02b, 0xb6c10594), uint64_constant(0x79071b9b, 0x8a4be869) }, /* 1e-338 */
+    { uint64_constant(0xb64ec836, 0xa47146f9), uint64_constant(0x9748e282, 0x6cdee284) }, /* 1e-337 */
+    { uint64_constant(0xe3e27a44, 0x4d8d98b7), uint64_constant(0xfd1b1b23, 0x08169b25) }, /* 1e-336 */
+    { uint64_constant(0x8e6d8c6a, 0xb0787f72), uint64_constant(0xfe30f0f5, 0xe50e20f7) }, /* 1e-335 */
+    { uint64_constant(0xb208ef85, 0x5c969f4f), uint64_constant(0xbdbd2d33, 0x5e51a935) }, /* 1e-334 */
+    { uint64_constant(0xde8b2b66, 0xb3bc4723), uint64_constant(0xad2c7880, 0x35e61382) }, /* 1e-333 */
+    { uint64_constant(0x8b16fb20, 0x3055ac76), uint64_constant(0x4c3bcb50, 0x21afcc31) }, /* 1e-332 */
+    { uint64_constant(0xaddcb9e8, 0x3c6b1793), uint64_constant(0xdf4abe24, 0x2a1bbf3d) }, /* 1e-331 */
+    { uint64_constant(0xd953e862, 0x4b85dd78), uint64_constant(0xd71d6dad, 0x34a2af0d) }, /* 1e-330 */
+    { uint64_constant(0x87d4713d, 0x6f33aa6b), uint64_constant(0x8672648c, 0x40e5ad68) }, /* 1e-329 */
+    { uint64_constant(0xa9c98d8c, 0xcb009506), uint64_constant(0x680efdaf, 0x511f18c2) }, /* 1e-328 */
+    { uint64_constant(0xd43bf0ef, 0xfdc0ba48), uint64_constant(0x0212bd1b, 0x2566def2) }, /* 1e-327 */
+    { uint64_constant(0x84a57695, 0xfe98746d), uint64_constant(0x014bb630, 0xf7604b57) }, /* 1e-326 */
+    { uint64_constant(0xa5ced43b, 0x7e3e9188), uint64_constant(0x419ea3bd, 0x35385e2d) }, /* 1e-325 */
+    { uint64_constant(0xcf42894a, 0x5dce35ea), uint64_constant(0x52064cac, 0x828675b9) }, /* 1e-324 */
+    { uint64_constant(0x818995ce, 0x7aa0e1b2), uint64_constant(0x7343efeb, 0xd1940993) }, /* 1e-323 */
+    { uint64_constant(0xa1ebfb42, 0x19491a1f), uint64_constant(0x1014ebe6, 0xc5f90bf8) }, /* 1e-322 */
+    { uint64_constant(0xca66fa12, 0x9f9b60a6), uint64_constant(0xd41a26e0, 0x77774ef6) }, /* 1e-321 */
+    { uint64_constant(0xfd00b897, 0x478238d0), uint64_constant(0x8920b098, 0x955522b4) }, /* 1e-320 */
+    { uint64_constant(0x9e20735e, 0x8cb16382), uint64_constant(0x55b46e5f, 0x5d5535b0) }, /* 1e-319 */
+    { uint64_constant(0xc5a89036, 0x2fddbc62), uint64_constant(0xeb2189f7, 0x34aa831d) }, /* 1e-318 */
+    { uint64_constant(0xf712b443, 0xbbd52b7b), uint64_constant(0xa5e9ec75, 0x01d523e4) }, /* 1e-317 */
+    { uint64_constant(0x9a6bb0aa, 0x55653b2d), uint64_constant(0x47b233c9, 0x2125366e) }, /* 1e-316 */
+    { uint64_constant(0xc1069cd4, 0xeabe89f8), uint64_constant(0x999ec0bb, 0x696e840a) }, /* 1e-315 */
+    { uint64_constant(0xf148440a, 0x256e2c76), uint64_constant(0xc00670ea, 0x43ca250d) }, /* 1e-314 */
+    { uint64_constant(0x96cd2a86, 0x5764dbca), uint64_constant(0x38040692, 0x6a5e5728) }, /* 1e-313 */
+    { uint64_constant(0xbc807527, 0xed3e12bc), uint64_constant(0xc6050837, 0x04f5ecf2) }, /* 1e-312 */
+    { uint64_constant(0xeba09271, 0xe88d976b), uint64_constant(0xf7864a44, 0xc633682e) }, /* 1e-311 */
+    { uint64_constant(0x93445b87, 0x31587ea3), uint64_constant(0x7ab3ee6a, 0xfbe0211d) }, /* 1e-310 */
+    { uint64_constant(0xb8157268, 0xfdae9e4c), uint64_constant(0x5960ea05, 0xbad82964) }, /* 1e-309 */
+    { uint64_constant(0xe61acf03, 0x3d1a45df), uint64_constant(0x6fb92487, 0x298e33bd) }, /* 1e-308 */
+    { uint64_constant(0x8fd0c162, 0x06306bab), uint64_constant(0xa5d3b6d4, 0x79f8e056) }, /* 1e-307 */
+    { uint64_constant(0xb3c4f1ba, 0x87bc8696), uint64_constant(0x8f48a489, 0x9877186c) }, /* 1e-306 */
+    { uint64_constant(0xe0b62e29, 0x29aba83c), uint64_constant(0x331acdab, 0xfe94de87) }, /* 1e-305 */
+    { uint64_constant(0x8c71dcd9, 0xba0b4925), uint64_constant(0x9ff0c08b, 0x7f1d0b14) }, /* 1e-304 */
+    { uint64_constant(0xaf8e5410, 0x288e1b6f), uint64_constant(0x07ecf0ae, 0x5ee44dd9) }, /* 1e-303 */
+    { uint64_constant(0xdb71e914, 0x32b1a24a), uint64_constant(0xc9e82cd9, 0xf69d6150) }, /* 1e-302 */
+    { uint64_constant(0x892731ac, 0x9faf056e), uint64_constant(0xbe311c08, 0x3a225cd2) }, /* 1e-301 */
+    { uint64_constant(0xab70fe17, 0xc79ac6ca), uint64_constant(0x6dbd630a, 0x48aaf406) }, /* 1e-300 */
+    { uint64_constant(0xd64d3d9d, 0xb981787d), uint64_constant(0x092cbbcc, 0xdad5b108) }, /* 1e-299 */
+    { uint64_constant(0x85f04682, 0x93f0eb4e), uint64_constant(0x25bbf560, 0x08c58ea5) }, /* 1e-298 */
+    { uint64_constant(0xa76c5823, 0x38ed2621), uint64_constant(0xaf2af2b8, 0x0af6f24e) }, /* 1e-297 */
+    { uint64_constant(0xd1476e2c, 0x07286faa), uint64_constant(0x1af5af66, 0x0db4aee1) }, /* 1e-296 */
+    { uint64_constant(0x82cca4db, 0x847945ca), uint64_constant(0x50d98d9f, 0xc890ed4d) }, /* 1e-295 */
+    { uint64_constant(0xa37fce12, 0x6597973c), uint64_constant(0xe50ff107, 0xbab528a0) }, /* 1e-294 */
+    { uint64_constant(0xcc5fc196, 0xfefd7d0c), uint64_constant(0x1e53ed49, 0xa96272c8) }, /* 1e-293 */
+    { uint64_constant(0xff77b1fc, 0xbebcdc4f), uint64_constant(0x25e8e89c, 0x13bb0f7a) }, /* 1e-292 */
+    { uint64_constant(0x9faacf3d, 0xf73609b1), uint64_constant(0x77b19161, 0x8c54e9ac) }, /* 1e-291 */
+    { uint64_constant(0xc795830d, 0x75038c1d), uint64_constant(0xd59df5b9, 0xef6a2417) }, /* 1e-290 */
+    { uint64_constant(0xf97ae3d0, 0xd2446f25), uint64_constant(0x4b057328, 0x6b44ad1d) }, /* 1e-289 */
+    { uint64_constant(0x9becce62, 0x836ac577), uint64_constant(0x4ee367f9, 0x430aec32) }, /* 1e-288 */
+    { uint64_constant(0xc2e801fb, 0x244576d5), uint64_constant(0x229c41f7, 0x93cda73f) }, /* 1e-287 */
+    { uint64_constant(0xf3a20279, 0xed56d48a), uint64_constant(0x6b435275, 0x78c1110f) }, /* 1e-286 */
+    { uint64_constant(0x9845418c, 0x345644d6), uint64_constant(0x830a1389, 0x6b78aaa9) }, /* 1e-285 */
+    { uint64_constant(0xbe5691ef, 0x416bd60c), uint64_constant(0x23cc986b, 0xc656d553) }, /* 1e-284 */
+    { uint64_constant(0xedec366b, 0x11c6cb8f), uint64_constant(0x2cbfbe86, 0xb7ec8aa8) }, /* 1e-283 */
+    { uint64_constant(0x94b3a202, 0xeb1c3f39), uint64_constant(0x7bf7d714, 0x32f3d6a9) }, /* 1e-282 */
+    { uint64_constant(0xb9e08a83, 0xa5e34f07), uint64_constant(0xdaf5ccd9, 0x3fb0cc53) }, /* 1e-281 */
+    { uint64_constant(0xe858ad24, 0x8f5c22c9), uint64_constant(0xd1b3400f, 0x8f9cff68) }, /* 1e-280 */
+    { uint64_constant(0x91376c36, 0xd99995be), uint64_constant(0x23100809, 0xb9c21fa1) }, /* 1e-279 */
+    { uint64_constant(0xb5854744, 0x8ffffb2d), uint64_constant(0xabd40a0c, 0x2832a78a) }, /* 1e-278 */
+    { uint64_constant(0xe2e69915, 0xb3fff9f9), uint64_constant(0x16c90c8f, 0x323f516c) }, /* 1e-277 */
+    { uint64_constant(0x8dd01fad, 0x907ffc3b), uint64_constant(0xae3da7d9, 0x7f6792e3) }, /* 1e-276 */
+    { uint64_constant(0xb1442798, 0xf49ffb4a), uint64_constant(0x99cd11cf, 0xdf41779c) }, /* 1e-275 */
+    { uint64_constant(0xdd95317f, 0x31c7fa1d), uint64_constant(0x40405643, 0xd711d583) }, /* 1e-274 */
+    { uint64_constant(0x8a7d3eef, 0x7f1cfc52), uint64_constant(0x482835ea, 0x666b2572) }, /* 1e-273 */
+    { uint64_constant(0xad1c8eab, 0x5ee43b66), uint64_constant(0xda324365, 0x0005eecf) }, /* 1e-272 */
+    { uint64_constant(0xd863b256, 0x369d4a40), uint64_constant(0x90bed43e, 0x40076a82) }, /* 1e-271 */
+    { uint64_constant(0x873e4f75, 0xe2224e68), uint64_constant(0x5a7744a6, 0xe804a291) }, /* 1e-270 */
+    { uint64_constant(0xa90de353, 0x5aaae202), uint64_constant(0x711515d0, 0xa205cb36) }, /* 1e-269 */
+    { uint64_constant(0xd3515c28, 0x31559a83), uint64_constant(0x0d5a5b44, 0xca873e03) }, /* 1e-268 */
+    { uint64_constant(0x8412d999, 0x1ed58091), uint64_constant(0xe858790a, 0xfe9486c2) }, /* 1e-267 */
+    { uint64_constant(0xa5178fff, 0x668ae0b6), uint64_constant(0x626e974d, 0xbe39a872) }, /* 1e-266 */
+    { uint64_constant(0xce5d73ff, 0x402d98e3), uint64_constant(0xfb0a3d21, 0x2dc8128f) }, /* 1e-265 */
+    { uint64_constant(0x80fa687f, 0x881c7f8e), uint64_constant(0x7ce66634, 0xbc9d0b99) }, /* 1e-264 */
+    { uint64_constant(0xa139029f, 0x6a239f72), uint64_constant(0x1c1fffc1, 0xebc44e80) }, /* 1e-263 */
+    { uint64_constant(0xc9874347, 0x44ac874e), uint64_constant(0xa327ffb2, 0x66b56220) }, /* 1e-262 */
+    { uint64_constant(0xfbe91419, 0x15d7a922), uint64_constant(0x4bf1ff9f, 0x0062baa8) }, /* 1e-261 */
+    { uint64_constant(0x9d71ac8f, 0xada6c9b5), uint64_constant(0x6f773fc3, 0x603db4a9) }, /* 1e-260 */
+    { uint64_constant(0xc4ce17b3, 0x99107c22), uint64_constant(0xcb550fb4, 0x384d21d3) }, /* 1e-259 */
+    { uint64_constant(0xf6019da0, 0x7f549b2b), uint64_constant(0x7e2a53a1, 0x46606a48) }, /* 1e-258 */
+    { uint64_constant(0x99c10284, 0x4f94e0fb), uint64_constant(0x2eda7444, 0xcbfc426d) }, /* 1e-257 */
+    { uint64_constant(0xc0314325, 0x637a1939), uint64_constant(0xfa911155, 0xfefb5308) }, /* 1e-256 */
+    { uint64_constant(0xf03d93ee, 0xbc589f88), uint64_constant(0x793555ab, 0x7eba27ca) }, /* 1e-255 */
+    { uint64_constant(0x96267c75, 0x35b763b5), uint64_constant(0x4bc1558b, 0x2f3458de) }, /* 1e-254 */
+    { uint64_constant(0xbbb01b92, 0x83253ca2), uint64_constant(0x9eb1aaed, 0xfb016f16) }, /* 1e-253 */
+    { uint64_constant(0xea9c2277, 0x23ee8bcb), uint64_constant(0x465e15a9, 0x79c1cadc) }, /* 1e-252 */
+    { uint64_constant(0x92a1958a, 0x7675175f), uint64_constant(0x0bfacd89, 0xec191ec9) }, /* 1e-251 */
+    { uint64_constant(0xb749faed, 0x14125d36), uint64_constant(0xcef980ec, 0x671f667b) }, /* 1e-250 */
+    { uint64_constant(0xe51c79a8, 0x5916f484), uint64_constant(0x82b7e127, 0x80e7401a) }, /* 1e-249 */
+    { uint64_constant(0x8f31cc09, 0x37ae58d2), uint64_constant(0xd1b2ecb8, 0xb0908810) }, /* 1e-248 */
+    { uint64_constant(0xb2fe3f0b, 0x8599ef07), uint64_constant(0x861fa7e6, 0xdcb4aa15) }, /* 1e-247 */
+    { uint64_constant(0xdfbdcece, 0x67006ac9), uint64_constant(0x67a791e0, 0x93e1d49a) }, /* 1e-246 */
+    { uint64_constant(0x8bd6a141, 0x006042bd), uint64_constant(0xe0c8bb2c, 0x5c6d24e0) }, /* 1e-245 */
+    { uint64_constant(0xaecc4991, 0x4078536d), uint64_constant(0x58fae9f7, 0x73886e18) }, /* 1e-244 */
+    { uint64_constant(0xda7f5bf5, 0x90966848), uint64_constant(0xaf39a475, 0x506a899e) }, /* 1e-243 */
+    { uint64_constant(0x888f9979, 0x7a5e012d), uint64_constant(0x6d8406c9, 0x52429603) }, /* 1e-242 */
+    { uint64_constant(0xaab37fd7, 0xd8f58178), uint64_constant(0xc8e5087b, 0xa6d33b83) }, /* 1e-241 */
+    { uint64_constant(0xd5605fcd, 0xcf32e1d6), uint64_constant(0xfb1e4a9a, 0x90880a64) }, /* 1e-240 */
+    { uint64_constant(0x855c3be0, 0xa17fcd26), uint64_constant(0x5cf2eea0, 0x9a55067f) }, /* 1e-239 */
+    { uint64_constant(0xa6b34ad8, 0xc9dfc06f), uint64_constant(0xf42faa48, 0xc0ea481e) }, /* 1e-238 */
+    { uint64_constant(0xd0601d8e, 0xfc57b08b), uint64_constant(0xf13b94da, 0xf124da26) }, /* 1e-237 */
+    { uint64_constant(0x823c1279, 0x5db6ce57), uint64_constant(0x76c53d08, 0xd6b70858) }, /* 1e-236 */
+    { uint64_constant(0xa2cb1717, 0xb52481ed), uint64_constant(0x54768c4b, 0x0c64ca6e) }, /* 1e-235 */
+    { uint64_constant(0xcb7ddcdd, 0xa26da268), uint64_constant(0xa9942f5d, 0xcf7dfd09) }, /* 1e-234 */
+    { uint64_constant(0xfe5d5415, 0x0b090b02), uint64_constant(0xd3f93b35, 0x435d7c4c) }, /* 1e-233 */
+    { uint64_constant(0x9efa548d, 0x26e5a6e1), uint64_constant(0xc47bc501, 0x4a1a6daf) }, /* 1e-232 */
+    { uint64_constant(0xc6b8e9b0, 0x709f109a), uint64_constant(0x359ab641, 0x9ca1091b) }, /* 1e-231 */
+    { uint64_constant(0xf867241c, 0x8cc6d4c0), uint64_constant(0xc30163d2, 0x03c94b62) }, /* 1e-230 */
+    { uint64_constant(0x9b407691, 0xd7fc44f8), uint64_constant(0x79e0de63, 0x425dcf1d) }, /* 1e-229 */
+    { uint64_constant(0xc2109436, 0x4dfb5636), uint64_constant(0x985915fc, 0x12f542e4) }, /* 1e-228 */
+    { uint64_constant(0xf294b943, 0xe17a2bc4), uint64_constant(0x3e6f5b7b, 0x17b2939d) }, /* 1e-227 */
+    { uint64_constant(0x979cf3ca, 0x6cec5b5a), uint64_constant(0xa705992c, 0xeecf9c42) }, /* 1e-226 */
+    { uint64_constant(0xbd8430bd, 0x08277231), uint64_constant(0x50c6ff78, 0x2a838353) }, /* 1e-225 */
+    { uint64_constant(0xece53cec, 0x4a314ebd), uint64_constant(0xa4f8bf56, 0x35246428) }, /* 1e-224 */
+    { uint64_constant(0x940f4613, 0xae5ed136), uint64_constant(0x871b7795, 0xe136be99) }, /* 1e-223 */
+    { uint64_constant(0xb9131798, 0x99f68584), uint64_constant(0x28e2557b, 0x59846e3f) }, /* 1e-222 */
+    { uint64_constant(0xe757dd7e, 0xc07426e5), uint64_constant(0x331aeada, 0x2fe589cf) }, /* 1e-221 */
+    { uint64_constant(0x9096ea6f, 0x3848984f), uint64_constant(0x3ff0d2c8, 0x5def7621) }, /* 1e-220 */
+    { uint64_constant(0xb4bca50b, 0x065abe63), uint64_constant(0x0fed077a, 0x756b53a9) }, /* 1e-219 */
+    { uint64_constant(0xe1ebce4d, 0xc7f16dfb), uint64_constant(0xd3e84959, 0x12c62894) }, /* 1e-218 */
+    { uint64_constant(0x8d3360f0, 0x9cf6e4bd), uint64_constant(0x64712dd7, 0xabbbd95c) }, /* 1e-217 */
+    { uint64_constant(0xb080392c, 0xc4349dec), uint64_constant(0xbd8d794d, 0x96aacfb3) }, /* 1e-216 */
+    { uint64_constant(0xdca04777, 0xf541c567), uint64_constant(0xecf0d7a0, 0xfc5583a0) }, /* 1e-215 */
+    { uint64_constant(0x89e42caa, 0xf9491b60), uint64_constant(0xf41686c4, 0x9db57244) }, /* 1e-214 */
+    { uint64_constant(0xac5d37d5, 0xb79b6239), uint64_constant(0x311c2875, 0xc522ced5) }, /* 1e-213 */
+    { uint64_constant(0xd77485cb, 0x25823ac7), uint64_constant(0x7d633293, 0x366b828b) }, /* 1e-212 */
+    { uint64_constant(0x86a8d39e, 0xf77164bc), uint64_constant(0xae5dff9c, 0x02033197) }, /* 1e-211 */
+    { uint64_constant(0xa8530886, 0xb54dbdeb), uint64_constant(0xd9f57f83, 0x0283fdfc) }, /* 1e-210 */
+    { uint64_constant(0xd267caa8, 0x62a12d66), uint64_constant(0xd072df63, 0xc324fd7b) }, /* 1e-209 */
+    { uint64_constant(0x8380dea9, 0x3da4bc60), uint64_constant(0x4247cb9e, 0x59f71e6d) }, /* 1e-208 */
+    { uint64_constant(0xa4611653, 0x8d0deb78), uint64_constant(0x52d9be85, 0xf074e608) }, /* 1e-207 */
+    { uint64_constant(0xcd795be8, 0x70516656), uint64_constant(0x67902e27, 0x6c921f8b) }, /* 1e-206 */
+    { uint64_constant(0x806bd971, 0x4632dff6), uint64_constant(0x00ba1cd8, 0xa3db53b6) }, /* 1e-205 */
+    { uint64_constant(0xa086cfcd, 0x97bf97f3), uint64_constant(0x80e8a40e, 0xccd228a4) }, /* 1e-204 */
+    { uint64_constant(0xc8a883c0, 0xfdaf7df0), uint64_constant(0x6122cd12, 0x8006b2cd) }, /* 1e-203 */
+    { uint64_constant(0xfad2a4b1, 0x3d1b5d6c), uint64_constant(0x796b8057, 0x20085f81) }, /* 1e-202 */
+    { uint64_constant(0x9cc3a6ee, 0xc6311a63), uint64_constant(0xcbe33036, 0x74053bb0) }, /* 1e-201 */
+    { uint64_constant(0xc3f490aa, 0x77bd60fc), uint64_constant(0xbedbfc44, 0x11068a9c) }, /* 1e-200 */
+    { uint64_constant(0xf4f1b4d5, 0x15acb93b), uint64_constant(0xee92fb55, 0x15482d44) }, /* 1e-199 */
+    { uint64_constant(0x99171105, 0x2d8bf3c5), uint64_constant(0x751bdd15, 0x2d4d1c4a) }, /* 1e-198 */
+    { uint64_constant(0xbf5cd546, 0x78eef0b6), uint64_constant(0xd262d45a, 0x78a0635d) }, /* 1e-197 */
+    { uint64_constant(0xef340a98, 0x172aace4), uint64_constant(0x86fb8971, 0x16c87c34) }, /* 1e-196 */
+    { uint64_constant(0x9580869f, 0x0e7aac0e), uint64_constant(0xd45d35e6, 0xae3d4da0) }, /* 1e-195 */
+    { uint64_constant(0xbae0a846, 0xd2195712), uint64_constant(0x89748360, 0x59cca109) }, /* 1e-194 */
+    { uint64_constant(0xe998d258, 0x869facd7), uint64_constant(0x2bd1a438, 0x703fc94b) }, /* 1e-193 */
+    { uint64_constant(0x91ff8377, 0x5423cc06), uint64_constant(0x7b6306a3, 0x4627ddcf) }, /* 1e-192 */
+    { uint64_constant(0xb67f6455, 0x292cbf08), uint64_constant(0x1a3bc84c, 0x17b1d542) }, /* 1e-191 */
+    { uint64_constant(0xe41f3d6a, 0x7377eeca), uint64_constant(0x20caba5f, 0x1d9e4a93) }, /* 1e-190 */
+    { uint64_constant(0x8e938662, 0x882af53e), uint64_constant(0x547eb47b, 0x7282ee9c) }, /* 1e-189 */
+    { uint64_constant(0xb23867fb, 0x2a35b28d), uint64_constant(0xe99e619a, 0x4f23aa43) }, /* 1e-188 */
+    { uint64_constant(0xdec681f9, 0xf4c31f31), uint64_constant(0x6405fa00, 0xe2ec94d4) }, /* 1e-187 */
+    { uint64_constant(0x8b3c113c, 0x38f9f37e), uint64_constant(0xde83bc40, 0x8dd3dd04) }, /* 1e-186 */
+    { uint64_constant(0xae0b158b, 0x4738705e), uint64_constant(0x9624ab50, 0xb148d445) }, /* 1e-185 */
+    { uint64_constant(0xd98ddaee, 0x19068c76), uint64_constant(0x3badd624, 0xdd9b0957) }, /* 1e-184 */
+    { uint64_constant(0x87f8a8d4, 0xcfa417c9), uint64_constant(0xe54ca5d7, 0x0a80e5d6) }, /* 1e-183 */
+    { uint64_constant(0xa9f6d30a, 0x038d1dbc), uint64_constant(0x5e9fcf4c, 0xcd211f4c) }, /* 1e-182 */
+    { uint64_constant(0xd47487cc, 0x8470652b), uint64_constant(0x7647c320, 0x0069671f) }, /* 1e-181 */
+    { uint64_constant(0x84c8d4df, 0xd2c63f3b), uint64_constant(0x29ecd9f4, 0x0041e073) }, /* 1e-180 */
+    { uint64_constant(0xa5fb0a17, 0xc777cf09), uint64_constant(0xf4681071, 0x00525890) }, /* 1e-179 */
+    { uint64_constant(0xcf79cc9d, 0xb955c2cc), uint64_constant(0x7182148d, 0x4066eeb4) }, /* 1e-178 */
+    { uint64_constant(0x81ac1fe2, 0x93d599bf), uint64_constant(0xc6f14cd8, 0x48405530) }, /* 1e-177 */
+    { uint64_constant(0xa21727db, 0x38cb002f), uint64_constant(0xb8ada00e, 0x5a506a7c) }, /* 1e-176 */
+    { uint64_constant(0xca9cf1d2, 0x06fdc03b), uint64_constant(0xa6d90811, 0xf0e4851c) }, /* 1e-175 */
+    { uint64_constant(0xfd442e46, 0x88bd304a), uint64_constant(0x908f4a16, 0x6d1da663) }, /* 1e-174 */
+    { uint64_constant(0x9e4a9cec, 0x15763e2e), uint64_constant(0x9a598e4e, 0x043287fe) }, /* 1e-173 */
+    { uint64_constant(0xc5dd4427, 0x1ad3cdba), uint64_constant(0x40eff1e1, 0x853f29fd) }, /* 1e-172 */
+    { uint64_constant(0xf7549530, 0xe188c128), uint64_constant(0xd12bee59, 0xe68ef47c) }, /* 1e-171 */
+    { uint64_constant(0x9a94dd3e, 0x8cf578b9), uint64_constant(0x82bb74f8, 0x301958ce) }, /* 1e-170 */
+    { uint64_constant(0xc13a148e, 0x3032d6e7), uint64_constant(0xe36a5236, 0x3c1faf01) }, /* 1e-169 */
+    { uint64_constant(0xf18899b1, 0xbc3f8ca1), uint64_constant(0xdc44e6c3, 0xcb279ac1) }, /* 1e-168 */
+    { uint64_constant(0x96f5600f, 0x15a7b7e5), uint64_constant(0x29ab103a, 0x5ef8c0b9) }, /* 1e-167 */
+    { uint64_constant(0xbcb2b812, 0xdb11a5de), uint64_constant(0x7415d448, 0xf6b6f0e7) }, /* 1e-166 */
+    { uint64_constant(0xebdf6617, 0x91d60f56), uint64_constant(0x111b495b, 0x3464ad21) }, /* 1e-165 */
+    { uint64_constant(0x936b9fce, 0xbb25c995), uint64_constant(0xcab10dd9, 0x00beec34) }, /* 1e-164 */
+    { uint64_constant(0xb84687c2, 0x69ef3bfb), uint64_constant(0x3d5d514f, 0x40eea742) }, /* 1e-163 */
+    { uint64_constant(0xe65829b3, 0x046b0afa), uint64_constant(0x0cb4a5a3, 0x112a5112) }, /* 1e-162 */
+    { uint64_constant(0x8ff71a0f, 0xe2c2e6dc), uint64_constant(0x47f0e785, 0xeaba72ab) }, /* 1e-161 */
+    { uint64_constant(0xb3f4e093, 0xdb73a093), uint64_constant(0x59ed2167, 0x65690f56) }, /* 1e-160 */
+    { uint64_constant(0xe0f218b8, 0xd25088b8), uint64_constant(0x306869c1, 0x3ec3532c) }, /* 1e-159 */
+    { uint64_constant(0x8c974f73, 0x83725573), uint64_constant(0x1e414218, 0xc73a13fb) }, /* 1e-158 */
+    { uint64_constant(0xafbd2350, 0x644eeacf), uint64_constant(0xe5d1929e, 0xf90898fa) }, /* 1e-157 */
+    { uint64_constant(0xdbac6c24, 0x7d62a583), uint64_constant(0xdf45f746, 0xb74abf39) }, /* 1e-156 */
+    { uint64_constant(0x894bc396, 0xce5da772), uint64_constant(0x6b8bba8c, 0x328eb783) }, /* 1e-155 */
+    { uint64_constant(0xab9eb47c, 0x81f5114f), uint64_constant(0x066ea92f, 0x3f326564) }, /* 1e-154 */
+    { uint64_constant(0xd686619b, 0xa27255a2), uint64_constant(0xc80a537b, 0x0efefebd) }, /* 1e-153 */
+    { uint64_constant(0x8613fd01, 0x45877585), uint64_constant(0xbd06742c, 0xe95f5f36) }, /* 1e-152 */
+    { uint64_constant(0xa798fc41, 0x96e952e7), uint64_constant(0x2c481138, 0x23b73704) }, /* 1e-151 */
+    { uint64_constant(0xd17f3b51, 0xfca3a7a0), uint64_constant(0xf75a1586, 0x2ca504c5) }, /* 1e-150 */
+    { uint64_constant(0x82ef8513, 0x3de648c4), uint64_constant(0x9a984d73, 0xdbe722fb) }, /* 1e-149 */
+    { uint64_constant(0xa3ab6658, 0x0d5fdaf5), uint64_constant(0xc13e60d0, 0xd2e0ebba) }, /* 1e-148 */
+    { uint64_constant(0xcc963fee, 0x10b7d1b3), uint64_constant(0x318df905, 0x079926a8) }, /* 1e-147 */
+    { uint64_constant(0xffbbcfe9, 0x94e5c61f), uint64_constant(0xfdf17746, 0x497f7052) }, /* 1e-146 */
+    { uint64_constant(0x9fd561f1, 0xfd0f9bd3), uint64_constant(0xfeb6ea8b, 0xedefa633) }, /* 1e-145 */
+    { uint64_constant(0xc7caba6e, 0x7c5382c8), uint64_constant(0xfe64a52e, 0xe96b8fc0) }, /* 1e-144 */
+    { uint64_constant(0xf9bd690a, 0x1b68637b), uint64_constant(0x3dfdce7a, 0xa3c673b0) }, /* 1e-143 */
+    { uint64_constant(0x9c1661a6, 0x51213e2d), uint64_constant(0x06bea10c, 0xa65c084e) }, /* 1e-142 */
+    { uint64_constant(0xc31bfa0f, 0xe5698db8), uint64_constant(0x486e494f, 0xcff30a62) }, /* 1e-141 */
+    { uint64_constant(0xf3e2f893, 0xdec3f126), uint64_constant(0x5a89dba3, 0xc3efccfa) }, /* 1e-140 */
+    { uint64_constant(0x986ddb5c, 0x6b3a76b7), uint64_constant(0xf8962946, 0x5a75e01c) }, /* 1e-139 */
+    { uint64_constant(0xbe895233, 0x86091465), uint64_constant(0xf6bbb397, 0xf1135823) }, /* 1e-138 */
+    { uint64_constant(0xee2ba6c0, 0x678b597f), uint64_constant(0x746aa07d, 0xed582e2c) }, /* 1e-137 */
+    { uint64_constant(0x94db4838, 0x40b717ef), uint64_constant(0xa8c2a44e, 0xb4571cdc) }, /* 1e-136 */
+    { uint64_constant(0xba121a46, 0x50e4ddeb), uint64_constant(0x92f34d62, 0x616ce413) }, /* 1e-135 */
+    { uint64_constant(0xe896a0d7, 0xe51e1566), uint64_constant(0x77b020ba, 0xf9c81d17) }, /* 1e-134 */
+    { uint64_constant(0x915e2486, 0xef32cd60), uint64_constant(0x0ace1474, 0xdc1d122e) }, /* 1e-133 */
+    { uint64_constant(0xb5b5ada8, 0xaaff80b8), uint64_constant(0x0d819992, 0x132456ba) }, /* 1e-132 */
+    { uint64_constant(0xe3231912, 0xd5bf60e6), uint64_constant(0x10e1fff6, 0x97ed6c69) }, /* 1e-131 */
+    { uint64_constant(0x8df5efab, 0xc5979c8f), uint64_constant(0xca8d3ffa, 0x1ef463c1) }, /* 1e-130 */
+    { uint64_constant(0xb1736b96, 0xb6fd83b3), uint64_constant(0xbd308ff8, 0xa6b17cb2) }, /* 1e-129 */
+    { uint64_constant(0xddd0467c, 0x64bce4a0), uint64_constant(0xac7cb3f6, 0xd05ddbde) }, /* 1e-128 */
+    { uint64_constant(0x8aa22c0d, 0xbef60ee4), uint64_constant(0x6bcdf07a, 0x423aa96b) }, /* 1e-127 */
+    { uint64_constant(0xad4ab711, 0x2eb3929d), uint64_constant(0x86c16c98, 0xd2c953c6) }, /* 1e-126 */
+    { uint64_constant(0xd89d64d5, 0x7a607744), uint64_constant(0xe871c7bf, 0x077ba8b7) }, /* 1e-125 */
+    { uint64_constant(0x87625f05, 0x6c7c4a8b), uint64_constant(0x11471cd7, 0x64ad4972) }, /* 1e-124 */
+    { uint64_constant(0xa93af6c6, 0xc79b5d2d), uint64_constant(0xd598e40d, 0x3dd89bcf) }, /* 1e-123 */
+    { uint64_constant(0xd389b478, 0x79823479), uint64_constant(0x4aff1d10, 0x8d4ec2c3) }, /* 1e-122 */
+    { uint64_constant(0x843610cb, 0x4bf160cb), uint64_constant(0xcedf722a, 0x585139ba) }, /* 1e-121 */
+    { uint64_constant(0xa54394fe, 0x1eedb8fe), uint64_constant(0xc2974eb4, 0xee658828) }, /* 1e-120 */
+    { uint64_constant(0xce947a3d, 0xa6a9273e), uint64_constant(0x733d2262, 0x29feea32) }, /* 1e-119 */
+    { uint64_constant(0x811ccc66, 0x8829b887), uint64_constant(0x0806357d, 0x5a3f525f) }, /* 1e-118 */
+    { uint64_constant(0xa163ff80, 0x2a3426a8), uint64_constant(0xca07c2dc, 0xb0cf26f7) }, /* 1e-117 */
+    { uint64_constant(0xc9bcff60, 0x34c13052), uint64_constant(0xfc89b393, 0xdd02f0b5) }, /* 1e-116 */
+    { uint64_constant(0xfc2c3f38, 0x41f17c67), uint64_constant(0xbbac2078, 0xd443ace2) }, /* 1e-115 */
+    { uint64_constant(0x9d9ba783, 0x2936edc0), uint64_constant(0xd54b944b, 0x84aa4c0d) }, /* 1e-114 */
+    { uint64_constant(0xc5029163, 0xf384a931), uint64_constant(0x0a9e795e, 0x65d4df11) }, /* 1e-113 */
+    { uint64_constant(0xf64335bc, 0xf065d37d), uint64_constant(0x4d4617b5, 0xff4a16d5) }, /* 1e-112 */
+    { uint64_constant(0x99ea0196, 0x163fa42e), uint64_constant(0x504bced1, 0xbf8e4e45) }, /* 1e-111 */
+    { uint64_constant(0xc06481fb, 0x9bcf8d39), uint64_constant(0xe45ec286, 0x2f71e1d6) }, /* 1e-110 */
+    { uint64_constant(0xf07da27a, 0x82c37088), uint64_constant(0x5d767327, 0xbb4e5a4c) }, /* 1e-109 */
+    { uint64_constant(0x964e858c, 0x91ba2655), uint64_constant(0x3a6a07f8, 0xd510f86f) }, /* 1e-108 */
+    { uint64_constant(0xbbe226ef, 0xb628afea), uint64_constant(0x890489f7, 0x0a55368b) }, /* 1e-107 */
+    { uint64_constant(0xeadab0ab, 0xa3b2dbe5), uint64_constant(0x2b45ac74, 0xccea842e) }, /* 1e-106 */
+    { uint64_constant(0x92c8ae6b, 0x464fc96f), uint64_constant(0x3b0b8bc9, 0x0012929d) }, /* 1e-105 */
+    { uint64_constant(0xb77ada06, 0x17e3bbcb), uint64_constant(0x09ce6ebb, 0x40173744) }, /* 1e-104 */
+    { uint64_constant(0xe5599087, 0x9ddcaabd), uint64_constant(0xcc420a6a, 0x101d0515) }, /* 1e-103 */
+    { uint64_constant(0x8f57fa54, 0xc2a9eab6), uint64_constant(0x9fa94682, 0x4a12232d) }, /* 1e-102 */
+    { uint64_constant(0xb32df8e9, 0xf3546564), uint64_constant(0x47939822, 0xdc96abf9) }, /* 1e-101 */
+    { uint64_constant(0xdff97724, 0x70297ebd), uint64_constant(0x59787e2b, 0x93bc56f7) }, /* 1e-100 */
+    { uint64_constant(0x8bfbea76, 0xc619ef36), uint64_constant(0x57eb4edb, 0x3c55b65a) }, /* 1e-99 */
+    { uint64_constant(0xaefae514, 0x77a06b03), uint64_constant(0xede62292, 0x0b6b23f1) }, /* 1e-98 */
+    { uint64_constant(0xdab99e59, 0x958885c4), uint64_constant(0xe95fab36, 0x8e45eced) }, /* 1e-97 */
+    { uint64_constant(0x88b402f7, 0xfd75539b), uint64_constant(0x11dbcb02, 0x18ebb414) }, /* 1e-96 */
+    { uint64_constant(0xaae103b5, 0xfcd2a881), uint64_constant(0xd652bdc2, 0x9f26a119) }, /* 1e-95 */
+    { uint64_constant(0xd59944a3, 0x7c0752a2), uint64_constant(0x4be76d33, 0x46f0495f) }, /* 1e-94 */
+    { uint64_constant(0x857fcae6, 0x2d8493a5), uint64_constant(0x6f70a440, 0x0c562ddb) }, /* 1e-93 */
+    { uint64_constant(0xa6dfbd9f, 0xb8e5b88e), uint64_constant(0xcb4ccd50, 0x0f6bb952) }, /* 1e-92 */
+    { uint64_constant(0xd097ad07, 0xa71f26b2), uint64_constant(0x7e2000a4, 0x1346a7a7) }, /* 1e-91 */
+    { uint64_constant(0x825ecc24, 0xc873782f), uint64_constant(0x8ed40066, 0x8c0c28c8) }, /* 1e-90 */
+    { uint64_constant(0xa2f67f2d, 0xfa90563b), uint64_constant(0x72890080, 0x2f0f32fa) }, /* 1e-89 */
+    { uint64_constant(0xcbb41ef9, 0x79346bca), uint64_constant(0x4f2b40a0, 0x3ad2ffb9) }, /* 1e-88 */
+    { uint64_constant(0xfea126b7, 0xd78186bc), uint64_constant(0xe2f610c8, 0x4987bfa8) }, /* 1e-87 */
+    { uint64_constant(0x9f24b832, 0xe6b0f436), uint64_constant(0x0dd9ca7d, 0x2df4d7c9) }, /* 1e-86 */
+    { uint64_constant(0xc6ede63f, 0xa05d3143), uint64_constant(0x91503d1c, 0x79720dbb) }, /* 1e-85 */
+    { uint64_constant(0xf8a95fcf, 0x88747d94), uint64_constant(0x75a44c63, 0x97ce912a) }, /* 1e-84 */
+    { uint64_constant(0x9b69dbe1, 0xb548ce7c), uint64_constant(0xc986afbe, 0x3ee11aba) }, /* 1e-83 */
+    { uint64_constant(0xc24452da, 0x229b021b), uint64_constant(0xfbe85bad, 0xce996168) }, /* 1e-82 */
+    { uint64_constant(0xf2d56790, 0xab41c2a2), uint64_constant(0xfae27299, 0x423fb9c3) }, /* 1e-81 */
+    { uint64_constant(0x97c560ba, 0x6b0919a5), uint64_constant(0xdccd879f, 0xc967d41a) }, /* 1e-80 */
+    { uint64_constant(0xbdb6b8e9, 0x05cb600f), uint64_constant(0x5400e987, 0xbbc1c920) }, /* 1e-79 */
+    { uint64_constant(0xed246723, 0x473e3813), uint64_constant(0x290123e9, 0xaab23b68) }, /* 1e-78 */
+    { uint64_constant(0x9436c076, 0x0c86e30b), uint64_constant(0xf9a0b672, 0x0aaf6521) }, /* 1e-77 */
+    { uint64_constant(0xb9447093, 0x8fa89bce), uint64_constant(0xf808e40e, 0x8d5b3e69) }, /* 1e-76 */
+    { uint64_constant(0xe7958cb8, 0x7392c2c2), uint64_constant(0xb60b1d12, 0x30b20e04) }, /* 1e-75 */
+    { uint64_constant(0x90bd77f3, 0x483bb9b9), uint64_constant(0xb1c6f22b, 0x5e6f48c2) }, /* 1e-74 */
+    { uint64_constant(0xb4ecd5f0, 0x1a4aa828), uint64_constant(0x1e38aeb6, 0x360b1af3) }, /* 1e-73 */
+    { uint64_constant(0xe2280b6c, 0x20dd5232), uint64_constant(0x25c6da63, 0xc38de1b0) }, /* 1e-72 */
+    { uint64_constant(0x8d590723, 0x948a535f), uint64_constant(0x579c487e, 0x5a38ad0e) }, /* 1e-71 */
+    { uint64_constant(0xb0af48ec, 0x79ace837), uint64_constant(0x2d835a9d, 0xf0c6d851) }, /* 1e-70 */
+    { uint64_constant(0xdcdb1b27, 0x98182244), uint64_constant(0xf8e43145, 0x6cf88e65) }, /* 1e-69 */
+    { uint64_constant(0x8a08f0f8, 0xbf0f156b), uint64_constant(0x1b8e9ecb, 0x641b58ff) }, /* 1e-68 */
+    { uint64_constant(0xac8b2d36, 0xeed2dac5), uint64_constant(0xe272467e, 0x3d222f3f) }, /* 1e-67 */
+    { uint64_constant(0xd7adf884, 0xaa879177), uint64_constant(0x5b0ed81d, 0xcc6abb0f) }, /* 1e-66 */
+    { uint64_constant(0x86ccbb52, 0xea94baea), uint64_constant(0x98e94712, 0x9fc2b4e9) }, /* 1e-65 */
+    { uint64_constant(0xa87fea27, 0xa539e9a5), uint64_constant(0x3f2398d7, 0x47b36224) }, /* 1e-64 */
+    { uint64_constant(0xd29fe4b1, 0x8e88640e), uint64_constant(0x8eec7f0d, 0x19a03aad) }, /* 1e-63 */
+    { uint64_constant(0x83a3eeee, 0xf9153e89), uint64_constant(0x1953cf68, 0x300424ac) }, /* 1e-62 */
+    { uint64_constant(0xa48ceaaa, 0xb75a8e2b), uint64_constant(0x5fa8c342, 0x3c052dd7) }, /* 1e-61 */
+    { uint64_constant(0xcdb02555, 0x653131b6), uint64_constant(0x3792f412, 0xcb06794d) }, /* 1e-60 */
+    { uint64_constant(0x808e1755, 0x5f3ebf11), uint64_constant(0xe2bbd88b, 0xbee40bd0) }, /* 1e-59 */
+    { uint64_constant(0xa0b19d2a, 0xb70e6ed6), uint64_constant(0x5b6aceae, 0xae9d0ec4) }, /* 1e-58 */
+    { uint64_constant(0xc8de0475, 0x64d20a8b), uint64_constant(0xf245825a, 0x5a445275) }, /* 1e-57 */
+    { uint64_constant(0xfb158592, 0xbe068d2e), uint64_constant(0xeed6e2f0, 0xf0d56712) }, /* 1e-56 */
+    { uint64_constant(0x9ced737b, 0xb6c4183d), uint64_constant(0x55464dd6, 0x9685606b) }, /* 1e-55 */
+    { uint64_constant(0xc428d05a, 0xa4751e4c), uint64_constant(0xaa97e14c, 0x3c26b886) }, /* 1e-54 */
+    { uint64_constant(0xf5330471, 0x4d9265df), uint64_constant(0xd53dd99f, 0x4b3066a8) }, /* 1e-53 */
+    { uint64_constant(0x993fe2c6, 0xd07b7fab), uint64_constant(0xe546a803, 0x8efe4029) }, /* 1e-52 */
+    { uint64_constant(0xbf8fdb78, 0x849a5f96), uint64_constant(0xde985204, 0x72bdd033) }, /* 1e-51 */
+    { uint64_constant(0xef73d256, 0xa5c0f77c), uint64_constant(0x963e6685, 0x8f6d4440) }, /* 1e-50 */
+    { uint64_constant(0x95a86376, 0x27989aad), uint64_constant(0xdde70013, 0x79a44aa8) }, /* 1e-49 */
+    { uint64_constant(0xbb127c53, 0xb17ec159), uint64_constant(0x5560c018, 0x580d5d52) }, /* 1e-48 */
+    { uint64_constant(0xe9d71b68, 0x9dde71af), uint64_constant(0xaab8f01e, 0x6e10b4a6) }, /* 1e-47 */
+    { uint64_constant(0x92267121, 0x62ab070d), uint64_constant(0xcab39613, 0x04ca70e8) }, /* 1e-46 */
+    { uint64_constant(0xb6b00d69, 0xbb55c8d1), uint64_constant(0x3d607b97, 0xc5fd0d22) }, /* 1e-45 */
+    { uint64_constant(0xe45c10c4, 0x2a2b3b05), uint64_constant(0x8cb89a7d, 0xb77c506a) }, /* 1e-44 */
+    { uint64_constant(0x8eb98a7a, 0x9a5b04e3), uint64_constant(0x77f3608e, 0x92adb242) }, /* 1e-43 */
+    { uint64_constant(0xb267ed19, 0x40f1c61c), uint64_constant(0x55f038b2, 0x37591ed3) }, /* 1e-42 */
+    { uint64_constant(0xdf01e85f, 0x912e37a3), uint64_constant(0x6b6c46de, 0xc52f6688) }, /* 1e-41 */
+    { uint64_constant(0x8b61313b, 0xbabce2c6), uint64_constant(0x2323ac4b, 0x3b3da015) }, /* 1e-40 */
+    { uint64_constant(0xae397d8a, 0xa96c1b77), uint64_constant(0xabec975e, 0x0a0d081a) }, /* 1e-39 */
+    { uint64_constant(0xd9c7dced, 0x53c72255), uint64_constant(0x96e7bd35, 0x8c904a21) }, /* 1e-38 */
+    { uint64_constant(0x881cea14, 0x545c7575), uint64_constant(0x7e50d641, 0x77da2e54) }, /* 1e-37 */
+    { uint64_constant(0xaa242499, 0x697392d2), uint64_constant(0xdde50bd1, 0xd5d0b9e9) }, /* 1e-36 */
+    { uint64_constant(0xd4ad2dbf, 0xc3d07787), uint64_constant(0x955e4ec6, 0x4b44e864) }, /* 1e-35 */
+    { uint64_constant(0x84ec3c97, 0xda624ab4), uint64_constant(0xbd5af13b, 0xef0b113e) }, /* 1e-34 */
+    { uint64_constant(0xa6274bbd, 0xd0fadd61), uint64_constant(0xecb1ad8a, 0xeacdd58e) }, /* 1e-33 */
+    { uint64_constant(0xcfb11ead, 0x453994ba), uint64_constant(0x67de18ed, 0xa5814af2) }, /* 1e-32 */
+    { uint64_constant(0x81ceb32c, 0x4b43fcf4), uint64_constant(0x80eacf94, 0x8770ced7) }, /* 1e-31 */
+    { uint64_constant(0xa2425ff7, 0x5e14fc31), uint64_constant(0xa1258379, 0xa94d028d) }, /* 1e-30 */
+    { uint64_constant(0xcad2f7f5, 0x359a3b3e), uint64_constant(0x096ee458, 0x13a04330) }, /* 1e-29 */
+    { uint64_constant(0xfd87b5f2, 0x8300ca0d), uint64_constant(0x8bca9d6e, 0x188853fc) }, /* 1e-28 */
+    { uint64_constant(0x9e74d1b7, 0x91e07e48), uint64_constant(0x775ea264, 0xcf55347d) }, /* 1e-27 */
+    { uint64_constant(0xc6120625, 0x76589dda), uint64_constant(0x95364afe, 0x032a819d) }, /* 1e-26 */
+    { uint64_constant(0xf79687ae, 0xd3eec551), uint64_constant(0x3a83ddbd, 0x83f52204) }, /* 1e-25 */
+    { uint64_constant(0x9abe14cd, 0x44753b52), uint64_constant(0xc4926a96, 0x72793542) }, /* 1e-24 */
+    { uint64_constant(0xc16d9a00, 0x95928a27), uint64_constant(0x75b7053c, 0x0f178293) }, /* 1e-23 */
+    { uint64_constant(0xf1c90080, 0xbaf72cb1), uint64_constant(0x5324c68b, 0x12dd6338) }, /* 1e-22 */
+    { uint64_constant(0x971da050, 0x74da7bee), uint64_constant(0xd3f6fc16, 0xebca5e03) }, /* 1e-21 */
+    { uint64_constant(0xbce50864, 0x92111aea), uint64_constant(0x88f4bb1c, 0xa6bcf584) }, /* 1e-20 */
+    { uint64_constant(0xec1e4a7d, 0xb69561a5), uint64_constant(0x2b31e9e3, 0xd06c32e5) }, /* 1e-19 */
+    { uint64_constant(0x9392ee8e, 0x921d5d07), uint64_constant(0x3aff322e, 0x62439fcf) }, /* 1e-18 */
+    { uint64_constant(0xb877aa32, 0x36a4b449), uint64_constant(0x09befeb9, 0xfad487c2) }, /* 1e-17 */
+    { uint64_constant(0xe69594be, 0xc44de15b), uint64_constant(0x4c2ebe68, 0x7989a9b3) }, /* 1e-16 */
+    { uint64_constant(0x901d7cf7, 0x3ab0acd9), uint64_constant(0x0f9d3701, 0x4bf60a10) }, /* 1e-15 */
+    { uint64_constant(0xb424dc35, 0x095cd80f), uint64_constant(0x538484c1, 0x9ef38c94) }, /* 1e-14 */
+    { uint64_constant(0xe12e1342, 0x4bb40e13), uint64_constant(0x2865a5f2, 0x06b06fb9) }, /* 1e-13 */
+    { uint64_constant(0x8cbccc09, 0x6f5088cb), uint64_constant(0xf93f87b7, 0x442e45d3) }, /* 1e-12 */
+    { uint64_constant(0xafebff0b, 0xcb24aafe), uint64_constant(0xf78f69a5, 0x1539d748) }, /* 1e-11 */
+    { uint64_constant(0xdbe6fece, 0xbdedd5be), uint64_constant(0xb573440e, 0x5a884d1b) }, /* 1e-10 */
+    { uint64_constant(0x89705f41, 0x36b4a597), uint64_constant(0x31680a88, 0xf8953030) }, /* 1e-9 */
+    { uint64_constant(0xabcc7711, 0x8461cefc), uint64_constant(0xfdc20d2b, 0x36ba7c3d) }, /* 1e-8 */
+    { uint64_constant(0xd6bf94d5, 0xe57a42bc), uint64_constant(0x3d329076, 0x04691b4c) }, /* 1e-7 */
+    { uint64_constant(0x8637bd05, 0xaf6c69b5), uint64_constant(0xa63f9a49, 0xc2c1b10f) }, /* 1e-6 */
+    { uint64_constant(0xa7c5ac47, 0x1b478423), uint64_constant(0x0fcf80dc, 0x33721d53) }, /* 1e-5 */
+    { uint64_constant(0xd1b71758, 0xe219652b), uint64_constant(0xd3c36113, 0x404ea4a8) }, /* 1e-4 */
+    { uint64_constant(0x83126e97, 0x8d4fdf3b), uint64_constant(0x645a1cac, 0x083126e9) }, /* 1e-3 */
+    { uint64_constant(0xa3d70a3d, 0x70a3d70a), uint64_constant(0x3d70a3d7, 0x0a3d70a3) }, /* 1e-2 */
+    { uint64_constant(0xcccccccc, 0xcccccccc), uint64_constant(0xcccccccc, 0xcccccccc) }, /* 1e-1 */
+    { uint64_constant(0x80000000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e0 */
+    { uint64_constant(0xa0000000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e1 */
+    { uint64_constant(0xc8000000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e2 */
+    { uint64_constant(0xfa000000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e3 */
+    { uint64_constant(0x9c400000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e4 */
+    { uint64_constant(0xc3500000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e5 */
+    { uint64_constant(0xf4240000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e6 */
+    { uint64_constant(0x98968000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e7 */
+    { uint64_constant(0xbebc2000, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e8 */
+    { uint64_constant(0xee6b2800, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e9 */
+    { uint64_constant(0x9502f900, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e10 */
+    { uint64_constant(0xba43b740, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e11 */
+    { uint64_constant(0xe8d4a510, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e12 */
+    { uint64_constant(0x9184e72a, 0x00000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e13 */
+    { uint64_constant(0xb5e620f4, 0x80000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e14 */
+    { uint64_constant(0xe35fa931, 0xa0000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e15 */
+    { uint64_constant(0x8e1bc9bf, 0x04000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e16 */
+    { uint64_constant(0xb1a2bc2e, 0xc5000000), uint64_constant(0x00000000, 0x00000000) }, /* 1e17 */
+    { uint64_constant(0xde0b6b3a, 0x76400000), uint64_constant(0x00000000, 0x00000000) }, /* 1e18 */
+    { uint64_constant(0x8ac72304, 0x89e80000), uint64_constant(0x00000000, 0x00000000) }, /* 1e19 */
+    { uint64_constant(0xad78ebc5, 0xac620000), uint64_constant(0x00000000, 0x00000000) }, /* 1e20 */
+    { uint64_constant(0xd8d726b7, 0x177a8000), uint64_constant(0x00000000, 0x00000000) }, /* 1e21 */
+    { uint64_constant(0x87867832, 0x6eac9000), uint64_constant(0x00000000, 0x00000000) }, /* 1e22 */
+    { uint64_constant(0xa968163f, 0x0a57b400), uint64_constant(0x00000000, 0x00000000) }, /* 1e23 */
+    { uint64_constant(0xd3c21bce, 0xcceda100), uint64_constant(0x00000000, 0x00000000) }, /* 1e24 */
+    { uint64_constant(0x84595161, 0x401484a0), uint64_constant(0x00000000, 0x00000000) }, /* 1e25 */
+    { uint64_constant(0xa56fa5b9, 0x9019a5c8), uint64_constant(0x00000000, 0x00000000) }, /* 1e26 */
+    { uint64_constant(0xcecb8f27, 0xf4200f3a), uint64_constant(0x00000000, 0x00000000) }, /* 1e27 */
+    { uint64_constant(0x813f3978, 0xf8940984), uint64_constant(0x40000000, 0x00000000) }, /* 1e28 */
+    { uint64_constant(0xa18f07d7, 0x36b90be5), uint64_constant(0x50000000, 0x00000000) }, /* 1e29 */
+    { uint64_constant(0xc9f2c9cd, 0x04674ede), uint64_constant(0xa4000000, 0x00000000) }, /* 1e30 */
+    { uint64_constant(0xfc6f7c40, 0x45812296), uint64_constant(0x4d000000, 0x00000000) }, /* 1e31 */
+    { uint64_constant(0x9dc5ada8, 0x2b70b59d), uint64_constant(0xf0200000, 0x00000000) }, /* 1e32 */
+    { uint64_constant(0xc5371912, 0x364ce305), uint64_constant(0x6c280000, 0x00000000) }, /* 1e33 */
+    { uint64_constant(0xf684df56, 0xc3e01bc6), uint64_constant(0xc7320000, 0x00000000) }, /* 1e34 */
+    { uint64_constant(0x9a130b96, 0x3a6c115c), uint64_constant(0x3c7f4000, 0x00000000) }, /* 1e35 */
+    { uint64_constant(0xc097ce7b, 0xc90715b3), uint64_constant(0x4b9f1000, 0x00000000) }, /* 1e36 */
+    { uint64_constant(0xf0bdc21a, 0xbb48db20), uint64_constant(0x1e86d400, 0x00000000) }, /* 1e37 */
+    { uint64_constant(0x96769950, 0xb50d88f4), uint64_constant(0x13144480, 0x00000000) }, /* 1e38 */
+    { uint64_constant(0xbc143fa4, 0xe250eb31), uint64_constant(0x17d955a0, 0x00000000) }, /* 1e39 */
+    { uint64_constant(0xeb194f8e, 0x1ae525fd), uint64_constant(0x5dcfab08, 0x00000000) }, /* 1e40 */
+    { uint64_constant(0x92efd1b8, 0xd0cf37be), uint64_constant(0x5aa1cae5, 0x00000000) }, /* 1e41 */
+    { uint64_constant(0xb7abc627, 0x050305ad), uint64_constant(0xf14a3d9e, 0x40000000) }, /* 1e42 */
+    { uint64_constant(0xe596b7b0, 0xc643c719), uint64_constant(0x6d9ccd05, 0xd0000000) }, /* 1e43 */
+    { uint64_constant(0x8f7e32ce, 0x7bea5c6f), uint64_constant(0xe4820023, 0xa2000000) }, /* 1e44 */
+    { uint64_constant(0xb35dbf82, 0x1ae4f38b), uint64_constant(0xdda2802c, 0x8a800000) }, /* 1e45 */
+    { uint64_constant(0xe0352f62, 0xa19e306e), uint64_constant(0xd50b2037, 0xad200000) }, /* 1e46 */
+    { uint64_constant(0x8c213d9d, 0xa502de45), uint64_constant(0x4526f422, 0xcc340000) }, /* 1e47 */
+    { uint64_constant(0xaf298d05, 0x0e4395d6), uint64_constant(0x9670b12b, 0x7f410000) }, /* 1e48 */
+    { uint64_constant(0xdaf3f046, 0x51d47b4c), uint64_constant(0x3c0cdd76, 0x5f114000) }, /* 1e49 */
+    { uint64_constant(0x88d8762b, 0xf324cd0f), uint64_constant(0xa5880a69, 0xfb6ac800) }, /* 1e50 */
+    { uint64_constant(0xab0e93b6, 0xefee0053), uint64_constant(0x8eea0d04, 0x7a457a00) }, /* 1e51 */
+    { uint64_constant(0xd5d238a4, 0xabe98068), uint64_constant(0x72a49045, 0x98d6d880) }, /* 1e52 */
+    { uint64_constant(0x85a36366, 0xeb71f041), uint64_constant(0x47a6da2b, 0x7f864750) }, /* 1e53 */
+    { uint64_constant(0xa70c3c40, 0xa64e6c51), uint64_constant(0x999090b6, 0x5f67d924) }, /* 1e54 */
+    { uint64_constant(0xd0cf4b50, 0xcfe20765), uint64_constant(0xfff4b4e3, 0xf741cf6d) }, /* 1e55 */
+    { uint64_constant(0x82818f12, 0x81ed449f), uint64_constant(0xbff8f10e, 0x7a8921a4) }, /* 1e56 */
+    { uint64_constant(0xa321f2d7, 0x226895c7), uint64_constant(0xaff72d52, 0x192b6a0d) }, /* 1e57 */
+    { uint64_constant(0xcbea6f8c, 0xeb02bb39), uint64_constant(0x9bf4f8a6, 0x9f764490) }, /* 1e58 */
+    { uint64_constant(0xfee50b70, 0x25c36a08), uint64_constant(0x02f236d0, 0x4753d5b4) }, /* 1e59 */
+    { uint64_constant(0x9f4f2726, 0x179a2245), uint64_constant(0x01d76242, 0x2c946590) }, /* 1e60 */
+    { uint64_constant(0xc722f0ef, 0x9d80aad6), uint64_constant(0x424d3ad2, 0xb7b97ef5) }, /* 1e61 */
+    { uint64_constant(0xf8ebad2b, 0x84e0d58b), uint64_constant(0xd2e08987, 0x65a7deb2) }, /* 1e62 */
+    { uint64_constant(0x9b934c3b, 0x330c8577), uint64_constant(0x63cc55f4, 0x9f88eb2f) }, /* 1e63 */
+    { uint64_constant(0xc2781f49, 0xffcfa6d5), uint64_constant(0x3cbf6b71, 0xc76b25fb) }, /* 1e64 */
+    { uint64_constant(0xf316271c, 0x7fc3908a), uint64_constant(0x8bef464e, 0x3945ef7a) }, /* 1e65 */
+    { uint64_constant(0x97edd871, 0xcfda3a56), uint64_constant(0x97758bf0, 0xe3cbb5ac) }, /* 1e66 */
+    { uint64_constant(0xbde94e8e, 0x43d0c8ec), uint64_constant(0x3d52eeed, 0x1cbea317) }, /* 1e67 */
+    { uint64_constant(0xed63a231, 0xd4c4fb27), uint64_constant(0x4ca7aaa8, 0x63ee4bdd) }, /* 1e68 */
+    { uint64_constant(0x945e455f, 0x24fb1cf8), uint64_constant(0x8fe8caa9, 0x3e74ef6a) }, /* 1e69 */
+    { uint64_constant(0xb975d6b6, 0xee39e436), uint64_constant(0xb3e2fd53, 0x8e122b44) }, /* 1e70 */
+    { uint64_constant(0xe7d34c64, 0xa9c85d44), uint64_constant(0x60dbbca8, 0x7196b616) }, /* 1e71 */
+    { uint64_constant(0x90e40fbe, 0xea1d3a4a), uint64_constant(0xbc8955e9, 0x46fe31cd) }, /* 1e72 */
+    { uint64_constant(0xb51d13ae, 0xa4a488dd), uint64_constant(0x6babab63, 0x98bdbe41) }, /* 1e73 */
+    { uint64_constant(0xe264589a, 0x4dcdab14), uint64_constant(0xc696963c, 0x7eed2dd1) }, /* 1e74 */
+    { uint64_constant(0x8d7eb760, 0x70a08aec), uint64_constant(0xfc1e1de5, 0xcf543ca2) }, /* 1e75 */
+    { uint64_constant(0xb0de6538, 0x8cc8ada8), uint64_constant(0x3b25a55f, 0x43294bcb) }, /* 1e76 */
+    { uint64_constant(0xdd15fe86, 0xaffad912), uint64_constant(0x49ef0eb7, 0x13f39ebe) }, /* 1e77 */
+    { uint64_constant(0x8a2dbf14, 0x2dfcc7ab), uint64_constant(0x6e356932, 0x6c784337) }, /* 1e78 */
+    { uint64_constant(0xacb92ed9, 0x397bf996), uint64_constant(0x49c2c37f, 0x07965404) }, /* 1e79 */
+    { uint64_constant(0xd7e77a8f, 0x87daf7fb), uint64_constant(0xdc33745e, 0xc97be906) }, /* 1e80 */
+    { uint64_constant(0x86f0ac99, 0xb4e8dafd), uint64_constant(0x69a028bb, 0x3ded71a3) }, /* 1e81 */
+    { uint64_constant(0xa8acd7c0, 0x222311bc), uint64_constant(0xc40832ea, 0x0d68ce0c) }, /* 1e82 */
+    { uint64_constant(0xd2d80db0, 0x2aabd62b), uint64_constant(0xf50a3fa4, 0x90c30190) }, /* 1e83 */
+    { uint64_constant(0x83c7088e, 0x1aab65db), uint64_constant(0x792667c6, 0xda79e0fa) }, /* 1e84 */
+    { uint64_constant(0xa4b8cab1, 0xa1563f52), uint64_constant(0x577001b8, 0x91185938) }, /* 1e85 */
+    { uint64_constant(0xcde6fd5e, 0x09abcf26), uint64_constant(0xed4c0226, 0xb55e6f86) }, /* 1e86 */
+    { uint64_constant(0x80b05e5a, 0xc60b6178), uint64_constant(0x544f8158, 0x315b05b4) }, /* 1e87 */
+    { uint64_constant(0xa0dc75f1, 0x778e39d6), uint64_constant(0x696361ae, 0x3db1c721) }, /* 1e88 */
+    { uint64_constant(0xc913936d, 0xd571c84c), uint64_constant(0x03bc3a19, 0xcd1e38e9) }, /* 1e89 */
+    { uint64_constant(0xfb587849, 0x4ace3a5f), uint64_constant(0x04ab48a0, 0x4065c723) }, /* 1e90 */
+    { uint64_constant(0x9d174b2d, 0xcec0e47b), uint64_constant(0x62eb0d64, 0x283f9c76) }, /* 1e91 */
+    { uint64_constant(0xc45d1df9, 0x42711d9a), uint64_constant(0x3ba5d0bd, 0x324f8394) }, /* 1e92 */
+    { uint64_constant(0xf5746577, 0x930d6500), uint64_constant(0xca8f44ec, 0x7ee36479) }, /* 1e93 */
+    { uint64_constant(0x9968bf6a, 0xbbe85f20), uint64_constant(0x7e998b13, 0xcf4e1ecb) }, /* 1e94 */
+    { uint64_constant(0xbfc2ef45, 0x6ae276e8), uint64_constant(0x9e3fedd8, 0xc321a67e) }, /* 1e95 */
+    { uint64_constant(0xefb3ab16, 0xc59b14a2), uint64_constant(0xc5cfe94e, 0xf3ea101e) }, /* 1e96 */
+    { uint64_constant(0x95d04aee, 0x3b80ece5), uint64_constant(0xbba1f1d1, 0x58724a12) }, /* 1e97 */
+    { uint64_constant(0xbb445da9, 0xca61281f), uint64_constant(0x2a8a6e45, 0xae8edc97) }, /* 1e98 */
+    { uint64_constant(0xea157514, 0x3cf97226), uint64_constant(0xf52d09d7, 0x1a3293bd) }, /* 1e99 */
+    { uint64_constant(0x924d692c, 0xa61be758), uint64_constant(0x593c2626, 0x705f9c56) }, /* 1e100 */
+    { uint64_constant(0xb6e0c377, 0xcfa2e12e), uint64_constant(0x6f8b2fb0, 0x0c77836c) }, /* 1e101 */
+    { uint64_constant(0xe498f455, 0xc38b997a), uint64_constant(0x0b6dfb9c, 0x0f956447) }, /* 1e102 */
+    { uint64_constant(0x8edf98b5, 0x9a373fec), uint64_constant(0x4724bd41, 0x89bd5eac) }, /* 1e103 */
+    { uint64_constant(0xb2977ee3, 0x00c50fe7), uint64_constant(0x58edec91, 0xec2cb657) }, /* 1e104 */
+    { uint64_constant(0xdf3d5e9b, 0xc0f653e1), uint64_constant(0x2f2967b6, 0x6737e3ed) }, /* 1e105 */
+    { uint64_constant(0x8b865b21, 0x5899f46c), uint64_constant(0xbd79e0d2, 0x0082ee74) }, /* 1e106 */
+    { uint64_constant(0xae67f1e9, 0xaec07187), uint64_constant(0xecd85906, 0x80a3aa11) }, /* 1e107 */
+    { uint64_constant(0xda01ee64, 0x1a708de9), uint64_constant(0xe80e6f48, 0x20cc9495) }, /* 1e108 */
+    { uint64_constant(0x884134fe, 0x908658b2), uint64_constant(0x3109058d, 0x147fdcdd) }, /* 1e109 */
+    { uint64_constant(0xaa51823e, 0x34a7eede), uint64_constant(0xbd4b46f0, 0x599fd415) }, /* 1e110 */
+    { uint64_constant(0xd4e5e2cd, 0xc1d1ea96), uint64_constant(0x6c9e18ac, 0x7007c91a) }, /* 1e111 */
+    { uint64_constant(0x850fadc0, 0x9923329e), uint64_constant(0x03e2cf6b, 0xc604ddb0) }, /* 1e112 */
+    { uint64_constant(0xa6539930, 0xbf6bff45), uint64_constant(0x84db8346, 0xb786151c) }, /* 1e113 */
+    { uint64_constant(0xcfe87f7c, 0xef46ff16), uint64_constant(0xe6126418, 0x65679a63) }, /* 1e114 */
+    { uint64_constant(0x81f14fae, 0x158c5f6e), uint64_constant(0x4fcb7e8f, 0x3f60c07e) }, /* 1e115 */
+    { uint64_constant(0xa26da399, 0x9aef7749), uint64_constant(0xe3be5e33, 0x0f38f09d) }, /* 1e116 */
+    { uint64_constant(0xcb090c80, 0x01ab551c), uint64_constant(0x5cadf5bf, 0xd3072cc5) }, /* 1e117 */
+    { uint64_constant(0xfdcb4fa0, 0x02162a63), uint64_constant(0x73d9732f, 0xc7c8f7f6) }, /* 1e118 */
+    { uint64_constant(0x9e9f11c4, 0x014dda7e), uint64_constant(0x2867e7fd, 0xdcdd9afa) }, /* 1e119 */
+    { uint64_constant(0xc646d635, 0x01a1511d), uint64_constant(0xb281e1fd, 0x541501b8) }, /* 1e120 */
+    { uint64_constant(0xf7d88bc2, 0x4209a565), uint64_constant(0x1f225a7c, 0xa91a4226) }, /* 1e121 */
+    { uint64_constant(0x9ae75759, 0x6946075f), uint64_constant(0x3375788d, 0xe9b06958) }, /* 1e122 */
+    { uint64_constant(0xc1a12d2f, 0xc3978937), uint64_constant(0x0052d6b1, 0x641c83ae) }, /* 1e123 */
+    { uint64_constant(0xf209787b, 0xb47d6b84), uint64_constant(0xc0678c5d, 0xbd23a49a) }, /* 1e124 */
+    { uint64_constant(0x9745eb4d, 0x50ce6332), uint64_constant(0xf840b7ba, 0x963646e0) }, /* 1e125 */
+    { uint64_constant(0xbd176620, 0xa501fbff), uint64_constant(0xb650e5a9, 0x3bc3d898) }, /* 1e126 */
+    { uint64_constant(0xec5d3fa8, 0xce427aff), uint64_constant(0xa3e51f13, 0x8ab4cebe) }, /* 1e127 */
+    { uint64_constant(0x93ba47c9, 0x80e98cdf), uint64_constant(0xc66f336c, 0x36b10137) }, /* 1e128 */
+    { uint64_constant(0xb8a8d9bb, 0xe123f017), uint64_constant(0xb80b0047, 0x445d4184) }, /* 1e129 */
+    { uint64_constant(0xe6d3102a, 0xd96cec1d), uint64_constant(0xa60dc059, 0x157491e5) }, /* 1e130 */
+    { uint64_constant(0x9043ea1a, 0xc7e41392), uint64_constant(0x87c89837, 0xad68db2f) }, /* 1e131 */
+    { uint64_constant(0xb454e4a1, 0x79dd1877), uint64_constant(0x29babe45, 0x98c311fb) }, /* 1e132 */
+    { uint64_constant(0xe16a1dc9, 0xd8545e94), uint64_constant(0xf4296dd6, 0xfef3d67a) }, /* 1e133 */
+    { uint64_constant(0x8ce2529e, 0x2734bb1d), uint64_constant(0x1899e4a6, 0x5f58660c) }, /* 1e134 */
+    { uint64_constant(0xb01ae745, 0xb101e9e4), uint64_constant(0x5ec05dcf, 0xf72e7f8f) }, /* 1e135 */
+    { uint64_constant(0xdc21a117, 0x1d42645d), uint64_constant(0x76707543, 0xf4fa1f73) }, /* 1e136 */
+    { uint64_constant(0x899504ae, 0x72497eba), uint64_constant(0x6a06494a, 0x791c53a8) }, /* 1e137 */
+    { uint64_constant(0xabfa45da, 0x0edbde69), uint64_constant(0x0487db9d, 0x17636892) }, /* 1e138 */
+    { uint64_constant(0xd6f8d750, 0x9292d603), uint64_constant(0x45a9d284, 0x5d3c42b6) }, /* 1e139 */
+    { uint64_constant(0x865b8692, 0x5b9bc5c2), uint64_constant(0x0b8a2392, 0xba45a9b2) }, /* 1e140 */
+    { uint64_constant(0xa7f26836, 0xf282b732), uint64_constant(0x8e6cac77, 0x68d7141e) }, /* 1e141 */
+    { uint64_constant(0xd1ef0244, 0xaf2364ff), uint64_constant(0x3207d795, 0x430cd926) }, /* 1e142 */
+    { uint64_constant(0x8335616a, 0xed761f1f), uint64_constant(0x7f44e6bd, 0x49e807b8) }, /* 1e143 */
+    { uint64_constant(0xa402b9c5, 0xa8d3a6e7), uint64_constant(0x5f16206c, 0x9c6209a6) }, /* 1e144 */
+    { uint64_constant(0xcd036837, 0x130890a1), uint64_constant(0x36dba887, 0xc37a8c0f) }, /* 1e145 */
+    { uint64_constant(0x80222122, 0x6be55a64), uint64_constant(0xc2494954, 0xda2c9789) }, /* 1e146 */
+    { uint64_constant(0xa02aa96b, 0x06deb0fd), uint64_constant(0xf2db9baa, 0x10b7bd6c) }, /* 1e147 */
+    { uint64_constant(0xc83553c5, 0xc8965d3d), uint64_constant(0x6f928294, 0x94e5acc7) }, /* 1e148 */
+    { uint64_constant(0xfa42a8b7, 0x3abbf48c), uint64_constant(0xcb772339, 0xba1f17f9) }, /* 1e149 */
+    { uint64_constant(0x9c69a972, 0x84b578d7), uint64_constant(0xff2a7604, 0x14536efb) }, /* 1e150 */
+    { uint64_constant(0xc38413cf, 0x25e2d70d), uint64_constant(0xfef51385, 0x19684aba) }, /* 1e151 */
+    { uint64_constant(0xf46518c2, 0xef5b8cd1), uint64_constant(0x7eb25866, 0x5fc25d69) }, /* 1e152 */
+    { uint64_constant(0x98bf2f79, 0xd5993802), uint64_constant(0xef2f773f, 0xfbd97a61) }, /* 1e153 */
+    { uint64_constant(0xbeeefb58, 0x4aff8603), uint64_constant(0xaafb550f, 0xfacfd8fa) }, /* 1e154 */
+    { uint64_constant(0xeeaaba2e, 0x5dbf6784), uint64_constant(0x95ba2a53, 0xf983cf38) }, /* 1e155 */
+    { uint64_constant(0x952ab45c, 0xfa97a0b2), uint64_constant(0xdd945a74, 0x7bf26183) }, /* 1e156 */
+    { uint64_constant(0xba756174, 0x393d88df), uint64_constant(0x94f97111, 0x9aeef9e4) }, /* 1e157 */
+    { uint64_constant(0xe912b9d1, 0x478ceb17), uint64_constant(0x7a37cd56, 0x01aab85d) }, /* 1e158 */
+    { uint64_constant(0x91abb422, 0xccb812ee), uint64_constant(0xac62e055, 0xc10ab33a) }, /* 1e159 */
+    { uint64_constant(0xb616a12b, 0x7fe617aa), uint64_constant(0x577b986b, 0x314d6009) }, /* 1e160 */
+    { uint64_constant(0xe39c4976, 0x5fdf9d94), uint64_constant(0xed5a7e85, 0xfda0b80b) }, /* 1e161 */
+    { uint64_constant(0x8e41ade9, 0xfbebc27d), uint64_constant(0x14588f13, 0xbe847307) }, /* 1e162 */
+    { uint64_constant(0xb1d21964, 0x7ae6b31c), uint64_constant(0x596eb2d8, 0xae258fc8) }, /* 1e163 */
+    { uint64_constant(0xde469fbd, 0x99a05fe3), uint64_constant(0x6fca5f8e, 0xd9aef3bb) }, /* 1e164 */
+    { uint64_constant(0x8aec23d6, 0x80043bee), uint64_constant(0x25de7bb9, 0x480d5854) }, /* 1e165 */
+    { uint64_constant(0xada72ccc, 0x20054ae9), uint64_constant(0xaf561aa7, 0x9a10ae6a) }, /* 1e166 */
+    { uint64_constant(0xd910f7ff, 0x28069da4), uint64_constant(0x1b2ba151, 0x8094da04) }, /* 1e167 */
+    { uint64_constant(0x87aa9aff, 0x79042286), uint64_constant(0x90fb44d2, 0xf05d0842) }, /* 1e168 */
+    { uint64_constant(0xa99541bf, 0x57452b28), uint64_constant(0x353a1607, 0xac744a53) }, /* 1e169 */
+    { uint64_constant(0xd3fa922f, 0x2d1675f2), uint64_constant(0x42889b89, 0x97915ce8) }, /* 1e170 */
+    { uint64_constant(0x847c9b5d, 0x7c2e09b7), uint64_constant(0x69956135, 0xfebada11) }, /* 1e171 */
+    { uint64_constant(0xa59bc234, 0xdb398c25), uint64_constant(0x43fab983, 0x7e699095) }, /* 1e172 */
+    { uint64_constant(0xcf02b2c2, 0x1207ef2e), uint64_constant(0x94f967e4, 0x5e03f4bb) }, /* 1e173 */
+    { uint64_constant(0x8161afb9, 0x4b44f57d), uint64_constant(0x1d1be0ee, 0xbac278f5) }, /* 1e174 */
+    { uint64_constant(0xa1ba1ba7, 0x9e1632dc), uint64_constant(0x6462d92a, 0x69731732) }, /* 1e175 */
+    { uint64_constant(0xca28a291, 0x859bbf93), uint64_constant(0x7d7b8f75, 0x03cfdcfe) }, /* 1e176 */
+    { uint64_constant(0xfcb2cb35, 0xe702af78), uint64_constant(0x5cda7352, 0x44c3d43e) }, /* 1e177 */
+    { uint64_constant(0x9defbf01, 0xb061adab), uint64_constant(0x3a088813, 0x6afa64a7) }, /* 1e178 */
+    { uint64_constant(0xc56baec2, 0x1c7a1916), uint64_constant(0x088aaa18, 0x45b8fdd0) }, /* 1e179 */
+    { uint64_constant(0xf6c69a72, 0xa3989f5b), uint64_constant(0x8aad549e, 0x57273d45) }, /* 1e180 */
+    { uint64_constant(0x9a3c2087, 0xa63f6399), uint64_constant(0x36ac54e2, 0xf678864b) }, /* 1e181 */
+    { uint64_constant(0xc0cb28a9, 0x8fcf3c7f), uint64_constant(0x84576a1b, 0xb416a7dd) }, /* 1e182 */
+    { uint64_constant(0xf0fdf2d3, 0xf3c30b9f), uint64_constant(0x656d44a2, 0xa11c51d5) }, /* 1e183 */
+    { uint64_constant(0x969eb7c4, 0x7859e743), uint64_constant(0x9f644ae5, 0xa4b1b325) }, /* 1e184 */
+    { uint64_constant(0xbc4665b5, 0x96706114), uint64_constant(0x873d5d9f, 0x0dde1fee) }, /* 1e185 */
+    { uint64_constant(0xeb57ff22, 0xfc0c7959), uint64_constant(0xa90cb506, 0xd155a7ea) }, /* 1e186 */
+    { uint64_constant(0x9316ff75, 0xdd87cbd8), uint64_constant(0x09a7f124, 0x42d588f2) }, /* 1e187 */
+    { uint64_constant(0xb7dcbf53, 0x54e9bece), uint64_constant(0x0c11ed6d, 0x538aeb2f) }, /* 1e188 */
+    { uint64_constant(0xe5d3ef28, 0x2a242e81), uint64_constant(0x8f1668c8, 0xa86da5fa) }, /* 1e189 */
+    { uint64_constant(0x8fa47579, 0x1a569d10), uint64_constant(0xf96e017d, 0x694487bc) }, /* 1e190 */
+    { uint64_constant(0xb38d92d7, 0x60ec4455), uint64_constant(0x37c981dc, 0xc395a9ac) }, /* 1e191 */
+    { uint64_constant(0xe070f78d, 0x3927556a), uint64_constant(0x85bbe253, 0xf47b1417) }, /* 1e192 */
+    { uint64_constant(0x8c469ab8, 0x43b89562), uint64_constant(0x93956d74, 0x78ccec8e) }, /* 1e193 */
+    { uint64_constant(0xaf584166, 0x54a6babb), uint64_constant(0x387ac8d1, 0x970027b2) }, /* 1e194 */
+    { uint64_constant(0xdb2e51bf, 0xe9d0696a), uint64_constant(0x06997b05, 0xfcc0319e) }, /* 1e195 */
+    { uint64_constant(0x88fcf317, 0xf22241e2), uint64_constant(0x441fece3, 0xbdf81f03) }, /* 1e196 */
+    { uint64_constant(0xab3c2fdd, 0xeeaad25a), uint64_constant(0xd527e81c, 0xad7626c3) }, /* 1e197 */
+    { uint64_constant(0xd60b3bd5, 0x6a5586f1), uint64_constant(0x8a71e223, 0xd8d3b074) }, /* 1e198 */
+    { uint64_constant(0x85c70565, 0x62757456), uint64_constant(0xf6872d56, 0x67844e49) }, /* 1e199 */
+    { uint64_constant(0xa738c6be, 0xbb12d16c), uint64_constant(0xb428f8ac, 0x016561db) }, /* 1e200 */
+    { uint64_constant(0xd106f86e, 0x69d785c7), uint64_constant(0xe13336d7, 0x01beba52) }, /* 1e201 */
+    { uint64_constant(0x82a45b45, 0x0226b39c), uint64_constant(0xecc00246, 0x61173473) }, /* 1e202 */
+    { uint64_constant(0xa34d7216, 0x42b06084), uint64_constant(0x27f002d7, 0xf95d0190) }, /* 1e203 */
+    { uint64_constant(0xcc20ce9b, 0xd35c78a5), uint64_constant(0x31ec038d, 0xf7b441f4) }, /* 1e204 */
+    { uint64_constant(0xff290242, 0xc83396ce), uint64_constant(0x7e670471, 0x75a15271) }, /* 1e205 */
+    { uint64_constant(0x9f79a169, 0xbd203e41), uint64_constant(0x0f0062c6, 0xe984d386) }, /* 1e206 */
+    { uint64_constant(0xc75809c4, 0x2c684dd1), uint64_constant(0x52c07b78, 0xa3e60868) }, /* 1e207 */
+    { uint64_constant(0xf92e0c35, 0x37826145), uint64_constant(0xa7709a56, 0xccdf8a82) }, /* 1e208 */
+    { uint64_constant(0x9bbcc7a1, 0x42b17ccb), uint64_constant(0x88a66076, 0x400bb691) }, /* 1e209 */
+    { uint64_constant(0xc2abf989, 0x935ddbfe), uint64_constant(0x6acff893, 0xd00ea435) }, /* 1e210 */
+    { uint64_constant(0xf356f7eb, 0xf83552fe), uint64_constant(0x0583f6b8, 0xc4124d43) }, /* 1e211 */
+    { uint64_constant(0x98165af3, 0x7b2153de), uint64_constant(0xc3727a33, 0x7a8b704a) }, /* 1e212 */
+    { uint64_constant(0xbe1bf1b0, 0x59e9a8d6), uint64_constant(0x744f18c0, 0x592e4c5c) }, /* 1e213 */
+    { uint64_constant(0xeda2ee1c, 0x7064130c), uint64_constant(0x1162def0, 0x6f79df73) }, /* 1e214 */
+    { uint64_constant(0x9485d4d1, 0xc63e8be7), uint64_constant(0x8addcb56, 0x45ac2ba8) }, /* 1e215 */
+    { uint64_constant(0xb9a74a06, 0x37ce2ee1), uint64_constant(0x6d953e2b, 0xd7173692) }, /* 1e216 */
+    { uint64_constant(0xe8111c87, 0xc5c1ba99), uint64_constant(0xc8fa8db6, 0xccdd0437) }, /* 1e217 */
+    { uint64_constant(0x910ab1d4, 0xdb9914a0), uint64_constant(0x1d9c9892, 0x400a22a2) }, /* 1e218 */
+    { uint64_constant(0xb54d5e4a, 0x127f59c8), uint64_constant(0x2503beb6, 0xd00cab4b) }, /* 1e219 */
+    { uint64_constant(0xe2a0b5dc, 0x971f303a), uint64_constant(0x2e44ae64, 0x840fd61d) }, /* 1e220 */
+    { uint64_constant(0x8da471a9, 0xde737e24), uint64_constant(0x5ceaecfe, 0xd289e5d2) }, /* 1e221 */
+    { uint64_constant(0xb10d8e14, 0x56105dad), uint64_constant(0x7425a83e, 0x872c5f47) }, /* 1e222 */
+    { uint64_constant(0xdd50f199, 0x6b947518), uint64_constant(0xd12f124e, 0x28f77719) }, /* 1e223 */
+    { uint64_constant(0x8a5296ff, 0xe33cc92f), uint64_constant(0x82bd6b70, 0xd99aaa6f) }, /* 1e224 */
+    { uint64_constant(0xace73cbf, 0xdc0bfb7b), uint64_constant(0x636cc64d, 0x1001550b) }, /* 1e225 */
+    { uint64_constant(0xd8210bef, 0xd30efa5a), uint64_constant(0x3c47f7e0, 0x5401aa4e) }, /* 1e226 */
+    { uint64_constant(0x8714a775, 0xe3e95c78), uint64_constant(0x65acfaec, 0x34810a71) }, /* 1e227 */
+    { uint64_constant(0xa8d9d153, 0x5ce3b396), uint64_constant(0x7f1839a7, 0x41a14d0d) }, /* 1e228 */
+    { uint64_constant(0xd31045a8, 0x341ca07c), uint64_constant(0x1ede4811, 0x1209a050) }, /* 1e229 */
+    { uint64_constant(0x83ea2b89, 0x2091e44d), uint64_constant(0x934aed0a, 0xab460432) }, /* 1e230 */
+    { uint64_constant(0xa4e4b66b, 0x68b65d60), uint64_constant(0xf81da84d, 0x5617853f) }, /* 1e231 */
+    { uint64_constant(0xce1de406, 0x42e3f4b9), uint64_constant(0x36251260, 0xab9d668e) }, /* 1e232 */
+    { uint64_constant(0x80d2ae83, 0xe9ce78f3), uint64_constant(0xc1d72b7c, 0x6b426019) }, /* 1e233 */
+    { uint64_constant(0xa1075a24, 0xe4421730), uint64_constant(0xb24cf65b, 0x8612f81f) }, /* 1e234 */
+    { uint64_constant(0xc94930ae, 0x1d529cfc), uint64_constant(0xdee033f2, 0x6797b627) }, /* 1e235 */
+    { uint64_constant(0xfb9b7cd9, 0xa4a7443c), uint64_constant(0x169840ef, 0x017da3b1) }, /* 1e236 */
+    { uint64_constant(0x9d412e08, 0x06e88aa5), uint64_constant(0x8e1f2895, 0x60ee864e) }, /* 1e237 */
+    { uint64_constant(0xc491798a, 0x08a2ad4e), uint64_constant(0xf1a6f2ba, 0xb92a27e2) }, /* 1e238 */
+    { uint64_constant(0xf5b5d7ec, 0x8acb58a2), uint64_constant(0xae10af69, 0x6774b1db) }, /* 1e239 */
+    { uint64_constant(0x9991a6f3, 0xd6bf1765), uint64_constant(0xacca6da1, 0xe0a8ef29) }, /* 1e240 */
+    { uint64_constant(0xbff610b0, 0xcc6edd3f), uint64_constant(0x17fd090a, 0x58d32af3) }, /* 1e241 */
+    { uint64_constant(0xeff394dc, 0xff8a948e), uint64_constant(0xddfc4b4c, 0xef07f5b0) }, /* 1e242 */
+    { uint64_constant(0x95f83d0a, 0x1fb69cd9), uint64_constant(0x4abdaf10, 0x1564f98e) }, /* 1e243 */
+    { uint64_constant(0xbb764c4c, 0xa7a4440f), uint64_constant(0x9d6d1ad4, 0x1abe37f1) }, /* 1e244 */
+    { uint64_constant(0xea53df5f, 0xd18d5513), uint64_constant(0x84c86189, 0x216dc5ed) }, /* 1e245 */
+    { uint64_constant(0x92746b9b, 0xe2f8552c), uint64_constant(0x32fd3cf5, 0xb4e49bb4) }, /* 1e246 */
+    { uint64_constant(0xb7118682, 0xdbb66a77), uint64_constant(0x3fbc8c33, 0x221dc2a1) }, /* 1e247 */
+    { uint64_constant(0xe4d5e823, 0x92a40515), uint64_constant(0x0fabaf3f, 0xeaa5334a) }, /* 1e248 */
+    { uint64_constant(0x8f05b116, 0x3ba6832d), uint64_constant(0x29cb4d87, 0xf2a7400e) }, /* 1e249 */
+    { uint64_constant(0xb2c71d5b, 0xca9023f8), uint64_constant(0x743e20e9, 0xef511012) }, /* 1e250 */
+    { uint64_constant(0xdf78e4b2, 0xbd342cf6), uint64_constant(0x914da924, 0x6b255416) }, /* 1e251 */
+    { uint64_constant(0x8bab8eef, 0xb6409c1a), uint64_constant(0x1ad089b6, 0xc2f7548e) }, /* 1e252 */
+    { uint64_constant(0xae9672ab, 0xa3d0c320), uint64_constant(0xa184ac24, 0x73b529b1) }, /* 1e253 */
+    { uint64_constant(0xda3c0f56, 0x8cc4f3e8), uint64_constant(0xc9e5d72d, 0x90a2741e) }, /* 1e254 */
+    { uint64_constant(0x88658996, 0x17fb1871), uint64_constant(0x7e2fa67c, 0x7a658892) }, /* 1e255 */
+    { uint64_constant(0xaa7eebfb, 0x9df9de8d), uint64_constant(0xddbb901b, 0x98feeab7) }, /* 1e256 */
+    { uint64_constant(0xd51ea6fa, 0x85785631), uint64_constant(0x552a7422, 0x7f3ea565) }, /* 1e257 */
+    { uint64_constant(0x8533285c, 0x936b35de), uint64_constant(0xd53a8895, 0x8f87275f) }, /* 1e258 */
+    { uint64_constant(0xa67ff273, 0xb8460356), uint64_constant(0x8a892aba, 0xf368f137) }, /* 1e259 */
+    { uint64_constant(0xd01fef10, 0xa657842c), uint64_constant(0x2d2b7569, 0xb0432d85) }, /* 1e260 */
+    { uint64_constant(0x8213f56a, 0x67f6b29b), uint64_constant(0x9c3b2962, 0x0e29fc73) }, /* 1e261 */
+    { uint64_constant(0xa298f2c5, 0x01f45f42), uint64_constant(0x8349f3ba, 0x91b47b8f) }, /* 1e262 */
+    { uint64_constant(0xcb3f2f76, 0x42717713), uint64_constant(0x241c70a9, 0x36219a73) }, /* 1e263 */
+    { uint64_constant(0xfe0efb53, 0xd30dd4d7), uint64_constant(0xed238cd3, 0x83aa0110) }, /* 1e264 */
+    { uint64_constant(0x9ec95d14, 0x63e8a506), uint64_constant(0xf4363804, 0x324a40aa) }, /* 1e265 */
+    { uint64_constant(0xc67bb459, 0x7ce2ce48), uint64_constant(0xb143c605, 0x3edcd0d5) }, /* 1e266 */
+    { uint64_constant(0xf81aa16f, 0xdc1b81da), uint64_constant(0xdd94b786, 0x8e94050a) }, /* 1e267 */
+    { uint64_constant(0x9b10a4e5, 0xe9913128), uint64_constant(0xca7cf2b4, 0x191c8326) }, /* 1e268 */
+    { uint64_constant(0xc1d4ce1f, 0x63f57d72), uint64_constant(0xfd1c2f61, 0x1f63a3f0) }, /* 1e269 */
+    { uint64_constant(0xf24a01a7, 0x3cf2dccf), uint64_constant(0xbc633b39, 0x673c8cec) }, /* 1e270 */
+    { uint64_constant(0x976e4108, 0x8617ca01), uint64_constant(0xd5be0503, 0xe085d813) }, /* 1e271 */
+    { uint64_constant(0xbd49d14a, 0xa79dbc82), uint64_constant(0x4b2d8644, 0xd8a74e18) }, /* 1e272 */
+    { uint64_constant(0xec9c459d, 0x51852ba2), uint64_constant(0xddf8e7d6, 0x0ed1219e) }, /* 1e273 */
+    { uint64_constant(0x93e1ab82, 0x52f33b45), uint64_constant(0xcabb90e5, 0xc942b503) }, /* 1e274 */
+    { uint64_constant(0xb8da1662, 0xe7b00a17), uint64_constant(0x3d6a751f, 0x3b936243) }, /* 1e275 */
+    { uint64_constant(0xe7109bfb, 0xa19c0c9d), uint64_constant(0x0cc51267, 0x0a783ad4) }, /* 1e276 */
+    { uint64_constant(0x906a617d, 0x450187e2), uint64_constant(0x27fb2b80, 0x668b24c5) }, /* 1e277 */
+    { uint64_constant(0xb484f9dc, 0x9641e9da), uint64_constant(0xb1f9f660, 0x802dedf6) }, /* 1e278 */
+    { uint64_constant(0xe1a63853, 0xbbd26451), uint64_constant(0x5e7873f8, 0xa0396973) }, /* 1e279 */
+    { uint64_constant(0x8d07e334, 0x55637eb2), uint64_constant(0xdb0b487b, 0x6423e1e8) }, /* 1e280 */
+    { uint64_constant(0xb049dc01, 0x6abc5e5f), uint64_constant(0x91ce1a9a, 0x3d2cda62) }, /* 1e281 */
+    { uint64_constant(0xdc5c5301, 0xc56b75f7), uint64_constant(0x7641a140, 0xcc7810fb) }, /* 1e282 */
+    { uint64_constant(0x89b9b3e1, 0x1b6329ba), uint64_constant(0xa9e904c8, 0x7fcb0a9d) }, /* 1e283 */
+    { uint64_constant(0xac2820d9, 0x623bf429), uint64_constant(0x546345fa, 0x9fbdcd44) }, /* 1e284 */
+    { uint64_constant(0xd732290f, 0xbacaf133), uint64_constant(0xa97c1779, 0x47ad4095) }, /* 1e285 */
+    { uint64_constant(0x867f59a9, 0xd4bed6c0), uint64_constant(0x49ed8eab, 0xcccc485d) }, /* 1e286 */
+    { uint64_constant(0xa81f3014, 0x49ee8c70), uint64_constant(0x5c68f256, 0xbfff5a74) }, /* 1e287 */
+    { uint64_constant(0xd226fc19, 0x5c6a2f8c), uint64_constant(0x73832eec, 0x6fff3111) }, /* 1e288 */
+    { uint64_constant(0x83585d8f, 0xd9c25db7), uint64_constant(0xc831fd53, 0xc5ff7eab) }, /* 1e289 */
+    { uint64_constant(0xa42e74f3, 0xd032f525), uint64_constant(0xba3e7ca8, 0xb77f5e55) }, /* 1e290 */
+    { uint64_constant(0xcd3a1230, 0xc43fb26f), uint64_constant(0x28ce1bd2, 0xe55f35eb) }, /* 1e291 */
+    { uint64_constant(0x80444b5e, 0x7aa7cf85), uint64_constant(0x7980d163, 0xcf5b81b3) }, /* 1e292 */
+    { uint64_constant(0xa0555e36, 0x1951c366), uint64_constant(0xd7e105bc, 0xc332621f) }, /* 1e293 */
+    { uint64_constant(0xc86ab5c3, 0x9fa63440), uint64_constant(0x8dd9472b, 0xf3fefaa7) }, /* 1e294 */
+    { uint64_constant(0xfa856334, 0x878fc150), uint64_constant(0xb14f98f6, 0xf0feb951) }, /* 1e295 */
+    { uint64_constant(0x9c935e00, 0xd4b9d8d2), uint64_constant(0x6ed1bf9a, 0x569f33d3) }, /* 1e296 */
+    { uint64_constant(0xc3b83581, 0x09e84f07), uint64_constant(0x0a862f80, 0xec4700c8) }, /* 1e297 */
+    { uint64_constant(0xf4a642e1, 0x4c6262c8), uint64_constant(0xcd27bb61, 0x2758c0fa) }, /* 1e298 */
+    { uint64_constant(0x98e7e9cc, 0xcfbd7dbd), uint64_constant(0x8038d51c, 0xb897789c) }, /* 1e299 */
+    { uint64_constant(0xbf21e440, 0x03acdd2c), uint64_constant(0xe0470a63, 0xe6bd56c3) }, /* 1e300 */
+    { uint64_constant(0xeeea5d50, 0x04981478), uint64_constant(0x1858ccfc, 0xe06cac74) }, /* 1e301 */
+    { uint64_constant(0x95527a52, 0x02df0ccb), uint64_constant(0x0f37801e, 0x0c43ebc8) }, /* 1e302 */
+    { uint64_constant(0xbaa718e6, 0x8396cffd), uint64_constant(0xd3056025, 0x8f54e6ba) }, /* 1e303 */
+    { uint64_constant(0xe950df20, 0x247c83fd), uint64_constant(0x47c6b82e, 0xf32a2069) }, /* 1e304 */
+    { uint64_constant(0x91d28b74, 0x16cdd27e), uint64_constant(0x4cdc331d, 0x57fa5441) }, /* 1e305 */
+    { uint64_constant(0xb6472e51, 0x1c81471d), uint64_constant(0xe0133fe4, 0xadf8e952) }, /* 1e306 */
+    { uint64_constant(0xe3d8f9e5, 0x63a198e5), uint64_constant(0x58180fdd, 0xd97723a6) }, /* 1e307 */
+    { uint64_constant(0x8e679c2f, 0x5e44ff8f), uint64_constant(0x570f09ea, 0xa7ea7648) }, /* 1e308 */
+    { uint64_constant(0xb201833b, 0x35d63f73), uint64_constant(0x2cd2cc65, 0x51e513da) }, /* 1e309 */
+    { uint64_constant(0xde81e40a, 0x034bcf4f), uint64_constant(0xf8077f7e, 0xa65e58d1) }, /* 1e310 */
+    { uint64_constant(0x8b112e86, 0x420f6191), uint64_constant(0xfb04afaf, 0x27faf782) }, /* 1e311 */
+    { uint64_constant(0xadd57a27, 0xd29339f6), uint64_constant(0x79c5db9a, 0xf1f9b563) }, /* 1e312 */
+    { uint64_constant(0xd94ad8b1, 0xc7380874), uint64_constant(0x18375281, 0xae7822bc) }, /* 1e313 */
+    { uint64_constant(0x87cec76f, 0x1c830548), uint64_constant(0x8f229391, 0x0d0b15b5) }, /* 1e314 */
+    { uint64_constant(0xa9c2794a, 0xe3a3c69a), uint64_constant(0xb2eb3875, 0x504ddb22) }, /* 1e315 */
+    { uint64_constant(0xd433179d, 0x9c8cb841), uint64_constant(0x5fa60692, 0xa46151eb) }, /* 1e316 */
+    { uint64_constant(0x849feec2, 0x81d7f328), uint64_constant(0xdbc7c41b, 0xa6bcd333) }, /* 1e317 */
+    { uint64_constant(0xa5c7ea73, 0x224deff3), uint64_constant(0x12b9b522, 0x906c0800) }, /* 1e318 */
+    { uint64_constant(0xcf39e50f, 0xeae16bef), uint64_constant(0xd768226b, 0x34870a00) }, /* 1e319 */
+    { uint64_constant(0x81842f29, 0xf2cce375), uint64_constant(0xe6a11583, 0x00d46640) }, /* 1e320 */
+    { uint64_constant(0xa1e53af4, 0x6f801c53), uint64_constant(0x60495ae3, 0xc1097fd0) }, /* 1e321 */
+    { uint64_constant(0xca5e89b1, 0x8b602368), uint64_constant(0x385bb19c, 0xb14bdfc4) }, /* 1e322 */
+    { uint64_constant(0xfcf62c1d, 0xee382c42), uint64_constant(0x46729e03, 0xdd9ed7b5) }, /* 1e323 */
+    { uint64_constant(0x9e19db92, 0xb4e31ba9), uint64_constant(0x6c07a2c2, 0x6a8346d1) }, /* 1e324 */
+    { uint64_constant(0xc5a05277, 0x621be293), uint64_constant(0xc7098b73, 0x05241885) }, /* 1e325 */
+    { uint64_constant(0xf7086715, 0x3aa2db38), uint64_constant(0xb8cbee4f, 0xc66d1ea7) }, /* 1e326 */
+    { uint64_constant(0x9a65406d, 0x44a5c903), uint64_constant(0x737f74f1, 0xdc043328) }, /* 1e327 */
+    { uint64_constant(0xc0fe9088, 0x95cf3b44), uint64_constant(0x505f522e, 0x53053ff2) }, /* 1e328 */
+    { uint64_constant(0xf13e34aa, 0xbb430a15), uint64_constant(0x647726b9, 0xe7c68fef) }, /* 1e329 */
+    { uint64_constant(0x96c6e0ea, 0xb509e64d), uint64_constant(0x5eca7834, 0x30dc19f5) }, /* 1e330 */
+    { uint64_constant(0xbc789925, 0x624c5fe0), uint64_constant(0xb67d1641, 0x3d132072) }, /* 1e331 */
+    { uint64_constant(0xeb96bf6e, 0xbadf77d8), uint64_constant(0xe41c5bd1, 0x8c57e88f) }, /* 1e332 */
+    { uint64_constant(0x933e37a5, 0x34cbaae7), uint64_constant(0x8e91b962, 0xf7b6f159) }, /* 1e333 */
+    { uint64_constant(0xb80dc58e, 0x81fe95a1), uint64_constant(0x723627bb, 0xb5a4adb0) }, /* 1e334 */
+    { uint64_constant(0xe61136f2, 0x227e3b09), uint64_constant(0xcec3b1aa, 0xa30dd91c) }, /* 1e335 */
+    { uint64_constant(0x8fcac257, 0x558ee4e6), uint64_constant(0x213a4f0a, 0xa5e8a7b1) }, /* 1e336 */
+    { uint64_constant(0xb3bd72ed, 0x2af29e1f), uint64_constant(0xa988e2cd, 0x4f62d19d) }, /* 1e337 */
+    { uint64_constant(0xe0accfa8, 0x75af45a7), uint64_constant(0x93eb1b80, 0xa33b8605) }, /* 1e338 */
+    { uint64_constant(0x8c6c01c9, 0x498d8b88), uint64_constant(0xbc72f130, 0x660533c3) }, /* 1e339 */
+    { uint64_constant(0xaf87023b, 0x9bf0ee6a), uint64_constant(0xeb8fad7c, 0x7f8680b4) }, /* 1e340 */
+    { uint64_constant(0xdb68c2ca, 0x82ed2a05), uint64_constant(0xa67398db, 0x9f6820e1) }, /* 1e341 */
+    { uint64_constant(0x892179be, 0x91d43a43), uint64_constant(0x88083f89, 0x43a1148c) }, /* 1e342 */
+    { uint64_constant(0xab69d82e, 0x364948d4), uint64_constant(0x6a0a4f6b, 0x948959b0) }, /* 1e343 */
+    { uint64_constant(0xd6444e39, 0xc3db9b09), uint64_constant(0x848ce346, 0x79abb01c) }, /* 1e344 */
+    { uint64_constant(0x85eab0e4, 0x1a6940e5), uint64_constant(0xf2d80e0c, 0x0c0b4e11) }, /* 1e345 */
+    { uint64_constant(0xa7655d1d, 0x2103911f), uint64_constant(0x6f8e118f, 0x0f0e2195) }, /* 1e346 */
+    { uint64_constant(0xd13eb464, 0x69447567), uint64_constant(0x4b7195f2, 0xd2d1a9fb) }  /* 1e347 */
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 cjson_uint128_t;
+#endif
+
+/* multiply two 64 bit numbers, returns the low 64 bits of the product and stores the high 64 bits in *high */
+static cjson_uint64_t multiply_64x64(const cjson_uint64_t a, const cjson_uint64_t b, cjson_uint64_t * const high)
+{
+#if defined(__SIZEOF_INT128__)
+    cjson_uint128_t product = (cjson_uint128_t)a * b;
+    *high = (cjson_uint64_t)(product >> 64);
+
+    return (cjson_uint64_t)product;
+#else
+    const cjson_uint64_t a_low = a & 0xFFFFFFFFU;
+    const cjson_uint64_t a_high = a >> 32;
+    const cjson_uint64_t b_low = b & 0xFFFFFFFFU;
+    const cjson_uint64_t b_high = b >> 32;
+    const cjson_uint64_t low_low = a_low * b_low;
+    const cjson_uint64_t low_high = a_low * b_high;
+    const cjson_uint64_t high_low = a_high * b_low;
+    const cjson_uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFU) + (high_low & 0xFFFFFFFFU);
+
+    *high = (a_high * b_high) + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+
+    return (middle << 32) | (low_low & 0xFFFFFFFFU);
+#endif
+}
+
+/* number of leading zero bits, value must not be 0 */
+static unsigned int count_leading_zeros(cjson_uint64_t value)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_clzll(value);
+#else
+    unsigned int count = 0;
+    while ((value & uint64_constant(0x80000000, 0)) == 0)
+    {
+        value <<= 1;
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+/* Convert mantissa * 10^exponent to the nearest double with the Eisel-Lemire algorithm.
+ * Returns false if the result can't be determined this way (rare halfway cases, subnormals and overflow). */
+static cjson_bool_t decimal_to_double(cjson_uint64_t mantissa, const long exponent, const cjson_bool_t negative, double * const number)
+{
+    const cjson_uint64_t *power = NULL;
+    cjson_uint64_t product_high = 0;
+    cjson_uint64_t product_low = 0;
+    cjson_uint64_t bits = 0;
+    unsigned int leading_zeros = 0;
+    unsigned int most_significant_bit = 0;
+    long binary_exponent = 0;
+
+    if (mantissa != 0)
+    {
+        if ((exponent < smallest_power_of_ten) || (exponent > largest_power_of_ten))
+        {
+            return false;
+        }
+
+        /* normalize the mantissa so its most significant bit is set */
+        leading_zeros = count_leading_zeros(mantissa);
+        mantissa <<= leading_zeros;
+        /* 217706 / 2^16 approximates log2(10), the offset of 1200 keeps the shifted value positive */
+        binary_exponent = (((217706L * exponent) + (1200L * 65536L)) >> 16) - 1200L + 64 + 1023 - (long)leading_zeros;
+
+        power = powers_of_ten[exponent - smallest_power_of_ten];
+        product_low = multiply_64x64(mantissa, power[0], &product_high);
+
+        /* the truncated power of ten may be too imprecise, take its lower half into account */
+        if (((product_high & 0x1FF) == 0x1FF) && ((product_low + mantissa) < mantissa))
+        {
+            cjson_uint64_t correction_high = 0;
+            cjson_uint64_t correction_low = multiply_64x64(mantissa, power[1], &correction_high);
+            cjson_uint64_t merged_high = product_high;
+            cjson_uint64_t merged_low = product_low + correction_high;
+            if (merged_low < product_low)
             {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
+                merged_high++;
+            }
+            if (((merged_high & 0x1FF) == 0x1FF) && ((merged_low + 1) == 0) && ((correction_low + mantissa) < mantissa))
+            {
+                return false;
             }
+            product_high = merged_high;
+            product_low = merged_low;
+        }
+
+        /* reduce to 54 bits */
+        most_significant_bit = (unsigned int)(product_high >> 63);
+        mantissa = product_high >> (most_significant_bit + 9);
+        binary_exponent -= (long)(1 ^ most_significant_bit);
+
+        /* exactly halfway between two doubles, round to even can't be decided here */
+        if ((product_low == 0) && ((product_high & 0x1FF) == 0) && ((mantissa & 3) == 1))
+        {
+            return false;
+        }
+
+        /* round to 53 bits */
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if ((mantissa >> 53) > 0)
+        {
+            mantissa >>= 1;
+            binary_exponent++;
+        }
+
+        /* subnormal, infinite or out of range */
+        if ((binary_exponent < 1) || (binary_exponent > 0x7FE))
+        {
+            return false;
         }
+
+        bits = ((cjson_uint64_t)binary_exponent << 52) | (mantissa & uint64_constant(0x000FFFFF, 0xFFFFFFFFU));
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
+
+    if (negative)
+    {
+        bits |= uint64_constant(0x80000000, 0);
+    }
+    memcpy(number, &bits, sizeof(bits));
 
     return true;
 }
 
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cjson_bool_t print_string(const cjson_t * const item, printbuffer * const p)
+/* Read a number in strict JSON syntax straight from the input buffer. Returns false for everything
+ * it can't convert exactly, including inputs where strtod would consume a different amount of text. */
+static cjson_bool_t parse_number_fast(const parse_buffer * const input_buffer, double * const number, size_t * const length)
 {
-    return print_string_ptr((unsigned char*)item->valuestring, p);
-}
-
-/* Predeclare these prototypes. */
-static cjson_bool_t parse_value(cjson_t * const item, parse_buffer * const input_buffer);
-static cjson_bool_t print_value(const cjson_t * const item, printbuffer * const output_buffer);
-static cjson_bool_t parse_array(cjson_t * const item, parse_buffer * const input_buffer);
-static cjson_bool_t print_array(const cjson_t * const item, printbuffer * const output_buffer);
-static cjson_bool_t parse_object(cjson_t * const item, parse_buffer * const input_buffer);
-static cjson_bool_t print_object(const cjson_t * const item, printbuffer * const output_buffer);
+    const unsigned char *input = buffer_at_offset(input_buffer);
+    const size_t available = input_buffer->length - input_buffer->offset;
+    cjson_uint64_t mantissa = 0;
+    long exponent = 0;
+    size_t significant_digits = 0;
+    size_t i = 0;
+    cjson_bool_t negative = false;
 
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL))
+    if ((i < available) && (input[i] == '-'))
     {
-        return NULL;
+        negative = true;
+        i++;
+    }
+    if ((i >= available) || (input[i] < '0') || (input[i] > '9'))
+    {
+        return false;
     }
 
-    if (cannot_access_at_index(buffer, 0))
+    /* integer part */
+    if (input[i] == '0')
     {
-        return buffer;
+        i++;
+    }
+    else
+    {
+        for (; (i < available) && (input[i] >= '0') && (input[i] <= '9'); i++)
+        {
+            mantissa = (mantissa * 10) + (cjson_uint64_t)(input[i] - '0');
+            significant_digits++;
+        }
     }
 
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    /* fraction */
+    if ((i < available) && (input[i] == '.'))
     {
-       buffer->offset++;
+        size_t fraction_start = ++i;
+        for (; (i < available) && (input[i] >= '0') && (input[i] <= '9'); i++)
+        {
+            if ((mantissa == 0) && (input[i] == '0'))
+            {
+                /* leading zeros of the fraction aren't significant */
+                exponent--;
+                continue;
+            }
+            mantissa = (mantissa * 10) + (cjson_uint64_t)(input[i] - '0');
+            significant_digits++;
+            exponent--;
+        }
+        if (i == fraction_start)
+        {
+            return false;
+        }
     }
 
-    if (buffer->offset == buffer->length)
+    /* more than 19 digits may not fit into 64 bits */
+    if (significant_digits > 19)
     {
-        buffer->offset--;
+        return false;
     }
 
-    return buffer;
-}
+    /* exponent */
+    if ((i < available) && ((input[i] == 'e') || (input[i] == 'E')))
+    {
+        long exponent_value = 0;
+        cjson_bool_t negative_exponent = false;
+        size_t exponent_start = 0;
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+        i++;
+        if ((i < available) && ((input[i] == '+') || (input[i] == '-')))
+        {
+            negative_exponent = (input[i] == '-');
+            i++;
+        }
+        exponent_start = i;
+        for (; (i < available) && (input[i] >= '0') && (input[i] <= '9'); i++)
+        {
+            if (exponent_value < 100000)
+            {
+                exponent_value = (exponent_value * 10) + (input[i] - '0');
+            }
+        }
+        if (i == exponent_start)
+        {
+            return false;
+        }
+        exponent += negative_exponent ? -exponent_value : exponent_value;
+    }
+
+    /* strtod would continue reading, e.g. "01", "1.e5" or "1e5.0" */
+    if ((i < available) && (((input[i] >= '0') && (input[i] <= '9')) || (input[i] == '.') || (input[i] == 'e') || (input[i] == 'E') || (input[i] == '+') || (input[i] == '-')))
     {
-        return NULL;
+        return false;
     }
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    if (!decimal_to_double(mantissa, exponent, negative, number))
     {
-        buffer->offset += 3;
+        return false;
     }
+    *length = i;
 
-    return buffer;
+    return true;
 }
+#endif /* CJSON_FAST_NUMBERS */
 
-CJSON_PUBLIC(cjson_t *) cjson_parse_with_opts(const char *value, const char **return_parse_end, cjson_bool_t require_null_terminated)
+/* Convert the number with strtod, which needs a NUL terminated copy with the decimal point of the current locale. */
+static cjson_bool_t parse_number_with_strtod(const parse_buffer * const input_buffer, double * const number, size_t * const length)
 {
-    size_t buffer_length;
+    unsigned char *after_end = NULL;
+    unsigned char number_c_string[64];
+    unsigned char decimal_point = get_decimal_point();
+    size_t i = 0;
 
-    if (NULL == value)
+    /* copy the number into a temporary buffer and replace '.' with the decimal point
+     * of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
     {
-        return NULL;
+        switch (buffer_at_offset(input_buffer)[i])
+        {
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '+':
+            case '-':
+            case 'e':
+            case 'E':
+                number_c_string[i] = buffer_at_offset(input_buffer)[i];
+                break;
+
+            case '.':
+                number_c_string[i] = decimal_point;
+                break;
+
+            default:
+                goto loop_end;
+        }
     }
+loop_end:
+    number_c_string[i] = '\0';
 
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+    *number = strtod((const char*)number_c_string, (char**)&after_end);
+    if (number_c_string == after_end)
+    {
+        return false; /* parse_error */
+    }
+    *length = (size_t)(after_end - number_c_string);
 
-    return cjson_parse_with_length_opts(value, buffer_length, return_parse_end, require_null_terminated);
+    return true;
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cjson_t *) cjson_parse_with_length_opts(const char *value, size_t buffer_length, const char **return_parse_end, cjson_bool_t require_null_terminated)
+/* Integers without fraction and exponent are read with an integer-only loop so they can be kept exactly.
+ * Returns false for everything else, including "-0" and integers that don't fit into 64 bits. */
+static cjson_bool_t parse_integer(const parse_buffer * const input_buffer, cjson_uint64_t * const magnitude, cjson_bool_t * const negative, size_t * const length)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cjson_t *item = NULL;
+    const unsigned char *input = buffer_at_offset(input_buffer);
+    const size_t available = input_buffer->length - input_buffer->offset;
+    cjson_uint64_t value = 0;
+    size_t i = 0;
 
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+    *negative = false;
+    if ((i < available) && (input[i] == '-'))
+    {
+        *negative = true;
+        i++;
+    }
+    if ((i >= available) || (input[i] < '0') || (input[i] > '9'))
+    {
+        return false;
+    }
 
-    if (value == NULL || 0 == buffer_length)
+    if (input[i] == '0')
     {
-        goto fail;
+        if (*negative)
+        {
+            return false; /* -0 is only representable as a double */
+        }
+        i++;
+    }
+    else
+    {
+        const size_t first_digit = i;
+        for (; (i < available) && (input[i] >= '0') && (input[i] <= '9'); i++)
+        {
+            const unsigned int digit = (unsigned int)(input[i] - '0');
+            /* up to 19 digits always fit */
+            if (((i - first_digit) >= 19) && (value > ((~(cjson_uint64_t)0 - digit) / 10)))
+            {
+                return false; /* overflow */
+            }
+            value = (value * 10) + digit;
+        }
+        if (*negative && (value > int64_magnitude_limit))
+        {
+            return false;
+        }
     }
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    /* not an integer after all, or strtod would continue reading, e.g. "01" */
+    if ((i < available) && (((input[i] >= '0') && (input[i] <= '9')) || (input[i] == '.') || (input[i] == 'e') || (input[i] == 'E') || (input[i] == '+') || (input[i] == '-')))
+    {
+        return false;
+    }
 
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
+    *magnitude = value;
+    *length = i;
+
+    return true;
+}
+
+/* set a number item to the integer with the given magnitude and sign, keeping it exactly in valueint64 */
+static void set_integer_value(cjson_t * const item, const cjson_uint64_t magnitude, const cjson_bool_t negative)
+{
+    if (negative)
     {
-        goto fail;
+        cjson_set_number_helper(item, -(double)magnitude);
+        /* written this way to avoid overflowing on the smallest cjson_int64_t */
+        item->valueint64 = -(cjson_int64_t)(magnitude - 1) - 1;
+        item->type |= CJSON_NUMBER_IS_INT64;
+    }
+    else if (magnitude < int64_magnitude_limit)
+    {
+        cjson_set_number_helper(item, (double)magnitude);
+        item->valueint64 = (cjson_int64_t)magnitude;
+        item->type |= CJSON_NUMBER_IS_INT64;
     }
+    else
+    {
+        cjson_set_number_helper(item, (double)magnitude);
+        /* the same as a two's complement conversion, but without implementation defined behaviour */
+        item->valueint64 = (cjson_int64_t)(magnitude - int64_magnitude_limit) - (cjson_int64_t)(int64_magnitude_limit - 1) - 1;
+        item->type |= CJSON_NUMBER_IS_UINT64;
+    }
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static cjson_bool_t parse_number(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    cjson_uint64_t magnitude = 0;
+    cjson_bool_t negative = false;
+    size_t length = 0;
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
-        /* parse failure. ep is set. */
-        goto fail;
+        return false;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+    if (parse_integer(input_buffer, &magnitude, &negative, &length))
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
-        {
-            goto fail;
-        }
+        item->type = CJSON_NUMBER;
+        set_integer_value(item, magnitude, negative);
+
+        input_buffer->offset += length;
+        return true;
     }
-    if (return_parse_end)
+
+#ifdef CJSON_FAST_NUMBERS
+    if (!parse_number_fast(input_buffer, &number, &length) && !parse_number_with_strtod(input_buffer, &number, &length))
+#else
+    if (!parse_number_with_strtod(input_buffer, &number, &length))
+#endif
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        input_buffer->error = CJSON_ERROR_INVALID_NUMBER;
+        return false; /* parse_error */
     }
 
-    return item;
+    item->valuedouble = number;
 
-fail:
-    if (item != NULL)
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
     {
-        cjson_delete(item);
+        item->valueint = INT_MAX;
     }
-
-    if (value != NULL)
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+        item->valueint = (int)number;
+    }
+
+    item->type = CJSON_NUMBER;
 
-        if (buffer.offset < buffer.length)
+    input_buffer->offset += length;
+    return true;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cjson_set_number_helper(cjson_t *object, double number)
+{
+    /* valueint64 no longer holds the number */
+    object->type &= ~(CJSON_NUMBER_IS_INT64 | CJSON_NUMBER_IS_UINT64);
+    invalidate_digests(object);
+
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
+
+    return object->valuedouble = number;
+}
+
+CJSON_PUBLIC(int) cjson_set_int_helper(cjson_t *object, double number)
+{
+    object->type &= ~(CJSON_NUMBER_IS_INT64 | CJSON_NUMBER_IS_UINT64);
+    invalidate_digests(object);
+
+    object->valuedouble = number;
+    object->valueint = (int)number;
+
+    return object->valueint;
+}
+
+CJSON_PUBLIC(int) cjson_set_bool_helper(cjson_t *object, cjson_bool_t boolean)
+{
+    if (!(object->type & (CJSON_FALSE | CJSON_TRUE)))
+    {
+        return CJSON_INVALID;
+    }
+    invalidate_digests(object);
+
+    object->type = (object->type & ~(CJSON_FALSE | CJSON_TRUE)) | (boolean ? CJSON_TRUE : CJSON_FALSE);
+
+    return object->type;
+}
+
+CJSON_PUBLIC(char*) cjson_set_value_string(cjson_t *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t length = 0;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    /* strings of arenas, cjson_parse_insitu and views are references too, but they can be replaced by copies */
+    if (!(object->type & CJSON_STRING) || ((object->type & (CJSON_IS_REFERENCE | CJSON_IN_ARENA | CJSON_IN_SITU | CJSON_STRING_IS_VIEW)) == CJSON_IS_REFERENCE))
+    {
+        return NULL;
+    }
+    invalidate_digests(object);
+    length = strlen(valuestring);
+    /* a view can't be overwritten, the text it points into may be read-only */
+    if (!(object->type & CJSON_STRING_IS_VIEW) && (length <= strlen(object->valuestring)))
+    {
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    if (object->type & CJSON_IN_ARENA)
+    {
+        /* the old string is released together with the arena */
+        copy = (char*)arena_allocate(((arena_item*)object)->arena, length + sizeof(""));
+        if (copy == NULL)
+        {
+            return NULL;
+        }
+        memcpy(copy, valuestring, length + sizeof(""));
+        object->valuestring = copy;
+        object->type &= ~CJSON_STRING_IS_VIEW;
+
+        return copy;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if ((object->valuestring != NULL) && !(object->type & CJSON_IS_REFERENCE))
+    {
+        cjson_free(object->valuestring);
+    }
+    object->valuestring = copy;
+    object->type &= ~(CJSON_IS_REFERENCE | CJSON_STRING_IS_VIEW);
+
+    return copy;
+}
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cjson_bool_t noalloc;
+    cjson_bool_t format; /* is this print a formatted print */
+    internal_hooks hooks;
+    cjson_write_fn write_fn; /* when set, full buffers are flushed here instead of growing */
+    void *user;
+} printbuffer;
+
+/* pass the output printed so far to the writer and empty the buffer */
+static cjson_bool_t flush_printbuffer(printbuffer * const p)
+{
+    if (p->offset == 0)
+    {
+        return true;
+    }
+
+    if (p->write_fn((const char*)p->buffer, p->offset, p->user) != p->offset)
+    {
+        return false;
+    }
+    p->offset = 0;
+
+    return true;
+}
+
+/* realloc printbuffer if necessary to have at least "needed" bytes more.
+ * One more byte is always kept free, so the output can be terminated once printing is done.
+ * Every print_* function advances the offset by exactly the number of bytes it wrote. */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset >= p->length))
+    {
+        /* make sure that offset is valid */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    if ((p->write_fn != NULL) && ((p->offset + needed + 1) > p->length))
+    {
+        /* hand the printed output to the writer and start over */
+        if (!flush_printbuffer(p))
+        {
+            return NULL;
+        }
+    }
+
+    needed += p->offset + 1;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize, p->hooks.user);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer, p->hooks.user);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize, p->hooks.user);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer, p->hooks.user);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+
+        memcpy(newbuffer, p->buffer, p->offset + 1);
+        p->hooks.deallocate(p->buffer, p->hooks.user);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* Copy data to the output. A writer gets data longer than its buffer in pieces. */
+static cjson_bool_t append_bytes(printbuffer * const p, const unsigned char *data, size_t length)
+{
+    unsigned char *output = NULL;
+
+    while (length > 0)
+    {
+        size_t piece = length;
+        if ((p->write_fn != NULL) && (piece >= p->length))
+        {
+            piece = p->length - 1;
+        }
+
+        output = ensure(p, piece);
+        if (output == NULL)
+        {
+            return false;
+        }
+        memcpy(output, data, piece);
+        p->offset += piece;
+        data += piece;
+        length -= piece;
+    }
+
+    return true;
+}
+
+/* Like append_bytes for count copies of character, e.g. indentation. */
+static cjson_bool_t append_repeated(printbuffer * const p, const unsigned char character, size_t count)
+{
+    unsigned char *output = NULL;
+
+    while (count > 0)
+    {
+        size_t piece = count;
+        if ((p->write_fn != NULL) && (piece >= p->length))
+        {
+            piece = p->length - 1;
+        }
+
+        output = ensure(p, piece);
+        if (output == NULL)
+        {
+            return false;
+        }
+        memset(output, character, piece);
+        p->offset += piece;
+        count -= piece;
+    }
+
+    return true;
+}
+
+/* securely comparison of floating-point variables */
+static cjson_bool_t compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+#ifdef CJSON_FAST_NUMBERS
+/* Ryu needs 125 bit approximations of 5^i (rounded down) and 2^k / 5^i (rounded up). These are the
+ * top 125 bits of the normalized powers of ten used for parsing, because 10^i = 5^i * 2^i.
+ * Results are stored as { low 64 bits, high 64 bits }. */
+static void power_of_five(const long i, cjson_uint64_t result[2])
+{
+    const cjson_uint64_t *power = powers_of_ten[i - smallest_power_of_ten];
+    result[0] = (power[1] >> 3) | (power[0] << 61);
+    result[1] = power[0] >> 3;
+}
+
+static void inverse_power_of_five(const long i, cjson_uint64_t result[2])
+{
+    if (i == 0)
+    {
+        /* 2^125 + 1, the only one that isn't below 2^125 */
+        result[0] = 1;
+        result[1] = uint64_constant(0x20000000, 0);
+        return;
+    }
+
+    power_of_five(-i, result);
+    result[0]++;
+    if (result[0] == 0)
+    {
+        result[1]++;
+    }
+}
+
+/* number of bits of 5^e, for 0 <= e <= 3528 */
+static long power_of_five_bits(const long e)
+{
+    return ((e * 1217359L) >> 19) + 1;
+}
+
+/* floor(log10(2^e)) for 0 <= e <= 1650 */
+static long log10_power_of_two(const long e)
+{
+    return (e * 78913L) >> 18;
+}
+
+/* floor(log10(5^e)) for 0 <= e <= 2620 */
+static long log10_power_of_five(const long e)
+{
+    return (e * 732923L) >> 20;
+}
+
+static cjson_bool_t is_multiple_of_power_of_five(cjson_uint64_t value, const long p)
+{
+    long count = 0;
+    while ((value % 5) == 0)
+    {
+        value /= 5;
+        count++;
+    }
+
+    return count >= p;
+}
+
+/* (m * factor) >> shift for a 128 bit factor and 64 < shift < 128 */
+static cjson_uint64_t multiply_shift(const cjson_uint64_t m, const cjson_uint64_t factor[2], const long shift)
+{
+    cjson_uint64_t high0 = 0;
+    cjson_uint64_t high1 = 0;
+    cjson_uint64_t low1 = 0;
+    cjson_uint64_t sum = 0;
+
+    multiply_64x64(m, factor[0], &high0);
+    low1 = multiply_64x64(m, factor[1], &high1);
+    sum = high0 + low1;
+    if (sum < high0)
+    {
+        high1++;
+    }
+
+    return (high1 << (128 - shift)) | (sum >> (shift - 64));
+}
+
+/* Find the shortest decimal digits * 10^exponent that parses back to the given finite, non-zero double
+ * (Ryu, see Ulf Adams: "Ryu: fast float-to-string conversion", PLDI 2018). */
+static cjson_uint64_t shortest_decimal(const double number, long * const exponent)
+{
+    cjson_uint64_t bits = 0;
+    cjson_uint64_t ieee_mantissa = 0;
+    long ieee_exponent = 0;
+    long e2 = 0;
+    long e10 = 0;
+    long removed = 0;
+    cjson_uint64_t m2 = 0;
+    cjson_uint64_t mv = 0;
+    cjson_uint64_t vr = 0;
+    cjson_uint64_t vp = 0;
+    cjson_uint64_t vm = 0;
+    cjson_uint64_t factor[2];
+    unsigned int mm_shift = 0;
+    unsigned int last_removed_digit = 0;
+    cjson_bool_t accept_bounds = false;
+    cjson_bool_t vm_is_trailing_zeros = false;
+    cjson_bool_t vr_is_trailing_zeros = false;
+
+    memcpy(&bits, &number, sizeof(bits));
+    ieee_mantissa = bits & uint64_constant(0x000FFFFF, 0xFFFFFFFFU);
+    ieee_exponent = (long)((bits >> 52) & 0x7FF);
+
+    /* decode into m2 * 2^e2, with two extra bits for the interval bounds */
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = ieee_exponent - 1023 - 52 - 2;
+        m2 = uint64_constant(0x00100000, 0) | ieee_mantissa;
+    }
+    accept_bounds = (m2 & 1) == 0;
+    mv = 4 * m2;
+    mm_shift = ((ieee_mantissa != 0) || (ieee_exponent <= 1)) ? 1 : 0;
+
+    /* the interval of valid representations, scaled to decimal */
+    if (e2 >= 0)
+    {
+        const long q = log10_power_of_two(e2) - ((e2 > 3) ? 1 : 0);
+        const long shift = -e2 + q + 125 + power_of_five_bits(q) - 1;
+        e10 = q;
+        inverse_power_of_five(q, factor);
+        vr = multiply_shift(4 * m2, factor, shift);
+        vp = multiply_shift((4 * m2) + 2, factor, shift);
+        vm = multiply_shift((4 * m2) - 1 - mm_shift, factor, shift);
+        if (q <= 21)
+        {
+            /* only one of mp, mv and mm can be a multiple of 5, if any */
+            if ((mv % 5) == 0)
+            {
+                vr_is_trailing_zeros = is_multiple_of_power_of_five(mv, q);
+            }
+            else if (accept_bounds)
+            {
+                vm_is_trailing_zeros = is_multiple_of_power_of_five(mv - 1 - mm_shift, q);
+            }
+            else
+            {
+                vp -= is_multiple_of_power_of_five(mv + 2, q) ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        const long q = log10_power_of_five(-e2) - ((-e2 > 1) ? 1 : 0);
+        const long i = -e2 - q;
+        const long shift = q - (power_of_five_bits(i) - 125);
+        e10 = q + e2;
+        power_of_five(i, factor);
+        vr = multiply_shift(4 * m2, factor, shift);
+        vp = multiply_shift((4 * m2) + 2, factor, shift);
+        vm = multiply_shift((4 * m2) - 1 - mm_shift, factor, shift);
+        if (q <= 1)
+        {
+            /* mv = 4 * m2 always has at least two trailing zero bits */
+            vr_is_trailing_zeros = true;
+            if (accept_bounds)
+            {
+                vm_is_trailing_zeros = (mm_shift == 1);
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if (q < 63)
+        {
+            vr_is_trailing_zeros = (mv & ((((cjson_uint64_t)1) << q) - 1)) == 0;
+        }
+    }
+
+    /* remove digits while the interval still contains a shorter representation */
+    if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        /* rare general case */
+        while ((vp / 10) > (vm / 10))
+        {
+            vm_is_trailing_zeros = vm_is_trailing_zeros && ((vm % 10) == 0);
+            vr_is_trailing_zeros = vr_is_trailing_zeros && (last_removed_digit == 0);
+            last_removed_digit = (unsigned int)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_is_trailing_zeros)
+        {
+            while ((vm % 10) == 0)
+            {
+                vr_is_trailing_zeros = vr_is_trailing_zeros && (last_removed_digit == 0);
+                last_removed_digit = (unsigned int)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_is_trailing_zeros && (last_removed_digit == 5) && ((vr % 2) == 0))
+        {
+            /* exactly halfway, round to even */
+            last_removed_digit = 4;
+        }
+        if (((vr == vm) && (!accept_bounds || !vm_is_trailing_zeros)) || (last_removed_digit >= 5))
+        {
+            vr++;
+        }
+    }
+    else
+    {
+        cjson_bool_t round_up = false;
+        /* remove two digits at a time first, this is usually possible */
+        if ((vp / 100) > (vm / 100))
+        {
+            round_up = (vr % 100) >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while ((vp / 10) > (vm / 10))
+        {
+            round_up = (vr % 10) >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if ((vr == vm) || round_up)
+        {
+            vr++;
+        }
+    }
+
+    *exponent = e10 + removed;
+
+    return vr;
+}
+
+/* Shortest digits of a double and how print_double lays them out. The layout follows printf's %g:
+ * scientific notation with at least two exponent digits for exponents below -4 or above the precision
+ * (15 digits, 17 if more digits are needed). */
+typedef struct
+{
+    unsigned char digits[17];
+    long digit_count;
+    long point; /* exponent of the first digit */
+    cjson_bool_t negative;
+    cjson_bool_t scientific;
+    size_t length; /* of the printed number */
+} double_layout;
+
+static void layout_double(const double number, double_layout * const layout)
+{
+    cjson_uint64_t decimal = 0;
+    long exponent = 0;
+    long precision = 15;
+    long digit_count = 0;
+    long point = 0;
+    size_t length = 0;
+
+    if (number == 0)
+    {
+        layout->digits[0] = '0';
+        digit_count = 1;
+    }
+    else
+    {
+        decimal = shortest_decimal(number, &exponent);
+        for (; decimal > 0; digit_count++)
+        {
+            layout->digits[16 - digit_count] = (unsigned char)('0' + (decimal % 10));
+            decimal /= 10;
+        }
+        memmove(layout->digits, layout->digits + 17 - digit_count, (size_t)digit_count);
+    }
+
+    point = exponent + digit_count - 1;
+    if (digit_count > 15)
+    {
+        precision = 17;
+    }
+    layout->scientific = (point < -4) || (point >= precision);
+    /* past 2^53 padding the digits with zeros can print another integer than the double holds, which would then
+     * parse back as that exact 64 bit integer */
+    if ((point >= digit_count) && ((number >= 9007199254740992.0) || (number <= -9007199254740992.0)))
+    {
+        layout->scientific = true;
+    }
+    layout->negative = number < 0;
+
+    length = (size_t)digit_count + (layout->negative ? 1 : 0);
+    if (layout->scientific)
+    {
+        length += (size_t)(((digit_count > 1) ? 1 : 0) + 2 + (((point >= 100) || (point <= -100)) ? 3 : 2));
+    }
+    else if (point < 0)
+    {
+        length += 2 + (size_t)(-point - 1);
+    }
+    else if (point >= digit_count)
+    {
+        length += (size_t)(point + 1 - digit_count);
+    }
+    else if (point < (digit_count - 1))
+    {
+        length++;
+    }
+
+    layout->digit_count = digit_count;
+    layout->point = point;
+    layout->length = length;
+}
+
+/* Print a finite double with the shortest digits that parse back to it, straight into the output buffer. */
+static cjson_bool_t print_double(const double number, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double_layout layout;
+    const unsigned char *digits = layout.digits;
+    long digit_count = 0;
+    long point = 0;
+    long i = 0;
+
+    layout_double(number, &layout);
+    digit_count = layout.digit_count;
+    point = layout.point;
+
+    if ((output_buffer->write_fn != NULL) && (layout.length >= output_buffer->length))
+    {
+        /* doesn't fit into the buffer of the writer, print it aside and pass it on in pieces */
+        unsigned char number_buffer[26];
+        printbuffer number_output = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+        number_output.buffer = number_buffer;
+        number_output.length = sizeof(number_buffer);
+        number_output.noalloc = true;
+
+        return print_double(number, &number_output) && append_bytes(output_buffer, number_buffer, number_output.offset);
+    }
+
+    output_pointer = ensure(output_buffer, layout.length);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    if (layout.negative)
+    {
+        *output_pointer++ = '-';
+    }
+    if (layout.scientific)
+    {
+        long absolute_exponent = (point < 0) ? -point : point;
+        *output_pointer++ = digits[0];
+        if (digit_count > 1)
+        {
+            *output_pointer++ = '.';
+            memcpy(output_pointer, digits + 1, (size_t)(digit_count - 1));
+            output_pointer += digit_count - 1;
+        }
+        *output_pointer++ = 'e';
+        *output_pointer++ = (point < 0) ? '-' : '+';
+        if (absolute_exponent >= 100)
+        {
+            *output_pointer++ = (unsigned char)('0' + (absolute_exponent / 100));
+        }
+        *output_pointer++ = (unsigned char)('0' + ((absolute_exponent / 10) % 10));
+        *output_pointer++ = (unsigned char)('0' + (absolute_exponent % 10));
+    }
+    else if (point < 0)
+    {
+        *output_pointer++ = '0';
+        *output_pointer++ = '.';
+        for (i = 0; i < (-point - 1); i++)
+        {
+            *output_pointer++ = '0';
+        }
+        memcpy(output_pointer, digits, (size_t)digit_count);
+        output_pointer += digit_count;
+    }
+    else if (point >= (digit_count - 1))
+    {
+        memcpy(output_pointer, digits, (size_t)digit_count);
+        output_pointer += digit_count;
+        for (i = digit_count - 1; i < point; i++)
+        {
+            *output_pointer++ = '0';
+        }
+    }
+    else
+    {
+        memcpy(output_pointer, digits, (size_t)(point + 1));
+        output_pointer += point + 1;
+        *output_pointer++ = '.';
+        memcpy(output_pointer, digits + point + 1, (size_t)(digit_count - point - 1));
+        output_pointer += digit_count - point - 1;
+    }
+
+    output_buffer->offset += layout.length;
+
+    return true;
+}
+#endif /* CJSON_FAST_NUMBERS */
+
+/* print an integer into buffer without going through sprintf, returns the length */
+static int print_integer(cjson_uint64_t magnitude, const cjson_bool_t negative, unsigned char * const buffer)
+{
+    unsigned char digits[20];
+    int count = 0;
+    int length = 0;
+
+    do
+    {
+        digits[count++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (negative)
+    {
+        buffer[length++] = '-';
+    }
+    while (count > 0)
+    {
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/* Render the number nicely from the given item into a string. */
+static cjson_bool_t print_number(const cjson_t * const item, printbuffer * const output_buffer)
+{
+    double d = item->valuedouble;
+    int length = 0;
+    size_t i = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+    unsigned char decimal_point = '.';
+    cjson_bool_t negative = false;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    if (has_exact_integer(item))
+    {
+        cjson_uint64_t magnitude = exact_integer_magnitude(item, &negative);
+        length = print_integer(magnitude, negative, number_buffer);
+    }
+    /* This checks for NaN and Infinity */
+    else if (isnan(d) || isinf(d))
+    {
+        length = sprintf((char*)number_buffer, "null");
+    }
+    else if (d == (double)item->valueint)
+    {
+        negative = item->valueint < 0;
+        length = print_integer(negative ? ((cjson_uint64_t)(-(item->valueint + 1)) + 1) : (cjson_uint64_t)item->valueint, negative, number_buffer);
+    }
+    else
+    {
+#ifdef CJSON_FAST_NUMBERS
+        return print_double(d, output_buffer);
+#else
+        double test = 0.0;
+        decimal_point = get_decimal_point();
+
+        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
+        length = sprintf((char*)number_buffer, "%1.15g", d);
+
+        /* Check whether the original double can be recovered */
+        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        {
+            /* If not, print with 17 decimal places of precision */
+            length = sprintf((char*)number_buffer, "%1.17g", d);
+        }
+#endif
+    }
+
+    /* sprintf failed or buffer overrun occurred */
+    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    {
+        return false;
+    }
+
+    /* replace locale dependent decimal point with '.' */
+    for (i = 0; i < ((size_t)length); i++)
+    {
+        if (number_buffer[i] == decimal_point)
+        {
+            number_buffer[i] = '.';
+        }
+    }
+
+    /* a writer with a smaller buffer gets the number in pieces */
+    return append_bytes(output_buffer, number_buffer, (size_t)length);
+}
+
+/* number of characters print_integer produces */
+static size_t integer_length(const cjson_uint64_t magnitude, const cjson_bool_t negative)
+{
+    cjson_uint64_t power = 10;
+    size_t digits = 1;
+
+    for (; (digits < 20) && (magnitude >= power); digits++)
+    {
+        if (digits == 19)
+        {
+            /* 10^20 doesn't fit into 64 bits */
+            digits = 20;
+            break;
+        }
+        power *= 10;
+    }
+
+    return digits + (negative ? 1 : 0);
+}
+
+/* Calculate the length print_number produces. Unless exact is set, doubles are only estimated
+ * with the longest representation, which avoids converting them twice. */
+static cjson_bool_t size_number(const cjson_t * const item, const cjson_bool_t exact, size_t * const size)
+{
+    double d = item->valuedouble;
+    cjson_bool_t negative = false;
+
+    if (has_exact_integer(item))
+    {
+        cjson_uint64_t magnitude = exact_integer_magnitude(item, &negative);
+        *size = integer_length(magnitude, negative);
+    }
+    else if (isnan(d) || isinf(d))
+    {
+        *size = sizeof("null") - 1;
+    }
+    else if (d == (double)item->valueint)
+    {
+        negative = item->valueint < 0;
+        *size = integer_length(negative ? ((cjson_uint64_t)(-(item->valueint + 1)) + 1) : (cjson_uint64_t)item->valueint, negative);
+    }
+    else if (!exact)
+    {
+        *size = sizeof("-2.2250738585072014e-308") - 1;
+    }
+    else
+    {
+#ifdef CJSON_FAST_NUMBERS
+        double_layout layout;
+        layout_double(d, &layout);
+        *size = layout.length;
+#else
+        unsigned char number_buffer[26];
+        printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+        buffer.buffer = number_buffer;
+        buffer.length = sizeof(number_buffer);
+        buffer.noalloc = true;
+        buffer.hooks = global_hooks;
+        if (!print_number(item, &buffer))
+        {
+            return false;
+        }
+        *size = buffer.offset;
+#endif
+    }
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* parse_hex4 can't tell invalid digits from 0000 */
+static cjson_bool_t is_hex4(const unsigned char * const input)
+{
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (!(((input[i] >= '0') && (input[i] <= '9')) || ((input[i] >= 'A') && (input[i] <= 'F')) || ((input[i] >= 'a') && (input[i] <= 'f'))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* an invalid digit could be the closing quote, the literal mustn't run over it */
+    if (!is_hex4(first_sequence + 2))
+    {
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u') || !is_hex4(second_sequence + 2))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+/* length of the run at the start of input that contains no '"', '\\' or control character,
+ * if output isn't NULL the run is copied there. Up to length bytes of output are written, so it must not overlap input. */
+static size_t string_run_length(const unsigned char * const input, const size_t length, unsigned char * const output)
+{
+    size_t i = 0;
+
+#ifdef CJSON_USE_AVX2
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i last_control = _mm256_set1_epi8(31);
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(input + i));
+            /* max(chunk, 31) == 31 for the bytes below 32 */
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, last_control), last_control);
+            unsigned int special = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash))));
+            if (output != NULL)
+            {
+                _mm256_storeu_si256((__m256i*)(output + i), chunk);
+            }
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+#ifdef CJSON_USE_SSE2
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i last_control = _mm_set1_epi8(31);
+        for (; (i + 16) <= length; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(input + i));
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, last_control), last_control);
+            unsigned int special = (unsigned int)_mm_movemask_epi8(_mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+            if (output != NULL)
+            {
+                _mm_storeu_si128((__m128i*)(output + i), chunk);
+            }
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+
+    if (output != NULL)
+    {
+        while ((i < length) && (input[i] > 31) && (input[i] != '\"') && (input[i] != '\\'))
+        {
+            output[i] = input[i];
+            i++;
+        }
+
+        return i;
+    }
+
+    while ((i < length) && (input[i] > 31) && (input[i] != '\"') && (input[i] != '\\'))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* Unescape the escape sequence at input into *output, which is advanced. Returns the length of the sequence, 0 if it is invalid. */
+static unsigned char unescape_sequence(const unsigned char * const input, const unsigned char * const input_end, unsigned char ** const output)
+{
+    if ((input_end - input) < 2)
+    {
+        return 0;
+    }
+
+    switch (input[1])
+    {
+        case 'b':
+            *(*output)++ = '\b';
+            break;
+        case 'f':
+            *(*output)++ = '\f';
+            break;
+        case 'n':
+            *(*output)++ = '\n';
+            break;
+        case 'r':
+            *(*output)++ = '\r';
+            break;
+        case 't':
+            *(*output)++ = '\t';
+            break;
+        case '\"':
+        case '\\':
+        case '/':
+            *(*output)++ = input[1];
+            break;
+
+        /* UTF-16 literal */
+        case 'u':
+            return utf16_literal_to_utf8(input, input_end, output);
+
+        default:
+            return 0;
+    }
+
+    return 2;
+}
+
+/* Unescape the string literal from *input up to input_end (excluding the quotes) into *output.
+ * Both pointers are advanced, on an invalid escape sequence or control character *input is left pointing at it. */
+static cjson_bool_t unescape_string(const unsigned char ** const input, const unsigned char * const input_end, unsigned char ** const output)
+{
+    const unsigned char *input_pointer = *input;
+    unsigned char *output_pointer = *output;
+    cjson_bool_t valid = true;
+
+    while (input_pointer < input_end)
+    {
+        /* copy everything up to the next escape sequence at once, in situ the output trails the input */
+        size_t run_length = string_run_length(input_pointer, (size_t)(input_end - input_pointer), NULL);
+        memmove(output_pointer, input_pointer, run_length);
+        output_pointer += run_length;
+        input_pointer += run_length;
+
+        if (input_pointer < input_end)
+        {
+            unsigned char sequence_length = 0;
+            if (*input_pointer == '\\')
+            {
+                sequence_length = unescape_sequence(input_pointer, input_end, &output_pointer);
+            }
+            if (sequence_length == 0)
+            {
+                /* failed to unescape or control character */
+                valid = false;
+                break;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    *input = input_pointer;
+    *output = output_pointer;
+    return valid;
+}
+
+/* Find the closing quote of the string literal that starts at the offset. first_escape is set to the first escape
+ * sequence (NULL if there is none) and skipped_bytes to the number of backslashes, unescaping saves at least that much.
+ * Fails on control characters, which have to be escaped. */
+static cjson_bool_t scan_string(parse_buffer * const input_buffer, const unsigned char ** const string_end, const unsigned char ** const first_escape, size_t * const skipped_bytes)
+{
+    const unsigned char * const buffer_end = input_buffer->content + input_buffer->length;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+
+    *first_escape = NULL;
+    *skipped_bytes = 0;
+    for (;;)
+    {
+        input_end += string_run_length(input_end, (size_t)(buffer_end - input_end), NULL);
+        if (input_end >= buffer_end)
+        {
+            input_buffer->error = CJSON_ERROR_UNEXPECTED_END;
+            return false; /* string ended unexpectedly */
+        }
+        if (*input_end == '\"')
+        {
+            break;
+        }
+        if (*input_end != '\\')
+        {
+            /* control characters have to be escaped, a '\0' ends null terminated text */
+            input_buffer->error = (*input_end == '\0') ? CJSON_ERROR_UNEXPECTED_END : CJSON_ERROR_INVALID_STRING;
+            return false;
+        }
+
+        /* is escape sequence */
+        if ((input_end + 1) >= buffer_end)
+        {
+            /* prevent buffer overflow when last input character is a backslash */
+            input_buffer->error = CJSON_ERROR_UNEXPECTED_END;
+            return false;
+        }
+        if (*first_escape == NULL)
+        {
+            *first_escape = input_end;
+        }
+        (*skipped_bytes)++;
+        input_end += 2;
+    }
+
+    *string_end = input_end;
+    return true;
+}
+
+/* Arena strings are copied before their length is known. They start with what is left of the current block, but at
+ * least this much, and grow in place or into a new allocation. What is left over is given back to the block. */
+#define ARENA_STRING_MINIMUM_CAPACITY 64
+
+static unsigned char *grow_arena_string(parse_buffer * const buffer, unsigned char * const output, const size_t length, size_t * const capacity, const size_t needed)
+{
+    size_t new_capacity = *capacity * 2;
+    unsigned char *new_output = NULL;
+
+    if (new_capacity < (length + needed))
+    {
+        new_capacity = length + needed;
+    }
+    if (arena_resize(buffer->arena, output, *capacity, new_capacity))
+    {
+        *capacity = new_capacity;
+        return output;
+    }
+
+    new_output = (unsigned char*)parse_allocate(buffer, new_capacity);
+    if (new_output == NULL)
+    {
+        return NULL;
+    }
+    memcpy(new_output, output, length);
+    *capacity = new_capacity;
+
+    return new_output;
+}
+
+/* Parse the input text into an unescaped cinput, and populate item. Strings are copied and unescaped in the pass that
+ * looks for their end, only for an output from the hooks the length is measured before so it can be allocated exactly. */
+static cjson_bool_t parse_string(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char * const buffer_end = input_buffer->content + input_buffer->length;
+    const unsigned char * const string_start = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_pointer = string_start;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    /* unescaping never makes a string longer */
+    size_t capacity = (size_t)(buffer_end - input_pointer) + 1;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    if (input_buffer->insitu != NULL)
+    {
+        /* it fits where the literal was, the terminator at the latest replaces the closing quote */
+        output = input_buffer->insitu + (input_pointer - input_buffer->content);
+    }
+    else if (input_buffer->arena != NULL)
+    {
+        const arena_block * const block = input_buffer->arena->blocks;
+        const size_t left = (block != NULL) ? (block->size - block->used) : 0;
+        if (capacity > left)
+        {
+            capacity = (left > ARENA_STRING_MINIMUM_CAPACITY) ? left : ARENA_STRING_MINIMUM_CAPACITY;
+        }
+        output = (unsigned char*)parse_allocate(input_buffer, capacity);
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+    else
+    {
+        const unsigned char *string_end = NULL;
+        const unsigned char *first_escape = NULL;
+        size_t skipped_bytes = 0;
+        if (!scan_string(input_buffer, &string_end, &first_escape, &skipped_bytes))
+        {
+            goto fail;
+        }
+
+        /* every escape sequence saves at least its backslash */
+        capacity = (size_t)(string_end - input_pointer) - skipped_bytes + sizeof("");
+        output = (unsigned char*)parse_allocate(input_buffer, capacity);
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* copy everything up to the first escape sequence at once */
+        length = (size_t)(((first_escape != NULL) ? first_escape : string_end) - input_pointer);
+        memcpy(output, input_pointer, length);
+        input_pointer += length;
+    }
+
+    while ((input_pointer >= buffer_end) || (*input_pointer != '\"'))
+    {
+        size_t available = (size_t)(buffer_end - input_pointer);
+        size_t run_length = 0;
+        unsigned char sequence_length = 0;
+
+        /* a byte is kept for the terminator */
+        if (available > (capacity - length - 1))
+        {
+            available = capacity - length - 1;
+        }
+        if (input_buffer->insitu != NULL)
+        {
+            /* the output trails the input in the same buffer, nothing has to be moved before the first escape sequence */
+            run_length = string_run_length(input_pointer, available, NULL);
+            if ((output + length) != input_pointer)
+            {
+                memmove(output + length, input_pointer, run_length);
+            }
+        }
+        else
+        {
+            run_length = string_run_length(input_pointer, available, output + length);
+        }
+        input_pointer += run_length;
+        length += run_length;
+
+        if (input_pointer >= buffer_end)
+        {
+            input_buffer->error = CJSON_ERROR_UNEXPECTED_END;
+            input_pointer = string_start;
+            goto fail; /* string ended unexpectedly */
+        }
+        if (*input_pointer == '\"')
+        {
+            break;
+        }
+        if (*input_pointer == '\\')
+        {
+            if ((input_pointer + 1) >= buffer_end)
+            {
+                /* prevent buffer overflow when last input character is a backslash */
+                input_buffer->error = CJSON_ERROR_UNEXPECTED_END;
+                input_pointer = string_start;
+                goto fail;
+            }
+            if ((capacity - length - 1) < 4)
+            {
+                /* an escape sequence gives at most 4 bytes, only an arena string can be short of them */
+                if (input_buffer->arena != NULL)
+                {
+                    unsigned char *grown = grow_arena_string(input_buffer, output, length, &capacity, 5);
+                    if (grown == NULL)
+                    {
+                        goto fail;
+                    }
+                    output = grown;
+                }
+            }
+            output_pointer = output + length;
+            sequence_length = unescape_sequence(input_pointer, buffer_end, &output_pointer);
+            if (sequence_length == 0)
+            {
+                input_buffer->error = CJSON_ERROR_INVALID_STRING;
+                goto fail;
+            }
+            input_pointer += sequence_length;
+            length = (size_t)(output_pointer - output);
+        }
+        else if (*input_pointer < 32)
+        {
+            /* control characters have to be escaped, a '\0' ends null terminated text */
+            input_buffer->error = (*input_pointer == '\0') ? CJSON_ERROR_UNEXPECTED_END : CJSON_ERROR_INVALID_STRING;
+            input_pointer = string_start;
+            goto fail;
+        }
+        else if (input_buffer->arena != NULL)
+        {
+            /* the arena string is full */
+            unsigned char *grown = grow_arena_string(input_buffer, output, length, &capacity, 2);
+            if (grown == NULL)
+            {
+                goto fail;
+            }
+            output = grown;
+        }
+        else
+        {
+            /* other outputs fit the whole string, running out of space means it doesn't end where it was scanned to */
+            input_buffer->error = CJSON_ERROR_INVALID_STRING;
+            goto fail;
+        }
+    }
+
+    /* zero terminate the output */
+    output[length] = '\0';
+    if (input_buffer->arena != NULL)
+    {
+        (void)arena_resize(input_buffer->arena, output, capacity, length + sizeof(""));
+    }
+
+    item->type = CJSON_STRING;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_pointer - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if ((output != NULL) && (input_buffer->insitu == NULL))
+    {
+        parse_deallocate(input_buffer, output);
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+static void* cast_away_const(const void* string);
+
+/* Parse a string value of cjson_parse_with_views. Without escape sequences it is left in the input, everything else
+ * (including the errors) is up to parse_string. */
+static cjson_bool_t parse_string_view(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_end = NULL;
+    const unsigned char *first_escape = NULL;
+    size_t skipped_bytes = 0;
+
+    if (!scan_string(input_buffer, &input_end, &first_escape, &skipped_bytes) || (first_escape != NULL))
+    {
+        return parse_string(item, input_buffer);
+    }
+
+    /* a reference, so neither cjson_delete nor a failed parse frees it */
+    item->type = CJSON_STRING | CJSON_STRING_IS_VIEW | CJSON_IS_REFERENCE;
+    item->valuestring = (char*)cast_away_const(buffer_at_offset(input_buffer) + 1);
+    item->valuestring_length = (size_t)(input_end - buffer_at_offset(input_buffer)) - 1;
+
+    input_buffer->offset = (size_t)(input_end - input_buffer->content) + 1;
+
+    return true;
+}
+
+/* length of the run at the start of input that can be printed without escaping,
+ * i.e. that contains no control characters, '"' or '\\' */
+static size_t escape_run_length(const unsigned char * const input, const size_t length)
+{
+    size_t i = 0;
+
+#ifdef CJSON_USE_AVX2
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i last_control = _mm256_set1_epi8(31);
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(input + i));
+            /* max(chunk, 31) == 31 for the bytes below 32 */
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, last_control), last_control);
+            unsigned int special = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash))));
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+#ifdef CJSON_USE_SSE2
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i last_control = _mm_set1_epi8(31);
+        for (; (i + 16) <= length; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(input + i));
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, last_control), last_control);
+            unsigned int special = (unsigned int)_mm_movemask_epi8(_mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+
+    while ((i < length) && (input[i] > 31) && (input[i] != '\"') && (input[i] != '\\'))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* Length of the string of the given length once escaped, without the quotes. */
+static size_t escaped_length(const unsigned char * const input, const size_t length)
+{
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+    size_t i = 0;
+
+    for (i = escape_run_length(input, length); i < length; i += 1 + escape_run_length(input + i + 1, length - i - 1))
+    {
+        switch (input[i])
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                /* UTF-16 escape sequence uXXXX */
+                escape_characters += 5;
+                break;
+        }
+    }
+
+    return length + escape_characters;
+}
+
+/* Write the escape sequence of a character that can't be printed as is and return its length.
+ * output needs room for 7 bytes because sprintf terminates the unicode escape. */
+static size_t print_escape(const unsigned char character, unsigned char * const output)
+{
+    output[0] = '\\';
+    switch (character)
+    {
+        case '\\':
+            output[1] = '\\';
+            return 2;
+        case '\"':
+            output[1] = '\"';
+            return 2;
+        case '\b':
+            output[1] = 'b';
+            return 2;
+        case '\f':
+            output[1] = 'f';
+            return 2;
+        case '\n':
+            output[1] = 'n';
+            return 2;
+        case '\r':
+            output[1] = 'r';
+            return 2;
+        case '\t':
+            output[1] = 't';
+            return 2;
+        default:
+            /* escape and print as unicode codepoint */
+            sprintf((char*)output + 1, "u%04x", character);
+            return 6;
+    }
+}
+
+/* Print a string that is too long for the buffer of a writer in pieces, flushing in between. */
+static cjson_bool_t print_string_streamed(const unsigned char * const input, const size_t input_length, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = input;
+    unsigned char escape[sizeof("\\u0000")];
+
+    if (!append_bytes(output_buffer, (const unsigned char*)"\"", 1))
+    {
+        return false;
+    }
+    while (input_pointer < (input + input_length))
+    {
+        size_t run = escape_run_length(input_pointer, (size_t)((input + input_length) - input_pointer));
+        if (!append_bytes(output_buffer, input_pointer, run))
+        {
+            return false;
+        }
+        input_pointer += run;
+        if (input_pointer == (input + input_length))
+        {
+            break;
+        }
+
+        if (!append_bytes(output_buffer, escape, print_escape(*input_pointer, escape)))
+        {
+            return false;
+        }
+        input_pointer++;
+    }
+
+    return append_bytes(output_buffer, (const unsigned char*)"\"", 1);
+}
+
+/* Render the string of input_length bytes provided to an escaped version that can be printed. */
+static cjson_bool_t print_string_ptr(const unsigned char * const input, const size_t input_length, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        return append_bytes(output_buffer, (const unsigned char*)"\"\"", sizeof("\"\"") - 1);
+    }
+
+    output_length = escaped_length(input, input_length);
+
+    if ((output_buffer->write_fn != NULL) && ((output_length + sizeof("\"\"")) > output_buffer->length))
+    {
+        /* doesn't fit into the buffer of the writer even after flushing it */
+        return print_string_streamed(input, input_length, output_buffer);
+    }
+
+    output = ensure(output_buffer, output_length + sizeof("\"\"") - 1);
+    if (output == NULL)
+    {
+        return false;
+    }
+    output_buffer->offset += output_length + 2;
+
+    /* no characters have to be escaped */
+    if (output_length == input_length)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string in runs that don't need escaping */
+    input_pointer = input;
+    while (input_pointer < (input + input_length))
+    {
+        size_t run = escape_run_length(input_pointer, (size_t)((input + input_length) - input_pointer));
+        memcpy(output_pointer, input_pointer, run);
+        output_pointer += run;
+        input_pointer += run;
+        if (input_pointer == (input + input_length))
+        {
+            break;
+        }
+
+        output_pointer += print_escape(*input_pointer, output_pointer);
+        input_pointer++;
+    }
+    output[output_length + 1] = '\"';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cjson_bool_t print_string(const cjson_t * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, value_length(item), p);
+}
+
+/* Predeclare these prototypes. */
+static cjson_bool_t parse_value(cjson_t * const item, parse_buffer * const input_buffer);
+static cjson_bool_t print_value(const cjson_t * const item, printbuffer * const output_buffer);
+static cjson_bool_t parse_array(cjson_t * const item, parse_buffer * const input_buffer);
+static cjson_bool_t print_array(const cjson_t * const item, printbuffer * const output_buffer);
+static cjson_bool_t parse_object(cjson_t * const item, parse_buffer * const input_buffer);
+static cjson_bool_t print_object(const cjson_t * const item, printbuffer * const output_buffer);
+static cjson_bool_t size_value(const cjson_t * const item, const size_t depth, const cjson_bool_t format, const cjson_bool_t exact, size_t * const size);
+
+/* The paths of cjson_parse_projected while parsing. Each has the position of its next reference token (the '/' in
+ * front of it, or the '\0' once the path is complete) and the depth down to which it matched the text so far. */
+typedef struct
+{
+    const char **positions;
+    size_t *depths;
+    size_t count;
+} path_projection;
+
+static cjson_bool_t project_value(cjson_t * const item, parse_buffer * const input_buffer, path_projection * const projection, cjson_bool_t * const kept);
+
+/* count the bytes <= 32 (whitespace and control characters) at the start of input */
+static size_t whitespace_length(const unsigned char * const input, const size_t length)
+{
+    size_t i = 0;
+
+#ifdef CJSON_USE_AVX2
+    {
+        const __m256i space = _mm256_set1_epi8(32);
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(input + i));
+            /* max(c, 32) == 32 exactly for the bytes that are skipped */
+            unsigned int skipped = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, space), space));
+            if (skipped != 0xFFFFFFFFU)
+            {
+                return i + lowest_bit_index(~skipped);
+            }
+        }
+    }
+#endif
+#ifdef CJSON_USE_SSE2
+    {
+        const __m128i space = _mm_set1_epi8(32);
+        for (; (i + 16) <= length; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(input + i));
+            unsigned int skipped = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space));
+            if (skipped != 0xFFFFU)
+            {
+                return i + lowest_bit_index(~skipped);
+            }
+        }
+    }
+#endif
+
+    while ((i < length) && (input[i] <= 32))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    /* most values are not preceded by whitespace at all */
+    if (cannot_access_at_index(buffer, 0) || (buffer_at_offset(buffer)[0] > 32))
+    {
+        return buffer;
+    }
+
+    buffer->offset += whitespace_length(buffer_at_offset(buffer), buffer->length - buffer->offset);
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_opts(const char *value, const char **return_parse_end, cjson_bool_t require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cjson_parse_with_length_opts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Report where and why a parse failed. The position is only turned into line and column here, so successful parses don't pay for it. */
+static void set_parse_error(const parse_buffer * const buffer, cjson_error_t * const error)
+{
+    size_t i = 0;
+
+    error->kind = buffer->error;
+    error->offset = 0;
+    error->line = 1;
+    error->column = 1;
+
+    if (buffer->offset < buffer->length)
+    {
+        error->offset = buffer->offset;
+    }
+    else if (buffer->length > 0)
+    {
+        error->offset = buffer->length - 1;
+    }
+
+    if (error->kind == CJSON_ERROR_NONE)
+    {
+        if ((buffer->offset >= buffer->length) || (buffer_at_offset(buffer)[0] == '\0'))
+        {
+            error->kind = CJSON_ERROR_UNEXPECTED_END;
+        }
+        else
+        {
+            error->kind = CJSON_ERROR_UNEXPECTED_CHARACTER;
+        }
+    }
+
+    for (i = 0; i < error->offset; i++)
+    {
+        if (buffer->content[i] == '\n')
+        {
+            error->line++;
+            error->column = 1;
+        }
+        else
+        {
+            error->column++;
+        }
+    }
+}
+
+/* Parse an object - create a new root, and populate.
+ * insitu is value again if strings are to be unescaped in place and NULL otherwise, views leaves strings without
+ * escape sequences in value */
+static cjson_t *parse(const char *value, size_t buffer_length, cjson_bool_t require_null_terminated, cjson_arena_t * const arena, char * const insitu, const cjson_bool_t views, path_projection * const projection, const internal_hooks * const hooks, cjson_error_t * const error)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, false };
+    cjson_t *item = NULL;
+    cjson_bool_t kept = false;
+
+    if (value == NULL)
+    {
+        error->kind = CJSON_ERROR_INVALID_ARGUMENT;
+        error->offset = 0;
+        error->line = 0;
+        error->column = 0;
+        return NULL;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = *hooks;
+    buffer.arena = arena;
+    buffer.insitu = (unsigned char*)insitu;
+    buffer.views = views;
+
+    if (buffer_length == 0)
+    {
+        goto fail;
+    }
+
+    item = parse_new_item(&buffer);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    buffer_skip_whitespace(skip_utf8_bom(&buffer));
+    /* the root is kept even if none of the paths lead into it */
+    if (!((projection != NULL) ? project_value(item, &buffer, projection, &kept) : parse_value(item, &buffer)))
+    {
+        /* parse failure. the error is at the offset */
+        goto fail;
+    }
+    mark_parsed_item(&buffer, item);
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            if (buffer.offset < buffer.length)
+            {
+                buffer.error = CJSON_ERROR_TRAILING_CHARACTERS;
+            }
+            goto fail;
+        }
+    }
+
+    error->kind = CJSON_ERROR_NONE;
+    error->offset = buffer.offset;
+    error->line = 0;
+    error->column = 0;
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        parse_delete(&buffer, item);
+    }
+    set_parse_error(&buffer, error);
+
+    return NULL;
+}
+
+/* Keep cjson_get_error_ptr working for the functions without an error parameter. The global is only
+ * written when it changes, successful parses just read it instead of dirtying a shared cache line. */
+static void set_global_error(const char * const value, const cjson_bool_t succeeded, const cjson_error_t * const error)
+{
+    if (succeeded || (value == NULL))
+    {
+        if (global_error.json != NULL)
+        {
+            global_error.json = NULL;
+            global_error.position = 0;
+        }
+        return;
+    }
+
+    global_error.json = (const unsigned char*)value;
+    global_error.position = error->offset;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_length_opts(const char *value, size_t buffer_length, const char **return_parse_end, cjson_bool_t require_null_terminated)
+{
+    cjson_error_t error;
+    cjson_t *item = parse(value, buffer_length, require_null_terminated, NULL, NULL, false, NULL, &global_hooks, &error);
+
+    set_global_error(value, item != NULL, &error);
+    if ((return_parse_end != NULL) && (value != NULL))
+    {
+        *return_parse_end = value + error.offset;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_error(const char *value, size_t buffer_length, cjson_bool_t require_null_terminated, cjson_error_t *error)
+{
+    cjson_error_t local_error;
+
+    return parse(value, buffer_length, require_null_terminated, NULL, NULL, false, NULL, &global_hooks, (error != NULL) ? error : &local_error);
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_into_arena(cjson_arena_t *arena, const char *value, size_t buffer_length)
+{
+    cjson_error_t error;
+    cjson_t *item = NULL;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    item = parse(value, buffer_length, false, arena, NULL, false, NULL, &arena->hooks, &error);
+    set_global_error(value, item != NULL, &error);
+
+    return item;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_insitu(char *buffer, size_t length)
+{
+    cjson_error_t error;
+    cjson_t *item = parse(buffer, length, false, NULL, buffer, false, NULL, &global_hooks, &error);
+
+    set_global_error(buffer, item != NULL, &error);
+
+    return item;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_views(const char *value, size_t buffer_length, cjson_error_t *error)
+{
+    cjson_error_t local_error;
+
+    return parse(value, buffer_length, false, NULL, NULL, true, NULL, &global_hooks, (error != NULL) ? error : &local_error);
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_projected(const char *value, size_t buffer_length, const char **paths, size_t count)
+{
+    path_projection projection = { NULL, NULL, 0 };
+    cjson_error_t error;
+    cjson_t *item = NULL;
+    size_t i = 0;
+
+    if (((paths == NULL) && (count > 0)) || (count > ((size_t)-1 / sizeof(size_t))))
+    {
+        return NULL;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if ((paths[i] == NULL) || ((paths[i][0] != '\0') && (paths[i][0] != '/')))
+        {
+            return NULL; /* not a JSON pointer */
+        }
+    }
+
+    if (count > 0)
+    {
+        projection.positions = (const char**)global_hooks.allocate(count * sizeof(*projection.positions), global_hooks.user);
+        projection.depths = (size_t*)global_hooks.allocate(count * sizeof(*projection.depths), global_hooks.user);
+        if ((projection.positions == NULL) || (projection.depths == NULL))
+        {
+            goto cleanup;
+        }
+        for (i = 0; i < count; i++)
+        {
+            projection.positions[i] = paths[i];
+            projection.depths[i] = 0;
+        }
+        projection.count = count;
+    }
+
+    item = parse(value, buffer_length, false, NULL, NULL, false, &projection, &global_hooks, &error);
+    set_global_error(value, item != NULL, &error);
+
+cleanup:
+    if (projection.positions != NULL)
+    {
+        global_hooks.deallocate(projection.positions, global_hooks.user);
+    }
+    if (projection.depths != NULL)
+    {
+        global_hooks.deallocate(projection.depths, global_hooks.user);
+    }
+
+    return item;
+}
+
+/* use the allocator if there is one and the global hooks otherwise */
+static cjson_bool_t allocator_hooks(const cjson_allocator_t * const allocator, internal_hooks * const hooks)
+{
+    if (allocator == NULL)
+    {
+        *hooks = global_hooks;
+        return true;
+    }
+
+    if ((allocator->malloc_fn == NULL) || (allocator->free_fn == NULL))
+    {
+        return false;
+    }
+
+    hooks->allocate = allocator->malloc_fn;
+    hooks->deallocate = allocator->free_fn;
+    hooks->reallocate = allocator->realloc_fn;
+    hooks->user = allocator->user;
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_allocator(const char *value, size_t buffer_length, const cjson_allocator_t *allocator, cjson_error_t *error)
+{
+    internal_hooks hooks;
+    cjson_error_t local_error;
+
+    if (error == NULL)
+    {
+        error = &local_error;
+    }
+
+    if (!allocator_hooks(allocator, &hooks))
+    {
+        error->kind = CJSON_ERROR_INVALID_ARGUMENT;
+        error->offset = 0;
+        error->line = 0;
+        error->column = 0;
+        return NULL;
+    }
+
+    return parse(value, buffer_length, false, NULL, NULL, false, NULL, &hooks, error);
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cjson_t *) cjson_parse(const char *value)
+{
+    return cjson_parse_with_opts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_length(const char *value, size_t buffer_length)
+{
+    return cjson_parse_with_length_opts(value, buffer_length, 0, 0);
+}
+
+/* State of cjson_sax_parse. Escaped strings are unescaped into scratch, which is only ever grown. */
+typedef struct
+{
+    parse_buffer buffer;
+    const cjson_sax_handler_t *handler;
+    void *user;
+    unsigned char *scratch;
+    size_t scratch_size;
+} sax_parser;
+
+static cjson_bool_t sax_parse_value(sax_parser * const parser);
+
+/* report the result of a callback, false aborts the parse */
+static cjson_bool_t sax_event(sax_parser * const parser, const cjson_bool_t result)
+{
+    if (!result)
+    {
+        parser->buffer.error = CJSON_ERROR_ABORTED;
+    }
+
+    return result;
+}
+
+/* Parse the string literal at the offset. Strings without escape sequences are handed out as they are in the input,
+ * the others are unescaped into the scratch buffer with the same code parse_string uses. */
+static cjson_bool_t sax_parse_string(sax_parser * const parser, const char ** const string, size_t * const length)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = NULL;
+    const unsigned char *first_escape = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t skipped_bytes = 0;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+    {
+        return false; /* not a string */
+    }
+
+    if (!scan_string(input_buffer, &input_end, &first_escape, &skipped_bytes))
+    {
+        input_buffer->offset++;
+        return false;
+    }
+
+    if (first_escape == NULL)
+    {
+        *string = (const char*)input_pointer;
+        *length = (size_t)(input_end - input_pointer);
+    }
+    else
+    {
+        const size_t needed = (size_t)(input_end - input_pointer) - skipped_bytes;
+        if (needed > parser->scratch_size)
+        {
+            size_t new_size = (parser->scratch_size == 0) ? 64 : parser->scratch_size;
+            unsigned char *new_scratch = NULL;
+            while (new_size < needed)
+            {
+                new_size *= 2;
+            }
+            new_scratch = (unsigned char*)input_buffer->hooks.allocate(new_size, input_buffer->hooks.user);
+            if (new_scratch == NULL)
+            {
+                input_buffer->error = CJSON_ERROR_OUT_OF_MEMORY;
+                return false;
+            }
+            if (parser->scratch != NULL)
+            {
+                input_buffer->hooks.deallocate(parser->scratch, input_buffer->hooks.user);
+            }
+            parser->scratch = new_scratch;
+            parser->scratch_size = new_size;
+        }
+
+        memcpy(parser->scratch, input_pointer, (size_t)(first_escape - input_pointer));
+        output_pointer = parser->scratch + (first_escape - input_pointer);
+        input_pointer = first_escape;
+        if (!unescape_string(&input_pointer, input_end, &output_pointer))
+        {
+            input_buffer->error = CJSON_ERROR_INVALID_STRING;
+            input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+            return false;
+        }
+        *string = (const char*)parser->scratch;
+        *length = (size_t)(output_pointer - parser->scratch);
+    }
+
+    input_buffer->offset = (size_t)(input_end - input_buffer->content) + 1;
+
+    return true;
+}
+
+static cjson_bool_t sax_parse_array(sax_parser * const parser)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if ((parser->handler->start_array != NULL) && !sax_event(parser, parser->handler->start_array(parser->user)))
+    {
+        return false;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    {
+        goto success; /* empty array */
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
+    {
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!sax_parse_value(parser))
+        {
+            return false;
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ']'))
+    {
+        return false; /* expected end of array */
+    }
+
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
+
+    return (parser->handler->end_array == NULL) || sax_event(parser, parser->handler->end_array(parser->user));
+}
+
+static cjson_bool_t sax_parse_object(sax_parser * const parser)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const char *key = NULL;
+    size_t key_length = 0;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if ((parser->handler->start_object != NULL) && !sax_event(parser, parser->handler->start_object(parser->user)))
+    {
+        return false;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    {
+        goto success; /* empty object */
+    }
+
+    /* step back to character in front of the first member */
+    input_buffer->offset--;
+    do
+    {
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!sax_parse_string(parser, &key, &key_length))
+        {
+            return false; /* failed to parse name */
+        }
+        if ((parser->handler->key != NULL) && !sax_event(parser, parser->handler->key(key, key_length, parser->user)))
+        {
+            return false;
+        }
+        buffer_skip_whitespace(input_buffer);
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            return false; /* invalid object */
+        }
+
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!sax_parse_value(parser))
+        {
+            return false;
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        return false; /* expected end of object */
+    }
+
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
+
+    return (parser->handler->end_object == NULL) || sax_event(parser, parser->handler->end_object(parser->user));
+}
+
+/* the counterpart of parse_value that calls the handler instead of filling in an item */
+static cjson_bool_t sax_parse_value(sax_parser * const parser)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const cjson_sax_handler_t * const handler = parser->handler;
+
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        input_buffer->offset += 4;
+        return (handler->null == NULL) || sax_event(parser, handler->null(parser->user));
+    }
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        input_buffer->offset += 5;
+        return (handler->boolean == NULL) || sax_event(parser, handler->boolean(false, parser->user));
+    }
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        input_buffer->offset += 4;
+        return (handler->boolean == NULL) || sax_event(parser, handler->boolean(true, parser->user));
+    }
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        return false;
+    }
+
+    switch (buffer_at_offset(input_buffer)[0])
+    {
+        case '\"':
+        {
+            const char *string = NULL;
+            size_t length = 0;
+            if (!sax_parse_string(parser, &string, &length))
+            {
+                return false;
+            }
+            return (handler->string == NULL) || sax_event(parser, handler->string(string, length, parser->user));
+        }
+
+        case '[':
+            return sax_parse_array(parser);
+
+        case '{':
+            return sax_parse_object(parser);
+
+        default:
+            if ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9')))
+            {
+                /* a temporary item lets parse_number do all of the work */
+                cjson_t number;
+                memset(&number, '\0', sizeof(number));
+                if (!parse_number(&number, input_buffer))
+                {
+                    return false;
+                }
+                return (handler->number == NULL) || sax_event(parser, handler->number(&number, parser->user));
+            }
+            return false;
+    }
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_sax_parse_with_error(const char *text, size_t length, const cjson_sax_handler_t *handler, void *user, cjson_error_t *error)
+{
+    sax_parser parser;
+    cjson_error_t local_error;
+    cjson_bool_t succeeded = false;
+
+    if (error == NULL)
+    {
+        error = &local_error;
+    }
+
+    if ((text == NULL) || (handler == NULL))
+    {
+        error->kind = CJSON_ERROR_INVALID_ARGUMENT;
+        error->offset = 0;
+        error->line = 0;
+        error->column = 0;
+        return false;
+    }
+
+    memset(&parser, '\0', sizeof(parser));
+    parser.buffer.content = (const unsigned char*)text;
+    parser.buffer.length = length;
+    parser.buffer.hooks = global_hooks;
+    parser.buffer.error = CJSON_ERROR_NONE;
+    parser.handler = handler;
+    parser.user = user;
+
+    if (length > 0)
+    {
+        buffer_skip_whitespace(skip_utf8_bom(&parser.buffer));
+        succeeded = sax_parse_value(&parser);
+    }
+
+    if (parser.scratch != NULL)
+    {
+        parser.buffer.hooks.deallocate(parser.scratch, parser.buffer.hooks.user);
+    }
+
+    if (!succeeded)
+    {
+        set_parse_error(&parser.buffer, error);
+        return false;
+    }
+
+    error->kind = CJSON_ERROR_NONE;
+    error->offset = parser.buffer.offset;
+    error->line = 0;
+    error->column = 0;
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_sax_parse(const char *text, size_t length, const cjson_sax_handler_t *handler, void *user)
+{
+    cjson_error_t error;
+    cjson_bool_t succeeded = cjson_sax_parse_with_error(text, length, handler, user, &error);
+
+    set_global_error(text, succeeded, &error);
+
+    return succeeded;
+}
+
+/* What a push parser expects next. After a token is complete the parser continues in state. */
+typedef enum
+{
+    PUSH_VALUE, /* any value */
+    PUSH_FIRST_VALUE, /* a value or the end of an empty array */
+    PUSH_FIRST_KEY, /* a key or the end of an empty object */
+    PUSH_KEY,
+    PUSH_COLON,
+    PUSH_SEPARATOR, /* ',' or the end of the innermost array/object */
+    PUSH_DONE /* the root value is complete, only whitespace may follow */
+} push_state;
+
+/* Values that can span chunks. Strings, keys and numbers are collected in token until they are
+ * complete and then handed to parse_string/parse_number, literals are matched byte by byte. */
+typedef enum
+{
+    PUSH_TOKEN_NONE,
+    PUSH_TOKEN_STRING,
+    PUSH_TOKEN_KEY,
+    PUSH_TOKEN_NUMBER,
+    PUSH_TOKEN_LITERAL,
+    PUSH_TOKEN_BOM
+} push_token;
+
+struct cjson_push_parser_t
+{
+    internal_hooks hooks;
+    cjson_t *root;
+    cjson_t *container; /* the innermost array or object that isn't closed yet, NULL at the top level */
+    size_t depth;
+    push_state state;
+    push_token token_kind;
+    size_t token_start; /* offset of the token in the whole input */
+    const char *literal; /* the text of a literal token */
+    cjson_bool_t escaped; /* the last byte of a string token is a backslash that starts an escape sequence */
+    unsigned char *token; /* the bytes of a token from earlier chunks */
+    size_t token_length;
+    size_t token_size;
+    size_t position; /* offset of the current chunk in the whole input */
+    cjson_error_t error;
+};
+
+static void push_parser_reset(cjson_push_parser_t * const parser)
+{
+    parser->root = NULL;
+    parser->container = NULL;
+    parser->depth = 0;
+    parser->state = PUSH_VALUE;
+    parser->token_kind = PUSH_TOKEN_NONE;
+    parser->token_start = 0;
+    parser->literal = NULL;
+    parser->escaped = false;
+    parser->token_length = 0;
+    parser->position = 0;
+    parser->error.kind = CJSON_ERROR_NONE;
+    parser->error.offset = 0;
+    parser->error.line = 0;
+    parser->error.column = 0;
+}
+
+CJSON_PUBLIC(cjson_push_parser_t *) cjson_push_parser_create(const cjson_allocator_t *allocator)
+{
+    internal_hooks hooks;
+    cjson_push_parser_t *parser = NULL;
+
+    if (!allocator_hooks(allocator, &hooks))
+    {
+        return NULL;
+    }
+
+    parser = (cjson_push_parser_t*)hooks.allocate(sizeof(cjson_push_parser_t), hooks.user);
+    if (parser == NULL)
+    {
+        return NULL;
+    }
+    memset(parser, '\0', sizeof(cjson_push_parser_t));
+    parser->hooks = hooks;
+    push_parser_reset(parser);
+
+    return parser;
+}
+
+CJSON_PUBLIC(void) cjson_push_parser_delete(cjson_push_parser_t *parser)
+{
+    if (parser == NULL)
+    {
+        return;
+    }
+
+    delete_item(parser->root, &parser->hooks);
+    if (parser->token != NULL)
+    {
+        parser->hooks.deallocate(parser->token, parser->hooks.user);
+    }
+    parser->hooks.deallocate(parser, parser->hooks.user);
+}
+
+/* Stop parsing. Line and column are left at 0, the input they would be counted in is gone. */
+static cjson_bool_t push_fail(cjson_push_parser_t * const parser, const cjson_error_kind_t kind, const size_t offset)
+{
+    parser->error.kind = kind;
+    parser->error.offset = offset;
+
+    return false;
+}
+
+/* keep the part of a token that is in the current chunk for later */
+static cjson_bool_t push_keep_token(cjson_push_parser_t * const parser, const unsigned char * const bytes, const size_t length)
+{
+    if ((parser->token_length + length) > parser->token_size)
+    {
+        size_t new_size = (parser->token_size == 0) ? 64 : parser->token_size;
+        unsigned char *new_token = NULL;
+        while (new_size < (parser->token_length + length))
+        {
+            new_size *= 2;
+        }
+
+        if (parser->hooks.reallocate != NULL)
+        {
+            new_token = (unsigned char*)parser->hooks.reallocate(parser->token, new_size, parser->hooks.user);
+        }
+        else
+        {
+            new_token = (unsigned char*)parser->hooks.allocate(new_size, parser->hooks.user);
+            if ((new_token != NULL) && (parser->token != NULL))
+            {
+                memcpy(new_token, parser->token, parser->token_length);
+                parser->hooks.deallocate(parser->token, parser->hooks.user);
+            }
+        }
+        if (new_token == NULL)
+        {
+            return push_fail(parser, CJSON_ERROR_OUT_OF_MEMORY, parser->token_start);
+        }
+        parser->token = new_token;
+        parser->token_size = new_size;
+    }
+
+    memcpy(parser->token + parser->token_length, bytes, length);
+    parser->token_length += length;
+
+    return true;
+}
+
+/* link item to the end of the innermost array or object */
+static void push_append(cjson_t * const container, cjson_t * const item)
+{
+    item->parent = container;
+    if (container->child == NULL)
+    {
+        container->child = item;
+    }
+    else
+    {
+        cjson_t * const tail = container->child->prev;
+        tail->next = item;
+        item->prev = tail;
+    }
+    /* the head's prev always points to the tail */
+    container->child->prev = item;
+}
+
+/* the item a value that is complete now is stored in */
+static cjson_t *push_value_item(cjson_push_parser_t * const parser)
+{
+    cjson_t *item = NULL;
+
+    if ((parser->container != NULL) && (parser->container->type == CJSON_OBJECT))
+    {
+        /* the member was created with its key */
+        return parser->container->child->prev;
+    }
+
+    item = cJSON_New_Item(&parser->hooks);
+    if (item == NULL)
+    {
+        push_fail(parser, CJSON_ERROR_OUT_OF_MEMORY, parser->token_start);
+        return NULL;
+    }
+    if (parser->container == NULL)
+    {
+        parser->root = item;
+    }
+    else
+    {
+        push_append(parser->container, item);
+    }
+
+    return item;
+}
+
+static void push_value_done(cjson_push_parser_t * const parser)
+{
+    parser->state = (parser->container == NULL) ? PUSH_DONE : PUSH_SEPARATOR;
+}
+
+static cjson_bool_t push_start_container(cjson_push_parser_t * const parser, const int type, const size_t offset)
+{
+    cjson_t *item = NULL;
+
+    if (parser->depth >= CJSON_NESTING_LIMIT)
+    {
+        return push_fail(parser, CJSON_ERROR_NESTING_LIMIT, offset);
+    }
+
+    parser->token_start = offset;
+    item = push_value_item(parser);
+    if (item == NULL)
+    {
+        return false;
+    }
+    item->type = type;
+    parser->container = item;
+    parser->depth++;
+    parser->state = (type == CJSON_ARRAY) ? PUSH_FIRST_VALUE : PUSH_FIRST_KEY;
+
+    return true;
+}
+
+/* close the innermost array or object */
+static void push_end_container(cjson_push_parser_t * const parser)
+{
+    cjson_t * const container = parser->container;
+
+    parser->depth--;
+    parser->container = container->parent;
+    push_value_done(parser);
+}
+
+/* Hand a complete string, key or number token to parse_string/parse_number. */
+static cjson_bool_t push_finish_token(cjson_push_parser_t * const parser, const unsigned char * const token, const size_t length)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, false };
+    cjson_t *item = NULL;
+
+    buffer.content = token;
+    buffer.length = length;
+    buffer.hooks = parser->hooks;
+
+    if (parser->token_kind == PUSH_TOKEN_KEY)
+    {
+        item = cJSON_New_Item(&parser->hooks);
+        if (item == NULL)
+        {
+            return push_fail(parser, CJSON_ERROR_OUT_OF_MEMORY, parser->token_start);
+        }
+        push_append(parser->container, item);
+        if (!parse_string(item, &buffer))
+        {
+            return push_fail(parser, (buffer.error != CJSON_ERROR_NONE) ? buffer.error : CJSON_ERROR_INVALID_STRING, parser->token_start + buffer.offset);
+        }
+        /* swap valuestring and string, because we parsed the name */
+        item->string = item->valuestring;
+        item->valuestring = NULL;
+        hash_item_key(item);
+        parser->state = PUSH_COLON;
+
+        return true;
+    }
+
+    item = push_value_item(parser);
+    if (item == NULL)
+    {
+        return false;
+    }
+    if (parser->token_kind == PUSH_TOKEN_STRING)
+    {
+        if (!parse_string(item, &buffer))
+        {
+            return push_fail(parser, (buffer.error != CJSON_ERROR_NONE) ? buffer.error : CJSON_ERROR_INVALID_STRING, parser->token_start + buffer.offset);
+        }
+    }
+    else
+    {
+        if (!parse_number(item, &buffer))
+        {
+            return push_fail(parser, CJSON_ERROR_INVALID_NUMBER, parser->token_start);
+        }
+        if (buffer.offset < length)
+        {
+            /* e.g. "1-2", the rest isn't part of the number */
+            return push_fail(parser, (parser->container != NULL) ? CJSON_ERROR_UNEXPECTED_CHARACTER : CJSON_ERROR_TRAILING_CHARACTERS, parser->token_start + buffer.offset);
+        }
+    }
+    push_value_done(parser);
+
+    return true;
+}
+
+/* complete a token that ended in an earlier chunk or will end in this one */
+static cjson_bool_t push_end_token(cjson_push_parser_t * const parser, const unsigned char * const bytes, const size_t length)
+{
+    cjson_bool_t result = false;
+
+    if (parser->token_length == 0)
+    {
+        /* the whole token is in this chunk */
+        result = push_finish_token(parser, bytes, length);
+    }
+    else
+    {
+        result = push_keep_token(parser, bytes, length) && push_finish_token(parser, parser->token, parser->token_length);
+    }
+    parser->token_kind = PUSH_TOKEN_NONE;
+    parser->token_length = 0;
+
+    return result;
+}
+
+static cjson_bool_t is_number_character(const unsigned char c)
+{
+    return ((c >= '0') && (c <= '9')) || (c == '-') || (c == '+') || (c == '.') || (c == 'e') || (c == 'E');
+}
+
+/* Continue the token at input[*offset]. Returns false on errors, *offset is advanced past what was consumed. */
+static cjson_bool_t push_continue_token(cjson_push_parser_t * const parser, const unsigned char * const input, size_t * const offset, const size_t length)
+{
+    size_t i = *offset;
+    /* where the part of the token in this chunk starts */
+    const size_t start = (parser->token_start > parser->position) ? (parser->token_start - parser->position) : 0;
+
+    switch (parser->token_kind)
+    {
+        case PUSH_TOKEN_LITERAL:
+        case PUSH_TOKEN_BOM:
+        {
+            const size_t literal_length = strlen(parser->literal);
+            for (; (i < length) && (parser->token_length < literal_length); i++, parser->token_length++)
+            {
+                if (input[i] != (unsigned char)parser->literal[parser->token_length])
+                {
+                    return push_fail(parser, CJSON_ERROR_UNEXPECTED_CHARACTER, parser->token_start);
+                }
+            }
+            *offset = i;
+            if (parser->token_length < literal_length)
+            {
+                return true;
+            }
+
+            parser->token_length = 0;
+            if (parser->token_kind == PUSH_TOKEN_LITERAL)
+            {
+                cjson_t *item = push_value_item(parser);
+                if (item == NULL)
+                {
+                    return false;
+                }
+                switch (parser->literal[0])
+                {
+                    case 'n':
+                        item->type = CJSON_NULL;
+                        break;
+                    case 'f':
+                        item->type = CJSON_FALSE;
+                        break;
+                    default:
+                        item->type = CJSON_TRUE;
+                        item->valueint = 1;
+                        break;
+                }
+                push_value_done(parser);
+            }
+            parser->token_kind = PUSH_TOKEN_NONE;
+            return true;
+        }
+
+        case PUSH_TOKEN_NUMBER:
+            while ((i < length) && is_number_character(input[i]))
+            {
+                i++;
+            }
+            *offset = i;
+            if (i == length)
+            {
+                /* the number may continue in the next chunk */
+                return push_keep_token(parser, input + start, i - start);
+            }
+            return push_end_token(parser, input + start, i - start);
+
+        case PUSH_TOKEN_STRING:
+        case PUSH_TOKEN_KEY:
+        case PUSH_TOKEN_NONE:
+        default:
+            /* string or key */
+            if (parser->token_start == (parser->position + i))
+            {
+                i++; /* the opening quote */
+            }
+            while (i < length)
+            {
+                if (parser->escaped)
+                {
+                    parser->escaped = false;
+                    i++;
+                    continue;
+                }
+                i += string_run_length(input + i, length - i, NULL);
+                if (i >= length)
+                {
+                    break;
+                }
+                i++;
+                if (input[i - 1] == '\\')
+                {
+                    parser->escaped = true;
+                    continue;
+                }
+                if (input[i - 1] != '\"')
+                {
+                    /* a control character, rejected when the token is parsed */
+                    continue;
+                }
+
+                /* closing quote */
+                *offset = i;
+                return push_end_token(parser, input + start, i - start);
+            }
+            *offset = i;
+            return push_keep_token(parser, input + start, i - start);
+    }
+}
+
+/* Start the value at input[*offset]. Strings, numbers and literals become tokens that push_continue_token reads. */
+static cjson_bool_t push_start_value(cjson_push_parser_t * const parser, const unsigned char * const input, size_t * const offset)
+{
+    const unsigned char c = input[*offset];
+    const size_t position = parser->position + *offset;
+
+    if ((c == '[') || (c == '{'))
+    {
+        (*offset)++;
+        return push_start_container(parser, (c == '[') ? CJSON_ARRAY : CJSON_OBJECT, position);
+    }
+
+    parser->token_start = position;
+    parser->token_length = 0;
+    if (c == '\"')
+    {
+        parser->token_kind = PUSH_TOKEN_STRING;
+        parser->escaped = false;
+    }
+    else if ((c == '-') || ((c >= '0') && (c <= '9')))
+    {
+        parser->token_kind = PUSH_TOKEN_NUMBER;
+    }
+    else if ((c == 'n') || (c == 't') || (c == 'f'))
+    {
+        parser->token_kind = PUSH_TOKEN_LITERAL;
+        parser->literal = (c == 'n') ? "null" : ((c == 't') ? "true" : "false");
+    }
+    else if ((c == 0xEF) && (position == 0))
+    {
+        /* skipped like skip_utf8_bom does */
+        parser->token_kind = PUSH_TOKEN_BOM;
+        parser->literal = "\xEF\xBB\xBF";
+    }
+    else
+    {
+        return push_fail(parser, CJSON_ERROR_UNEXPECTED_CHARACTER, position);
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_push_parser_feed(cjson_push_parser_t *parser, const char *buffer, size_t length)
+{
+    const unsigned char * const input = (const unsigned char*)buffer;
+    size_t i = 0;
+
+    if ((parser == NULL) || ((buffer == NULL) && (length > 0)))
+    {
+        return false;
+    }
+    if (parser->error.kind != CJSON_ERROR_NONE)
+    {
+        return false;
+    }
+
+    while (i < length)
+    {
+        cjson_bool_t result = true;
+
+        if (parser->token_kind != PUSH_TOKEN_NONE)
+        {
+            result = push_continue_token(parser, input, &i, length);
+        }
+        else if (input[i] <= 32)
+        {
+            i += whitespace_length(input + i, length - i);
+            continue;
+        }
+        else
+        {
+            const unsigned char c = input[i];
+            switch (parser->state)
+            {
+                case PUSH_FIRST_VALUE:
+                    if (c == ']')
+                    {
+                        i++;
+                        push_end_container(parser);
+                        break;
+                    }
+                    result = push_start_value(parser, input, &i);
+                    break;
+
+                case PUSH_VALUE:
+                    result = push_start_value(parser, input, &i);
+                    break;
+
+                case PUSH_FIRST_KEY:
+                case PUSH_KEY:
+                    if ((c == '}') && (parser->state == PUSH_FIRST_KEY))
+                    {
+                        i++;
+                        push_end_container(parser);
+                    }
+                    else if (c == '\"')
+                    {
+                        parser->token_kind = PUSH_TOKEN_KEY;
+                        parser->token_start = parser->position + i;
+                        parser->token_length = 0;
+                        parser->escaped = false;
+                    }
+                    else
+                    {
+                        result = push_fail(parser, CJSON_ERROR_UNEXPECTED_CHARACTER, parser->position + i);
+                    }
+                    break;
+
+                case PUSH_COLON:
+                    if (c != ':')
+                    {
+                        result = push_fail(parser, CJSON_ERROR_UNEXPECTED_CHARACTER, parser->position + i);
+                        break;
+                    }
+                    i++;
+                    parser->state = PUSH_VALUE;
+                    break;
+
+                case PUSH_SEPARATOR:
+                    if (c == ',')
+                    {
+                        parser->state = (parser->container->type == CJSON_ARRAY) ? PUSH_VALUE : PUSH_KEY;
+                    }
+                    else if (c == ((parser->container->type == CJSON_ARRAY) ? ']' : '}'))
+                    {
+                        push_end_container(parser);
+                    }
+                    else
+                    {
+                        result = push_fail(parser, CJSON_ERROR_UNEXPECTED_CHARACTER, parser->position + i);
+                        break;
+                    }
+                    i++;
+                    break;
+
+                case PUSH_DONE:
+                default:
+                    result = push_fail(parser, CJSON_ERROR_TRAILING_CHARACTERS, parser->position + i);
+                    break;
+            }
+        }
+
+        if (!result)
+        {
+            return false;
+        }
+    }
+    parser->position += length;
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_push_parser_finish(cjson_push_parser_t *parser, cjson_error_t *error)
+{
+    cjson_t *root = NULL;
+
+    if (parser == NULL)
+    {
+        if (error != NULL)
+        {
+            error->kind = CJSON_ERROR_INVALID_ARGUMENT;
+            error->offset = 0;
+            error->line = 0;
+            error->column = 0;
+        }
+        return NULL;
+    }
+
+    if (parser->error.kind == CJSON_ERROR_NONE)
+    {
+        /* only the end of the input ends a number at the top level */
+        if ((parser->token_kind == PUSH_TOKEN_NUMBER) && (parser->container == NULL))
+        {
+            push_finish_token(parser, parser->token, parser->token_length);
+        }
+        if ((parser->error.kind == CJSON_ERROR_NONE) && (parser->state != PUSH_DONE))
+        {
+            push_fail(parser, CJSON_ERROR_UNEXPECTED_END, parser->position);
+        }
+    }
+
+    if (parser->error.kind == CJSON_ERROR_NONE)
+    {
+        root = parser->root;
+        parser->root = NULL;
+        parser->error.offset = parser->position;
+    }
+    if (error != NULL)
+    {
+        *error = parser->error;
+    }
+
+    delete_item(parser->root, &parser->hooks);
+    push_parser_reset(parser);
+
+    return root;
+}
+
+CJSON_PUBLIC(void) cjson_ndjson_iter_init(cjson_ndjson_iter_t *iter, const char *buffer, size_t length, cjson_arena_t *arena)
+{
+    if (iter == NULL)
+    {
+        return;
+    }
+
+    iter->buffer = buffer;
+    iter->length = (buffer != NULL) ? length : 0;
+    iter->offset = 0;
+    iter->line = 1;
+    iter->line_start = 0;
+    iter->arena = arena;
+}
+
+/* move the iterator to end, counting the lines on the way */
+static void ndjson_advance(cjson_ndjson_iter_t * const iter, const size_t end)
+{
+    const char *newline = NULL;
+
+    while ((iter->offset < end) && ((newline = (const char*)memchr(iter->buffer + iter->offset, '\n', end - iter->offset)) != NULL))
+    {
+        iter->offset = (size_t)(newline - iter->buffer) + 1;
+        iter->line++;
+        iter->line_start = iter->offset;
+    }
+    iter->offset = end;
+}
+
+/* Read the next record. With reset_arena false, the records parsed into the arena accumulate. */
+static cjson_bool_t ndjson_read(cjson_ndjson_iter_t * const iter, cjson_t ** const item, cjson_error_t *error, const cjson_bool_t reset_arena)
+{
+    cjson_error_t local_error;
+    cjson_t *parsed = NULL;
+    size_t start = 0;
+    size_t end = 0;
+    const char *newline = NULL;
+
+    if (error == NULL)
+    {
+        error = &local_error;
+    }
+    if (item != NULL)
+    {
+        *item = NULL;
+    }
+    if ((iter == NULL) || (iter->buffer == NULL))
+    {
+        return false;
+    }
+
+    /* blank lines and the whitespace between records */
+    ndjson_advance(iter, iter->offset + whitespace_length((const unsigned char*)iter->buffer + iter->offset, iter->length - iter->offset));
+    if (iter->offset >= iter->length)
+    {
+        return false;
+    }
+
+    /* a record ends with its line, so an invalid one can't take the records after it along */
+    start = iter->offset;
+    newline = (const char*)memchr(iter->buffer + start, '\n', iter->length - start);
+    end = (newline != NULL) ? ((size_t)(newline - iter->buffer) + 1) : iter->length;
+    if (iter->arena != NULL)
+    {
+        if (reset_arena)
+        {
+            cjson_arena_reset(iter->arena);
+        }
+        parsed = parse(iter->buffer + start, end - start, false, iter->arena, NULL, false, NULL, &iter->arena->hooks, error);
+    }
+    else
+    {
+        parsed = parse(iter->buffer + start, end - start, false, NULL, NULL, false, NULL, &global_hooks, error);
+    }
+
+    if (parsed != NULL)
+    {
+        error->offset += start;
+        ndjson_advance(iter, error->offset);
+        if (item != NULL)
+        {
+            *item = parsed;
+        }
+        else if (iter->arena == NULL)
+        {
+            cjson_delete(parsed);
+        }
+        return true;
+    }
+
+    /* make the error position relative to the whole buffer */
+    error->offset += start;
+    error->column += start - iter->line_start;
+    error->line = iter->line;
+
+    /* carry on with the next line */
+    ndjson_advance(iter, end);
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_ndjson_next(cjson_ndjson_iter_t *iter, cjson_t **item, cjson_error_t *error)
+{
+    return ndjson_read(iter, item, error, true);
+}
+
+static cjson_bool_t ndjson_parse_sequential(const char * const buffer, const size_t length, const cjson_ndjson_callback callback, void * const user)
+{
+    cjson_ndjson_iter_t iter;
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *item = NULL;
+    cjson_error_t error;
+    cjson_bool_t keep_going = true;
+
+    if (arena == NULL)
+    {
+        return false;
+    }
+
+    cjson_ndjson_iter_init(&iter, buffer, length, arena);
+    while (keep_going && ndjson_read(&iter, &item, &error, true))
+    {
+        keep_going = callback(item, &error, user);
+    }
+    cjson_arena_delete(arena);
+
+    return keep_going;
+}
+
+#ifdef CJSON_USE_PTHREADS
+/* Batches are about length / (threads * NDJSON_BATCHES_PER_THREAD) bytes, within these limits. */
+#define NDJSON_BATCHES_PER_THREAD 8
+#define NDJSON_MIN_BATCH_SIZE 16384
+#define NDJSON_MAX_BATCH_SIZE 1048576
+/* in unordered mode, how many records a thread delivers between checks whether another one stopped */
+#define NDJSON_STOP_CHECK_INTERVAL 64
+
+typedef struct ndjson_job ndjson_job;
+
+/* a record that waits for its turn to be delivered */
+typedef struct
+{
+    cjson_t *item;
+    cjson_error_t error;
+} ndjson_record;
+
+/* A worker owns the batches number + j * worker_count for front <= j < back. It works through them from the front and
+ * the others steal from the back when they run out, so the lowest batches are parsed first, which keeps ordered delivery going. */
+typedef struct
+{
+    ndjson_job *job;
+    size_t number;
+    pthread_mutex_t lock; /* guards front and back */
+    size_t front;
+    size_t back;
+    cjson_arena_t *arena;
+    ndjson_record *records; /* the records of the current batch in ordered mode */
+    size_t records_size;
+    pthread_t thread;
+    cjson_bool_t started;
+} ndjson_worker;
+
+struct ndjson_job
+{
+    const char *buffer;
+    size_t length;
+    size_t batch_size;
+    cjson_ndjson_callback callback;
+    void *user;
+    cjson_bool_t ordered;
+    ndjson_worker *workers;
+    size_t worker_count;
+    pthread_mutex_t lock; /* guards the fields below */
+    pthread_cond_t turn_changed;
+    size_t next_batch; /* the batch that is delivered next in ordered mode */
+    size_t lines; /* number of lines in the batches delivered so far */
+    cjson_bool_t stopped;
+};
+
+/* batch starts at the first line that starts at or after batch * batch_size */
+static size_t ndjson_batch_start(const ndjson_job * const job, const size_t batch)
+{
+    const size_t start = batch * job->batch_size;
+    const char *newline = NULL;
+
+    if (start == 0)
+    {
+        return 0;
+    }
+    if (start >= job->length)
+    {
+        return job->length;
+    }
+
+    newline = (const char*)memchr(job->buffer + start - 1, '\n', job->length - start + 1);
+
+    return (newline != NULL) ? ((size_t)(newline - job->buffer) + 1) : job->length;
+}
+
+static cjson_bool_t ndjson_stopped(ndjson_job * const job)
+{
+    cjson_bool_t stopped = false;
+
+    pthread_mutex_lock(&job->lock);
+    stopped = job->stopped;
+    pthread_mutex_unlock(&job->lock);
+
+    return stopped;
+}
+
+static void ndjson_stop(ndjson_job * const job)
+{
+    pthread_mutex_lock(&job->lock);
+    job->stopped = true;
+    pthread_cond_broadcast(&job->turn_changed);
+    pthread_mutex_unlock(&job->lock);
+}
+
+/* the next batch of the worker's own, or one stolen from another worker */
+static cjson_bool_t ndjson_take_batch(ndjson_worker * const worker, size_t * const batch)
+{
+    const ndjson_job * const job = worker->job;
+    size_t i = 0;
+
+    for (i = 0; i < job->worker_count; i++)
+    {
+        ndjson_worker * const victim = &job->workers[(worker->number + i) % job->worker_count];
+        cjson_bool_t found = false;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->front < victim->back)
+        {
+            found = true;
+            if (victim == worker)
+            {
+                *batch = victim->number + (victim->front++ * job->worker_count);
+            }
+            else
+            {
+                *batch = victim->number + (--victim->back * job->worker_count);
+            }
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (found)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* keep a record of the batch until it is its turn */
+static cjson_bool_t ndjson_keep_record(ndjson_worker * const worker, const size_t count, cjson_t * const item, const cjson_error_t * const error)
+{
+    if (count == worker->records_size)
+    {
+        const size_t new_size = (worker->records_size == 0) ? 64 : (worker->records_size * 2);
+        ndjson_record *new_records = (ndjson_record*)global_hooks.allocate(new_size * sizeof(ndjson_record), global_hooks.user);
+        if (new_records == NULL)
+        {
+            return false;
+        }
+        if (worker->records != NULL)
+        {
+            memcpy(new_records, worker->records, count * sizeof(ndjson_record));
+            global_hooks.deallocate(worker->records, global_hooks.user);
+        }
+        worker->records = new_records;
+        worker->records_size = new_size;
+    }
+
+    worker->records[count].item = item;
+    worker->records[count].error = *error;
+
+    return true;
+}
+
+/* Parse a batch and deliver its records. Returns false if parsing has to stop. */
+static cjson_bool_t ndjson_run_batch(ndjson_worker * const worker, const size_t batch)
+{
+    ndjson_job * const job = worker->job;
+    const size_t start = ndjson_batch_start(job, batch);
+    cjson_ndjson_iter_t iter;
+    cjson_t *item = NULL;
+    cjson_error_t error;
+    cjson_bool_t keep_going = true;
+    size_t lines_before = 0;
+    size_t count = 0;
+    size_t i = 0;
+
+    cjson_ndjson_iter_init(&iter, job->buffer + start, ndjson_batch_start(job, batch + 1) - start, worker->arena);
+    if (!job->ordered)
+    {
+        while (keep_going && ndjson_read(&iter, &item, &error, true))
+        {
+            /* the lines before the batch haven't been counted */
+            error.offset += start;
+            error.line = 0;
+            error.column = 0;
+            keep_going = job->callback(item, &error, job->user);
+            /* look for a stop from the other threads now and then, the lock is shared by all of them */
+            if (keep_going && ((++count % NDJSON_STOP_CHECK_INTERVAL) == 0))
+            {
+                keep_going = !ndjson_stopped(job);
+            }
+        }
+        return keep_going;
+    }
+
+    /* the whole batch stays in the arena until it is delivered */
+    cjson_arena_reset(worker->arena);
+    while (ndjson_read(&iter, &item, &error, false))
+    {
+        error.offset += start;
+        if (!ndjson_keep_record(worker, count, item, &error))
+        {
+            return false;
+        }
+        count++;
+    }
+
+    pthread_mutex_lock(&job->lock);
+    while ((job->next_batch != batch) && !job->stopped)
+    {
+        pthread_cond_wait(&job->turn_changed, &job->lock);
+    }
+    keep_going = !job->stopped;
+    lines_before = job->lines;
+    pthread_mutex_unlock(&job->lock);
+
+    for (i = 0; keep_going && (i < count); i++)
+    {
+        if (worker->records[i].error.kind != CJSON_ERROR_NONE)
+        {
+            worker->records[i].error.line += lines_before;
+        }
+        keep_going = job->callback(worker->records[i].item, &worker->records[i].error, job->user);
+    }
+
+    pthread_mutex_lock(&job->lock);
+    job->lines += iter.line - 1;
+    job->next_batch++;
+    /* stop before the next batch gets its turn */
+    if (!keep_going)
+    {
+        job->stopped = true;
+    }
+    pthread_cond_broadcast(&job->turn_changed);
+    pthread_mutex_unlock(&job->lock);
+
+    return keep_going;
+}
+
+static void *ndjson_worker_main(void *context)
+{
+    ndjson_worker * const worker = (ndjson_worker*)context;
+    size_t batch = 0;
+
+    while (!ndjson_stopped(worker->job) && ndjson_take_batch(worker, &batch))
+    {
+        if (!ndjson_run_batch(worker, batch))
+        {
+            ndjson_stop(worker->job);
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void ndjson_delete_workers(ndjson_job * const job, const size_t count)
+{
+    size_t i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        pthread_mutex_destroy(&job->workers[i].lock);
+        cjson_arena_delete(job->workers[i].arena);
+        if (job->workers[i].records != NULL)
+        {
+            global_hooks.deallocate(job->workers[i].records, global_hooks.user);
+        }
+    }
+    global_hooks.deallocate(job->workers, global_hooks.user);
+}
+
+static cjson_bool_t ndjson_parse_threaded(const char * const buffer, const size_t length, size_t threads, const cjson_ndjson_callback callback, void * const user, const cjson_bool_t ordered)
+{
+    ndjson_job job;
+    size_t batch_count = 0;
+    size_t i = 0;
+
+    memset(&job, '\0', sizeof(job));
+    job.buffer = buffer;
+    job.length = length;
+    job.callback = callback;
+    job.user = user;
+    job.ordered = ordered;
+    job.batch_size = length / (threads * NDJSON_BATCHES_PER_THREAD);
+    if (job.batch_size < NDJSON_MIN_BATCH_SIZE)
+    {
+        job.batch_size = NDJSON_MIN_BATCH_SIZE;
+    }
+    else if (job.batch_size > NDJSON_MAX_BATCH_SIZE)
+    {
+        job.batch_size = NDJSON_MAX_BATCH_SIZE;
+    }
+    batch_count = (length / job.batch_size) + (((length % job.batch_size) != 0) ? 1 : 0);
+    if (threads > batch_count)
+    {
+        threads = batch_count;
+    }
+    if (threads <= 1)
+    {
+        /* not worth starting threads */
+        return ndjson_parse_sequential(buffer, length, callback, user);
+    }
+
+    job.workers = (ndjson_worker*)global_hooks.allocate(threads * sizeof(ndjson_worker), global_hooks.user);
+    if (job.workers == NULL)
+    {
+        return false;
+    }
+    memset(job.workers, '\0', threads * sizeof(ndjson_worker));
+    for (i = 0; i < threads; i++)
+    {
+        ndjson_worker * const worker = &job.workers[i];
+        worker->job = &job;
+        worker->number = i;
+        worker->front = 0;
+        worker->back = (batch_count - i + threads - 1) / threads;
+        worker->arena = cjson_arena_create(0);
+        if ((worker->arena == NULL) || (pthread_mutex_init(&worker->lock, NULL) != 0))
+        {
+            cjson_arena_delete(worker->arena);
+            ndjson_delete_workers(&job, i);
+            return false;
+        }
+    }
+    job.worker_count = threads;
+    if (pthread_mutex_init(&job.lock, NULL) != 0)
+    {
+        ndjson_delete_workers(&job, threads);
+        return false;
+    }
+    if (pthread_cond_init(&job.turn_changed, NULL) != 0)
+    {
+        pthread_mutex_destroy(&job.lock);
+        ndjson_delete_workers(&job, threads);
+        return false;
+    }
+
+    /* the calling thread is worker 0, the batches of workers that couldn't be started are stolen by the others */
+    for (i = 1; i < threads; i++)
+    {
+        job.workers[i].started = (pthread_create(&job.workers[i].thread, NULL, ndjson_worker_main, &job.workers[i]) == 0);
+    }
+    ndjson_worker_main(&job.workers[0]);
+    for (i = 1; i < threads; i++)
+    {
+        if (job.workers[i].started)
+        {
+            pthread_join(job.workers[i].thread, NULL);
+        }
+    }
+
+    pthread_cond_destroy(&job.turn_changed);
+    pthread_mutex_destroy(&job.lock);
+    ndjson_delete_workers(&job, threads);
+
+    return !job.stopped;
+}
+
+/* one thread per processor if nthreads doesn't say otherwise */
+static size_t ndjson_thread_count(const int nthreads)
+{
+    if (nthreads > 0)
+    {
+        return (size_t)nthreads;
+    }
+#ifdef _SC_NPROCESSORS_ONLN
+    {
+        const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        if (processors > 0)
+        {
+            return (size_t)processors;
+        }
+    }
+#endif
+
+    return 1;
+}
+#endif /* CJSON_USE_PTHREADS */
+
+CJSON_PUBLIC(cjson_bool_t) cjson_parse_ndjson_parallel(const char *buffer, size_t length, int nthreads, cjson_ndjson_callback callback, void *user, int flags)
+{
+    if ((buffer == NULL) || (callback == NULL))
+    {
+        return false;
+    }
+
+#ifdef CJSON_USE_PTHREADS
+    {
+        const size_t threads = ndjson_thread_count(nthreads);
+        if (threads > 1)
+        {
+            return ndjson_parse_threaded(buffer, length, threads, callback, user, !(flags & CJSON_NDJSON_UNORDERED));
+        }
+    }
+#else
+    (void)nthreads;
+    (void)flags;
+#endif
+
+    return ndjson_parse_sequential(buffer, length, callback, user);
+}
+
+/* length of the run at the start of input that contains none of '"', '[', ']', '{' and '}'.
+ * Setting bit 5 folds '[' and ']' onto '{' and '}', no other byte maps to either. */
+static size_t structural_run_length(const unsigned char * const input, const size_t length)
+{
+    size_t i = 0;
+
+#ifdef CJSON_USE_AVX2
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i fold = _mm256_set1_epi8(0x20);
+        const __m256i open = _mm256_set1_epi8('{');
+        const __m256i close = _mm256_set1_epi8('}');
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(input + i));
+            const __m256i folded = _mm256_or_si256(chunk, fold);
+            unsigned int special = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close))));
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+#ifdef CJSON_USE_SSE2
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i fold = _mm_set1_epi8(0x20);
+        const __m128i open = _mm_set1_epi8('{');
+        const __m128i close = _mm_set1_epi8('}');
+        for (; (i + 16) <= length; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(input + i));
+            const __m128i folded = _mm_or_si128(chunk, fold);
+            unsigned int special = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close))));
+            if (special != 0)
+            {
+                return i + lowest_bit_index(special);
+            }
+        }
+    }
+#endif
+
+    while (i < length)
+    {
+        const unsigned char folded = (unsigned char)(input[i] | 0x20);
+        if ((input[i] == '\"') || (folded == '{') || (folded == '}'))
+        {
+            break;
+        }
+        i++;
+    }
+
+    return i;
+}
+
+/* can't be part of a scalar, so ends it */
+static cjson_bool_t is_delimiter(const unsigned char character)
+{
+    return (character <= 32) || (character == ',') || (character == ':') || (character == ']') || (character == '}');
+}
+
+/* Skip the value at the offset without building it. Strings are scanned to their closing quote and containers to the
+ * matching bracket, which is all that is checked: a scalar is taken to reach up to the next delimiter. */
+static cjson_bool_t skip_value(parse_buffer * const input_buffer)
+{
+    /* a bit per nesting level, set if it is an object */
+    unsigned char objects[(CJSON_NESTING_LIMIT / CHAR_BIT) + 1];
+    size_t depth = 0;
+    size_t offset = input_buffer->offset;
+
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        return false;
+    }
+
+    do
+    {
+        const unsigned char character = input_buffer->content[offset];
+        switch (character)
+        {
+            case '\"':
+            {
+                const unsigned char *string_end = NULL;
+                const unsigned char *first_escape = NULL;
+                size_t skipped_bytes = 0;
+
+                input_buffer->offset = offset;
+                if (!scan_string(input_buffer, &string_end, &first_escape, &skipped_bytes))
+                {
+                    return false;
+                }
+                offset = (size_t)(string_end - input_buffer->content) + 1;
+                break;
+            }
+
+            case '[':
+            case '{':
+                if ((input_buffer->depth + depth) >= CJSON_NESTING_LIMIT)
+                {
+                    input_buffer->offset = offset;
+                    input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+                    return false;
+                }
+                if (character == '{')
+                {
+                    objects[depth / CHAR_BIT] |= (unsigned char)(1U << (depth % CHAR_BIT));
+                }
+                else
+                {
+                    objects[depth / CHAR_BIT] &= (unsigned char)~(1U << (depth % CHAR_BIT));
+                }
+                depth++;
+                offset++;
+                break;
+
+            case ']':
+            case '}':
+                if ((depth == 0) || ((cjson_bool_t)((objects[(depth - 1) / CHAR_BIT] >> ((depth - 1) % CHAR_BIT)) & 1) != (character == '}')))
+                {
+                    /* closes nothing or the wrong kind of container */
+                    input_buffer->offset = offset;
+                    return false;
+                }
+                depth--;
+                offset++;
+                break;
+
+            default:
+                if (depth > 0)
+                {
+                    /* nothing but the strings and brackets matters inside a container */
+                    offset += structural_run_length(input_buffer->content + offset, input_buffer->length - offset);
+                    break;
+                }
+                /* a scalar on its own */
+                while ((offset < input_buffer->length) && !is_delimiter(input_buffer->content[offset]))
+                {
+                    offset++;
+                }
+                if (offset == input_buffer->offset)
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+    while ((depth > 0) && (offset < input_buffer->length));
+
+    /* an unclosed container leaves the offset at the end, which is reported as an unexpected end */
+    input_buffer->offset = offset;
+
+    return depth == 0;
+}
+
+/* a parse buffer over the text of the document of value, at the given offset */
+static void od_buffer(const cjson_od_value_t * const value, const size_t offset, parse_buffer * const buffer)
+{
+    memset(buffer, '\0', sizeof(*buffer));
+    buffer->content = (const unsigned char*)value->document->text;
+    buffer->length = value->document->length;
+    buffer->offset = offset;
+    buffer->depth = value->depth;
+    buffer->hooks = global_hooks;
+    buffer->error = CJSON_ERROR_NONE;
+}
+
+/* a parse buffer for the entries of container, which are nested one level deeper */
+static void od_entry_buffer(const cjson_od_value_t * const container, const size_t offset, parse_buffer * const buffer)
+{
+    od_buffer(container, offset, buffer);
+    buffer->depth++;
+}
+
+/* make value the entry of container at the offset of buffer */
+static void od_set_entry(cjson_od_value_t * const container, const parse_buffer * const buffer, cjson_od_value_t * const value)
+{
+    /* container and value may be the same to step into the entry */
+    container->cursor = buffer->offset;
+    value->document = container->document;
+    value->offset = buffer->offset;
+    value->cursor = 0;
+    value->depth = buffer->depth;
+}
+
+/* keep the first error of the document */
+static cjson_bool_t od_fail(const cjson_od_value_t * const value, const parse_buffer * const buffer)
+{
+    if (value->document->error.kind == CJSON_ERROR_NONE)
+    {
+        set_parse_error(buffer, &value->document->error);
+    }
+
+    return false;
+}
+
+/* after whitespace, the buffer has to be at the start of a value */
+static cjson_bool_t od_at_value(parse_buffer * const buffer)
+{
+    buffer_skip_whitespace(buffer);
+
+    return can_access_at_index(buffer, 0) && !is_delimiter(buffer_at_offset(buffer)[0]);
+}
+
+/* Move the buffer from the opening bracket (first) or the start of an entry to the start of the next entry, which is
+ * a key in objects and an element in arrays. found is false at the closing bracket. */
+static cjson_bool_t od_next_entry(parse_buffer * const buffer, const cjson_bool_t first, const unsigned char closing, cjson_bool_t * const found)
+{
+    *found = false;
+    if (first)
+    {
+        if (buffer->depth > CJSON_NESTING_LIMIT)
+        {
+            buffer->error = CJSON_ERROR_NESTING_LIMIT;
+            return false;
+        }
+        buffer->offset++;
+    }
+    else if (!skip_value(buffer))
+    {
+        return false;
+    }
+
+    buffer_skip_whitespace(buffer);
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return false;
+    }
+    if (buffer_at_offset(buffer)[0] == closing)
+    {
+        return true;
+    }
+    if (!first)
+    {
+        if (buffer_at_offset(buffer)[0] != ',')
+        {
+            return false;
+        }
+        buffer->offset++;
+    }
+    if (!od_at_value(buffer))
+    {
+        return false;
+    }
+
+    *found = true;
+    return true;
+}
+
+/* Read the key at the offset and compare it with key, then move on to the value. Escape sequences are only decoded
+ * if the keys match up to the first one. */
+static cjson_bool_t od_read_key(parse_buffer * const buffer, const char * const key, const size_t key_length, cjson_bool_t * const matches)
+{
+    const unsigned char *literal = buffer_at_offset(buffer) + 1;
+    const unsigned char *literal_end = NULL;
+    const unsigned char *first_escape = NULL;
+    size_t skipped_bytes = 0;
+
+    *matches = false;
+    if ((buffer_at_offset(buffer)[0] != '\"') || !scan_string(buffer, &literal_end, &first_escape, &skipped_bytes))
+    {
+        return false;
+    }
+
+    if (first_escape == NULL)
+    {
+        *matches = ((size_t)(literal_end - literal) == key_length) && (memcmp(literal, key, key_length) == 0);
+    }
+    else if ((key_length >= (size_t)(first_escape - literal)) && (memcmp(literal, key, (size_t)(first_escape - literal)) == 0))
+    {
+        /* unescaping never makes a string longer */
+        unsigned char small_key[256];
+        unsigned char *decoded = small_key;
+        unsigned char *decoded_end = NULL;
+        const unsigned char *input = literal;
+        const size_t size = (size_t)(literal_end - literal) - skipped_bytes;
+
+        if (size > sizeof(small_key))
+        {
+            decoded = (unsigned char*)parse_allocate(buffer, size);
+            if (decoded == NULL)
+            {
+                return false;
+            }
+        }
+        decoded_end = decoded;
+        if (unescape_string(&input, literal_end, &decoded_end))
+        {
+            *matches = ((size_t)(decoded_end - decoded) == key_length) && (memcmp(decoded, key, key_length) == 0);
+        }
+        else
+        {
+            buffer->offset = (size_t)(input - buffer->content);
+            buffer->error = CJSON_ERROR_INVALID_STRING;
+        }
+        if (decoded != small_key)
+        {
+            parse_deallocate(buffer, decoded);
+        }
+        if (buffer->error != CJSON_ERROR_NONE)
+        {
+            return false;
+        }
+    }
+
+    buffer->offset = (size_t)(literal_end - buffer->content) + 1;
+    buffer_skip_whitespace(buffer);
+    if (cannot_access_at_index(buffer, 0) || (buffer_at_offset(buffer)[0] != ':'))
+    {
+        return false;
+    }
+    buffer->offset++;
+
+    return od_at_value(buffer);
+}
+
+/* parse the number at value into a temporary item */
+static cjson_bool_t od_parse_number(const cjson_od_value_t * const value, cjson_t * const item)
+{
+    parse_buffer buffer;
+
+    memset(item, '\0', sizeof(*item));
+    if (cjson_od_type(value) != CJSON_NUMBER)
+    {
+        return false;
+    }
+
+    od_buffer(value, value->offset, &buffer);
+    if (!parse_number(item, &buffer))
+    {
+        return od_fail(value, &buffer);
+    }
+    if (can_access_at_index(&buffer, 0) && !is_delimiter(buffer_at_offset(&buffer)[0]))
+    {
+        /* garbage behind the number */
+        return od_fail(value, &buffer);
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_ondemand_init(cjson_ondemand_t *document, const char *text, size_t length, cjson_od_value_t *root)
+{
+    parse_buffer buffer;
+
+    if ((document == NULL) || (root == NULL))
+    {
+        return false;
+    }
+
+    document->text = text;
+    document->length = length;
+    document->error.kind = CJSON_ERROR_NONE;
+    document->error.offset = 0;
+    document->error.line = 0;
+    document->error.column = 0;
+    root->document = document;
+    root->offset = 0;
+    root->cursor = 0;
+    root->depth = 0;
+
+    if (text == NULL)
+    {
+        document->error.kind = CJSON_ERROR_INVALID_ARGUMENT;
+        return false;
+    }
+
+    od_buffer(root, 0, &buffer);
+    if (!od_at_value(skip_utf8_bom(&buffer)))
+    {
+        return od_fail(root, &buffer);
+    }
+    root->offset = buffer.offset;
+
+    return true;
+}
+
+CJSON_PUBLIC(int) cjson_od_type(const cjson_od_value_t *value)
+{
+    unsigned char character = 0;
+
+    if ((value == NULL) || (value->document == NULL) || (value->offset >= value->document->length))
+    {
+        return CJSON_INVALID;
+    }
+
+    character = (unsigned char)value->document->text[value->offset];
+    switch (character)
+    {
+        case '{':
+            return CJSON_OBJECT;
+        case '[':
+            return CJSON_ARRAY;
+        case '\"':
+            return CJSON_STRING;
+        case 't':
+            return CJSON_TRUE;
+        case 'f':
+            return CJSON_FALSE;
+        case 'n':
+            return CJSON_NULL;
+        default:
+            if ((character == '-') || ((character >= '0') && (character <= '9')))
+            {
+                return CJSON_NUMBER;
+            }
+            return CJSON_INVALID;
+    }
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_od_find_field(cjson_od_value_t *object, const char *key, cjson_od_value_t *value)
+{
+    parse_buffer buffer;
+    size_t key_length = 0;
+    size_t stop = 0; /* where the search that wrapped around started */
+    cjson_bool_t first = false;
+    cjson_bool_t found = false;
+    cjson_bool_t matches = false;
+
+    if ((key == NULL) || (value == NULL) || (cjson_od_type(object) != CJSON_OBJECT))
+    {
+        return false;
+    }
+
+    key_length = strlen(key);
+    first = (object->cursor == 0);
+    od_entry_buffer(object, first ? object->offset : object->cursor, &buffer);
+    for (;;)
+    {
+        if (!od_next_entry(&buffer, first, '}', &found))
+        {
+            return od_fail(object, &buffer);
+        }
+        if (!found)
+        {
+            if ((object->cursor == 0) || (stop != 0))
+            {
+                return false;
+            }
+            /* continue with the fields in front of the cursor */
+            stop = object->cursor;
+            od_entry_buffer(object, object->offset, &buffer);
+            first = true;
+            continue;
+        }
+        first = false;
+
+        if (!od_read_key(&buffer, key, key_length, &matches))
+        {
+            return od_fail(object, &buffer);
+        }
+        if (matches)
+        {
+            od_set_entry(object, &buffer, value);
+            return true;
+        }
+        if (buffer.offset == stop)
+        {
+            return false;
+        }
+    }
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_od_next_element(cjson_od_value_t *array, cjson_od_value_t *element)
+{
+    parse_buffer buffer;
+    cjson_bool_t found = false;
+
+    if ((element == NULL) || (cjson_od_type(array) != CJSON_ARRAY))
+    {
+        return false;
+    }
+
+    od_entry_buffer(array, (array->cursor == 0) ? array->offset : array->cursor, &buffer);
+    if (!od_next_entry(&buffer, array->cursor == 0, ']', &found))
+    {
+        return od_fail(array, &buffer);
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    od_set_entry(array, &buffer, element);
+
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_od_get_double(const cjson_od_value_t *value, double *number)
+{
+    cjson_t item;
+
+    if ((number == NULL) || !od_parse_number(value, &item))
+    {
+        return false;
+    }
+
+    *number = item.valuedouble;
+    return true;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_od_get_int64(const cjson_od_value_t *value, cjson_int64_t *number)
+{
+    cjson_t item;
+
+    if ((number == NULL) || !od_parse_number(value, &item))
+    {
+        return false;
+    }
+
+    return cjson_get_int64(&item, number);
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_od_parse(const cjson_od_value_t *value)
+{
+    parse_buffer buffer;
+    cjson_t *item = NULL;
+
+    if ((value == NULL) || (value->document == NULL))
+    {
+        return NULL;
+    }
+
+    od_buffer(value, value->offset, &buffer);
+    item = parse_new_item(&buffer);
+    if (item == NULL)
+    {
+        od_fail(value, &buffer);
+        return NULL;
+    }
+    if (!parse_value(item, &buffer))
+    {
+        parse_delete(&buffer, item);
+        od_fail(value, &buffer);
+        return NULL;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_skip_value(const char *text, size_t length, const char **end)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, false };
+    cjson_bool_t skipped = false;
+
+    if (text == NULL)
+    {
+        return false;
+    }
+
+    buffer.content = (const unsigned char*)text;
+    buffer.length = length;
+    buffer.hooks = global_hooks;
+
+    if (od_at_value(&buffer))
+    {
+        skipped = skip_value(&buffer);
+    }
+
+    if (end != NULL)
+    {
+        *end = text + buffer.offset;
+    }
+
+    return skipped;
+}
+
+static unsigned char *print(const cjson_t * const item, cjson_bool_t format, const internal_hooks * const hooks)
+{
+    printbuffer buffer[1];
+    unsigned char *printed = NULL;
+    size_t size = 0;
+
+    memset(buffer, 0, sizeof(buffer));
+
+    /* calculate the size first, so the output is allocated only once. Doubles are only
+     * estimated, converting them twice would cost more than the bytes this saves */
+    if (!size_value(item, 0, format, false, &size))
+    {
+        return NULL;
+    }
+
+    buffer->buffer = (unsigned char*) hooks->allocate(size + 1, hooks->user);
+    buffer->length = size + 1;
+    buffer->noalloc = true;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    if (buffer->buffer == NULL)
+    {
+        return NULL;
+    }
+
+    /* print the value */
+    if (!print_value(item, buffer))
+    {
+        hooks->deallocate(buffer->buffer, hooks->user);
+        return NULL;
+    }
+    buffer->buffer[buffer->offset] = '\0';
+
+    /* give back what the estimate left over, if that is possible in place */
+    if ((buffer->offset < size) && (hooks->reallocate != NULL))
+    {
+        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1, hooks->user);
+        if (printed != NULL)
+        {
+            return printed;
+        }
+    }
+
+    return buffer->buffer;
+}
+
+/* Render a cJSON item/entity/structure to text. */
+CJSON_PUBLIC(char *) cjson_print(const cjson_t *item)
+{
+    return (char*)print(item, true, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cjson_print_unformatted(const cjson_t *item)
+{
+    return (char*)print(item, false, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cjson_print_with_allocator(const cjson_t *item, cjson_bool_t format, const cjson_allocator_t *allocator)
+{
+    internal_hooks hooks;
+
+    if (!allocator_hooks(allocator, &hooks))
+    {
+        return NULL;
+    }
+
+    return (char*)print(item, format, &hooks);
+}
+
+CJSON_PUBLIC(char *) cjson_print_buffered(const cjson_t *item, int prebuffer, cjson_bool_t fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+
+    if (prebuffer < 0)
+    {
+        return NULL;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer, global_hooks.user);
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = (size_t)prebuffer;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer, global_hooks.user);
+        return NULL;
+    }
+    p.buffer[p.offset] = '\0';
+
+    return (char*)p.buffer;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_print_preallocated(cjson_t *item, char *buffer, const int length, const cjson_bool_t format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+
+    if ((length < 0) || (buffer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)buffer;
+    p.length = (size_t)length;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        return false;
+    }
+    p.buffer[p.offset] = '\0';
+
+    return true;
+}
+
+/* Parser core - when encountering text, process appropriately. */
+static cjson_bool_t parse_value(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false; /* no input */
+    }
+
+    /* parse the different types of values */
+    /* null */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        item->type = CJSON_NULL;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* false */
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        item->type = CJSON_FALSE;
+        input_buffer->offset += 5;
+        return true;
+    }
+    /* true */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        item->type = CJSON_TRUE;
+        item->valueint = 1;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* string */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        return input_buffer->views ? parse_string_view(item, input_buffer) : parse_string(item, input_buffer);
+    }
+    /* number */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        return parse_number(item, input_buffer);
+    }
+    /* array */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+    {
+        return parse_array(item, input_buffer);
+    }
+    /* object */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        return parse_object(item, input_buffer);
+    }
+
+    return false;
+}
+
+/* Render a value to text. */
+static cjson_bool_t print_value(const cjson_t * const item, printbuffer * const output_buffer)
+{
+    if ((item == NULL) || (output_buffer == NULL))
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case CJSON_NULL:
+            return append_bytes(output_buffer, (const unsigned char*)"null", 4);
+
+        case CJSON_FALSE:
+            return append_bytes(output_buffer, (const unsigned char*)"false", 5);
+
+        case CJSON_TRUE:
+            return append_bytes(output_buffer, (const unsigned char*)"true", 4);
+
+        case CJSON_NUMBER:
+            return print_number(item, output_buffer);
+
+        case CJSON_RAW:
+        {
+            size_t raw_length = 0;
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+
+            raw_length = strlen(item->valuestring);
+            return append_bytes(output_buffer, (const unsigned char*)item->valuestring, raw_length);
+        }
+
+        case CJSON_STRING:
+            return print_string(item, output_buffer);
+
+        case CJSON_ARRAY:
+            return print_array(item, output_buffer);
+
+        case CJSON_OBJECT:
+            return print_object(item, output_buffer);
+
+        default:
+            return false;
+    }
+}
+
+/* Build an array from input text. */
+static cjson_bool_t parse_array(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    cjson_t *head = NULL; /* head of the linked list */
+    cjson_t *current_item = NULL;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (buffer_at_offset(input_buffer)[0] != '[')
+    {
+        /* not an array */
+        goto fail;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    {
+        /* empty array */
+        goto success;
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cjson_t *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        new_item->parent = item;
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse next value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        mark_parsed_item(input_buffer, current_item);
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+    {
+        goto fail; /* expected end of array */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    item->type = CJSON_ARRAY;
+    item->child = head;
+
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        parse_delete(input_buffer, head);
+    }
+
+    return false;
+}
+
+/* Render an array to text */
+static cjson_bool_t print_array(const cjson_t * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cjson_t *current_element = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output array. */
+    /* opening square bracket */
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer = '[';
+    output_buffer->offset++;
+    output_buffer->depth++;
+
+    while (current_element != NULL)
+    {
+        if (!print_value(current_element, output_buffer))
+        {
+            return false;
+        }
+        if (current_element->next)
+        {
+            length = (size_t) (output_buffer->format ? 2 : 1);
+            if (!append_bytes(output_buffer, (const unsigned char*)", ", length))
+            {
+                return false;
+            }
+        }
+        current_element = current_element->next;
+    }
+
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer = ']';
+    output_buffer->offset++;
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Build an object from the text. */
+static cjson_bool_t parse_object(cjson_t * const item, parse_buffer * const input_buffer)
+{
+    cjson_t *head = NULL; /* linked list head */
+    cjson_t *current_item = NULL;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    {
+        goto fail; /* not an object */
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    {
+        goto success; /* empty object */
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cjson_t *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        new_item->parent = item;
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse the name of the child */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_string(current_item, input_buffer))
         {
-            local_error.position = buffer.offset;
+            goto fail; /* failed to parse name */
         }
-        else if (buffer.length > 0)
+        buffer_skip_whitespace(input_buffer);
+
+        /* swap valuestring and string, because we parsed the name */
+        current_item->string = current_item->valuestring;
+        current_item->valuestring = NULL;
+        /* hash the name while it is still in the cache */
+        hash_item_key(current_item);
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
-            local_error.position = buffer.length - 1;
+            goto fail; /* invalid object */
         }
 
-        if (return_parse_end != NULL)
+        /* parse the value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            goto fail; /* failed to parse value */
         }
-
-        global_error = local_error;
+        mark_parsed_item(input_buffer, current_item);
+        buffer_skip_whitespace(input_buffer);
     }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    return NULL;
-}
-
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cjson_t *) cjson_parse(const char *value)
-{
-    return cjson_parse_with_opts(value, 0, 0);
-}
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        goto fail; /* expected end of object */
+    }
 
-CJSON_PUBLIC(cjson_t *) cjson_parse_with_length(const char *value, size_t buffer_length)
-{
-    return cjson_parse_with_length_opts(value, buffer_length, 0, 0);
-}
+success:
+    input_buffer->depth--;
 
-#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+    if (head != NULL) {
+        head->prev = current_item;
+    }
 
-static unsigned char *print(const cjson_t * const item, cjson_bool_t format, const internal_hooks * const hooks)
-{
-    static const size_t default_buffer_size = 256;
-    printbuffer buffer[1];
-    unsigned char *printed = NULL;
+    item->type = CJSON_OBJECT;
+    item->child = head;
 
-    memset(buffer, 0, sizeof(buffer));
+    input_buffer->offset++;
+    return true;
 
-    /* create buffer */
-    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
-    buffer->length = default_buffer_size;
-    buffer->format = format;
-    buffer->hooks = *hooks;
-    if (buffer->buffer == NULL)
+fail:
+    if (head != NULL)
     {
-        goto fail;
+        parse_delete(input_buffer, head);
     }
 
-    /* print the value */
-    if (!print_value(item, buffer))
-    {
-        goto fail;
-    }
-    update_offset(buffer);
+    return false;
+}
 
-    /* check if reallocate is available */
-    if (hooks->reallocate != NULL)
+/* Does the reference token at token (behind its '/') name key? "~0" stands for '~' and "~1" for '/'. */
+static cjson_bool_t pointer_token_equals(const char *token, const unsigned char * const key, const size_t key_length)
+{
+    size_t i = 0;
+
+    for (; (*token != '\0') && (*token != '/'); token++, i++)
     {
-        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
-        if (printed == NULL) {
-            goto fail;
+        unsigned char character = (unsigned char)*token;
+        if (character == '~')
+        {
+            if ((token[1] != '0') && (token[1] != '1'))
+            {
+                return false;
+            }
+            token++;
+            character = (*token == '0') ? '~' : '/';
         }
-        buffer->buffer = NULL;
-    }
-    else /* otherwise copy the JSON over to a new buffer */
-    {
-        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
-        if (printed == NULL)
+        if ((i >= key_length) || (key[i] != character))
         {
-            goto fail;
+            return false;
         }
-        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
-        printed[buffer->offset] = '\0'; /* just to be sure */
-
-        /* free the buffer */
-        hooks->deallocate(buffer->buffer);
     }
 
-    return printed;
+    return i == key_length;
+}
 
-fail:
-    if (buffer->buffer != NULL)
+/* Does the reference token at token (behind its '/') name the array index? Leading zeros aren't allowed. */
+static cjson_bool_t pointer_token_is_index(const char *token, const size_t index)
+{
+    size_t value = 0;
+
+    if ((*token == '\0') || (*token == '/') || ((token[0] == '0') && (token[1] != '\0') && (token[1] != '/')))
     {
-        hooks->deallocate(buffer->buffer);
+        return false;
     }
-
-    if (printed != NULL)
+    for (; (*token != '\0') && (*token != '/'); token++)
     {
-        hooks->deallocate(printed);
+        if ((*token < '0') || (*token > '9') || (value > (index / 10)))
+        {
+            return false;
+        }
+        value = (value * 10) + (size_t)(*token - '0');
+        if (value > index)
+        {
+            return false;
+        }
     }
 
-    return NULL;
-}
-
-/* Render a cJSON item/entity/structure to text. */
-CJSON_PUBLIC(char *) cjson_print(const cjson_t *item)
-{
-    return (char*)print(item, true, &global_hooks);
-}
-
-CJSON_PUBLIC(char *) cjson_print_unformatted(const cjson_t *item)
-{
-    return (char*)print(item, false, &global_hooks);
+    return value == index;
 }
 
-CJSON_PUBLIC(char *) cjson_print_buffered(const cjson_t *item, int prebuffer, cjson_bool_t fmt)
+/* Is a path complete at this depth, so the value there is wanted in full? */
+static cjson_bool_t projection_complete(const path_projection * const projection, const size_t depth)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t i = 0;
 
-    if (prebuffer < 0)
+    for (i = 0; i < projection->count; i++)
     {
-        return NULL;
+        if ((projection->depths[i] == depth) && (projection->positions[i][0] == '\0'))
+        {
+            return true;
+        }
     }
 
-    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
-    if (!p.buffer)
-    {
-        return NULL;
-    }
+    return false;
+}
 
-    p.length = (size_t)prebuffer;
-    p.offset = 0;
-    p.noalloc = false;
-    p.format = fmt;
-    p.hooks = global_hooks;
+/* Follow the paths that matched down to depth into the member with the key (the element with the index if key is
+ * NULL). Returns false if none of them leads there. */
+static cjson_bool_t projection_descend(path_projection * const projection, const size_t depth, const unsigned char * const key, const size_t key_length, const size_t index)
+{
+    cjson_bool_t selected = false;
+    size_t i = 0;
 
-    if (!print_value(item, &p))
+    for (i = 0; i < projection->count; i++)
     {
-        global_hooks.deallocate(p.buffer);
-        return NULL;
+        const char *token = projection->positions[i] + 1;
+        if ((projection->depths[i] != depth) || (projection->positions[i][0] != '/'))
+        {
+            continue;
+        }
+        if ((key != NULL) ? pointer_token_equals(token, key, key_length) : pointer_token_is_index(token, index))
+        {
+            while ((*token != '\0') && (*token != '/'))
+            {
+                token++;
+            }
+            projection->positions[i] = token;
+            projection->depths[i] = depth + 1;
+            selected = true;
+        }
     }
 
-    return (char*)p.buffer;
+    return selected;
 }
 
-CJSON_PUBLIC(cjson_bool_t) cjson_print_preallocated(cjson_t *item, char *buffer, const int length, const cjson_bool_t format)
+/* undo projection_descend once the member is done */
+static void projection_ascend(path_projection * const projection, const size_t depth)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t i = 0;
 
-    if ((length < 0) || (buffer == NULL))
+    for (i = 0; i < projection->count; i++)
     {
-        return false;
+        if (projection->depths[i] > depth)
+        {
+            /* tokens can't contain a '/', so the previous one marks the start of the token that was followed */
+            const char *position = projection->positions[i] - 1;
+            while (*position != '/')
+            {
+                position--;
+            }
+            projection->positions[i] = position;
+            projection->depths[i] = depth;
+        }
     }
-
-    p.buffer = (unsigned char*)buffer;
-    p.length = (size_t)length;
-    p.offset = 0;
-    p.noalloc = true;
-    p.format = format;
-    p.hooks = global_hooks;
-
-    return print_value(item, &p);
 }
 
-/* Parser core - when encountering text, process appropriately. */
-static cjson_bool_t parse_value(cjson_t * const item, parse_buffer * const input_buffer)
+/* Build an object from the text, with only the members that are on one of the paths. */
+static cjson_bool_t project_object(cjson_t * const item, parse_buffer * const input_buffer, path_projection * const projection)
 {
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
-    {
-        return false; /* no input */
-    }
+    cjson_t *head = NULL; /* linked list head */
+    cjson_t *current_item = NULL;
 
-    /* parse the different types of values */
-    /* null */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
-    {
-        item->type = CJSON_NULL;
-        input_buffer->offset += 4;
-        return true;
-    }
-    /* false */
-    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
-    {
-        item->type = CJSON_FALSE;
-        input_buffer->offset += 5;
-        return true;
-    }
-    /* true */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
-    {
-        item->type = CJSON_TRUE;
-        item->valueint = 1;
-        input_buffer->offset += 4;
-        return true;
-    }
-    /* string */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
-    {
-        return parse_string(item, input_buffer);
-    }
-    /* number */
-    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
-    {
-        return parse_number(item, input_buffer);
-    }
-    /* array */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        return parse_array(item, input_buffer);
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
+        return false; /* to deeply nested */
     }
-    /* object */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    input_buffer->depth++;
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
     {
-        return parse_object(item, input_buffer);
+        goto success; /* empty object */
     }
 
-    return false;
-}
-
-/* Render a value to text. */
-static cjson_bool_t print_value(const cjson_t * const item, printbuffer * const output_buffer)
-{
-    unsigned char *output = NULL;
-
-    if ((item == NULL) || (output_buffer == NULL))
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
     {
-        return false;
+        input_buffer->offset--;
+        goto fail;
     }
 
-    switch ((item->type) & 0xFF)
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
     {
-        case CJSON_NULL:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
+        const unsigned char *key_end = NULL;
+        const unsigned char *first_escape = NULL;
+        size_t skipped_bytes = 0;
+        size_t key_offset = 0;
+        cjson_bool_t selected = false;
+
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        key_offset = input_buffer->offset;
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"') || !scan_string(input_buffer, &key_end, &first_escape, &skipped_bytes))
+        {
+            goto fail; /* failed to parse name */
+        }
+
+        if (first_escape == NULL)
+        {
+            const unsigned char *key = buffer_at_offset(input_buffer) + 1;
+            selected = projection_descend(projection, input_buffer->depth - 1, key, (size_t)(key_end - key), 0);
+        }
+        else
+        {
+            /* rare enough to decode the name just for the comparison */
+            cjson_t name;
+            memset(&name, '\0', sizeof(name));
+            if (!parse_string(&name, input_buffer))
             {
-                return false;
+                goto fail;
             }
-            strcpy((char*)output, "null");
-            return true;
+            selected = projection_descend(projection, input_buffer->depth - 1, (const unsigned char*)name.valuestring, strlen(name.valuestring), 0);
+            parse_deallocate(input_buffer, name.valuestring);
+            input_buffer->offset = key_offset;
+        }
 
-        case CJSON_FALSE:
-            output = ensure(output_buffer, 6);
-            if (output == NULL)
+        if (!selected)
+        {
+            input_buffer->offset = (size_t)(key_end - input_buffer->content) + 1;
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
             {
-                return false;
+                goto fail; /* invalid object */
             }
-            strcpy((char*)output, "false");
-            return true;
-
-        case CJSON_TRUE:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+            if (!skip_value(input_buffer))
             {
-                return false;
+                goto fail;
+            }
+        }
+        else
+        {
+            cjson_bool_t kept = false;
+            cjson_t *new_item = parse_new_item(input_buffer);
+            if (new_item == NULL)
+            {
+                goto fail; /* allocation failure */
             }
-            strcpy((char*)output, "true");
-            return true;
 
-        case CJSON_NUMBER:
-            return print_number(item, output_buffer);
+            if (!parse_string(new_item, input_buffer))
+            {
+                parse_delete(input_buffer, new_item);
+                goto fail;
+            }
+            new_item->string = new_item->valuestring;
+            new_item->valuestring = NULL;
+            hash_item_key(new_item);
 
-        case CJSON_RAW:
-        {
-            size_t raw_length = 0;
-            if (item->valuestring == NULL)
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
             {
-                return false;
+                parse_delete(input_buffer, new_item);
+                goto fail; /* invalid object */
+            }
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+            if (!project_value(new_item, input_buffer, projection, &kept))
+            {
+                parse_delete(input_buffer, new_item);
+                goto fail;
             }
+            projection_ascend(projection, input_buffer->depth - 1);
 
-            raw_length = strlen(item->valuestring) + sizeof("");
-            output = ensure(output_buffer, raw_length);
-            if (output == NULL)
+            if (!kept)
             {
-                return false;
+                parse_delete(input_buffer, new_item);
+            }
+            else
+            {
+                /* attach the item to the list */
+                new_item->parent = item;
+                if (head == NULL)
+                {
+                    current_item = head = new_item;
+                }
+                else
+                {
+                    current_item->next = new_item;
+                    new_item->prev = current_item;
+                    current_item = new_item;
+                }
             }
-            memcpy(output, item->valuestring, raw_length);
-            return true;
         }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-        case CJSON_STRING:
-            return print_string(item, output_buffer);
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        goto fail; /* expected end of object */
+    }
 
-        case CJSON_ARRAY:
-            return print_array(item, output_buffer);
+success:
+    input_buffer->depth--;
 
-        case CJSON_OBJECT:
-            return print_object(item, output_buffer);
+    if (head != NULL) {
+        head->prev = current_item;
+    }
 
-        default:
-            return false;
+    item->type = CJSON_OBJECT;
+    item->child = head;
+
+    input_buffer->offset++;
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        parse_delete(input_buffer, head);
     }
+
+    return false;
 }
 
-/* Build an array from input text. */
-static cjson_bool_t parse_array(cjson_t * const item, parse_buffer * const input_buffer)
+/* Build an array from the text, with only the elements that are on one of the paths. Elements skipped in front of one
+ * that is kept are replaced by null, so the indices stay the same. */
+static cjson_bool_t project_array(cjson_t * const item, parse_buffer * const input_buffer, path_projection * const projection)
 {
-    cjson_t *head = NULL; /* head of the linked list */
+    cjson_t *head = NULL; /* linked list head */
     cjson_t *current_item = NULL;
+    size_t count = 0;
+    size_t index = 0;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
+        input_buffer->error = CJSON_ERROR_NESTING_LIMIT;
         return false; /* to deeply nested */
     }
     input_buffer->depth++;
 
-    if (buffer_at_offset(input_buffer)[0] != '[')
-    {
-        /* not an array */
-        goto fail;
-    }
-
     input_buffer->offset++;
     buffer_skip_whitespace(input_buffer);
     if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
     {
-        /* empty array */
-        goto success;
+        goto success; /* empty array */
     }
 
     /* check if we skipped to the end of the buffer */
@@ -1472,36 +7464,67 @@ static cjson_bool_t parse_array(cjson_t * const item, parse_buffer * const input
 
     /* step back to character in front of the first element */
     input_buffer->offset--;
-    /* loop through the comma separated array elements */
     do
     {
-        /* allocate next item */
-        cjson_t *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
+        cjson_bool_t kept = false;
+        cjson_t *new_item = NULL;
 
-        /* attach next item to list */
-        if (head == NULL)
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!projection_descend(projection, input_buffer->depth - 1, NULL, 0, index))
         {
-            /* start the linked list */
-            current_item = head = new_item;
+            if (!skip_value(input_buffer))
+            {
+                goto fail;
+            }
         }
         else
         {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
+            new_item = parse_new_item(input_buffer);
+            if (new_item == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
+            if (!project_value(new_item, input_buffer, projection, &kept))
+            {
+                parse_delete(input_buffer, new_item);
+                goto fail;
+            }
+            projection_ascend(projection, input_buffer->depth - 1);
+            if (!kept)
+            {
+                parse_delete(input_buffer, new_item);
+            }
         }
+        index++;
 
-        /* parse next value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        /* fill in the elements in front of a kept one */
+        while (kept && (count < index))
         {
-            goto fail; /* failed to parse value */
+            cjson_t *element = new_item;
+            if (count < (index - 1))
+            {
+                element = parse_new_item(input_buffer);
+                if (element == NULL)
+                {
+                    parse_delete(input_buffer, new_item);
+                    goto fail; /* allocation failure */
+                }
+                element->type = CJSON_NULL;
+            }
+
+            element->parent = item;
+            if (head == NULL)
+            {
+                current_item = head = element;
+            }
+            else
+            {
+                current_item->next = element;
+                element->prev = current_item;
+                current_item = element;
+            }
+            count++;
         }
         buffer_skip_whitespace(input_buffer);
     }
@@ -1529,299 +7552,299 @@ success:
 fail:
     if (head != NULL)
     {
-        cjson_delete(head);
+        parse_delete(input_buffer, head);
     }
 
     return false;
 }
 
-/* Render an array to text */
-static cjson_bool_t print_array(const cjson_t * const item, printbuffer * const output_buffer)
+/* Build the parts of the value that are on the paths. kept is false if there are none, scalars are still parsed then. */
+static cjson_bool_t project_value(cjson_t * const item, parse_buffer * const input_buffer, path_projection * const projection, cjson_bool_t * const kept)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cjson_t *current_element = item->child;
-
-    if (output_buffer == NULL)
+    *kept = false;
+    if (cannot_access_at_index(input_buffer, 0))
     {
         return false;
     }
 
-    /* Compose the output array. */
-    /* opening square bracket */
-    output_pointer = ensure(output_buffer, 1);
-    if (output_pointer == NULL)
+    if (projection_complete(projection, input_buffer->depth))
     {
-        return false;
+        *kept = true;
+        return parse_value(item, input_buffer);
     }
 
-    *output_pointer = '[';
-    output_buffer->offset++;
-    output_buffer->depth++;
-
-    while (current_element != NULL)
+    switch (buffer_at_offset(input_buffer)[0])
     {
-        if (!print_value(current_element, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
-        if (current_element->next)
-        {
-            length = (size_t) (output_buffer->format ? 2 : 1);
-            output_pointer = ensure(output_buffer, length + 1);
-            if (output_pointer == NULL)
+        case '{':
+            if (!project_object(item, input_buffer, projection))
             {
                 return false;
             }
-            *output_pointer++ = ',';
-            if(output_buffer->format)
+            break;
+
+        case '[':
+            if (!project_array(item, input_buffer, projection))
             {
-                *output_pointer++ = ' ';
+                return false;
             }
-            *output_pointer = '\0';
-            output_buffer->offset += length;
-        }
-        current_element = current_element->next;
-    }
+            break;
 
-    output_pointer = ensure(output_buffer, 2);
-    if (output_pointer == NULL)
-    {
-        return false;
+        default:
+            /* the paths go further than the value does */
+            return parse_value(item, input_buffer);
     }
-    *output_pointer++ = ']';
-    *output_pointer = '\0';
-    output_buffer->depth--;
 
+    *kept = item->child != NULL;
     return true;
 }
 
-/* Build an object from the text. */
-static cjson_bool_t parse_object(cjson_t * const item, parse_buffer * const input_buffer)
+/* Render an object to text. */
+static cjson_bool_t print_object(const cjson_t * const item, printbuffer * const output_buffer)
 {
-    cjson_t *head = NULL; /* linked list head */
-    cjson_t *current_item = NULL;
-
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
-    {
-        return false; /* to deeply nested */
-    }
-    input_buffer->depth++;
-
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
-    {
-        goto fail; /* not an object */
-    }
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cjson_t *current_item = item->child;
 
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    if (output_buffer == NULL)
     {
-        goto success; /* empty object */
+        return false;
     }
 
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    /* Compose the output: */
+    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
+    if (!append_bytes(output_buffer, (const unsigned char*)"{\n", length))
     {
-        input_buffer->offset--;
-        goto fail;
+        return false;
     }
+    output_buffer->depth++;
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
+    while (current_item)
     {
-        /* allocate next item */
-        cjson_t *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
+        if (output_buffer->format && !append_repeated(output_buffer, '\t', output_buffer->depth))
         {
-            goto fail; /* allocation failure */
+            return false;
         }
 
-        /* attach next item to list */
-        if (head == NULL)
-        {
-            /* start the linked list */
-            current_item = head = new_item;
-        }
-        else
+        /* print key */
+        if (!print_string_ptr((unsigned char*)current_item->string, (current_item->string == NULL) ? 0 : strlen(current_item->string), output_buffer))
         {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
+            return false;
         }
 
-        /* parse the name of the child */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
+        length = (size_t) (output_buffer->format ? 2 : 1);
+        if (!append_bytes(output_buffer, (const unsigned char*)":\t", length))
         {
-            goto fail; /* failed to parse name */
+            return false;
         }
-        buffer_skip_whitespace(input_buffer);
-
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
 
-        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        /* print value */
+        if (!print_value(current_item, output_buffer))
         {
-            goto fail; /* invalid object */
+            return false;
         }
 
-        /* parse the value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        /* print comma if not last */
+        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
+        if (!append_bytes(output_buffer, (const unsigned char*)(current_item->next ? ",\n" : "\n"), length))
         {
-            goto fail; /* failed to parse value */
+            return false;
         }
-        buffer_skip_whitespace(input_buffer);
+
+        current_item = current_item->next;
     }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    /* fmt: tabs and } */
+    if (output_buffer->format && !append_repeated(output_buffer, '\t', output_buffer->depth - 1))
     {
-        goto fail; /* expected end of object */
+        return false;
+    }
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer = '}';
+    output_buffer->offset++;
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Calculate the length print_value produces for item, without printing it. This mirrors print_value,
+ * print_array and print_object. Without exact, the length of doubles is an upper bound. */
+static cjson_bool_t size_value(const cjson_t * const item, const size_t depth, const cjson_bool_t format, const cjson_bool_t exact, size_t * const size)
+{
+    const cjson_t *child = NULL;
+    size_t child_size = 0;
+
+    if (item == NULL)
+    {
+        return false;
     }
 
-success:
-    input_buffer->depth--;
+    switch ((item->type) & 0xFF)
+    {
+        case CJSON_NULL:
+        case CJSON_TRUE:
+            *size = 4;
+            return true;
+
+        case CJSON_FALSE:
+            *size = 5;
+            return true;
+
+        case CJSON_NUMBER:
+            return size_number(item, exact, size);
+
+        case CJSON_RAW:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            *size = strlen(item->valuestring);
+            return true;
+
+        case CJSON_STRING:
+            *size = (item->valuestring == NULL) ? 2 : (escaped_length((const unsigned char*)item->valuestring, value_length(item)) + 2);
+            return true;
+
+        case CJSON_ARRAY:
+            /* [ and ] with ", " or "," between the elements */
+            *size = 2;
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (!size_value(child, depth + 1, format, exact, &child_size))
+                {
+                    return false;
+                }
+                *size += child_size + ((child->next != NULL) ? (format ? 2 : 1) : 0);
+            }
+            return true;
 
-    if (head != NULL) {
-        head->prev = current_item;
-    }
+        case CJSON_OBJECT:
+            /* formatted: {\n, then per member depth + 1 tabs, key, :\t, value, optional comma and \n, depth tabs and } */
+            *size = format ? (2 + depth + 1) : 2;
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (!size_value(child, depth + 1, format, exact, &child_size))
+                {
+                    return false;
+                }
+                *size += child_size + ((child->next != NULL) ? 1 : 0);
+                *size += (child->string == NULL) ? 2 : (escaped_length((const unsigned char*)child->string, strlen(child->string)) + 2);
+                *size += format ? ((depth + 1) + 2 + 1) : 1;
+            }
+            return true;
 
-    item->type = CJSON_OBJECT;
-    item->child = head;
+        default:
+            return false;
+    }
+}
 
-    input_buffer->offset++;
-    return true;
+CJSON_PUBLIC(size_t) cjson_print_size(const cjson_t *item, cjson_bool_t format)
+{
+    size_t size = 0;
 
-fail:
-    if (head != NULL)
+    if (!size_value(item, 0, format, true, &size))
     {
-        cjson_delete(head);
+        return 0;
     }
 
-    return false;
+    return size;
 }
 
-/* Render an object to text. */
-static cjson_bool_t print_object(const cjson_t * const item, printbuffer * const output_buffer)
+CJSON_PUBLIC(cjson_bool_t) cjson_print_to_writer(const cjson_t *item, cjson_bool_t format, cjson_write_fn write_fn, void *user, size_t chunk_size)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cjson_t *current_item = item->child;
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    cjson_bool_t success = false;
 
-    if (output_buffer == NULL)
+    if ((item == NULL) || (write_fn == NULL))
     {
         return false;
     }
 
-    /* Compose the output: */
-    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
-    output_pointer = ensure(output_buffer, length + 1);
-    if (output_pointer == NULL)
+    if (chunk_size == 0)
     {
-        return false;
+        chunk_size = 4096;
     }
-
-    *output_pointer++ = '{';
-    output_buffer->depth++;
-    if (output_buffer->format)
+    else if (chunk_size < 2)
     {
-        *output_pointer++ = '\n';
+        /* one byte of output and the terminator */
+        chunk_size = 2;
     }
-    output_buffer->offset += length;
 
-    while (current_item)
+    p.buffer = (unsigned char*)global_hooks.allocate(chunk_size, global_hooks.user);
+    if (p.buffer == NULL)
     {
-        if (output_buffer->format)
-        {
-            size_t i;
-            output_pointer = ensure(output_buffer, output_buffer->depth);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            for (i = 0; i < output_buffer->depth; i++)
-            {
-                *output_pointer++ = '\t';
-            }
-            output_buffer->offset += output_buffer->depth;
-        }
+        return false;
+    }
+    p.length = chunk_size;
+    p.format = format;
+    p.hooks = global_hooks;
+    p.write_fn = write_fn;
+    p.user = user;
 
-        /* print key */
-        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
+    success = print_value(item, &p) && flush_printbuffer(&p);
 
-        length = (size_t) (output_buffer->format ? 2 : 1);
-        output_pointer = ensure(output_buffer, length);
-        if (output_pointer == NULL)
-        {
-            return false;
-        }
-        *output_pointer++ = ':';
-        if (output_buffer->format)
-        {
-            *output_pointer++ = '\t';
-        }
-        output_buffer->offset += length;
+    if (p.buffer != NULL)
+    {
+        p.hooks.deallocate(p.buffer, p.hooks.user);
+    }
 
-        /* print value */
-        if (!print_value(current_item, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
+    return success;
+}
 
-        /* print comma if not last */
-        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
-        output_pointer = ensure(output_buffer, length + 1);
-        if (output_pointer == NULL)
-        {
-            return false;
-        }
-        if (current_item->next)
-        {
-            *output_pointer++ = ',';
-        }
+CJSON_PUBLIC(size_t) cjson_write_to_file(const char *data, size_t length, void *user)
+{
+    if ((data == NULL) || (user == NULL))
+    {
+        return 0;
+    }
 
-        if (output_buffer->format)
-        {
-            *output_pointer++ = '\n';
-        }
-        *output_pointer = '\0';
-        output_buffer->offset += length;
+    return fwrite(data, 1, length, (FILE*)user);
+}
 
-        current_item = current_item->next;
-    }
+CJSON_PUBLIC(size_t) cjson_write_to_fd(const char *data, size_t length, void *user)
+{
+#if defined(CJSON_FD_WRITE_WIN32) || defined(CJSON_FD_WRITE_POSIX)
+    size_t written = 0;
 
-    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
-    if (output_pointer == NULL)
+    if ((data == NULL) || (user == NULL))
     {
-        return false;
+        return 0;
     }
-    if (output_buffer->format)
+
+    while (written < length)
     {
-        size_t i;
-        for (i = 0; i < (output_buffer->depth - 1); i++)
+#ifdef CJSON_FD_WRITE_WIN32
+        unsigned int piece = ((length - written) > INT_MAX) ? (unsigned int)INT_MAX : (unsigned int)(length - written);
+        int result = _write(*(const int*)user, data + written, piece);
+        if (result <= 0)
+        {
+            break;
+        }
+#else
+        ssize_t result = write(*(const int*)user, data + written, length - written);
+        if ((result < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (result <= 0)
         {
-            *output_pointer++ = '\t';
+            break;
         }
+#endif
+        written += (size_t)result;
     }
-    *output_pointer++ = '}';
-    *output_pointer = '\0';
-    output_buffer->depth--;
 
-    return true;
+    return written;
+#else
+    /* no file descriptors on this platform */
+    (void)data;
+    (void)length;
+    (void)user;
+    return 0;
+#endif
 }
 
 /* Get Array size/item / object item. */
@@ -1835,6 +7858,11 @@ CJSON_PUBLIC(int) cjson_get_array_size(const cjson_t *array)
         return 0;
     }
 
+    if (has_lookup_table(array->index))
+    {
+        return (int)array->index->count;
+    }
+
     child = array->child;
 
     while(child != NULL)
@@ -1857,6 +7885,12 @@ static cjson_t* get_array_item(const cjson_t *array, size_t index)
         return NULL;
     }
 
+    if ((array->index != NULL) && (array->index->items != NULL))
+    {
+        const cjson_index_t * const vector = array->index;
+        return (index < vector->count) ? vector->items[vector->first + index] : NULL;
+    }
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
@@ -1886,6 +7920,11 @@ static cjson_t *get_object_item(const cjson_t * const object, const char * const
         return NULL;
     }
 
+    if ((object->index != NULL) && (object->index->slots != NULL))
+    {
+        return index_lookup(object->index, name, key_hash((const unsigned char*)name), case_sensitive);
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -1919,6 +7958,108 @@ CJSON_PUBLIC(cjson_t *) cjson_get_object_item_case_sensitive(const cjson_t * con
     return get_object_item(object, string, true);
 }
 
+CJSON_PUBLIC(cjson_key_t) cjson_key_make(const char *string)
+{
+    cjson_key_t key = { NULL, 0, 0 };
+
+    if (string != NULL)
+    {
+        key.string = string;
+        key.length = strlen(string);
+        key.hash = key_hash((const unsigned char*)string);
+    }
+
+    return key;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_get_object_item_by_key(const cjson_t * const object, const cjson_key_t key)
+{
+    cjson_t *current_element = NULL;
+
+    if ((object == NULL) || (key.string == NULL))
+    {
+        return NULL;
+    }
+
+    if ((object->index != NULL) && (object->index->slots != NULL))
+    {
+        return index_lookup(object->index, key.string, key.hash, true);
+    }
+
+    for (current_element = object->child; current_element != NULL; current_element = current_element->next)
+    {
+        /* a different hash rules the key out without reading it */
+        if (((current_element->string_hash == key.hash) || (current_element->string_hash == 0))
+            && (current_element->string != NULL) && (strcmp(current_element->string, key.string) == 0))
+        {
+            return current_element;
+        }
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_object_build_index(cjson_t *object)
+{
+    if ((object == NULL) || !cjson_is_object(object) || (object->type & (CJSON_IS_REFERENCE | CJSON_IN_ARENA)))
+    {
+        return false;
+    }
+
+    return build_object_index(object, (object->index != NULL) ? &object->index->hooks : &global_hooks, NULL);
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_array_build_index(cjson_t *array)
+{
+    if ((array == NULL) || !cjson_is_array(array) || (array->type & (CJSON_IS_REFERENCE | CJSON_IN_ARENA)))
+    {
+        return false;
+    }
+
+    return build_array_index(array, (array->index != NULL) ? &array->index->hooks : &global_hooks, NULL);
+}
+
+/* index the arrays and objects below and including item that are past the thresholds */
+static cjson_bool_t build_indexes(cjson_t * const item)
+{
+    cjson_bool_t built = true;
+    cjson_t *child = NULL;
+    size_t count = 0;
+    size_t threshold = 0;
+
+    if (!(cjson_is_array(item) || cjson_is_object(item)) || (item->type & CJSON_IS_REFERENCE))
+    {
+        return true;
+    }
+
+    for (child = item->child; child != NULL; child = child->next)
+    {
+        count++;
+        if (!build_indexes(child))
+        {
+            built = false;
+        }
+    }
+
+    threshold = cjson_is_array(item) ? CJSON_ARRAY_INDEX_THRESHOLD : CJSON_OBJECT_INDEX_THRESHOLD;
+    if ((count <= threshold) || has_lookup_table(item->index))
+    {
+        return built;
+    }
+
+    return build_index(item, (item->index != NULL) ? &item->index->hooks : &global_hooks, (item->type & CJSON_IN_ARENA) ? ((arena_item*)item)->arena : NULL) && built;
+}
+
+CJSON_PUBLIC(cjson_bool_t) cjson_build_indexes(cjson_t *item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return build_indexes(item);
+}
+
 CJSON_PUBLIC(cjson_bool_t) cjson_has_object_item(const cjson_t *object, const char *string)
 {
     return cjson_get_object_item(object, string) ? 1 : 0;
@@ -1948,7 +8089,11 @@ static cjson_t *create_reference(const cjson_t *item, const internal_hooks * con
 
     memcpy(reference, item, sizeof(cjson_t));
     reference->string = NULL;
-    reference->type |= CJSON_IS_REFERENCE;
+    reference->string_hash = 0;
+    /* the index stays with the original */
+    reference->index = NULL;
+    reference->parent = NULL;
+    reference->type = (reference->type | CJSON_IS_REFERENCE) & ~CJSON_IN_ARENA;
     reference->next = reference->prev = NULL;
     return reference;
 }
@@ -1961,6 +8106,9 @@ static cjson_bool_t add_item_to_array(cjson_t *array, cjson_t *item)
     {
         return false;
     }
+    hash_item_key(item);
+    item->parent = array;
+    invalidate_digests(array);
 
     child = array->child;
     /*
@@ -1983,6 +8131,33 @@ static cjson_bool_t add_item_to_array(cjson_t *array, cjson_t *item)
         }
     }
 
+    if (has_lookup_table(array->index))
+    {
+        if (array->index->items != NULL)
+        {
+            array_index_insert(array, array->index->count, item);
+        }
+        else
+        {
+            index_append(array, item);
+        }
+    }
+    else if ((cjson_is_array(array) || cjson_is_object(array)) && !(array->type & (CJSON_IS_REFERENCE | CJSON_IN_ARENA)))
+    {
+        /* index arrays and objects once they grow past the threshold, only counting as far as that */
+        const size_t threshold = cjson_is_array(array) ? CJSON_ARRAY_INDEX_THRESHOLD : CJSON_OBJECT_INDEX_THRESHOLD;
+        size_t count = 0;
+        for (child = array->child; (child != NULL) && (count <= threshold + 1); child = child->next)
+        {
+            count++;
+        }
+        if (count == threshold + 1)
+        {
+            /* fails for members without a key, those objects are searched like lists */
+            build_index(array, &global_hooks, NULL);
+        }
+    }
+
     return true;
 }
 
@@ -2036,7 +8211,7 @@ static cjson_bool_t add_item_to_object(cjson_t * const object, const char * cons
 
     if (!(item->type & CJSON_STRING_IS_CONST) && (item->string != NULL))
     {
-        hooks->deallocate(item->string);
+        hooks->deallocate(item->string, hooks->user);
     }
 
     item->string = new_key;
@@ -2186,10 +8361,27 @@ CJSON_PUBLIC(cjson_t*) cjson_add_array_to_object(cjson_t * const object, const c
 
 CJSON_PUBLIC(cjson_t *) cjson_detach_item_via_pointer(cjson_t *parent, cjson_t * const item)
 {
+    cjson_bool_t refill_vector = false;
+
     if ((parent == NULL) || (item == NULL))
     {
         return NULL;
     }
+    invalidate_digests(parent);
+
+    if ((parent->index != NULL) && (parent->index->items != NULL))
+    {
+        refill_vector = !array_index_remove(parent->index, item);
+    }
+    else if ((parent->index != NULL) && (parent->index->slots != NULL))
+    {
+        index_slot *slot = index_find_item(parent->index, item);
+        if (slot != NULL)
+        {
+            slot->item = &removed_index_item;
+            parent->index->count--;
+        }
+    }
 
     if (item != parent->child)
     {
@@ -2216,6 +8408,13 @@ CJSON_PUBLIC(cjson_t *) cjson_detach_item_via_pointer(cjson_t *parent, cjson_t *
     /* make sure the detached item doesn't point anywhere anymore */
     item->prev = NULL;
     item->next = NULL;
+    item->parent = NULL;
+
+    /* lookups only read the vector, so it is never left behind the list */
+    if (refill_vector)
+    {
+        array_index_refill(parent->index, parent->child);
+    }
 
     return item;
 }
@@ -2274,6 +8473,9 @@ CJSON_PUBLIC(cjson_bool_t) cjson_insert_item_in_array(cjson_t *array, int which,
     {
         return add_item_to_array(array, newitem);
     }
+    hash_item_key(newitem);
+    newitem->parent = array;
+    invalidate_digests(array);
 
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
@@ -2286,11 +8488,24 @@ CJSON_PUBLIC(cjson_bool_t) cjson_insert_item_in_array(cjson_t *array, int which,
     {
         newitem->prev->next = newitem;
     }
+
+    if ((array->index != NULL) && (array->index->items != NULL))
+    {
+        array_index_insert(array, (size_t)which, newitem);
+    }
+    else if ((array->index != NULL) && (array->index->slots != NULL))
+    {
+        /* the order of members with the same key may have changed */
+        rebuild_index(array);
+    }
     return true;
 }
 
 CJSON_PUBLIC(cjson_bool_t) cjson_replace_item_via_pointer(cjson_t * const parent, cjson_t * const item, cjson_t * replacement)
 {
+    cjson_bool_t index_outdated = false;
+    cjson_bool_t refill_vector = false;
+
     if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
     {
         return false;
@@ -2300,6 +8515,27 @@ CJSON_PUBLIC(cjson_bool_t) cjson_replace_item_via_pointer(cjson_t * const parent
     {
         return true;
     }
+    hash_item_key(replacement);
+    replacement->parent = parent;
+    invalidate_digests(parent);
+
+    if ((parent->index != NULL) && (parent->index->items != NULL))
+    {
+        refill_vector = !array_index_replace(parent->index, item, replacement);
+    }
+    else if ((parent->index != NULL) && (parent->index->slots != NULL))
+    {
+        /* a replacement with a key of the same hash takes over the slot, which keeps the order */
+        index_slot *slot = index_find_item(parent->index, item);
+        if ((slot != NULL) && (replacement->string != NULL) && (replacement->string_hash == slot->hash))
+        {
+            slot->item = replacement;
+        }
+        else
+        {
+            index_outdated = true;
+        }
+    }
 
     replacement->next = item->next;
     replacement->prev = item->prev;
@@ -2331,6 +8567,15 @@ CJSON_PUBLIC(cjson_bool_t) cjson_replace_item_via_pointer(cjson_t * const parent
         }
     }
 
+    if (index_outdated)
+    {
+        rebuild_index(parent);
+    }
+    else if (refill_vector)
+    {
+        array_index_refill(parent->index, parent->child);
+    }
+
     item->next = NULL;
     item->prev = NULL;
     cjson_delete(item);
@@ -2426,32 +8671,63 @@ CJSON_PUBLIC(cjson_t *) cjson_create_bool(cjson_bool_t boolean)
     return item;
 }
 
-CJSON_PUBLIC(cjson_t *) cjson_create_number(double num)
+CJSON_PUBLIC(cjson_t *) cjson_create_number(double num)
+{
+    cjson_t *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = CJSON_NUMBER;
+        item->valuedouble = num;
+
+        /* use saturation in case of overflow */
+        if (num >= INT_MAX)
+        {
+            item->valueint = INT_MAX;
+        }
+        else if (num <= (double)INT_MIN)
+        {
+            item->valueint = INT_MIN;
+        }
+        else
+        {
+            item->valueint = (int)num;
+        }
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cjson_t *) cjson_create_int64(cjson_int64_t num)
 {
     cjson_t *item = cJSON_New_Item(&global_hooks);
     if(item)
     {
         item->type = CJSON_NUMBER;
-        item->valuedouble = num;
-
-        /* use saturation in case of overflow */
-        if (num >= INT_MAX)
-        {
-            item->valueint = INT_MAX;
-        }
-        else if (num <= (double)INT_MIN)
+        if (num < 0)
         {
-            item->valueint = INT_MIN;
+            set_integer_value(item, (cjson_uint64_t)(-(num + 1)) + 1, true);
         }
         else
         {
-            item->valueint = (int)num;
+            set_integer_value(item, (cjson_uint64_t)num, false);
         }
     }
 
     return item;
 }
 
+CJSON_PUBLIC(cjson_t *) cjson_create_uint64(cjson_uint64_t num)
+{
+    cjson_t *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = CJSON_NUMBER;
+        set_integer_value(item, num, false);
+    }
+
+    return item;
+}
+
 CJSON_PUBLIC(cjson_t *) cjson_create_string(const char *string)
 {
     cjson_t *item = cJSON_New_Item(&global_hooks);
@@ -2564,6 +8840,7 @@ CJSON_PUBLIC(cjson_t *) cjson_create_int_array(const int *numbers, int count)
             cjson_delete(a);
             return NULL;
         }
+        n->parent = a;
         if(!i)
         {
             a->child = n;
@@ -2578,6 +8855,10 @@ CJSON_PUBLIC(cjson_t *) cjson_create_int_array(const int *numbers, int count)
     if (a && a->child) {
         a->child->prev = n;
     }
+    if (a && (count > CJSON_ARRAY_INDEX_THRESHOLD))
+    {
+        build_array_index(a, &global_hooks, NULL);
+    }
 
     return a;
 }
@@ -2604,6 +8885,7 @@ CJSON_PUBLIC(cjson_t *) cjson_create_float_array(const float *numbers, int count
             cjson_delete(a);
             return NULL;
         }
+        n->parent = a;
         if(!i)
         {
             a->child = n;
@@ -2618,6 +8900,10 @@ CJSON_PUBLIC(cjson_t *) cjson_create_float_array(const float *numbers, int count
     if (a && a->child) {
         a->child->prev = n;
     }
+    if (a && (count > CJSON_ARRAY_INDEX_THRESHOLD))
+    {
+        build_array_index(a, &global_hooks, NULL);
+    }
 
     return a;
 }
@@ -2644,6 +8930,7 @@ CJSON_PUBLIC(cjson_t *) cjson_create_double_array(const double *numbers, int cou
             cjson_delete(a);
             return NULL;
         }
+        n->parent = a;
         if(!i)
         {
             a->child = n;
@@ -2658,6 +8945,10 @@ CJSON_PUBLIC(cjson_t *) cjson_create_double_array(const double *numbers, int cou
     if (a && a->child) {
         a->child->prev = n;
     }
+    if (a && (count > CJSON_ARRAY_INDEX_THRESHOLD))
+    {
+        build_array_index(a, &global_hooks, NULL);
+    }
 
     return a;
 }
@@ -2684,6 +8975,7 @@ CJSON_PUBLIC(cjson_t *) cjson_create_string_array(const char *const *strings, in
             cjson_delete(a);
             return NULL;
         }
+        n->parent = a;
         if(!i)
         {
             a->child = n;
@@ -2698,6 +8990,10 @@ CJSON_PUBLIC(cjson_t *) cjson_create_string_array(const char *const *strings, in
     if (a && a->child) {
         a->child->prev = n;
     }
+    if (a && (count > CJSON_ARRAY_INDEX_THRESHOLD))
+    {
+        build_array_index(a, &global_hooks, NULL);
+    }
 
     return a;
 }
@@ -2722,10 +9018,28 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~CJSON_IS_REFERENCE);
+    newitem->type = item->type & (~(CJSON_IS_REFERENCE | CJSON_IN_ARENA | CJSON_IN_SITU | CJSON_STRING_IS_VIEW));
+    if (item->type & (CJSON_IN_ARENA | CJSON_IN_SITU))
+    {
+        /* keys of arena and in situ items only live as long as the arena or the buffer */
+        newitem->type &= ~CJSON_STRING_IS_CONST;
+    }
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
-    if (item->valuestring)
+    newitem->valueint64 = item->valueint64;
+    newitem->string_hash = item->string_hash;
+    if (item->type & CJSON_STRING_IS_VIEW)
+    {
+        /* the copy of a view is an ordinary string */
+        newitem->valuestring = (char*)global_hooks.allocate(item->valuestring_length + sizeof(""), global_hooks.user);
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
+        memcpy(newitem->valuestring, item->valuestring, item->valuestring_length);
+        newitem->valuestring[item->valuestring_length] = '\0';
+    }
+    else if (item->valuestring)
     {
         newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
         if (!newitem->valuestring)
@@ -2735,7 +9049,7 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
     }
     if (item->string)
     {
-        newitem->string = (item->type & CJSON_STRING_IS_CONST) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        newitem->string = (newitem->type & CJSON_STRING_IS_CONST) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
         if (!newitem->string)
         {
             goto fail;
@@ -2758,6 +9072,7 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
         if (next != NULL)
         {
             /* If newitem->child already set, then crosswire ->prev and ->next and move on */
+            newchild->parent = newitem;
             next->next = newchild;
             newchild->prev = next;
             next = newchild;
@@ -2765,6 +9080,7 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
         else
         {
             /* Set newitem->child and move to it */
+            newchild->parent = newitem;
             newitem->child = newchild;
             next = newchild;
         }
@@ -2774,6 +9090,15 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
     {
         newitem->child->prev = newchild;
     }
+    if (has_lookup_table(item->index))
+    {
+        build_index(newitem, &global_hooks, NULL);
+    }
+    /* the copy of a whole subtree has the same digest */
+    if (cached_digest(item) != NULL)
+    {
+        cache_digest(newitem, *cached_digest(item));
+    }
 
     return newitem;
 
@@ -2983,6 +9308,358 @@ CJSON_PUBLIC(cjson_bool_t) cjson_is_raw(const cjson_t * const item)
     return (item->type & 0xFF) == CJSON_RAW;
 }
 
+/* number of children, without walking them if the item has an index */
+static size_t count_children(const cjson_t * const item)
+{
+    const cjson_t *child = NULL;
+    size_t count = 0;
+
+    if (has_lookup_table(item->index))
+    {
+        return item->index->count;
+    }
+
+    for (child = item->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/* the member of object that a lookup of the key of item finds, through index if it isn't NULL */
+static cjson_t *find_member(const cjson_t * const object, const cjson_index_t * const index, const cjson_t * const item, const cjson_bool_t case_sensitive)
+{
+    if (item->string == NULL)
+    {
+        return NULL;
+    }
+    if (index != NULL)
+    {
+        return index_lookup(index, item->string, item_key_hash(item), case_sensitive);
+    }
+
+    return get_object_item(object, item->string, case_sensitive);
+}
+
+/* Objects are equal if looking up the key of every member of one of them in the other one finds an equal member.
+ * Large objects without an index get a temporary one, which keeps this O(n) without modifying them. */
+static cjson_bool_t compare_objects(const cjson_t * const a, const cjson_t * const b, const cjson_bool_t case_sensitive)
+{
+    const cjson_index_t *a_index = ((a->index != NULL) && (a->index->slots != NULL)) ? a->index : NULL;
+    const cjson_index_t *b_index = ((b->index != NULL) && (b->index->slots != NULL)) ? b->index : NULL;
+    cjson_index_t *a_temporary = NULL;
+    cjson_index_t *b_temporary = NULL;
+    const size_t count = count_children(a);
+    cjson_t *a_element = NULL;
+    cjson_t *b_element = NULL;
+    cjson_bool_t equal = true;
+
+    if (count != count_children(b))
+    {
+        return false;
+    }
+
+    if (count > CJSON_OBJECT_INDEX_THRESHOLD)
+    {
+        /* if this fails (out of memory, members without a key) the members are searched linearly */
+        if (a_index == NULL)
+        {
+            a_index = a_temporary = create_object_index(a, &global_hooks, NULL);
+        }
+        if (b_index == NULL)
+        {
+            b_index = b_temporary = create_object_index(b, &global_hooks, NULL);
+        }
+    }
+
+    CJSON_ARRAY_FOREACH(a_element, a)
+    {
+        b_element = find_member(b, b_index, a_element, case_sensitive);
+        if ((b_element == NULL) || !cjson_compare(a_element, b_element, case_sensitive))
+        {
+            equal = false;
+            break;
+        }
+    }
+
+    /* the other way around as well, or a could be a subset of b when it has duplicate keys. Pairs that
+     * have been compared above are skipped, which is all of them unless keys are duplicated. */
+    if (equal)
+    {
+        CJSON_ARRAY_FOREACH(b_element, b)
+        {
+            a_element = find_member(a, a_index, b_element, case_sensitive);
+            if ((a_element == NULL)
+                || ((find_member(b, b_index, a_element, case_sensitive) != b_element) && !cjson_compare(b_element, a_element, case_sensitive)))
+            {
+                equal = false;
+                break;
+            }
+        }
+    }
+
+    delete_index(a_temporary);
+    delete_index(b_temporary);
+
+    return equal;
+}
+
+/* Structural hashing. Every item is hashed into two 64 bit lanes. Array elements are chained in order, object
+ * members are hashed with their (lower case) key and summed up, which makes their order irrelevant.
+ * Cached digests use two bits for bookkeeping: the lowest bit of low is always set, so a cached digest is never
+ * all zero, and the lowest bit of high tells whether the digest is exact. Exact digests are equal for all items
+ * that cjson_compare considers equal, so different exact digests mean different items. */
+#define DIGEST_APPROXIMATE 1 /* cjson_compare may find items with another digest equal */
+#define DIGEST_UNCACHEABLE 2 /* contains references, which can change without their parents noticing */
+
+static cjson_uint64_t mix_bits(cjson_uint64_t bits)
+{
+    bits ^= bits >> 33;
+    bits *= uint64_constant(0xff51afd7, 0xed558ccd);
+    bits ^= bits >> 33;
+    bits *= uint64_constant(0xc4ceb9fe, 0x1a85ec53);
+    bits ^= bits >> 33;
+
+    return bits;
+}
+
+/* add a 64 bit word to both lanes */
+static void digest_add_word(cjson_digest_t * const digest, const cjson_uint64_t word)
+{
+    const cjson_uint64_t mixed = mix_bits(word);
+
+    digest->low ^= mixed;
+    digest->low = ((digest->low << 27) | (digest->low >> 37)) * 5 + 0x52dce729;
+    digest->high += mixed ^ uint64_constant(0x9e3779b9, 0x7f4a7c15);
+    digest->high = ((digest->high << 31) | (digest->high >> 33)) * 9 + 0x38495ab5;
+}
+
+static void digest_finish(cjson_digest_t * const digest, const size_t length)
+{
+    digest->low = mix_bits(digest->low ^ (cjson_uint64_t)length);
+    digest->high = mix_bits(digest->high ^ digest->low);
+}
+
+static cjson_digest_t digest_start(const int type)
+{
+    cjson_digest_t digest;
+
+    digest.low = uint64_constant(0x87c37b91, 0x114253d5) ^ (cjson_uint64_t)type;
+    digest.high = uint64_constant(0x4cf5ad43, 0x2745937f) + (cjson_uint64_t)type;
+
+    return digest;
+}
+
+/* hash bytes eight at a time, lower case if fold_case is set */
+static void digest_add_bytes(cjson_digest_t * const digest, const unsigned char *bytes, const size_t length, const cjson_bool_t fold_case)
+{
+    size_t offset = 0;
+
+    while (offset < length)
+    {
+        cjson_uint64_t word = 0;
+        size_t i = 0;
+        for (i = 0; (i < 8) && (offset < length); i++, offset++)
+        {
+            const unsigned char character = fold_case ? (unsigned char)tolower(bytes[offset]) : bytes[offset];
+            word |= (cjson_uint64_t)character << (8 * i);
+        }
+        digest_add_word(digest, word);
+    }
+    digest_finish(digest, length);
+}
+
+static cjson_digest_t key_digest(const char * const key)
+{
+    cjson_digest_t digest = digest_start(0);
+
+    if (key != NULL)
+    {
+        digest_add_bytes(&digest, (const unsigned char*)key, strlen(key), true);
+    }
+
+    return digest;
+}
+
+/* check whether an object has members whose keys only differ in case, or might */
+static cjson_bool_t has_duplicate_keys(const cjson_t * const object, const size_t count)
+{
+    const cjson_t *member = NULL;
+    const cjson_t *other = NULL;
+
+    if (count <= CJSON_OBJECT_INDEX_THRESHOLD)
+    {
+        for (member = object->child; member != NULL; member = member->next)
+        {
+            for (other = member->next; other != NULL; other = other->next)
+            {
+                if ((member->string == NULL) || (other->string == NULL) || (case_insensitive_strcmp((const unsigned char*)member->string, (const unsigned char*)other->string) == 0))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    if ((object->index == NULL) || (object->index->slots == NULL))
+    {
+        /* not worth a temporary index */
+        return true;
+    }
+    for (member = object->child; member != NULL; member = member->next)
+    {
+        if (find_member(object, object->index, member, false) != member)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static cjson_digest_t hash_item(cjson_t * const item, const int flags, unsigned int * const state);
+
+static cjson_digest_t hash_children(cjson_t * const item, const int flags, unsigned int * const state)
+{
+    cjson_digest_t digest = digest_start(item->type & 0xFF);
+    cjson_digest_t sum = { 0, 0 };
+    cjson_t *child = NULL;
+    size_t count = 0;
+
+    for (child = item->child; child != NULL; child = child->next)
+    {
+        cjson_digest_t child_digest = hash_item(child, flags, state);
+        if (cjson_is_object(item))
+        {
+            const cjson_digest_t key = key_digest(child->string);
+            sum.low += mix_bits(key.low ^ child_digest.low);
+            sum.high += mix_bits(key.high + child_digest.high);
+        }
+        else
+        {
+            digest_add_word(&digest, child_digest.low);
+            digest_add_word(&digest, child_digest.high);
+        }
+        count++;
+    }
+
+    if (cjson_is_object(item))
+    {
+        digest_add_word(&digest, sum.low);
+        digest_add_word(&digest, sum.high);
+        if (has_duplicate_keys(item, count))
+        {
+            *state |= DIGEST_APPROXIMATE;
+        }
+    }
+    digest_finish(&digest, count);
+
+    return digest;
+}
+
+static cjson_digest_t hash_item(cjson_t * const item, const int flags, unsigned int * const state)
+{
+    const cjson_digest_t *cached = cached_digest(item);
+    cjson_digest_t digest = digest_start(item->type & 0xFF);
+    unsigned int item_state = 0;
+    double number = 0;
+    cjson_uint64_t bits = 0;
+
+    if (cached != NULL)
+    {
+        if (!(cached->high & 1))
+        {
+            *state |= DIGEST_APPROXIMATE;
+        }
+        digest.low = cached->low;
+        digest.high = cached->high & ~(cjson_uint64_t)1;
+        return digest;
+    }
+
+    if (item->type & CJSON_IS_REFERENCE)
+    {
+        item_state |= DIGEST_UNCACHEABLE;
+    }
+
+    switch (item->type & 0xFF)
+    {
+        case CJSON_NUMBER:
+            /* numbers that compare equal have the same double, unless they are only approximately equal */
+            number = (item->valuedouble == 0) ? 0 : item->valuedouble;
+            if ((number != floor(number)) || (fabs(number) >= 4503599627370496.0))
+            {
+                item_state |= DIGEST_APPROXIMATE;
+            }
+            memcpy(&bits, &number, sizeof(bits));
+            digest_add_word(&digest, bits);
+            digest_finish(&digest, sizeof(bits));
+            break;
+
+        case CJSON_STRING:
+        case CJSON_RAW:
+            if (item->valuestring != NULL)
+            {
+                digest_add_bytes(&digest, (const unsigned char*)item->valuestring, value_length(item), false);
+            }
+            break;
+
+        case CJSON_ARRAY:
+        case CJSON_OBJECT:
+            digest = hash_children(item, flags, &item_state);
+            break;
+
+        default:
+            digest_finish(&digest, 0);
+            break;
+    }
+    digest.low |= 1;
+    digest.high &= ~(cjson_uint64_t)1;
+
+    if ((flags & CJSON_HASH_CACHE) && !(item_state & DIGEST_UNCACHEABLE) && (item->type & (CJSON_ARRAY | CJSON_OBJECT)))
+    {
+        cjson_digest_t cached_value = digest;
+        if (!(item_state & DIGEST_APPROXIMATE))
+        {
+            cached_value.high |= 1;
+        }
+        cache_digest(item, cached_value);
+    }
+    *state |= item_state;
+
+    return digest;
+}
+
+CJSON_PUBLIC(cjson_digest_t) cjson_hash(cjson_t *item, int flags)
+{
+    cjson_digest_t digest = { 0, 0 };
+    unsigned int state = 0;
+
+    if (item == NULL)
+    {
+        return digest;
+    }
+
+    return hash_item(item, flags, &state);
+}
+
+CJSON_PUBLIC(void) cjson_hash_invalidate(cjson_t *item)
+{
+    invalidate_digests(item);
+}
+
+/* cached digests that are both exact and different belong to different items */
+static cjson_bool_t digests_differ(const cjson_t * const a, const cjson_t * const b)
+{
+    const cjson_digest_t *a_digest = cached_digest(a);
+    const cjson_digest_t *b_digest = cached_digest(b);
+
+    return (a_digest != NULL) && (b_digest != NULL) && (a_digest->high & b_digest->high & 1)
+        && ((a_digest->low != b_digest->low) || (a_digest->high != b_digest->high));
+}
+
 CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t * const b, const cjson_bool_t case_sensitive)
 {
     if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
@@ -3013,6 +9690,11 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
         return true;
     }
 
+    if (digests_differ(a, b))
+    {
+        return false;
+    }
+
     switch (a->type & 0xFF)
     {
         /* in these cases and equal type is enough */
@@ -3022,6 +9704,11 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
             return true;
 
         case CJSON_NUMBER:
+            if (has_exact_integer(a) && has_exact_integer(b))
+            {
+                /* exact integers are only equal if they are the same integer */
+                return ((a->type & CJSON_NUMBER_IS_UINT64) == (b->type & CJSON_NUMBER_IS_UINT64)) && (a->valueint64 == b->valueint64);
+            }
             if (compare_double(a->valuedouble, b->valuedouble))
             {
                 return true;
@@ -3034,6 +9721,12 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
             {
                 return false;
             }
+            if ((a->type | b->type) & CJSON_STRING_IS_VIEW)
+            {
+                /* views aren't terminated */
+                const size_t length = value_length(a);
+                return (length == value_length(b)) && (memcmp(a->valuestring, b->valuestring, length) == 0);
+            }
             if (strcmp(a->valuestring, b->valuestring) == 0)
             {
                 return true;
@@ -3046,6 +9739,11 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
             cjson_t *a_element = a->child;
             cjson_t *b_element = b->child;
 
+            if (has_lookup_table(a->index) && has_lookup_table(b->index) && (a->index->count != b->index->count))
+            {
+                return false;
+            }
+
             for (; (a_element != NULL) && (b_element != NULL);)
             {
                 if (!cjson_compare(a_element, b_element, case_sensitive))
@@ -3066,42 +9764,7 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
         }
 
         case CJSON_OBJECT:
-        {
-            cjson_t *a_element = NULL;
-            cjson_t *b_element = NULL;
-            CJSON_ARRAY_FOREACH(a_element, a)
-            {
-                /* TODO This has O(n^2) runtime, which is horrible! */
-                b_element = get_object_item(b, a_element->string, case_sensitive);
-                if (b_element == NULL)
-                {
-                    return false;
-                }
-
-                if (!cjson_compare(a_element, b_element, case_sensitive))
-                {
-                    return false;
-                }
-            }
-
-            /* doing this twice, once on a and b to prevent true comparison if a subset of b
-             * TODO: Do this the proper way, this is just a fix for now */
-            CJSON_ARRAY_FOREACH(b_element, b)
-            {
-                a_element = get_object_item(a, b_element->string, case_sensitive);
-                if (a_element == NULL)
-                {
-                    return false;
-                }
-
-                if (!cjson_compare(b_element, a_element, case_sensitive))
-                {
-                    return false;
-                }
-            }
-
-            return true;
-        }
+            return compare_objects(a, b, case_sensitive);
 
         default:
             return false;
@@ -3110,10 +9773,10 @@ CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t
 
 CJSON_PUBLIC(void *) cjson_malloc(size_t size)
 {
-    return global_hooks.allocate(size);
+    return global_hooks.allocate(size, global_hooks.user);
 }
 
 CJSON_PUBLIC(void) cjson_free(void *object)
 {
-    global_hooks.deallocate(object);
+    global_hooks.deallocate(object, global_hooks.user);
 }
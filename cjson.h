@@ -85,6 +85,16 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #include <stddef.h>
 
+/* exact 64 bit integer types, see valueint64 */
+#if defined(_MSC_VER) && (_MSC_VER < 1600)
+typedef __int64 cjson_int64_t;
+typedef unsigned __int64 cjson_uint64_t;
+#else
+#include <stdint.h>
+typedef int64_t cjson_int64_t;
+typedef uint64_t cjson_uint64_t;
+#endif
+
 /* cJSON Types: */
 #define CJSON_INVALID   (0)
 #define CJSON_FALSE     (1 << 0)
@@ -98,6 +108,18 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define CJSON_IS_REFERENCE      256
 #define CJSON_STRING_IS_CONST   512
+#define CJSON_IN_ARENA          1024 /* the item itself lives in a cjson_arena_t */
+#define CJSON_NUMBER_IS_INT64   2048 /* valueint64 holds the exact value of the number */
+#define CJSON_NUMBER_IS_UINT64  4096 /* valueint64 holds an exact value above INT64_MAX, converted to cjson_int64_t */
+#define CJSON_IN_SITU           8192 /* parsed by cjson_parse_insitu, referenced and constant strings point into its buffer */
+#define CJSON_STRING_IS_VIEW    16384 /* valuestring points into the text given to cjson_parse_with_views and isn't '\0' terminated */
+
+/* Structural hash of an item, see cjson_hash. low on its own can be used as a 64 bit hash. */
+typedef struct cjson_digest_t
+{
+    cjson_uint64_t low;
+    cjson_uint64_t high;
+} cjson_digest_t;
 
 /* The cJSON structure: */
 typedef struct cjson_t
@@ -117,9 +139,23 @@ typedef struct cjson_t
     int valueint;
     /* The item's number, if type==cJSON_Number */
     double valuedouble;
+    /* The exact integer, if type has CJSON_NUMBER_IS_INT64 or CJSON_NUMBER_IS_UINT64. Use cjson_get_int64/cjson_get_uint64 to read it. */
+    cjson_int64_t valueint64;
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+    /* Hash of string, stored by cJSON when the item is parsed or linked into an object. 0 if unknown. */
+    unsigned long string_hash;
+
+    /* Index of the children of a large array or object, managed by cJSON. Code that links or unlinks children by hand
+     * instead of with the functions below has to rebuild it with cjson_array_build_index or cjson_object_build_index.
+     * It also holds the digest of an array or object cached by cjson_hash with CJSON_HASH_CACHE. */
+    struct cjson_index_t *index;
+
+    /* The array or object this item is linked into, NULL for roots and detached items. Managed by cJSON. */
+    struct cjson_t *parent;
+    /* Length of valuestring if type has CJSON_STRING_IS_VIEW. Use cjson_get_string_view to read any string with its length. */
+    size_t valuestring_length;
 } cjson_t;
 
 typedef struct cjson_hooks_t
@@ -129,19 +165,77 @@ typedef struct cjson_hooks_t
       void (CJSON_CDECL *free_fn)(void *ptr);
 } cjson_hooks_t;
 
+/* Allocator for a single call, e.g. one per thread, or for everything with cjson_init_allocator.
+ * Every function gets user as its last argument. realloc_fn is optional, without it growing a buffer means malloc, copy and free. */
+typedef struct cjson_allocator_t
+{
+      void *(CJSON_CDECL *malloc_fn)(size_t sz, void *user);
+      void (CJSON_CDECL *free_fn)(void *ptr, void *user);
+      void *(CJSON_CDECL *realloc_fn)(void *ptr, size_t sz, void *user);
+      void *user;
+} cjson_allocator_t;
+
 typedef int cjson_bool_t;
 
+/* Region allocator for cjson_parse_into_arena. Nodes and strings are bump-allocated from large blocks
+ * and released all at once with cjson_arena_reset or cjson_arena_delete. */
+typedef struct cjson_arena_t cjson_arena_t;
+
+/* Why a parse failed. */
+typedef enum
+{
+    CJSON_ERROR_NONE = 0,
+    CJSON_ERROR_INVALID_ARGUMENT, /* no input or unusable allocator */
+    CJSON_ERROR_OUT_OF_MEMORY,
+    CJSON_ERROR_UNEXPECTED_END, /* the input ends in the middle of a value */
+    CJSON_ERROR_UNEXPECTED_CHARACTER,
+    CJSON_ERROR_INVALID_NUMBER,
+    CJSON_ERROR_INVALID_STRING, /* invalid escape sequence or UTF-16 surrogate */
+    CJSON_ERROR_NESTING_LIMIT, /* nested deeper than CJSON_NESTING_LIMIT */
+    CJSON_ERROR_TRAILING_CHARACTERS, /* more than whitespace after the value although a '\0' was required */
+    CJSON_ERROR_ABORTED /* a cjson_sax_parse callback returned false */
+} cjson_error_kind_t;
+
+/* Result of a parse with an error parameter. On failure offset is the byte offset of the error in the input and
+ * line and column (both starting at 1, the column counts bytes) locate it. On success offset is where parsing
+ * stopped and line and column are 0. */
+typedef struct cjson_error_t
+{
+    cjson_error_kind_t kind;
+    size_t offset;
+    size_t line;
+    size_t column;
+} cjson_error_t;
+
+/* Output callback for cjson_print_to_writer. Receives the next length bytes of the printed text
+ * (not '\0' terminated) and returns how many of them it consumed; anything less aborts printing. */
+typedef size_t (*cjson_write_fn)(const char *data, size_t length, void *user);
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_NESTING_LIMIT
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* Objects with more members than this (built up by adding members, or passed to cjson_build_indexes) get a hash index, which makes
+ * key lookups O(1). */
+#ifndef CJSON_OBJECT_INDEX_THRESHOLD
+#define CJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+/* Arrays with more elements than this (built up the same way) keep a vector of them, which makes cjson_get_array_size and
+ * cjson_get_array_item O(1). */
+#ifndef CJSON_ARRAY_INDEX_THRESHOLD
+#define CJSON_ARRAY_INDEX_THRESHOLD 16
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cjson_version(void);
 
 /* Supply malloc, realloc and free functions to cJSON */
 CJSON_PUBLIC(void) cjson_init_hooks(cjson_hooks_t* hooks);
+/* Like cjson_init_hooks, but with a realloc_fn and a user context. Returns false without malloc_fn or free_fn, NULL resets. */
+CJSON_PUBLIC(cjson_bool_t) cjson_init_allocator(const cjson_allocator_t *allocator);
 
 /* Memory Management: the caller is always responsible to free the results from all variants of cJSON_Parse (with cJSON_Delete) and cJSON_Print (with stdlib free, cJSON_Hooks.free_fn, or cJSON_free as appropriate). The exception is cJSON_PrintPreallocated, where the caller has full responsibility of the buffer. */
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. */
@@ -151,6 +245,156 @@ CJSON_PUBLIC(cjson_t *) cjson_parse_with_length(const char *value, size_t buffer
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cjson_t *) cjson_parse_with_opts(const char *value, const char **return_parse_end, cjson_bool_t require_null_terminated);
 CJSON_PUBLIC(cjson_t *) cjson_parse_with_length_opts(const char *value, size_t buffer_length, const char **return_parse_end, cjson_bool_t require_null_terminated);
+/* Like cjson_parse_with_length_opts, but the outcome is reported in error (may be NULL) instead of cjson_get_error_ptr.
+ * Nothing global is written, so this is safe to call from several threads at once. */
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_error(const char *value, size_t buffer_length, cjson_bool_t require_null_terminated, cjson_error_t *error);
+
+/* Arena parsing: the whole tree is allocated from the arena, so the result must not outlive it and is freed
+ * by resetting or deleting the arena instead of calling cJSON_Delete (doing so anyway is harmless).
+ * block_size is the size of the blocks the arena allocates, 0 selects a default. */
+CJSON_PUBLIC(cjson_arena_t *) cjson_arena_create(size_t block_size);
+/* Release everything allocated from the arena, but keep one block around for reuse. */
+CJSON_PUBLIC(void) cjson_arena_reset(cjson_arena_t *arena);
+CJSON_PUBLIC(void) cjson_arena_delete(cjson_arena_t *arena);
+CJSON_PUBLIC(cjson_t *) cjson_parse_into_arena(cjson_arena_t *arena, const char *value, size_t buffer_length);
+
+/* In situ parsing: strings are unescaped inside buffer and '\0' terminated there, so values and keys point into it
+ * instead of being copied. The buffer is modified (also by a failed parse) and the tree must not outlive it, but is
+ * still freed with cjson_delete. Setting a longer string copies it out of the buffer. */
+CJSON_PUBLIC(cjson_t *) cjson_parse_insitu(char *buffer, size_t length);
+
+/* Parse read-only text without copying strings: values without escape sequences point into value instead, flagged with
+ * CJSON_STRING_IS_VIEW and not '\0' terminated, so they have to be read with cjson_get_string_view. Escaped values and
+ * all keys are decoded into copies as usual. The tree must not outlive value, but is freed with cjson_delete. */
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_views(const char *value, size_t buffer_length, cjson_error_t *error);
+
+/* Parse only the values at the given JSON pointers ("/items/0/name", with "~0" for '~' and "~1" for '/' in keys; ""
+ * is the whole document) and the objects and arrays on the way to them. Everything else is skipped by matching
+ * brackets, which only checks that its strings are terminated and its brackets balanced. Skipped array elements in
+ * front of a kept one become null so the indices stay the same. The result is an ordinary tree, the root is always
+ * returned. Returns NULL for invalid text or paths that aren't JSON pointers. */
+CJSON_PUBLIC(cjson_t *) cjson_parse_projected(const char *value, size_t buffer_length, const char **paths, size_t count);
+
+/* Per-call allocation: everything these allocate or free goes through allocator instead of the cjson_init_hooks functions,
+ * so every thread can use an allocator of its own (NULL selects the global hooks). Trees from cjson_parse_with_allocator are
+ * released with cjson_delete_with_allocator and the same allocator, the other functions that add to or delete from a tree
+ * still use the global hooks. */
+CJSON_PUBLIC(cjson_t *) cjson_parse_with_allocator(const char *value, size_t buffer_length, const cjson_allocator_t *allocator, cjson_error_t *error);
+CJSON_PUBLIC(char *) cjson_print_with_allocator(const cjson_t *item, cjson_bool_t format, const cjson_allocator_t *allocator);
+CJSON_PUBLIC(void) cjson_delete_with_allocator(cjson_t *item, const cjson_allocator_t *allocator);
+
+/* Event callbacks for cjson_sax_parse, any of them may be NULL. Returning false stops the parse.
+ * Strings and keys are passed with their length and are not '\0' terminated. They point either into the input or into
+ * a buffer that is reused for the next escaped string, so copy what has to outlive the callback. The number is a
+ * temporary item that works with cjson_get_number_value, cjson_get_int64 and cjson_get_uint64. */
+typedef struct cjson_sax_handler_t
+{
+    cjson_bool_t (*start_object)(void *user);
+    cjson_bool_t (*end_object)(void *user);
+    cjson_bool_t (*start_array)(void *user);
+    cjson_bool_t (*end_array)(void *user);
+    cjson_bool_t (*key)(const char *string, size_t length, void *user);
+    cjson_bool_t (*string)(const char *string, size_t length, void *user);
+    cjson_bool_t (*number)(const cjson_t *number, void *user);
+    cjson_bool_t (*boolean)(cjson_bool_t value, void *user);
+    cjson_bool_t (*null)(void *user);
+} cjson_sax_handler_t;
+/* Parse the first value in text and report it to handler as a sequence of events instead of building a tree. Nothing is
+ * allocated per value, only a buffer for unescaping strings that grows to the longest escaped string. Returns true if the
+ * whole value was parsed. The events that were already delivered before an error are not taken back. */
+CJSON_PUBLIC(cjson_bool_t) cjson_sax_parse(const char *text, size_t length, const cjson_sax_handler_t *handler, void *user);
+/* Like cjson_sax_parse, but the outcome is reported in error (may be NULL) instead of cjson_get_error_ptr. */
+CJSON_PUBLIC(cjson_bool_t) cjson_sax_parse_with_error(const char *text, size_t length, const cjson_sax_handler_t *handler, void *user, cjson_error_t *error);
+
+/* Push parser for input that arrives in chunks: every chunk is parsed as far as possible when it is fed, only a value
+ * that is cut off by the end of a chunk (a string, key, number or literal) is kept until it is complete, so the input
+ * doesn't have to be collected first. The result is the tree cjson_parse_with_length would build from all chunks
+ * together, except that anything but whitespace after the value is an error. The allocator is used like in
+ * cjson_parse_with_allocator (NULL selects the global hooks). */
+typedef struct cjson_push_parser_t cjson_push_parser_t;
+CJSON_PUBLIC(cjson_push_parser_t *) cjson_push_parser_create(const cjson_allocator_t *allocator);
+/* Parse the next length bytes of the input. Returns false once the input is invalid, cjson_push_parser_finish reports why. */
+CJSON_PUBLIC(cjson_bool_t) cjson_push_parser_feed(cjson_push_parser_t *parser, const char *buffer, size_t length);
+/* End the input and return the tree (NULL on failure, the reason is in error, which may be NULL). The error offset
+ * counts from the start of the first chunk, line and column are always 0. The parser is reset and can parse the next input. */
+CJSON_PUBLIC(cjson_t *) cjson_push_parser_finish(cjson_push_parser_t *parser, cjson_error_t *error);
+CJSON_PUBLIC(void) cjson_push_parser_delete(cjson_push_parser_t *parser);
+
+/* Iterator over NDJSON / JSON Lines and other concatenated documents: every value in the buffer is a record,
+ * separated from the next one by any whitespace. The fields are private, set them up with cjson_ndjson_iter_init. */
+typedef struct cjson_ndjson_iter_t
+{
+    const char *buffer;
+    size_t length;
+    size_t offset; /* where the search for the next record starts */
+    size_t line; /* line of offset, starting at 1 */
+    size_t line_start; /* offset of the first byte of that line */
+    cjson_arena_t *arena;
+} cjson_ndjson_iter_t;
+/* With an arena, records are parsed into it and each call to cjson_ndjson_next resets it, so a record is only valid until
+ * the next one is read, but memory is reused instead of allocated per record. Without one (NULL) every record is a tree of
+ * its own that the caller releases with cjson_delete. */
+CJSON_PUBLIC(void) cjson_ndjson_iter_init(cjson_ndjson_iter_t *iter, const char *buffer, size_t length, cjson_arena_t *arena);
+/* Read the next record. Returns false when there are no more records. Otherwise *item is the record, or NULL if it is invalid.
+ * Then error (may be NULL) tells why, with offset, line and column counted in the whole buffer, and the iterator continues
+ * on the next line. A record ends with its line, one that spans lines is reported as invalid line by line. On success
+ * error->offset is where the record ends. */
+CJSON_PUBLIC(cjson_bool_t) cjson_ndjson_next(cjson_ndjson_iter_t *iter, cjson_t **item, cjson_error_t *error);
+
+/* Called by cjson_parse_ndjson_parallel for every record. item is NULL for invalid records and error tells why, error->offset
+ * is counted in the whole buffer. The item belongs to an arena of the parsing thread and is only valid during the call.
+ * Returning false stops parsing. */
+typedef cjson_bool_t (*cjson_ndjson_callback)(cjson_t *item, const cjson_error_t *error, void *user);
+/* Deliver every record as soon as it is parsed, from several threads at once and in no particular order. Error lines and
+ * columns are 0 then, the lines in front of a batch are only known once the batches before it are done. After the callback
+ * returns false, the other threads may still deliver a few records. */
+#define CJSON_NDJSON_UNORDERED 1
+/* Parse newline delimited records on nthreads threads (0 or less picks one per processor). The buffer is split at newlines
+ * into batches, every thread works through a queue of them and steals from the other queues once its own is empty, and
+ * parses into an arena of its own. Without CJSON_NDJSON_UNORDERED in flags the callback gets one record at a time in the
+ * order of the buffer. Records end with their line like for cjson_ndjson_next, so the records and errors are the same as
+ * the iterator's wherever the batches start. Without pthreads (the ENABLE_CJSON_THREADS CMake option), with one
+ * thread or for small buffers the records are parsed on the calling thread. Returns false if the callback stopped
+ * parsing or memory ran out. */
+CJSON_PUBLIC(cjson_bool_t) cjson_parse_ndjson_parallel(const char *buffer, size_t length, int nthreads, cjson_ndjson_callback callback, void *user, int flags);
+
+/* On-demand parsing: instead of a tree, the document hands out cursors to values that are only parsed when they are read.
+ * Fields and elements in front of the one looked for are skipped by matching brackets, which checks that strings are
+ * terminated and brackets balanced, but not the scalars in between. Nothing is allocated. The text must outlive the
+ * document and its cursors. The first error is kept in error, a function that fails without one (a missing field, the
+ * end of an array or a value of another type) leaves it at CJSON_ERROR_NONE. */
+typedef struct cjson_ondemand_t
+{
+    const char *text;
+    size_t length;
+    cjson_error_t error;
+} cjson_ondemand_t;
+/* A value in the document. The fields are private, cursors are set up by the functions below. */
+typedef struct cjson_od_value_t
+{
+    cjson_ondemand_t *document;
+    size_t offset; /* where the value starts */
+    size_t cursor; /* in objects and arrays the value where the last search ended, 0 before the first one */
+    size_t depth; /* number of objects and arrays the value is in */
+} cjson_od_value_t;
+/* Start reading text, root is the value it contains. Whatever follows that value isn't looked at. */
+CJSON_PUBLIC(cjson_bool_t) cjson_ondemand_init(cjson_ondemand_t *document, const char *text, size_t length, cjson_od_value_t *root);
+/* The type of a value (CJSON_TRUE or CJSON_FALSE for booleans), judged by its first character. */
+CJSON_PUBLIC(int) cjson_od_type(const cjson_od_value_t *value);
+/* Find the field with the given key (case sensitive) in an object. The search continues behind the field found last and
+ * wraps around, so fields read in the order of the document are found without going over the object again. */
+CJSON_PUBLIC(cjson_bool_t) cjson_od_find_field(cjson_od_value_t *object, const char *key, cjson_od_value_t *value);
+/* Step to the next element of an array, the first one on the first call. Returns false after the last one. */
+CJSON_PUBLIC(cjson_bool_t) cjson_od_next_element(cjson_od_value_t *array, cjson_od_value_t *element);
+CJSON_PUBLIC(cjson_bool_t) cjson_od_get_double(const cjson_od_value_t *value, double *number);
+/* Only succeeds for integers in the range of cjson_int64_t, like cjson_get_int64. */
+CJSON_PUBLIC(cjson_bool_t) cjson_od_get_int64(const cjson_od_value_t *value, cjson_int64_t *number);
+/* Parse the value into a tree of its own, to be released with cjson_delete. This is how strings are read. */
+CJSON_PUBLIC(cjson_t *) cjson_od_parse(const cjson_od_value_t *value);
+
+/* Skip the value at the start of text (after whitespace) without building it, matching brackets like the on-demand
+ * functions do. end (if not NULL) is set behind the value, or to where the scan failed. Leaves the global error alone. */
+CJSON_PUBLIC(cjson_bool_t) cjson_skip_value(const char *text, size_t length, const char **end);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cjson_print(const cjson_t *item);
@@ -159,8 +403,17 @@ CJSON_PUBLIC(char *) cjson_print_unformatted(const cjson_t *item);
 /* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
 CJSON_PUBLIC(char *) cjson_print_buffered(const cjson_t *item, int prebuffer, cjson_bool_t fmt);
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
-/* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
+/* NOTE: the buffer needs cjson_print_size(item, format) + 1 bytes, including the terminating '\0' */
 CJSON_PUBLIC(cjson_bool_t) cjson_print_preallocated(cjson_t *item, char *buffer, const int length, const cjson_bool_t format);
+/* Calculate the exact length of the text cjson_print (format=1) or cjson_print_unformatted (format=0) produce, without the terminating '\0'.
+ * Returns 0 if the item can't be printed. */
+CJSON_PUBLIC(size_t) cjson_print_size(const cjson_t *item, cjson_bool_t format);
+/* Render a cJSON entity through a buffer of chunk_size bytes (0 picks a default) that is handed to write_fn whenever it fills up.
+ * Memory use doesn't depend on the size of the document, strings and numbers longer than the buffer are passed on in pieces. Returns 1 on success and 0 on failure, output already written is not undone. */
+CJSON_PUBLIC(cjson_bool_t) cjson_print_to_writer(const cjson_t *item, cjson_bool_t format, cjson_write_fn write_fn, void *user, size_t chunk_size);
+/* Ready-made writers: user is a FILE* for cjson_write_to_file and a pointer to an int file descriptor for cjson_write_to_fd. */
+CJSON_PUBLIC(size_t) cjson_write_to_file(const char *data, size_t length, void *user);
+CJSON_PUBLIC(size_t) cjson_write_to_fd(const char *data, size_t length, void *user);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cjson_delete(cjson_t *item);
 
@@ -172,12 +425,42 @@ CJSON_PUBLIC(cjson_t *) cjson_get_array_item(const cjson_t *array, int index);
 CJSON_PUBLIC(cjson_t *) cjson_get_object_item(const cjson_t * const object, const char * const string);
 CJSON_PUBLIC(cjson_t *) cjson_get_object_item_case_sensitive(const cjson_t * const object, const char * const string);
 CJSON_PUBLIC(cjson_bool_t) cjson_has_object_item(const cjson_t *object, const char *string);
+/* A key with its length and hash computed once, for looking up the same key in many objects.
+ * The string isn't copied and has to outlive the key. */
+typedef struct cjson_key_t
+{
+    const char *string;
+    size_t length;
+    unsigned long hash;
+} cjson_key_t;
+CJSON_PUBLIC(cjson_key_t) cjson_key_make(const char *string);
+/* Get item "key" from object. Case sensitive. Members whose key has a different hash are skipped without comparing the strings. */
+CJSON_PUBLIC(cjson_t *) cjson_get_object_item_by_key(const cjson_t * const object, const cjson_key_t key);
+/* Build (or rebuild) the hash index of an object regardless of its size. Adding, replacing and removing members keeps it up to date.
+ * Objects get one when they grow past CJSON_OBJECT_INDEX_THRESHOLD. Fails for references, objects in an arena
+ * and members without a key. */
+CJSON_PUBLIC(cjson_bool_t) cjson_object_build_index(cjson_t *object);
+/* Build (or rebuild) the element vector of an array regardless of its size. Arrays get one when they grow past
+ * CJSON_ARRAY_INDEX_THRESHOLD, and adding, inserting, replacing and removing elements keeps it up to date. Fails for references and arrays in an arena. */
+CJSON_PUBLIC(cjson_bool_t) cjson_array_build_index(cjson_t *array);
+/* Parsing doesn't build indexes, so documents that are read once don't pay for them. For a parsed tree that is looked up a lot,
+ * this gives every array and object in item past CJSON_ARRAY_INDEX_THRESHOLD or CJSON_OBJECT_INDEX_THRESHOLD an index,
+ * taken from the arena for items in one. References are skipped. Returns false if memory ran out, the tree stays usable. */
+CJSON_PUBLIC(cjson_bool_t) cjson_build_indexes(cjson_t *item);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
+/* This is shared by all threads, cjson_parse_with_error and cjson_parse_with_allocator report errors per call instead. */
 CJSON_PUBLIC(const char *) cjson_get_error_ptr(void);
 
 /* Check item type and return its value */
+/* NULL for string views, which aren't '\0' terminated. */
 CJSON_PUBLIC(char *) cjson_get_string_value(const cjson_t * const item);
+/* Any string with its length in *length, views included. NULL (and a length of 0) if item isn't a string. */
+CJSON_PUBLIC(const char *) cjson_get_string_view(const cjson_t * const item, size_t *length);
 CJSON_PUBLIC(double) cjson_get_number_value(const cjson_t * const item);
+/* Get the value of a number that is an integer in the range of the result type, returns false otherwise.
+ * Integers parsed from JSON are kept exactly, even above 2^53. */
+CJSON_PUBLIC(cjson_bool_t) cjson_get_int64(const cjson_t * const item, cjson_int64_t * const value);
+CJSON_PUBLIC(cjson_bool_t) cjson_get_uint64(const cjson_t * const item, cjson_uint64_t * const value);
 
 /* These functions check the type of an item */
 CJSON_PUBLIC(cjson_bool_t) cjson_is_invalid(const cjson_t * const item);
@@ -197,6 +480,9 @@ CJSON_PUBLIC(cjson_t *) cjson_create_true(void);
 CJSON_PUBLIC(cjson_t *) cjson_create_false(void);
 CJSON_PUBLIC(cjson_t *) cjson_create_bool(cjson_bool_t boolean);
 CJSON_PUBLIC(cjson_t *) cjson_create_number(double num);
+/* create numbers that keep the exact integer and are printed without going through a double */
+CJSON_PUBLIC(cjson_t *) cjson_create_int64(cjson_int64_t num);
+CJSON_PUBLIC(cjson_t *) cjson_create_uint64(cjson_uint64_t num);
 CJSON_PUBLIC(cjson_t *) cjson_create_string(const char *string);
 /* raw json */
 CJSON_PUBLIC(cjson_t *) cjson_create_raw(const char *raw);
@@ -251,9 +537,23 @@ CJSON_PUBLIC(cjson_t *) cjson_duplicate(const cjson_t *item, cjson_bool_t recurs
  * need to be released. With recurse!=0, it will duplicate any children connected to the item.
  * The item->next and ->prev pointers are always zero on return from Duplicate. */
 /* Recursively compare two cJSON items for equality. If either a or b is NULL or invalid, they will be considered unequal.
- * case_sensitive determines if object keys are treated case sensitive (1) or case insensitive (0) */
+ * case_sensitive determines if object keys are treated case sensitive (1) or case insensitive (0).
+ * Objects and arrays with a different number of children are never equal. Comparing objects takes linear time. */
 CJSON_PUBLIC(cjson_bool_t) cjson_compare(const cjson_t * const a, const cjson_t * const b, const cjson_bool_t case_sensitive);
 
+/* Store the digests of the arrays and objects in item (including item itself) with their index, so hashing them again doesn't
+ * have to visit unchanged subtrees. Those without an index get a small allocation for it, which cjson_delete releases (or the
+ * arena, for items of cjson_parse_into_arena). References are never cached, and neither is anything that contains one. */
+#define CJSON_HASH_CACHE 1
+/* 128 bit structural hash of item (not a cryptographic one). The order of object members doesn't matter, and keys are hashed
+ * case insensitively. Items that cjson_compare considers equal have equal digests, unless they contain numbers that are only
+ * approximately equal or objects with duplicate keys. The functions of this library that change items drop the cached digests
+ * of the item and its parents, after changing an item directly call cjson_hash_invalidate.
+ * If both items have a cached digest, cjson_compare uses them to tell unequal items apart without visiting them. */
+CJSON_PUBLIC(cjson_digest_t) cjson_hash(cjson_t *item, int flags);
+/* Drop the cached digests of item and its parents. */
+CJSON_PUBLIC(void) cjson_hash_invalidate(cjson_t *item);
+
 /* Minify a strings, remove blank characters(such as ' ', '\t', '\r', '\n') from strings.
  * The input pointer json cannot point to a read-only address area, such as a string constant,
  * but should point to a readable and writable address area. */
@@ -271,20 +571,20 @@ CJSON_PUBLIC(cjson_t*) cjson_add_raw_to_object(cjson_t * const object, const cha
 CJSON_PUBLIC(cjson_t*) cjson_add_object_to_object(cjson_t * const object, const char * const name);
 CJSON_PUBLIC(cjson_t*) cjson_add_array_to_object(cjson_t * const object, const char * const name);
 
-/* When assigning an integer value, it needs to be propagated to valuedouble too. */
-#define CJSON_SET_INT_VALUE(object, number) ((object) ? (object)->valueint = (object)->valuedouble = (number) : (number))
+/* When assigning an integer value, it needs to be propagated to valuedouble too. The setters below also drop the
+ * digests cached by cjson_hash, values written to the fields directly have to be reported with cjson_hash_invalidate. */
+CJSON_PUBLIC(int) cjson_set_int_helper(cjson_t *object, double number);
+#define CJSON_SET_INT_VALUE(object, number) ((object != NULL) ? cjson_set_int_helper(object, (double)(number)) : (number))
 /* helper for the cJSON_SetNumberValue macro */
 CJSON_PUBLIC(double) cjson_set_number_helper(cjson_t *object, double number);
 #define CJSON_SET_NUMBER_VALUE(object, number) ((object != NULL) ? cjson_set_number_helper(object, (double)number) : (number))
-/* Change the valuestring of a cJSON_String object, only takes effect when type of object is cJSON_String */
+/* Change the valuestring of a cJSON_String object, only takes effect when type of object is cJSON_String.
+ * Items of cjson_parse_into_arena get a string from their arena, so it is only valid as long as the arena is. */
 CJSON_PUBLIC(char*) cjson_set_value_string(cjson_t *object, const char *valuestring);
 
 /* If the object is not a boolean type this does nothing and returns cJSON_Invalid else it returns the new type*/
-#define CJSON_SET_BOOL_VALUE(object, boolValue) ( \
-    (object != NULL && ((object)->type & (CJSON_FALSE|CJSON_TRUE))) ? \
-    (object)->type=((object)->type &(~(CJSON_FALSE|CJSON_TRUE)))|((boolValue)?CJSON_TRUE:CJSON_FALSE) : \
-    CJSON_INVALID\
-)
+CJSON_PUBLIC(int) cjson_set_bool_helper(cjson_t *object, cjson_bool_t boolean);
+#define CJSON_SET_BOOL_VALUE(object, boolValue) ((object != NULL) ? cjson_set_bool_helper(object, (boolValue) ? 1 : 0) : CJSON_INVALID)
 
 /* Macro for iterating over an array or object */
 #define CJSON_ARRAY_FOREACH(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
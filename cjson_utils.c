@@ -56,12 +56,12 @@
 #ifdef true
 #undef true
 #endif
-#define true ((cJSON_bool)1)
+#define true ((cjson_bool_t)1)
 
 #ifdef false
 #undef false
 #endif
-#define false ((cJSON_bool)0)
+#define false ((cjson_bool_t)0)
 
 static unsigned char* cJSONUtils_strdup(const unsigned char* const string)
 {
@@ -69,7 +69,7 @@ static unsigned char* cJSONUtils_strdup(const unsigned char* const string)
     unsigned char *copy = NULL;
 
     length = strlen((const char*)string) + sizeof("");
-    copy = (unsigned char*) cJSON_malloc(length);
+    copy = (unsigned char*) cjson_malloc(length);
     if (copy == NULL)
     {
         return NULL;
@@ -80,7 +80,7 @@ static unsigned char* cJSONUtils_strdup(const unsigned char* const string)
 }
 
 /* string comparison which doesn't consider NULL pointers equal */
-static int compare_strings(const unsigned char *string1, const unsigned char *string2, const cJSON_bool case_sensitive)
+static int compare_strings(const unsigned char *string1, const unsigned char *string2, const cjson_bool_t case_sensitive)
 {
     if ((string1 == NULL) || (string2 == NULL))
     {
@@ -109,7 +109,7 @@ static int compare_strings(const unsigned char *string1, const unsigned char *st
 }
 
 /* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
+static cjson_bool_t compare_double(double a, double b)
 {
     double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
@@ -117,7 +117,7 @@ static cJSON_bool compare_double(double a, double b)
 
 
 /* Compare the next path element of two JSON pointers, two NULL pointers are considered unequal: */
-static cJSON_bool compare_pointers(const unsigned char *name, const unsigned char *pointer, const cJSON_bool case_sensitive)
+static cjson_bool_t compare_pointers(const unsigned char *name, const unsigned char *pointer, const cjson_bool_t case_sensitive)
 {
     if ((name == NULL) || (pointer == NULL))
     {
@@ -195,10 +195,10 @@ static void encode_string_as_pointer(unsigned char *destination, const unsigned
     destination[0] = '\0';
 }
 
-CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const object, const cJSON * const target)
+CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cjson_t * const object, const cjson_t * const target)
 {
     size_t child_index = 0;
-    cJSON *current_child = 0;
+    cjson_t *current_child = 0;
 
     if ((object == NULL) || (target == NULL))
     {
@@ -218,38 +218,38 @@ CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const obje
         /* found the target? */
         if (target_pointer != NULL)
         {
-            if (cJSON_IsArray(object))
+            if (cjson_is_array(object))
             {
                 /* reserve enough memory for a 64 bit integer + '/' and '\0' */
-                unsigned char *full_pointer = (unsigned char*)cJSON_malloc(strlen((char*)target_pointer) + 20 + sizeof("/"));
+                unsigned char *full_pointer = (unsigned char*)cjson_malloc(strlen((char*)target_pointer) + 20 + sizeof("/"));
                 /* check if conversion to unsigned long is valid
                  * This should be eliminated at compile time by dead code elimination
                  * if size_t is an alias of unsigned long, or if it is bigger */
                 if (child_index > ULONG_MAX)
                 {
-                    cJSON_free(target_pointer);
-                    cJSON_free(full_pointer);
+                    cjson_free(target_pointer);
+                    cjson_free(full_pointer);
                     return NULL;
                 }
                 sprintf((char*)full_pointer, "/%lu%s", (unsigned long)child_index, target_pointer); /* /<array_index><path> */
-                cJSON_free(target_pointer);
+                cjson_free(target_pointer);
 
                 return (char*)full_pointer;
             }
 
-            if (cJSON_IsObject(object))
+            if (cjson_is_object(object))
             {
-                unsigned char *full_pointer = (unsigned char*)cJSON_malloc(strlen((char*)target_pointer) + pointer_encoded_length((unsigned char*)current_child->string) + 2);
+                unsigned char *full_pointer = (unsigned char*)cjson_malloc(strlen((char*)target_pointer) + pointer_encoded_length((unsigned char*)current_child->string) + 2);
                 full_pointer[0] = '/';
                 encode_string_as_pointer(full_pointer + 1, (unsigned char*)current_child->string);
                 strcat((char*)full_pointer, (char*)target_pointer);
-                cJSON_free(target_pointer);
+                cjson_free(target_pointer);
 
                 return (char*)full_pointer;
             }
 
             /* reached leaf of the tree, found nothing */
-            cJSON_free(target_pointer);
+            cjson_free(target_pointer);
             return NULL;
         }
     }
@@ -258,10 +258,10 @@ CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const obje
     return NULL;
 }
 
-/* non broken version of cJSON_GetArrayItem */
-static cJSON *get_array_item(const cJSON *array, size_t item)
+/* non broken version of cjson_get_array_item */
+static cjson_t *get_array_item(const cjson_t *array, size_t item)
 {
-    cJSON *child = array ? array->child : NULL;
+    cjson_t *child = array ? array->child : NULL;
     while ((child != NULL) && (item > 0))
     {
         item--;
@@ -271,7 +271,7 @@ static cJSON *get_array_item(const cJSON *array, size_t item)
     return child;
 }
 
-static cJSON_bool decode_array_index_from_pointer(const unsigned char * const pointer, size_t * const index)
+static cjson_bool_t decode_array_index_from_pointer(const unsigned char * const pointer, size_t * const index)
 {
     size_t parsed_index = 0;
     size_t position = 0;
@@ -298,9 +298,9 @@ static cJSON_bool decode_array_index_from_pointer(const unsigned char * const po
     return 1;
 }
 
-static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
+static cjson_t *get_item_from_pointer(cjson_t * const object, const char * pointer, const cjson_bool_t case_sensitive)
 {
-    cJSON *current_element = object;
+    cjson_t *current_element = object;
 
     if (pointer == NULL)
     {
@@ -311,7 +311,7 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
     while ((pointer[0] == '/') && (current_element != NULL))
     {
         pointer++;
-        if (cJSON_IsArray(current_element))
+        if (cjson_is_array(current_element))
         {
             size_t index = 0;
             if (!decode_array_index_from_pointer((const unsigned char*)pointer, &index))
@@ -321,7 +321,7 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
 
             current_element = get_array_item(current_element, index);
         }
-        else if (cJSON_IsObject(current_element))
+        else if (cjson_is_object(current_element))
         {
             current_element = current_element->child;
             /* GetObjectItem. */
@@ -345,12 +345,12 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
     return current_element;
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GetPointer(cjson_t * const object, const char *pointer)
 {
     return get_item_from_pointer(object, pointer, false);
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointerCaseSensitive(cJSON * const object, const char *pointer)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GetPointerCaseSensitive(cjson_t * const object, const char *pointer)
 {
     return get_item_from_pointer(object, pointer, true);
 }
@@ -374,7 +374,7 @@ static void decode_pointer_inplace(unsigned char *string)
             }
             else if (string[1] == '1')
             {
-                decoded_string[1] = '/';
+                decoded_string[0] = '/';
             }
             else
             {
@@ -384,55 +384,35 @@ static void decode_pointer_inplace(unsigned char *string)
 
             string++;
         }
+        else
+        {
+            decoded_string[0] = string[0];
+        }
     }
 
     decoded_string[0] = '\0';
 }
 
-/* non-broken cJSON_DetachItemFromArray */
-static cJSON *detach_item_from_array(cJSON *array, size_t which)
+/* cjson_detach_item_from_array with a size_t index */
+static cjson_t *detach_item_from_array(cjson_t *array, size_t which)
 {
-    cJSON *c = array->child;
-    while (c && (which > 0))
-    {
-        c = c->next;
-        which--;
-    }
-    if (!c)
+    cjson_t *item = get_array_item(array, which);
+    if (item == NULL)
     {
         /* item doesn't exist */
         return NULL;
     }
-    if (c != array->child)
-    {
-        /* not the first element */
-        c->prev->next = c->next;
-    }
-    if (c->next)
-    {
-        c->next->prev = c->prev;
-    }
-    if (c == array->child)
-    {
-        array->child = c->next;
-    }
-    else if (c->next == NULL)
-    {
-        array->child->prev = c->prev;
-    }
-    /* make sure the detached item doesn't point anywhere anymore */
-    c->prev = c->next = NULL;
 
-    return c;
+    return cjson_detach_item_via_pointer(array, item);
 }
 
 /* detach an item at the given path */
-static cJSON *detach_path(cJSON *object, const unsigned char *path, const cJSON_bool case_sensitive)
+static cjson_t *detach_path(cjson_t *object, const unsigned char *path, const cjson_bool_t case_sensitive)
 {
     unsigned char *parent_pointer = NULL;
     unsigned char *child_pointer = NULL;
-    cJSON *parent = NULL;
-    cJSON *detached_item = NULL;
+    cjson_t *parent = NULL;
+    cjson_t *detached_item = NULL;
 
     /* copy path and split it in parent and child */
     parent_pointer = cJSONUtils_strdup(path);
@@ -452,7 +432,7 @@ static cJSON *detach_path(cJSON *object, const unsigned char *path, const cJSON_
     parent = get_item_from_pointer(object, (char*)parent_pointer, case_sensitive);
     decode_pointer_inplace(child_pointer);
 
-    if (cJSON_IsArray(parent))
+    if (cjson_is_array(parent))
     {
         size_t index = 0;
         if (!decode_array_index_from_pointer(child_pointer, &index))
@@ -461,9 +441,9 @@ static cJSON *detach_path(cJSON *object, const unsigned char *path, const cJSON_
         }
         detached_item = detach_item_from_array(parent, index);
     }
-    else if (cJSON_IsObject(parent))
+    else if (cjson_is_object(parent))
     {
-        detached_item = cJSON_DetachItemFromObject(parent, (char*)child_pointer);
+        detached_item = cjson_detach_item_from_object(parent, (char*)child_pointer);
     }
     else
     {
@@ -474,20 +454,20 @@ static cJSON *detach_path(cJSON *object, const unsigned char *path, const cJSON_
 cleanup:
     if (parent_pointer != NULL)
     {
-        cJSON_free(parent_pointer);
+        cjson_free(parent_pointer);
     }
 
     return detached_item;
 }
 
 /* sort lists using mergesort */
-static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
+static cjson_t *sort_list(cjson_t *list, const cjson_bool_t case_sensitive)
 {
-    cJSON *first = list;
-    cJSON *second = list;
-    cJSON *current_item = list;
-    cJSON *result = list;
-    cJSON *result_tail = NULL;
+    cjson_t *first = list;
+    cjson_t *second = list;
+    cjson_t *current_item = list;
+    cjson_t *result = list;
+    cjson_t *result_tail = NULL;
 
     if ((list == NULL) || (list->next == NULL))
     {
@@ -534,7 +514,7 @@ static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
     /* Merge the sub-lists */
     while ((first != NULL) && (second != NULL))
     {
-        cJSON *smaller = NULL;
+        cjson_t *smaller = NULL;
         if (compare_strings((unsigned char*)first->string, (unsigned char*)second->string, case_sensitive) < 0)
         {
             smaller = first;
@@ -592,16 +572,28 @@ static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
     return result;
 }
 
-static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
+static void sort_object(cjson_t * const object, const cjson_bool_t case_sensitive)
 {
     if (object == NULL)
     {
         return;
     }
     object->child = sort_list(object->child, case_sensitive);
+    if (object->child != NULL)
+    {
+        /* the prev of the first child is the last one */
+        cjson_t *last = object->child;
+        while (last->next != NULL)
+        {
+            last = last->next;
+        }
+        object->child->prev = last;
+    }
+    /* the index only maps keys to items, but cached digests may depend on the order */
+    cjson_hash_invalidate(object);
 }
 
-static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensitive)
+static cjson_bool_t compare_json(cjson_t *a, cjson_t *b, const cjson_bool_t case_sensitive)
 {
     if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
     {
@@ -610,7 +602,7 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
     }
     switch (a->type & 0xFF)
     {
-        case cJSON_Number:
+        case CJSON_NUMBER:
             /* numeric mismatch. */
             if ((a->valueint != b->valueint) || (!compare_double(a->valuedouble, b->valuedouble)))
             {
@@ -621,7 +613,7 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
                 return true;
             }
 
-        case cJSON_String:
+        case CJSON_STRING:
             /* string mismatch. */
             if (strcmp(a->valuestring, b->valuestring) != 0)
             {
@@ -632,10 +624,10 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
                 return true;
             }
 
-        case cJSON_Array:
+        case CJSON_ARRAY:
             for ((void)(a = a->child), b = b->child; (a != NULL) && (b != NULL); (void)(a = a->next), b = b->next)
             {
-                cJSON_bool identical = compare_json(a, b, case_sensitive);
+                cjson_bool_t identical = compare_json(a, b, case_sensitive);
                 if (!identical)
                 {
                     return false;
@@ -652,12 +644,12 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
                 return true;
             }
 
-        case cJSON_Object:
+        case CJSON_OBJECT:
             sort_object(a, case_sensitive);
             sort_object(b, case_sensitive);
             for ((void)(a = a->child), b = b->child; (a != NULL) && (b != NULL); (void)(a = a->next), b = b->next)
             {
-                cJSON_bool identical = false;
+                cjson_bool_t identical = false;
                 /* compare object keys */
                 if (compare_strings((unsigned char*)a->string, (unsigned char*)b->string, case_sensitive))
                 {
@@ -689,60 +681,34 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
     return true;
 }
 
-/* non broken version of cJSON_InsertItemInArray */
-static cJSON_bool insert_item_in_array(cJSON *array, size_t which, cJSON *newitem)
+/* cjson_insert_item_in_array with a size_t index that fails after the end of the array */
+static cjson_bool_t insert_item_in_array(cjson_t *array, size_t which, cjson_t *newitem)
 {
-    cJSON *child = array->child;
-    while (child && (which > 0))
-    {
-        child = child->next;
-        which--;
-    }
-    if (which > 0)
+    if ((which > (size_t)INT_MAX) || ((which > 0) && (get_array_item(array, which - 1) == NULL)))
     {
         /* item is after the end of the array */
         return 0;
     }
-    if (child == NULL)
-    {
-        cJSON_AddItemToArray(array, newitem);
-        return 1;
-    }
 
-    /* insert into the linked list */
-    newitem->next = child;
-    newitem->prev = child->prev;
-    child->prev = newitem;
-
-    /* was it at the beginning */
-    if (child == array->child)
-    {
-        array->child = newitem;
-    }
-    else
-    {
-        newitem->prev->next = newitem;
-    }
-
-    return 1;
+    return cjson_insert_item_in_array(array, (int)which, newitem);
 }
 
-static cJSON *get_object_item(const cJSON * const object, const char* name, const cJSON_bool case_sensitive)
+static cjson_t *get_object_item(const cjson_t * const object, const char* name, const cjson_bool_t case_sensitive)
 {
     if (case_sensitive)
     {
-        return cJSON_GetObjectItemCaseSensitive(object, name);
+        return cjson_get_object_item_case_sensitive(object, name);
     }
 
-    return cJSON_GetObjectItem(object, name);
+    return cjson_get_object_item(object, name);
 }
 
 enum patch_operation { INVALID, ADD, REMOVE, REPLACE, MOVE, COPY, TEST };
 
-static enum patch_operation decode_patch_operation(const cJSON * const patch, const cJSON_bool case_sensitive)
+static enum patch_operation decode_patch_operation(const cjson_t * const patch, const cjson_bool_t case_sensitive)
 {
-    cJSON *operation = get_object_item(patch, "op", case_sensitive);
-    if (!cJSON_IsString(operation))
+    cjson_t *operation = get_object_item(patch, "op", case_sensitive);
+    if (!cjson_is_string(operation))
     {
         return INVALID;
     }
@@ -780,42 +746,67 @@ static enum patch_operation decode_patch_operation(const cJSON * const patch, co
     return INVALID;
 }
 
-/* overwrite and existing item with another one and free resources on the way */
-static void overwrite_item(cJSON * const root, const cJSON replacement)
+/* overwrite an existing item with the contents of another one, which takes the old contents to free them */
+static void overwrite_item(cjson_t * const root, cjson_t * const replacement)
 {
-    if (root == NULL)
+    cjson_t old;
+    cjson_t *child = NULL;
+
+    if ((root == NULL) || (replacement == NULL))
     {
         return;
     }
 
-    if (root->string != NULL)
+    /* root keeps its key, the one of the replacement isn't needed */
+    if (!(replacement->type & CJSON_STRING_IS_CONST) && (replacement->string != NULL))
     {
-        cJSON_free(root->string);
+        cjson_free(replacement->string);
     }
-    if (root->valuestring != NULL)
+    replacement->string = NULL;
+
+    memcpy(&old, root, sizeof(cjson_t));
+    memcpy(root, replacement, sizeof(cjson_t));
+    memcpy(replacement, &old, sizeof(cjson_t));
+
+    /* root keeps its place and key, replacement is detached */
+    root->next = old.next;
+    root->prev = old.prev;
+    root->parent = old.parent;
+    root->string = old.string;
+    root->string_hash = old.string_hash;
+    replacement->next = NULL;
+    replacement->prev = NULL;
+    replacement->parent = NULL;
+    replacement->string = NULL;
+    replacement->string_hash = 0;
+    replacement->type &= ~CJSON_STRING_IS_CONST;
+    root->type = (root->type & ~CJSON_STRING_IS_CONST) | (old.type & CJSON_STRING_IS_CONST);
+
+    for (child = root->child; child != NULL; child = child->next)
     {
-        cJSON_free(root->valuestring);
+        child->parent = root;
     }
-    if (root->child != NULL)
+    for (child = replacement->child; child != NULL; child = child->next)
     {
-        cJSON_Delete(root->child);
+        child->parent = replacement;
     }
 
-    memcpy(root, &replacement, sizeof(cJSON));
+    cjson_hash_invalidate(root);
+    cjson_delete(replacement);
 }
 
-static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_sensitive)
+static int apply_patch(cjson_t *object, const cjson_t *patch, const cjson_bool_t case_sensitive)
 {
-    cJSON *path = NULL;
-    cJSON *value = NULL;
-    cJSON *parent = NULL;
+    cjson_t *path = NULL;
+    cjson_t *value = NULL;
+    cjson_t *parent = NULL;
     enum patch_operation opcode = INVALID;
     unsigned char *parent_pointer = NULL;
     unsigned char *child_pointer = NULL;
     int status = 0;
 
     path = get_object_item(patch, "path", case_sensitive);
-    if (!cJSON_IsString(path))
+    if (!cjson_is_string(path))
     {
         /* malformed patch. */
         status = 2;
@@ -840,9 +831,16 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     {
         if (opcode == REMOVE)
         {
-            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL};
+            value = cjson_create_null();
+            if (value == NULL)
+            {
+                status = 8;
+                goto cleanup;
+            }
+            value->type = CJSON_INVALID;
 
-            overwrite_item(object, invalid);
+            overwrite_item(object, value);
+            value = NULL;
 
             status = 0;
             goto cleanup;
@@ -858,7 +856,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
                 goto cleanup;
             }
 
-            value = cJSON_Duplicate(value, 1);
+            value = cjson_duplicate(value, 1);
             if (value == NULL)
             {
                 /* out of memory for add/replace. */
@@ -866,19 +864,9 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
                 goto cleanup;
             }
 
-            overwrite_item(object, *value);
-
-            /* delete the duplicated value */
-            cJSON_free(value);
+            overwrite_item(object, value);
             value = NULL;
 
-            /* the string "value" isn't needed */
-            if (object->string != NULL)
-            {
-                cJSON_free(object->string);
-                object->string = NULL;
-            }
-
             status = 0;
             goto cleanup;
         }
@@ -887,13 +875,13 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     if ((opcode == REMOVE) || (opcode == REPLACE))
     {
         /* Get rid of old. */
-        cJSON *old_item = detach_path(object, (unsigned char*)path->valuestring, case_sensitive);
+        cjson_t *old_item = detach_path(object, (unsigned char*)path->valuestring, case_sensitive);
         if (old_item == NULL)
         {
             status = 13;
             goto cleanup;
         }
-        cJSON_Delete(old_item);
+        cjson_delete(old_item);
         if (opcode == REMOVE)
         {
             /* For Remove, this job is done. */
@@ -905,7 +893,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     /* Copy/Move uses "from". */
     if ((opcode == MOVE) || (opcode == COPY))
     {
-        cJSON *from = get_object_item(patch, "from", case_sensitive);
+        cjson_t *from = get_object_item(patch, "from", case_sensitive);
         if (from == NULL)
         {
             /* missing "from" for copy/move. */
@@ -929,7 +917,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
         }
         if (opcode == COPY)
         {
-            value = cJSON_Duplicate(value, 1);
+            value = cjson_duplicate(value, 1);
         }
         if (value == NULL)
         {
@@ -947,7 +935,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
             status = 7;
             goto cleanup;
         }
-        value = cJSON_Duplicate(value, 1);
+        value = cjson_duplicate(value, 1);
         if (value == NULL)
         {
             /* out of memory for add/replace. */
@@ -978,11 +966,11 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
         status = 9;
         goto cleanup;
     }
-    else if (cJSON_IsArray(parent))
+    else if (cjson_is_array(parent))
     {
         if (strcmp((char*)child_pointer, "-") == 0)
         {
-            cJSON_AddItemToArray(parent, value);
+            cjson_add_item_to_array(parent, value);
             value = NULL;
         }
         else
@@ -1002,17 +990,17 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
             value = NULL;
         }
     }
-    else if (cJSON_IsObject(parent))
+    else if (cjson_is_object(parent))
     {
         if (case_sensitive)
         {
-            cJSON_DeleteItemFromObjectCaseSensitive(parent, (char*)child_pointer);
+            cjson_delete_item_from_object_case_sensitive(parent, (char*)child_pointer);
         }
         else
         {
-            cJSON_DeleteItemFromObject(parent, (char*)child_pointer);
+            cjson_delete_item_from_object(parent, (char*)child_pointer);
         }
-        cJSON_AddItemToObject(parent, (char*)child_pointer, value);
+        cjson_add_item_to_object(parent, (char*)child_pointer, value);
         value = NULL;
     }
     else /* parent is not an object */
@@ -1025,22 +1013,22 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
 cleanup:
     if (value != NULL)
     {
-        cJSON_Delete(value);
+        cjson_delete(value);
     }
     if (parent_pointer != NULL)
     {
-        cJSON_free(parent_pointer);
+        cjson_free(parent_pointer);
     }
 
     return status;
 }
 
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches)
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cjson_t * const object, const cjson_t * const patches)
 {
-    const cJSON *current_patch = NULL;
+    const cjson_t *current_patch = NULL;
     int status = 0;
 
-    if (!cJSON_IsArray(patches))
+    if (!cjson_is_array(patches))
     {
         /* malformed patches. */
         return 1;
@@ -1064,12 +1052,12 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * co
     return 0;
 }
 
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches)
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cjson_t * const object, const cjson_t * const patches)
 {
-    const cJSON *current_patch = NULL;
+    const cjson_t *current_patch = NULL;
     int status = 0;
 
-    if (!cJSON_IsArray(patches))
+    if (!cjson_is_array(patches))
     {
         /* malformed patches. */
         return 1;
@@ -1093,52 +1081,52 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, con
     return 0;
 }
 
-static void compose_patch(cJSON * const patches, const unsigned char * const operation, const unsigned char * const path, const unsigned char *suffix, const cJSON * const value)
+static void compose_patch(cjson_t * const patches, const unsigned char * const operation, const unsigned char * const path, const unsigned char *suffix, const cjson_t * const value)
 {
-    cJSON *patch = NULL;
+    cjson_t *patch = NULL;
 
     if ((patches == NULL) || (operation == NULL) || (path == NULL))
     {
         return;
     }
 
-    patch = cJSON_CreateObject();
+    patch = cjson_create_object();
     if (patch == NULL)
     {
         return;
     }
-    cJSON_AddItemToObject(patch, "op", cJSON_CreateString((const char*)operation));
+    cjson_add_item_to_object(patch, "op", cjson_create_string((const char*)operation));
 
     if (suffix == NULL)
     {
-        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)path));
+        cjson_add_item_to_object(patch, "path", cjson_create_string((const char*)path));
     }
     else
     {
         size_t suffix_length = pointer_encoded_length(suffix);
         size_t path_length = strlen((const char*)path);
-        unsigned char *full_path = (unsigned char*)cJSON_malloc(path_length + suffix_length + sizeof("/"));
+        unsigned char *full_path = (unsigned char*)cjson_malloc(path_length + suffix_length + sizeof("/"));
 
         sprintf((char*)full_path, "%s/", (const char*)path);
         encode_string_as_pointer(full_path + path_length + 1, suffix);
 
-        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)full_path));
-        cJSON_free(full_path);
+        cjson_add_item_to_object(patch, "path", cjson_create_string((const char*)full_path));
+        cjson_free(full_path);
     }
 
     if (value != NULL)
     {
-        cJSON_AddItemToObject(patch, "value", cJSON_Duplicate(value, 1));
+        cjson_add_item_to_object(patch, "value", cjson_duplicate(value, 1));
     }
-    cJSON_AddItemToArray(patches, patch);
+    cjson_add_item_to_array(patches, patch);
 }
 
-CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char * const operation, const char * const path, const cJSON * const value)
+CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cjson_t * const array, const char * const operation, const char * const path, const cjson_t * const value)
 {
     compose_patch(array, (const unsigned char*)operation, (const unsigned char*)path, NULL, value);
 }
 
-static void create_patches(cJSON * const patches, const unsigned char * const path, cJSON * const from, cJSON * const to, const cJSON_bool case_sensitive)
+static void create_patches(cjson_t * const patches, const unsigned char * const path, cjson_t * const from, cjson_t * const to, const cjson_bool_t case_sensitive)
 {
     if ((from == NULL) || (to == NULL))
     {
@@ -1153,26 +1141,26 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
 
     switch (from->type & 0xFF)
     {
-        case cJSON_Number:
+        case CJSON_NUMBER:
             if ((from->valueint != to->valueint) || !compare_double(from->valuedouble, to->valuedouble))
             {
                 compose_patch(patches, (const unsigned char*)"replace", path, NULL, to);
             }
             return;
 
-        case cJSON_String:
+        case CJSON_STRING:
             if (strcmp(from->valuestring, to->valuestring) != 0)
             {
                 compose_patch(patches, (const unsigned char*)"replace", path, NULL, to);
             }
             return;
 
-        case cJSON_Array:
+        case CJSON_ARRAY:
         {
             size_t index = 0;
-            cJSON *from_child = from->child;
-            cJSON *to_child = to->child;
-            unsigned char *new_path = (unsigned char*)cJSON_malloc(strlen((const char*)path) + 20 + sizeof("/")); /* Allow space for 64bit int. log10(2^64) = 20 */
+            cjson_t *from_child = from->child;
+            cjson_t *to_child = to->child;
+            unsigned char *new_path = (unsigned char*)cjson_malloc(strlen((const char*)path) + 20 + sizeof("/")); /* Allow space for 64bit int. log10(2^64) = 20 */
 
             /* generate patches for all array elements that exist in both "from" and "to" */
             for (index = 0; (from_child != NULL) && (to_child != NULL); (void)(from_child = from_child->next), (void)(to_child = to_child->next), index++)
@@ -1182,7 +1170,7 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
                  * if size_t is an alias of unsigned long, or if it is bigger */
                 if (index > ULONG_MAX)
                 {
-                    cJSON_free(new_path);
+                    cjson_free(new_path);
                     return;
                 }
                 sprintf((char*)new_path, "%s/%lu", path, (unsigned long)index); /* path of the current array element */
@@ -1197,7 +1185,7 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
                  * if size_t is an alias of unsigned long, or if it is bigger */
                 if (index > ULONG_MAX)
                 {
-                    cJSON_free(new_path);
+                    cjson_free(new_path);
                     return;
                 }
                 sprintf((char*)new_path, "%lu", (unsigned long)index);
@@ -1208,14 +1196,14 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
             {
                 compose_patch(patches, (const unsigned char*)"add", path, (const unsigned char*)"-", to_child);
             }
-            cJSON_free(new_path);
+            cjson_free(new_path);
             return;
         }
 
-        case cJSON_Object:
+        case CJSON_OBJECT:
         {
-            cJSON *from_child = NULL;
-            cJSON *to_child = NULL;
+            cjson_t *from_child = NULL;
+            cjson_t *to_child = NULL;
             sort_object(from, case_sensitive);
             sort_object(to, case_sensitive);
 
@@ -1243,14 +1231,14 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
                     /* both object keys are the same */
                     size_t path_length = strlen((const char*)path);
                     size_t from_child_name_length = pointer_encoded_length((unsigned char*)from_child->string);
-                    unsigned char *new_path = (unsigned char*)cJSON_malloc(path_length + from_child_name_length + sizeof("/"));
+                    unsigned char *new_path = (unsigned char*)cjson_malloc(path_length + from_child_name_length + sizeof("/"));
 
                     sprintf((char*)new_path, "%s/", path);
                     encode_string_as_pointer(new_path + path_length + 1, (unsigned char*)from_child->string);
 
                     /* create a patch for the element */
                     create_patches(patches, new_path, from_child, to_child, case_sensitive);
-                    cJSON_free(new_path);
+                    cjson_free(new_path);
 
                     from_child = from_child->next;
                     to_child = to_child->next;
@@ -1278,129 +1266,129 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
     }
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatches(cJSON * const from, cJSON * const to)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GeneratePatches(cjson_t * const from, cjson_t * const to)
 {
-    cJSON *patches = NULL;
+    cjson_t *patches = NULL;
 
     if ((from == NULL) || (to == NULL))
     {
         return NULL;
     }
 
-    patches = cJSON_CreateArray();
+    patches = cjson_create_array();
     create_patches(patches, (const unsigned char*)"", from, to, false);
 
     return patches;
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatchesCaseSensitive(cJSON * const from, cJSON * const to)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GeneratePatchesCaseSensitive(cjson_t * const from, cjson_t * const to)
 {
-    cJSON *patches = NULL;
+    cjson_t *patches = NULL;
 
     if ((from == NULL) || (to == NULL))
     {
         return NULL;
     }
 
-    patches = cJSON_CreateArray();
+    patches = cjson_create_array();
     create_patches(patches, (const unsigned char*)"", from, to, true);
 
     return patches;
 }
 
-CJSON_PUBLIC(void) cJSONUtils_SortObject(cJSON * const object)
+CJSON_PUBLIC(void) cJSONUtils_SortObject(cjson_t * const object)
 {
     sort_object(object, false);
 }
 
-CJSON_PUBLIC(void) cJSONUtils_SortObjectCaseSensitive(cJSON * const object)
+CJSON_PUBLIC(void) cJSONUtils_SortObjectCaseSensitive(cjson_t * const object)
 {
     sort_object(object, true);
 }
 
-static cJSON *merge_patch(cJSON *target, const cJSON * const patch, const cJSON_bool case_sensitive)
+static cjson_t *merge_patch(cjson_t *target, const cjson_t * const patch, const cjson_bool_t case_sensitive)
 {
-    cJSON *patch_child = NULL;
+    cjson_t *patch_child = NULL;
 
-    if (!cJSON_IsObject(patch))
+    if (!cjson_is_object(patch))
     {
         /* scalar value, array or NULL, just duplicate */
-        cJSON_Delete(target);
-        return cJSON_Duplicate(patch, 1);
+        cjson_delete(target);
+        return cjson_duplicate(patch, 1);
     }
 
-    if (!cJSON_IsObject(target))
+    if (!cjson_is_object(target))
     {
-        cJSON_Delete(target);
-        target = cJSON_CreateObject();
+        cjson_delete(target);
+        target = cjson_create_object();
     }
 
     patch_child = patch->child;
     while (patch_child != NULL)
     {
-        if (cJSON_IsNull(patch_child))
+        if (cjson_is_null(patch_child))
         {
             /* NULL is the indicator to remove a value, see RFC7396 */
             if (case_sensitive)
             {
-                cJSON_DeleteItemFromObjectCaseSensitive(target, patch_child->string);
+                cjson_delete_item_from_object_case_sensitive(target, patch_child->string);
             }
             else
             {
-                cJSON_DeleteItemFromObject(target, patch_child->string);
+                cjson_delete_item_from_object(target, patch_child->string);
             }
         }
         else
         {
-            cJSON *replace_me = NULL;
-            cJSON *replacement = NULL;
+            cjson_t *replace_me = NULL;
+            cjson_t *replacement = NULL;
 
             if (case_sensitive)
             {
-                replace_me = cJSON_DetachItemFromObjectCaseSensitive(target, patch_child->string);
+                replace_me = cjson_detach_item_from_object_case_sensitive(target, patch_child->string);
             }
             else
             {
-                replace_me = cJSON_DetachItemFromObject(target, patch_child->string);
+                replace_me = cjson_detach_item_from_object(target, patch_child->string);
             }
 
             replacement = merge_patch(replace_me, patch_child, case_sensitive);
             if (replacement == NULL)
             {
-                cJSON_Delete(target);
+                cjson_delete(target);
                 return NULL;
             }
 
-            cJSON_AddItemToObject(target, patch_child->string, replacement);
+            cjson_add_item_to_object(target, patch_child->string, replacement);
         }
         patch_child = patch_child->next;
     }
     return target;
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatch(cJSON *target, const cJSON * const patch)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_MergePatch(cjson_t *target, const cjson_t * const patch)
 {
     return merge_patch(target, patch, false);
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatchCaseSensitive(cJSON *target, const cJSON * const patch)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_MergePatchCaseSensitive(cjson_t *target, const cjson_t * const patch)
 {
     return merge_patch(target, patch, true);
 }
 
-static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const cJSON_bool case_sensitive)
+static cjson_t *generate_merge_patch(cjson_t * const from, cjson_t * const to, const cjson_bool_t case_sensitive)
 {
-    cJSON *from_child = NULL;
-    cJSON *to_child = NULL;
-    cJSON *patch = NULL;
+    cjson_t *from_child = NULL;
+    cjson_t *to_child = NULL;
+    cjson_t *patch = NULL;
     if (to == NULL)
     {
         /* patch to delete everything */
-        return cJSON_CreateNull();
+        return cjson_create_null();
     }
-    if (!cJSON_IsObject(to) || !cJSON_IsObject(from))
+    if (!cjson_is_object(to) || !cjson_is_object(from))
     {
-        return cJSON_Duplicate(to, 1);
+        return cjson_duplicate(to, 1);
     }
 
     sort_object(from, case_sensitive);
@@ -1408,7 +1396,7 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
 
     from_child = from->child;
     to_child = to->child;
-    patch = cJSON_CreateObject();
+    patch = cjson_create_object();
     if (patch == NULL)
     {
         return NULL;
@@ -1435,14 +1423,14 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
         if (diff < 0)
         {
             /* from has a value that to doesn't have -> remove */
-            cJSON_AddItemToObject(patch, from_child->string, cJSON_CreateNull());
+            cjson_add_item_to_object(patch, from_child->string, cjson_create_null());
 
             from_child = from_child->next;
         }
         else if (diff > 0)
         {
             /* to has a value that from doesn't have -> add to patch */
-            cJSON_AddItemToObject(patch, to_child->string, cJSON_Duplicate(to_child, 1));
+            cjson_add_item_to_object(patch, to_child->string, cjson_duplicate(to_child, 1));
 
             to_child = to_child->next;
         }
@@ -1452,7 +1440,7 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
             if (!compare_json(from_child, to_child, case_sensitive))
             {
                 /* not identical --> generate a patch */
-                cJSON_AddItemToObject(patch, to_child->string, cJSONUtils_GenerateMergePatch(from_child, to_child));
+                cjson_add_item_to_object(patch, to_child->string, cJSONUtils_GenerateMergePatch(from_child, to_child));
             }
 
             /* next key in the object */
@@ -1463,19 +1451,19 @@ static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const c
     if (patch->child == NULL)
     {
         /* no patch generated */
-        cJSON_Delete(patch);
+        cjson_delete(patch);
         return NULL;
     }
 
     return patch;
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatch(cJSON * const from, cJSON * const to)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GenerateMergePatch(cjson_t * const from, cjson_t * const to)
 {
     return generate_merge_patch(from, to, false);
 }
 
-CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatchCaseSensitive(cJSON * const from, cJSON * const to)
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GenerateMergePatchCaseSensitive(cjson_t * const from, cjson_t * const to)
 {
     return generate_merge_patch(from, to, true);
 }
@@ -31,33 +31,33 @@ extern "C"
 #include "cjson.h"
 
 /* Implement RFC6901 (https://tools.ietf.org/html/rfc6901) JSON Pointer spec. */
-CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer);
-CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointerCaseSensitive(cJSON * const object, const char *pointer);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GetPointer(cjson_t * const object, const char *pointer);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GetPointerCaseSensitive(cjson_t * const object, const char *pointer);
 
 /* Implement RFC6902 (https://tools.ietf.org/html/rfc6902) JSON Patch spec. */
 /* NOTE: This modifies objects in 'from' and 'to' by sorting the elements by their key */
-CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatches(cJSON * const from, cJSON * const to);
-CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatchesCaseSensitive(cJSON * const from, cJSON * const to);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GeneratePatches(cjson_t * const from, cjson_t * const to);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GeneratePatchesCaseSensitive(cjson_t * const from, cjson_t * const to);
 /* Utility for generating patch array entries. */
-CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char * const operation, const char * const path, const cJSON * const value);
+CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cjson_t * const array, const char * const operation, const char * const path, const cjson_t * const value);
 /* Returns 0 for success. */
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches);
-CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches);
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cjson_t * const object, const cjson_t * const patches);
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cjson_t * const object, const cjson_t * const patches);
 
 /*
 // Note that ApplyPatches is NOT atomic on failure. To implement an atomic ApplyPatches, use:
-//int cJSONUtils_AtomicApplyPatches(cJSON **object, cJSON *patches)
+//int cJSONUtils_AtomicApplyPatches(cjson_t **object, cjson_t *patches)
 //{
-//    cJSON *modme = cJSON_Duplicate(*object, 1);
+//    cjson_t *modme = cjson_duplicate(*object, 1);
 //    int error = cJSONUtils_ApplyPatches(modme, patches);
 //    if (!error)
 //    {
-//        cJSON_Delete(*object);
+//        cjson_delete(*object);
 //        *object = modme;
 //    }
 //    else
 //    {
-//        cJSON_Delete(modme);
+//        cjson_delete(modme);
 //    }
 //
 //    return error;
@@ -67,19 +67,19 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, con
 
 /* Implement RFC7386 (https://tools.ietf.org/html/rfc7396) JSON Merge Patch spec. */
 /* target will be modified by patch. return value is new ptr for target. */
-CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatch(cJSON *target, const cJSON * const patch);
-CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatchCaseSensitive(cJSON *target, const cJSON * const patch);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_MergePatch(cjson_t *target, const cjson_t * const patch);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_MergePatchCaseSensitive(cjson_t *target, const cjson_t * const patch);
 /* generates a patch to move from -> to */
 /* NOTE: This modifies objects in 'from' and 'to' by sorting the elements by their key */
-CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatch(cJSON * const from, cJSON * const to);
-CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatchCaseSensitive(cJSON * const from, cJSON * const to);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GenerateMergePatch(cjson_t * const from, cjson_t * const to);
+CJSON_PUBLIC(cjson_t *) cJSONUtils_GenerateMergePatchCaseSensitive(cjson_t * const from, cjson_t * const to);
 
 /* Given a root object and a target object, construct a pointer from one to the other. */
-CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const object, const cJSON * const target);
+CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cjson_t * const object, const cjson_t * const target);
 
 /* Sorts the members of the object into alphabetical order. */
-CJSON_PUBLIC(void) cJSONUtils_SortObject(cJSON * const object);
-CJSON_PUBLIC(void) cJSONUtils_SortObjectCaseSensitive(cJSON * const object);
+CJSON_PUBLIC(void) cJSONUtils_SortObject(cjson_t * const object);
+CJSON_PUBLIC(void) cJSONUtils_SortObjectCaseSensitive(cjson_t * const object);
 
 #ifdef __cplusplus
 }
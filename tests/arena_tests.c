@@ -0,0 +1,177 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static void arena_should_parse_documents(void)
+{
+    const char json[] = "{\"name\": \"Awesome 4K\", \"resolutions\": [{\"width\": 1280, \"height\": 720}, {\"width\": 3840, \"height\": 2160}], \"valid\": true}";
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *root = NULL;
+    cjson_t *resolutions = NULL;
+
+    TEST_ASSERT_NOT_NULL(arena);
+    root = cjson_parse_into_arena(arena, json, sizeof(json));
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_BITS(CJSON_IN_ARENA, CJSON_IN_ARENA, root->type);
+
+    TEST_ASSERT_EQUAL_STRING("Awesome 4K", cjson_get_string_value(cjson_get_object_item(root, "name")));
+    resolutions = cjson_get_object_item(root, "resolutions");
+    TEST_ASSERT_EQUAL_INT(2, cjson_get_array_size(resolutions));
+    TEST_ASSERT_EQUAL_DOUBLE(2160.0, cjson_get_number_value(cjson_get_object_item(cjson_get_array_item(resolutions, 1), "height")));
+    TEST_ASSERT_TRUE(cjson_is_true(cjson_get_object_item(root, "valid")));
+
+    cjson_arena_delete(arena);
+}
+
+static void arena_should_fail_on_invalid_input(void)
+{
+    const char json[] = "{\"a\": [1, 2, \"unterminated}";
+    cjson_arena_t *arena = cjson_arena_create(0);
+
+    TEST_ASSERT_NULL(cjson_parse_into_arena(NULL, json, sizeof(json)));
+    TEST_ASSERT_NULL(cjson_parse_into_arena(arena, NULL, 0));
+    TEST_ASSERT_NULL(cjson_parse_into_arena(arena, json, sizeof(json)));
+
+    cjson_arena_delete(arena);
+}
+
+static void arena_should_handle_allocations_larger_than_a_block(void)
+{
+    char json[1024];
+    cjson_arena_t *arena = cjson_arena_create(64);
+    cjson_t *root = NULL;
+    size_t i = 0;
+
+    json[0] = '[';
+    json[1] = '\"';
+    for (i = 2; i < (sizeof(json) - 3); i++)
+    {
+        json[i] = 'a';
+    }
+    json[sizeof(json) - 3] = '\"';
+    json[sizeof(json) - 2] = ']';
+    json[sizeof(json) - 1] = '\0';
+
+    root = cjson_parse_into_arena(arena, json, sizeof(json));
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_EQUAL_UINT((unsigned int)(sizeof(json) - 5), (unsigned int)strlen(cjson_get_string_value(cjson_get_array_item(root, 0))));
+
+    cjson_arena_delete(arena);
+}
+
+static void arena_should_be_reusable_after_reset(void)
+{
+    const char json[] = "[\"a\", \"b\", {\"c\": null}]";
+    cjson_arena_t *arena = cjson_arena_create(128);
+    cjson_t *root = NULL;
+    int i = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        root = cjson_parse_into_arena(arena, json, sizeof(json));
+        TEST_ASSERT_NOT_NULL(root);
+        TEST_ASSERT_TRUE(cjson_is_null(cjson_get_object_item(cjson_get_array_item(root, 2), "c")));
+        cjson_arena_reset(arena);
+    }
+
+    cjson_arena_delete(arena);
+}
+
+static void arena_items_should_survive_mutation_and_duplication(void)
+{
+    const char json[] = "{\"key\": \"value\", \"list\": [1, 2]}";
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *root = NULL;
+    cjson_t *copy = NULL;
+
+    root = cjson_parse_into_arena(arena, json, sizeof(json));
+    TEST_ASSERT_NOT_NULL(root);
+
+    /* heap items added to an arena tree are freed by cJSON_Delete, arena items are skipped */
+    TEST_ASSERT_NOT_NULL(cjson_add_string_to_object(root, "heap", "allocated"));
+    TEST_ASSERT_TRUE(cjson_add_item_to_array(cjson_get_object_item(root, "list"), cjson_create_number(3)));
+
+    copy = cjson_duplicate(root, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_BITS(CJSON_IN_ARENA | CJSON_IS_REFERENCE, 0, copy->type);
+
+    cjson_delete(root);
+    cjson_arena_delete(arena);
+
+    TEST_ASSERT_EQUAL_STRING("value", cjson_get_string_value(cjson_get_object_item(copy, "key")));
+    TEST_ASSERT_EQUAL_STRING("allocated", cjson_get_string_value(cjson_get_object_item(copy, "heap")));
+    TEST_ASSERT_EQUAL_INT(3, cjson_get_array_size(cjson_get_object_item(copy, "list")));
+
+    cjson_delete(copy);
+}
+
+static void arena_items_should_get_strings_from_the_arena(void)
+{
+    const char json[] = "{\"key\": \"value\", \"other\": \"x\"}";
+    cjson_arena_t *arena = cjson_arena_create(128);
+    cjson_t *root = NULL;
+    cjson_t *item = NULL;
+    char *string = NULL;
+
+    root = cjson_parse_into_arena(arena, json, sizeof(json));
+    TEST_ASSERT_NOT_NULL(root);
+
+    item = cjson_get_object_item(root, "key");
+    TEST_ASSERT_EQUAL_STRING("val", cjson_set_value_string(item, "val"));
+    TEST_ASSERT_EQUAL_STRING("val", cjson_get_string_value(item));
+
+    /* a longer string comes from the arena, so nothing has to be freed */
+    item = cjson_get_object_item(root, "other");
+    string = cjson_set_value_string(item, "a value that doesn't fit into a block of 128 bytes, so it gets a block of its own in the arena");
+    TEST_ASSERT_NOT_NULL(string);
+    TEST_ASSERT_EQUAL_PTR(string, cjson_get_string_value(item));
+    TEST_ASSERT_BITS(CJSON_IN_ARENA | CJSON_IS_REFERENCE, CJSON_IN_ARENA | CJSON_IS_REFERENCE, item->type);
+    TEST_ASSERT_EQUAL_STRING("a longer value", cjson_set_value_string(cjson_get_object_item(root, "key"), "a longer value"));
+
+    cjson_delete(root);
+    cjson_arena_delete(arena);
+}
+
+static void arena_functions_should_handle_null(void)
+{
+    cjson_arena_reset(NULL);
+    cjson_arena_delete(NULL);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(arena_should_parse_documents);
+    RUN_TEST(arena_should_fail_on_invalid_input);
+    RUN_TEST(arena_should_handle_allocations_larger_than_a_block);
+    RUN_TEST(arena_should_be_reusable_after_reset);
+    RUN_TEST(arena_items_should_survive_mutation_and_duplication);
+    RUN_TEST(arena_items_should_get_strings_from_the_arena);
+    RUN_TEST(arena_functions_should_handle_null);
+
+    return UNITY_END();
+}
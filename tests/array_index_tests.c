@@ -0,0 +1,280 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* the vector has to contain exactly the elements of the list, in the same order */
+static void assert_vector_matches_list(const cjson_t *array)
+{
+    cjson_t *child = NULL;
+    size_t position = 0;
+
+    TEST_ASSERT_NOT_NULL(array->index);
+    TEST_ASSERT_NOT_NULL(array->index->items);
+    for (child = array->child; child != NULL; child = child->next)
+    {
+        TEST_ASSERT_TRUE(position < array->index->count);
+        TEST_ASSERT_EQUAL_PTR(child, array->index->items[array->index->first + position]);
+        TEST_ASSERT_EQUAL_PTR(child, cjson_get_array_item(array, (int)position));
+        position++;
+    }
+    TEST_ASSERT_EQUAL_UINT((unsigned int)position, (unsigned int)array->index->count);
+    TEST_ASSERT_EQUAL_INT((int)position, cjson_get_array_size(array));
+    TEST_ASSERT_NULL(cjson_get_array_item(array, (int)position));
+}
+
+static void vector_should_be_built_for_large_parsed_arrays_on_request(void)
+{
+    const char json[] = "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, [1, 2]]";
+    cjson_t *array = cjson_parse(json);
+
+    TEST_ASSERT_NOT_NULL(array);
+    /* plain parsing leaves indexing to the caller */
+    TEST_ASSERT_NULL(array->index);
+    TEST_ASSERT_TRUE(cjson_build_indexes(array));
+    assert_vector_matches_list(array);
+    TEST_ASSERT_NULL(cjson_get_array_item(array, 18)->index);
+    TEST_ASSERT_EQUAL_INT(17, cjson_get_array_item(array, 17)->valueint);
+    /* the vector isn't a hash index */
+    TEST_ASSERT_NULL(cjson_get_object_item(array, "17"));
+
+    cjson_delete(array);
+}
+
+static void vector_should_be_built_when_arrays_grow(void)
+{
+    cjson_t *array = cjson_create_array();
+    cjson_t *created = NULL;
+    int numbers[CJSON_ARRAY_INDEX_THRESHOLD + 1];
+    int i = 0;
+
+    for (i = 0; i < CJSON_ARRAY_INDEX_THRESHOLD; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+        numbers[i] = i;
+    }
+    TEST_ASSERT_NULL(array->index);
+
+    cjson_add_item_to_array(array, cjson_create_number(i));
+    numbers[i] = i;
+    assert_vector_matches_list(array);
+
+    /* appending past the initial capacity */
+    for (i = 0; i < 100; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+    }
+    assert_vector_matches_list(array);
+
+    created = cjson_create_int_array(numbers, CJSON_ARRAY_INDEX_THRESHOLD + 1);
+    assert_vector_matches_list(created);
+    cjson_delete(created);
+
+    created = cjson_create_int_array(numbers, CJSON_ARRAY_INDEX_THRESHOLD);
+    TEST_ASSERT_NULL(created->index);
+    cjson_delete(created);
+
+    cjson_delete(array);
+}
+
+static void vector_should_follow_mutations(void)
+{
+    cjson_t *array = cjson_create_array();
+    int i = 0;
+
+    for (i = 0; i < 40; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+    }
+    assert_vector_matches_list(array);
+
+    /* inserting at the front, in the middle and past the end */
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(array, 0, cjson_create_string("first")));
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(array, 20, cjson_create_string("middle")));
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(array, 1000, cjson_create_string("last")));
+    assert_vector_matches_list(array);
+    TEST_ASSERT_EQUAL_STRING("first", cjson_get_array_item(array, 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("middle", cjson_get_array_item(array, 20)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("last", cjson_get_array_item(array, 42)->valuestring);
+
+    /* replacing */
+    TEST_ASSERT_TRUE(cjson_replace_item_in_array(array, 0, cjson_create_true()));
+    TEST_ASSERT_TRUE(cjson_replace_item_in_array(array, 42, cjson_create_false()));
+    assert_vector_matches_list(array);
+    TEST_ASSERT_TRUE(cjson_is_true(cjson_get_array_item(array, 0)));
+    TEST_ASSERT_TRUE(cjson_is_false(cjson_get_array_item(array, 42)));
+
+    /* detaching the first, the last and one in the middle */
+    cjson_delete_item_from_array(array, 0);
+    cjson_delete_item_from_array(array, 41);
+    cjson_delete(cjson_detach_item_via_pointer(array, cjson_get_array_item(array, 19)));
+    assert_vector_matches_list(array);
+    TEST_ASSERT_EQUAL_INT(40, cjson_get_array_size(array));
+    for (i = 0; i < 40; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, cjson_get_array_item(array, i)->valueint);
+    }
+
+    /* emptying it */
+    while (array->child != NULL)
+    {
+        cjson_delete_item_from_array(array, 0);
+    }
+    TEST_ASSERT_EQUAL_INT(0, cjson_get_array_size(array));
+    TEST_ASSERT_NULL(cjson_get_array_item(array, 0));
+
+    cjson_delete(array);
+}
+
+static void vector_should_not_be_shifted_when_detaching(void)
+{
+    cjson_t *array = cjson_create_array();
+    cjson_index_t before;
+    int i = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+    }
+
+    /* taking elements off the front moves the start of the vector instead of the rest */
+    for (i = 0; i < 500; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, cjson_get_array_item(array, 0)->valueint);
+        cjson_delete_item_from_array(array, 0);
+    }
+    TEST_ASSERT_EQUAL_UINT(500, (unsigned int)array->index->first);
+    TEST_ASSERT_EQUAL_INT(500, cjson_get_array_size(array));
+    TEST_ASSERT_EQUAL_INT(700, cjson_get_array_item(array, 200)->valueint);
+
+    /* the last one is removed in place, others refill the vector right away */
+    cjson_delete_item_from_array(array, 499);
+    TEST_ASSERT_EQUAL_UINT(500, (unsigned int)array->index->first);
+    TEST_ASSERT_TRUE(cjson_replace_item_in_array(array, 250, cjson_create_null()));
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)array->index->first);
+    assert_vector_matches_list(array);
+    cjson_delete_item_from_array(array, 100);
+    assert_vector_matches_list(array);
+
+    /* lookups only read the vector, so concurrent readers are safe */
+    before = *array->index;
+    TEST_ASSERT_TRUE(cjson_is_null(cjson_get_array_item(array, 249)));
+    TEST_ASSERT_EQUAL_MEMORY(&before, array->index, sizeof(before));
+
+    /* appending after the front was emptied, then growing it past its capacity */
+    for (i = 0; i < 400; i++)
+    {
+        cjson_delete_item_from_array(array, 0);
+    }
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(array, 3, cjson_create_string("three")));
+    for (i = 0; i < 2000; i++)
+    {
+        cjson_add_item_to_array(array, cjson_create_number(i));
+    }
+    assert_vector_matches_list(array);
+    TEST_ASSERT_EQUAL_STRING("three", cjson_get_array_item(array, 3)->valuestring);
+    TEST_ASSERT_EQUAL_INT(2099, cjson_get_array_size(array));
+
+    cjson_delete(array);
+}
+
+static void vector_should_be_copied_but_not_referenced(void)
+{
+    cjson_t *array = cjson_parse("[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]");
+    cjson_t *copy = cjson_duplicate(array, true);
+    cjson_t *container = cjson_create_array();
+
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_NULL(copy->index);
+    cjson_delete(copy);
+    TEST_ASSERT_TRUE(cjson_build_indexes(array));
+    copy = cjson_duplicate(array, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    assert_vector_matches_list(copy);
+
+    TEST_ASSERT_TRUE(cjson_add_item_reference_to_array(container, array));
+    TEST_ASSERT_NULL(container->child->index);
+    TEST_ASSERT_FALSE(cjson_array_build_index(container->child));
+    TEST_ASSERT_EQUAL_INT(20, cjson_get_array_size(container->child));
+    TEST_ASSERT_EQUAL_INT(19, cjson_get_array_item(container->child, 19)->valueint);
+
+    cjson_delete(container);
+    cjson_delete(copy);
+    cjson_delete(array);
+}
+
+static void vector_should_work_in_arenas(void)
+{
+    const char json[] = "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]";
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *parsed = NULL;
+    int i = 0;
+
+    parsed = cjson_parse_into_arena(arena, json, sizeof(json));
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_TRUE(cjson_build_indexes(parsed));
+    assert_vector_matches_list(parsed);
+    TEST_ASSERT_FALSE(cjson_array_build_index(parsed));
+
+    /* growing an arena vector past its capacity drops it */
+    for (i = 0; i < 20; i++)
+    {
+        cjson_add_item_to_array(parsed, cjson_create_null());
+    }
+    TEST_ASSERT_NULL(parsed->index);
+    TEST_ASSERT_EQUAL_INT(40, cjson_get_array_size(parsed));
+    TEST_ASSERT_TRUE(cjson_is_null(cjson_get_array_item(parsed, 39)));
+    for (i = 0; i < 20; i++)
+    {
+        cjson_delete_item_from_array(parsed, 20);
+    }
+
+    cjson_arena_delete(arena);
+}
+
+static void array_index_functions_should_handle_invalid_input(void)
+{
+    cjson_t *object = cjson_create_object();
+
+    TEST_ASSERT_FALSE(cjson_array_build_index(NULL));
+    TEST_ASSERT_FALSE(cjson_array_build_index(object));
+
+    cjson_delete(object);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(vector_should_be_built_for_large_parsed_arrays_on_request);
+    RUN_TEST(vector_should_be_built_when_arrays_grow);
+    RUN_TEST(vector_should_follow_mutations);
+    RUN_TEST(vector_should_not_be_shifted_when_detaching);
+    RUN_TEST(vector_should_be_copied_but_not_referenced);
+    RUN_TEST(vector_should_work_in_arenas);
+    RUN_TEST(array_index_functions_should_handle_invalid_input);
+
+    return UNITY_END();
+}
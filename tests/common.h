@@ -33,11 +33,11 @@ void reset(cjson_t *item) {
     }
     if ((item->valuestring != NULL) && !(item->type & CJSON_IS_REFERENCE))
     {
-        global_hooks.deallocate(item->valuestring);
+        global_hooks.deallocate(item->valuestring, global_hooks.user);
     }
     if ((item->string != NULL) && !(item->type & CJSON_STRING_IS_CONST))
     {
-        global_hooks.deallocate(item->string);
+        global_hooks.deallocate(item->string, global_hooks.user);
     }
 
     memset(item, 0, sizeof(cjson_t));
@@ -189,6 +189,52 @@ static void cjson_compare_should_compare_objects(void)
                 false))
 }
 
+static void cjson_compare_should_compare_large_objects(void)
+{
+    cjson_t *a = cjson_create_object();
+    cjson_t *b = cjson_create_object();
+    char key[32];
+    int i = 0;
+
+    /* same members in opposite order, b has no index */
+    for (i = 0; i < 100; i++)
+    {
+        sprintf(key, "key%d", i);
+        cjson_add_number_to_object(a, key, i);
+        sprintf(key, "KEY%d", 99 - i);
+        cjson_add_number_to_object(b, key, 99 - i);
+    }
+    /* adding members indexed both, b goes back to a plain list */
+    TEST_ASSERT_NOT_NULL(b->index);
+    free_index(b);
+    TEST_ASSERT_TRUE(cjson_object_build_index(a));
+    TEST_ASSERT_TRUE(cjson_compare(a, b, false));
+    TEST_ASSERT_TRUE(cjson_compare(b, a, false));
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+    /* comparing doesn't modify the objects */
+    TEST_ASSERT_NULL(b->index);
+
+    CJSON_SET_NUMBER_VALUE(cjson_get_object_item(b, "key50"), 0);
+    TEST_ASSERT_FALSE(cjson_compare(a, b, false));
+    CJSON_SET_NUMBER_VALUE(cjson_get_object_item(b, "key50"), 50);
+    TEST_ASSERT_TRUE(cjson_compare(a, b, false));
+
+    /* a different number of members */
+    cjson_add_null_to_object(b, "extra");
+    TEST_ASSERT_FALSE(cjson_compare(a, b, false));
+    TEST_ASSERT_FALSE(cjson_compare(b, a, false));
+
+    cjson_delete(a);
+    cjson_delete(b);
+
+    /* duplicate keys */
+    TEST_ASSERT_TRUE(compare_from_string("{\"a\": 1, \"a\": 1}", "{\"a\": 1, \"a\": 1}", true));
+    TEST_ASSERT_FALSE(compare_from_string("{\"a\": 1, \"a\": 1}", "{\"a\": 1, \"a\": 2}", true));
+    TEST_ASSERT_FALSE(compare_from_string("{\"a\": 1, \"a\": 1}", "{\"a\": 1, \"b\": 1}", true));
+    TEST_ASSERT_FALSE(compare_from_string("{\"a\": 1, \"b\": 1}", "{\"a\": 1, \"a\": 1}", true));
+    TEST_ASSERT_FALSE(compare_from_string("{\"a\": 1, \"a\": 1}", "{\"a\": 1}", true));
+}
+
 int CJSON_CDECL main(void)
 {
     UNITY_BEGIN();
@@ -203,6 +249,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(cjson_compare_should_compare_raw);
     RUN_TEST(cjson_compare_should_compare_arrays);
     RUN_TEST(cjson_compare_should_compare_objects);
+    RUN_TEST(cjson_compare_should_compare_large_objects);
 
     return UNITY_END();
 }
@@ -0,0 +1,322 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cjson_bool_t digests_equal(const cjson_digest_t a, const cjson_digest_t b)
+{
+    return (a.low == b.low) && (a.high == b.high);
+}
+
+static cjson_digest_t hash_of(const char *json)
+{
+    cjson_t *item = cjson_parse(json);
+    cjson_digest_t digest;
+
+    TEST_ASSERT_NOT_NULL(item);
+    digest = cjson_hash(item, 0);
+    cjson_delete(item);
+
+    return digest;
+}
+
+static void hash_should_ignore_key_order(void)
+{
+    TEST_ASSERT_TRUE(digests_equal(hash_of("{\"a\": 1, \"b\": [true, null], \"c\": {\"d\": \"e\"}}"), hash_of("{\"c\": {\"d\": \"e\"}, \"B\": [true, null], \"a\": 1.0}")));
+    TEST_ASSERT_TRUE(digests_equal(hash_of("[]"), hash_of(" [ ] ")));
+
+    TEST_ASSERT_FALSE(digests_equal(hash_of("{\"a\": 1, \"b\": 2}"), hash_of("{\"a\": 2, \"b\": 1}")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("{\"a\": 1}"), hash_of("{\"b\": 1}")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("[1, 2]"), hash_of("[2, 1]")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("[[1], 2]"), hash_of("[1, [2]]")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("[]"), hash_of("{}")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("\"1\""), hash_of("1")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("true"), hash_of("false")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("\"abcdefgh\""), hash_of("\"abcdefghi\"")));
+    TEST_ASSERT_FALSE(digests_equal(hash_of("0"), hash_of("null")));
+}
+
+static void hash_should_cache_digests(void)
+{
+    cjson_t *root = cjson_parse("{\"list\": [1, {\"deep\": \"value\"}, 3], \"other\": {\"x\": false}}");
+    cjson_t *deep = NULL;
+    cjson_digest_t digest;
+
+    TEST_ASSERT_NOT_NULL(root);
+    deep = cjson_get_object_item(cjson_get_array_item(cjson_get_object_item(root, "list"), 1), "deep");
+    TEST_ASSERT_EQUAL_PTR(root, deep->parent->parent->parent);
+
+    digest = cjson_hash(root, 0);
+    TEST_ASSERT_NULL(cached_digest(root));
+    TEST_ASSERT_TRUE(digests_equal(digest, cjson_hash(root, CJSON_HASH_CACHE)));
+    TEST_ASSERT_NOT_NULL(cached_digest(root));
+    TEST_ASSERT_NOT_NULL(cached_digest(deep->parent));
+    TEST_ASSERT_TRUE(digests_equal(digest, cjson_hash(root, 0)));
+
+    /* changing an item drops the digests on the way up only */
+    cjson_set_value_string(deep, "changed");
+    TEST_ASSERT_NULL(cached_digest(deep->parent));
+    TEST_ASSERT_NULL(cached_digest(deep->parent->parent));
+    TEST_ASSERT_NULL(cached_digest(root));
+    TEST_ASSERT_NOT_NULL(cached_digest(cjson_get_object_item(root, "other")));
+    TEST_ASSERT_FALSE(digests_equal(digest, cjson_hash(root, CJSON_HASH_CACHE)));
+
+    cjson_set_value_string(deep, "value");
+    TEST_ASSERT_TRUE(digests_equal(digest, cjson_hash(root, CJSON_HASH_CACHE)));
+
+    cjson_delete(root);
+}
+
+/* hashing with the cache gives the same digest as hashing a fresh copy */
+static void assert_cache_matches(cjson_t *item)
+{
+    char *printed = cjson_print(item);
+    cjson_t *copy = cjson_parse(printed);
+
+    TEST_ASSERT_TRUE(digests_equal(cjson_hash(copy, 0), cjson_hash(item, CJSON_HASH_CACHE)));
+
+    cjson_delete(copy);
+    cjson_free(printed);
+}
+
+static void mutations_should_drop_cached_digests(void)
+{
+    cjson_t *root = cjson_parse("{\"a\": {\"b\": [1, 2, 3]}}");
+    cjson_t *array = cjson_get_object_item(cjson_get_object_item(root, "a"), "b");
+    cjson_t *detached = NULL;
+
+    TEST_ASSERT_NOT_NULL(root);
+#define ASSERT_DROPPED(mutation) \
+    cjson_hash(root, CJSON_HASH_CACHE); \
+    mutation; \
+    TEST_ASSERT_NULL(cached_digest(root)); \
+    assert_cache_matches(root)
+
+    ASSERT_DROPPED(cjson_add_item_to_array(array, cjson_create_number(4)));
+    ASSERT_DROPPED(cjson_insert_item_in_array(array, 0, cjson_create_number(0)));
+    ASSERT_DROPPED(cjson_replace_item_in_array(array, 1, cjson_create_string("one")));
+    ASSERT_DROPPED(cjson_delete_item_from_array(array, 0));
+    ASSERT_DROPPED(cjson_add_number_to_object(cjson_get_object_item(root, "a"), "c", 1));
+    ASSERT_DROPPED(cjson_replace_item_in_object(cjson_get_object_item(root, "a"), "c", cjson_create_null()));
+    ASSERT_DROPPED(CJSON_SET_NUMBER_VALUE(cjson_get_array_item(array, 1), 42));
+    ASSERT_DROPPED(CJSON_SET_INT_VALUE(cjson_get_array_item(array, 1), 43));
+    ASSERT_DROPPED(detached = cjson_detach_item_from_object(root, "a"));
+#undef ASSERT_DROPPED
+
+    TEST_ASSERT_NULL(detached->parent);
+    TEST_ASSERT_NOT_NULL(cached_digest(detached));
+
+    cjson_delete(detached);
+    cjson_delete(root);
+}
+
+static void references_should_not_be_cached(void)
+{
+    cjson_t *shared = cjson_parse("[1, 2]");
+    cjson_t *root = cjson_create_object();
+    cjson_digest_t digest;
+
+    cjson_add_item_reference_to_object(root, "shared", shared);
+    digest = cjson_hash(root, CJSON_HASH_CACHE);
+    TEST_ASSERT_NULL(cached_digest(root));
+    TEST_ASSERT_NULL(cached_digest(root->child));
+
+    /* changing the original changes the digest of the tree that references it */
+    cjson_add_item_to_array(shared, cjson_create_number(3));
+    TEST_ASSERT_FALSE(digests_equal(digest, cjson_hash(root, CJSON_HASH_CACHE)));
+
+    cjson_delete(root);
+    cjson_delete(shared);
+}
+
+static void compare_should_use_cached_digests(void)
+{
+    cjson_t *a = cjson_parse("{\"x\": [1, 2, {\"y\": \"z\"}], \"w\": 3}");
+    cjson_t *b = cjson_parse("{\"w\": 3, \"x\": [1, 2, {\"y\": \"Z\"}]}");
+
+    cjson_hash(a, CJSON_HASH_CACHE);
+    cjson_hash(b, CJSON_HASH_CACHE);
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+
+    /* a direct change that isn't reported leaves the outdated digests in place */
+    cjson_get_object_item(cjson_get_array_item(cjson_get_object_item(b, "x"), 2), "y")->valuestring[0] = 'z';
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+    cjson_hash_invalidate(cjson_get_object_item(cjson_get_array_item(cjson_get_object_item(b, "x"), 2), "y"));
+    TEST_ASSERT_TRUE(cjson_compare(a, b, true));
+
+    /* equal digests still compare the items */
+    cjson_hash(b, CJSON_HASH_CACHE);
+    cjson_get_object_item(b, "w")->valuedouble = 4;
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+
+    cjson_delete(a);
+    cjson_delete(b);
+}
+
+static void setter_macros_should_drop_cached_digests(void)
+{
+    cjson_t *a = cjson_parse("{\"flag\": true, \"count\": 1}");
+    cjson_t *b = cjson_parse("{\"flag\": false, \"count\": 2}");
+
+    cjson_hash(a, CJSON_HASH_CACHE);
+    cjson_hash(b, CJSON_HASH_CACHE);
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+
+    /* the trees become equal, outdated digests would still tell them apart */
+    TEST_ASSERT_EQUAL_INT(CJSON_TRUE, CJSON_SET_BOOL_VALUE(cjson_get_object_item(b, "flag"), 1));
+    TEST_ASSERT_NULL(cached_digest(b));
+    cjson_hash(b, CJSON_HASH_CACHE);
+    TEST_ASSERT_EQUAL_INT(1, CJSON_SET_INT_VALUE(cjson_get_object_item(b, "count"), 1));
+    TEST_ASSERT_NULL(cached_digest(b));
+    TEST_ASSERT_TRUE(cjson_compare(a, b, true));
+    TEST_ASSERT_TRUE(digests_equal(cjson_hash(a, CJSON_HASH_CACHE), cjson_hash(b, CJSON_HASH_CACHE)));
+
+    cjson_delete(a);
+    cjson_delete(b);
+}
+
+static void compare_should_not_trust_approximate_digests(void)
+{
+    cjson_t *a = cjson_create_array();
+    cjson_t *b = cjson_create_array();
+    cjson_t *c = cjson_parse("{\"x\": 1, \"X\": 1, \"y\": 1}");
+    cjson_t *d = cjson_parse("{\"x\": 1, \"y\": 1, \"Y\": 1}");
+
+    /* numbers that are only approximately equal */
+    cjson_add_item_to_array(a, cjson_create_number(0.1 + 0.2));
+    cjson_add_item_to_array(b, cjson_create_number(0.3));
+    TEST_ASSERT_FALSE(digests_equal(cjson_hash(a, CJSON_HASH_CACHE), cjson_hash(b, CJSON_HASH_CACHE)));
+    TEST_ASSERT_TRUE(cjson_compare(a, b, true));
+
+    /* duplicate keys */
+    TEST_ASSERT_FALSE(digests_equal(cjson_hash(c, CJSON_HASH_CACHE), cjson_hash(d, CJSON_HASH_CACHE)));
+    TEST_ASSERT_TRUE(cjson_compare(c, d, false));
+
+    cjson_delete(a);
+    cjson_delete(b);
+    cjson_delete(c);
+    cjson_delete(d);
+}
+
+static void hash_should_handle_large_objects(void)
+{
+    cjson_t *a = cjson_create_object();
+    cjson_t *b = NULL;
+    char *printed = NULL;
+    char key[32];
+    int i = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        sprintf(key, "key%d", i);
+        cjson_add_number_to_object(a, key, i);
+    }
+    printed = cjson_print(a);
+    b = cjson_parse(printed);
+
+    /* b has an index, a doesn't */
+    free_index(a);
+    TEST_ASSERT_TRUE(cjson_build_indexes(b));
+    TEST_ASSERT_NOT_NULL(b->index);
+    TEST_ASSERT_TRUE(digests_equal(cjson_hash(a, CJSON_HASH_CACHE), cjson_hash(b, CJSON_HASH_CACHE)));
+    TEST_ASSERT_TRUE(cjson_compare(a, b, true));
+    CJSON_SET_NUMBER_VALUE(cjson_get_object_item(b, "key7"), 8);
+    cjson_hash(b, CJSON_HASH_CACHE);
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+
+    cjson_free(printed);
+    cjson_delete(a);
+    cjson_delete(b);
+}
+
+static void digests_should_be_kept_with_the_index(void)
+{
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *small = cjson_parse("{\"a\": [1, 2]}");
+    cjson_t *in_arena = NULL;
+    cjson_t *large = cjson_create_array();
+    cjson_digest_t digest;
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(arena);
+    TEST_ASSERT_NOT_NULL(small);
+    TEST_ASSERT_NOT_NULL(large);
+
+    /* without a lookup table, the index only holds the digest */
+    cjson_hash(small, CJSON_HASH_CACHE);
+    TEST_ASSERT_NOT_NULL(cached_digest(small));
+    TEST_ASSERT_FALSE(has_lookup_table(small->index));
+    TEST_ASSERT_EQUAL_INT(2, cjson_get_array_size(cjson_get_object_item(small, "a")));
+    cjson_add_number_to_object(small, "b", 3);
+    TEST_ASSERT_NULL(cached_digest(small));
+    assert_cache_matches(small);
+
+    in_arena = cjson_parse_into_arena(arena, "{\"a\": [1, 2]}", 14);
+    TEST_ASSERT_NOT_NULL(in_arena);
+    cjson_hash(in_arena, CJSON_HASH_CACHE);
+    TEST_ASSERT_NOT_NULL(cached_digest(in_arena));
+    TEST_ASSERT_TRUE(in_arena->index->in_arena);
+
+    /* building the lookup table keeps the digest */
+    for (i = 0; i < 4; i++)
+    {
+        cjson_add_item_to_array(large, cjson_create_number(i));
+    }
+    digest = cjson_hash(large, CJSON_HASH_CACHE);
+    TEST_ASSERT_TRUE(cjson_array_build_index(large));
+    TEST_ASSERT_TRUE(has_lookup_table(large->index));
+    TEST_ASSERT_NOT_NULL(cached_digest(large));
+    TEST_ASSERT_TRUE(digests_equal(digest, cjson_hash(large, 0)));
+
+    cjson_delete(small);
+    cjson_delete(large);
+    cjson_arena_delete(arena);
+}
+
+static void hash_should_handle_null(void)
+{
+    cjson_digest_t digest = cjson_hash(NULL, CJSON_HASH_CACHE);
+
+    TEST_ASSERT_TRUE((digest.low == 0) && (digest.high == 0));
+    cjson_hash_invalidate(NULL);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(hash_should_ignore_key_order);
+    RUN_TEST(hash_should_cache_digests);
+    RUN_TEST(mutations_should_drop_cached_digests);
+    RUN_TEST(references_should_not_be_cached);
+    RUN_TEST(compare_should_use_cached_digests);
+    RUN_TEST(setter_macros_should_drop_cached_digests);
+    RUN_TEST(compare_should_not_trust_approximate_digests);
+    RUN_TEST(hash_should_handle_large_objects);
+    RUN_TEST(digests_should_be_kept_with_the_index);
+    RUN_TEST(hash_should_handle_null);
+
+    return UNITY_END();
+}
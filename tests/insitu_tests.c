@@ -0,0 +1,166 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cjson_bool_t points_into(const char * const string, const char * const buffer, const size_t length)
+{
+    size_t i = 0;
+
+    /* compare addresses one by one, relational operators aren't defined between unrelated pointers */
+    for (i = 0; i < length; i++)
+    {
+        if (string == (buffer + i))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void insitu_should_unescape_strings_into_the_buffer(void)
+{
+    char json[] = "{\"a\\u00e9\": \"x\\ty\", \"plain\": \"abc\", \"list\": [\"\\\"q\\\"\", \"\\ud83d\\ude00\", 1, true]}";
+    cjson_t *tree = cjson_parse(json);
+    cjson_t *item = NULL;
+    char *printed = NULL;
+
+    item = cjson_parse_insitu(json, sizeof(json) - 1);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_NOT_NULL(tree);
+    TEST_ASSERT_TRUE(cjson_compare(tree, item, true));
+
+    TEST_ASSERT_EQUAL_STRING("a\xc3\xa9", item->child->string);
+    TEST_ASSERT_EQUAL_STRING("x\ty", item->child->valuestring);
+    TEST_ASSERT_TRUE(points_into(item->child->string, json, sizeof(json)));
+    TEST_ASSERT_TRUE(points_into(item->child->valuestring, json, sizeof(json)));
+    TEST_ASSERT_BITS_HIGH(CJSON_IN_SITU | CJSON_IS_REFERENCE | CJSON_STRING_IS_CONST, item->child->type);
+
+    TEST_ASSERT_EQUAL_STRING("abc", cjson_get_object_item(item, "plain")->valuestring);
+    TEST_ASSERT_TRUE(points_into(cjson_get_object_item(item, "plain")->valuestring, json, sizeof(json)));
+    TEST_ASSERT_EQUAL_STRING("\"q\"", cjson_get_array_item(cjson_get_object_item(item, "list"), 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("\xf0\x9f\x98\x80", cjson_get_array_item(cjson_get_object_item(item, "list"), 1)->valuestring);
+
+    /* containers and numbers have no strings in the buffer */
+    TEST_ASSERT_BITS_LOW(CJSON_IS_REFERENCE, item->type);
+    TEST_ASSERT_BITS_LOW(CJSON_IS_REFERENCE, cjson_get_array_item(cjson_get_object_item(item, "list"), 2)->type);
+
+    printed = cjson_print_unformatted(item);
+    TEST_ASSERT_NOT_NULL(printed);
+    TEST_ASSERT_EQUAL_STRING("{\"a\xc3\xa9\":\"x\\ty\",\"plain\":\"abc\",\"list\":[\"\\\"q\\\"\",\"\xf0\x9f\x98\x80\",1,true]}", printed);
+
+    cjson_free(printed);
+    cjson_delete(item);
+    cjson_delete(tree);
+}
+
+static void insitu_should_keep_modified_trees_apart_from_the_buffer(void)
+{
+    char json[] = "{\"key\": \"value\", \"other\": \"text\", \"gone\": \"away\"}";
+    cjson_t *item = cjson_parse_insitu(json, sizeof(json) - 1);
+    cjson_t *copy = NULL;
+    cjson_t *detached = NULL;
+
+    TEST_ASSERT_NOT_NULL(item);
+
+    /* a shorter string is overwritten in place, a longer one is copied out of the buffer */
+    TEST_ASSERT_EQUAL_STRING("val", cjson_set_value_string(cjson_get_object_item(item, "key"), "val"));
+    TEST_ASSERT_TRUE(points_into(cjson_get_object_item(item, "key")->valuestring, json, sizeof(json)));
+    TEST_ASSERT_EQUAL_STRING("a longer value", cjson_set_value_string(cjson_get_object_item(item, "other"), "a longer value"));
+    TEST_ASSERT_FALSE(points_into(cjson_get_object_item(item, "other")->valuestring, json, sizeof(json)));
+    TEST_ASSERT_BITS_LOW(CJSON_IS_REFERENCE, cjson_get_object_item(item, "other")->type);
+
+    /* replacing and detaching items don't free strings from the buffer */
+    TEST_ASSERT_TRUE(cjson_replace_item_in_object(item, "key", cjson_create_string("new")));
+    detached = cjson_detach_item_from_object(item, "gone");
+    TEST_ASSERT_NOT_NULL(detached);
+    TEST_ASSERT_TRUE(cjson_add_item_to_object(item, "back", detached));
+    TEST_ASSERT_EQUAL_STRING("away", cjson_get_object_item(item, "back")->valuestring);
+
+    /* duplicates don't depend on the buffer */
+    copy = cjson_duplicate(item, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    memset(json, 'x', sizeof(json) - 1);
+    TEST_ASSERT_EQUAL_STRING("new", cjson_get_object_item(copy, "key")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("a longer value", cjson_get_object_item(copy, "other")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("away", cjson_get_object_item(copy, "back")->valuestring);
+    TEST_ASSERT_BITS_LOW(CJSON_IN_SITU | CJSON_IS_REFERENCE | CJSON_STRING_IS_CONST, cjson_get_object_item(copy, "other")->type);
+
+    cjson_delete(item);
+    cjson_delete(copy);
+}
+
+static void insitu_should_index_large_objects(void)
+{
+    char json[4096];
+    size_t length = 0;
+    cjson_t *item = NULL;
+    int i = 0;
+
+    json[length++] = '{';
+    for (i = 0; i < 100; i++)
+    {
+        length += (size_t)sprintf(json + length, "%s\"key\\u0030%d\": \"value %d\"", (i == 0) ? "" : ", ", i, i);
+    }
+    json[length++] = '}';
+
+    item = cjson_parse_insitu(json, length);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(100, cjson_get_array_size(item));
+    TEST_ASSERT_EQUAL_STRING("value 0", cjson_get_object_item(item, "key00")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("value 57", cjson_get_object_item(item, "key057")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("value 99", cjson_get_object_item_case_sensitive(item, "key099")->valuestring);
+
+    cjson_delete(item);
+}
+
+static void insitu_should_fail_without_leaking(void)
+{
+    char unterminated[] = "{\"a\": \"b\", \"c\": [\"d\", \"e";
+    char invalid_escape[] = "[\"abc\", \"x\\q\"]";
+    char control_character[] = "[\"abc\", \"x\\ty\nz\"]";
+    char missing_value[] = "{\"a\": \"b\", \"c\": }";
+    char empty[] = "";
+
+    TEST_ASSERT_NULL(cjson_parse_insitu(unterminated, sizeof(unterminated) - 1));
+    TEST_ASSERT_NULL(cjson_parse_insitu(invalid_escape, sizeof(invalid_escape) - 1));
+    TEST_ASSERT_NULL(cjson_parse_insitu(control_character, sizeof(control_character) - 1));
+    TEST_ASSERT_NULL(cjson_parse_insitu(missing_value, sizeof(missing_value) - 1));
+    TEST_ASSERT_TRUE(cjson_get_error_ptr() == (missing_value + 16));
+    TEST_ASSERT_NULL(cjson_parse_insitu(empty, 0));
+    TEST_ASSERT_NULL(cjson_parse_insitu(NULL, 10));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(insitu_should_unescape_strings_into_the_buffer);
+    RUN_TEST(insitu_should_keep_modified_trees_apart_from_the_buffer);
+    RUN_TEST(insitu_should_index_large_objects);
+    RUN_TEST(insitu_should_fail_without_leaking);
+
+    return UNITY_END();
+}
@@ -29,38 +29,38 @@
 #include "common.h"
 #include "../cjson_utils.h"
 
-static cJSON *parse_test_file(const char * const filename)
+static cjson_t *parse_test_file(const char * const filename)
 {
     char *file = NULL;
-    cJSON *json = NULL;
+    cjson_t *json = NULL;
 
     file = read_file(filename);
     TEST_ASSERT_NOT_NULL_MESSAGE(file, "Failed to read file.");
 
-    json = cJSON_Parse(file);
+    json = cjson_parse(file);
     TEST_ASSERT_NOT_NULL_MESSAGE(json, "Failed to parse test json.");
-    TEST_ASSERT_TRUE_MESSAGE(cJSON_IsArray(json), "Json is not an array.");
+    TEST_ASSERT_TRUE_MESSAGE(cjson_is_array(json), "Json is not an array.");
 
     free(file);
 
     return json;
 }
 
-static cJSON_bool test_apply_patch(const cJSON * const test)
+static cjson_bool_t test_apply_patch(const cjson_t * const test)
 {
-    cJSON *doc = NULL;
-    cJSON *patch = NULL;
-    cJSON *expected = NULL;
-    cJSON *error_element = NULL;
-    cJSON *comment = NULL;
-    cJSON *disabled = NULL;
+    cjson_t *doc = NULL;
+    cjson_t *patch = NULL;
+    cjson_t *expected = NULL;
+    cjson_t *error_element = NULL;
+    cjson_t *comment = NULL;
+    cjson_t *disabled = NULL;
 
-    cJSON *object = NULL;
-    cJSON_bool successful = false;
+    cjson_t *object = NULL;
+    cjson_bool_t successful = false;
 
     /* extract all the data out of the test */
-    comment = cJSON_GetObjectItemCaseSensitive(test, "comment");
-    if (cJSON_IsString(comment))
+    comment = cjson_get_object_item_case_sensitive(test, "comment");
+    if (cjson_is_string(comment))
     {
         printf("Testing \"%s\"\n", comment->valuestring);
     }
@@ -69,23 +69,23 @@ static cJSON_bool test_apply_patch(const cJSON * const test)
         printf("Testing unknown\n");
     }
 
-    disabled = cJSON_GetObjectItemCaseSensitive(test, "disabled");
-    if (cJSON_IsTrue(disabled))
+    disabled = cjson_get_object_item_case_sensitive(test, "disabled");
+    if (cjson_is_true(disabled))
     {
         printf("SKIPPED\n");
         return true;
     }
 
-    doc = cJSON_GetObjectItemCaseSensitive(test, "doc");
+    doc = cjson_get_object_item_case_sensitive(test, "doc");
     TEST_ASSERT_NOT_NULL_MESSAGE(doc, "No \"doc\" in the test.");
-    patch = cJSON_GetObjectItemCaseSensitive(test, "patch");
+    patch = cjson_get_object_item_case_sensitive(test, "patch");
     TEST_ASSERT_NOT_NULL_MESSAGE(patch, "No \"patch\"in the test.");
     /* Make a working copy of 'doc' */
-    object = cJSON_Duplicate(doc, true);
+    object = cjson_duplicate(doc, true);
     TEST_ASSERT_NOT_NULL(object);
 
-    expected = cJSON_GetObjectItemCaseSensitive(test, "expected");
-    error_element = cJSON_GetObjectItemCaseSensitive(test, "error");
+    expected = cjson_get_object_item_case_sensitive(test, "expected");
+    error_element = cjson_get_object_item_case_sensitive(test, "error");
     if (error_element != NULL)
     {
         /* excepting an error */
@@ -101,11 +101,11 @@ static cJSON_bool test_apply_patch(const cJSON * const test)
 
         if (expected != NULL)
         {
-            successful = cJSON_Compare(object, expected, true);
+            successful = cjson_compare(object, expected, true);
         }
     }
 
-    cJSON_Delete(object);
+    cjson_delete(object);
 
     if (successful)
     {
@@ -119,36 +119,36 @@ static cJSON_bool test_apply_patch(const cJSON * const test)
     return successful;
 }
 
-static cJSON_bool test_generate_test(cJSON *test)
+static cjson_bool_t test_generate_test(cjson_t *test)
 {
-    cJSON *doc = NULL;
-    cJSON *patch = NULL;
-    cJSON *expected = NULL;
-    cJSON *disabled = NULL;
+    cjson_t *doc = NULL;
+    cjson_t *patch = NULL;
+    cjson_t *expected = NULL;
+    cjson_t *disabled = NULL;
 
-    cJSON *object = NULL;
-    cJSON_bool successful = false;
+    cjson_t *object = NULL;
+    cjson_bool_t successful = false;
 
     char *printed_patch = NULL;
 
-    disabled = cJSON_GetObjectItemCaseSensitive(test, "disabled");
-    if (cJSON_IsTrue(disabled))
+    disabled = cjson_get_object_item_case_sensitive(test, "disabled");
+    if (cjson_is_true(disabled))
     {
         printf("SKIPPED\n");
         return true;
     }
 
-    doc = cJSON_GetObjectItemCaseSensitive(test, "doc");
+    doc = cjson_get_object_item_case_sensitive(test, "doc");
     TEST_ASSERT_NOT_NULL_MESSAGE(doc, "No \"doc\" in the test.");
 
     /* Make a working copy of 'doc' */
-    object = cJSON_Duplicate(doc, true);
+    object = cjson_duplicate(doc, true);
     TEST_ASSERT_NOT_NULL(object);
 
-    expected = cJSON_GetObjectItemCaseSensitive(test, "expected");
+    expected = cjson_get_object_item_case_sensitive(test, "expected");
     if (expected == NULL)
     {
-        cJSON_Delete(object);
+        cjson_delete(object);
         /* if there is no expected output, this test doesn't make sense */
         return true;
     }
@@ -156,17 +156,17 @@ static cJSON_bool test_generate_test(cJSON *test)
     patch = cJSONUtils_GeneratePatchesCaseSensitive(doc, expected);
     TEST_ASSERT_NOT_NULL_MESSAGE(patch, "Failed to generate patches.");
 
-    printed_patch = cJSON_Print(patch);
+    printed_patch = cjson_print(patch);
     printf("%s\n", printed_patch);
     free(printed_patch);
 
     /* apply the generated patch */
     TEST_ASSERT_EQUAL_INT_MESSAGE(0, cJSONUtils_ApplyPatchesCaseSensitive(object, patch), "Failed to apply generated patch.");
 
-    successful = cJSON_Compare(object, expected, true);
+    successful = cjson_compare(object, expected, true);
 
-    cJSON_Delete(patch);
-    cJSON_Delete(object);
+    cjson_delete(patch);
+    cjson_delete(object);
 
     if (successful)
     {
@@ -182,51 +182,51 @@ static cJSON_bool test_generate_test(cJSON *test)
 
 static void cjson_utils_should_pass_json_patch_test_tests(void)
 {
-    cJSON *tests = parse_test_file("json-patch-tests/tests.json");
-    cJSON *test = NULL;
+    cjson_t *tests = parse_test_file("json-patch-tests/tests.json");
+    cjson_t *test = NULL;
 
-    cJSON_bool failed = false;
-    cJSON_ArrayForEach(test, tests)
+    cjson_bool_t failed = false;
+    for (test = tests->child; test != NULL; test = test->next)
     {
         failed |= !test_apply_patch(test);
         failed |= !test_generate_test(test);
     }
 
-    cJSON_Delete(tests);
+    cjson_delete(tests);
 
     TEST_ASSERT_FALSE_MESSAGE(failed, "Some tests failed.");
 }
 
 static void cjson_utils_should_pass_json_patch_test_spec_tests(void)
 {
-    cJSON *tests = parse_test_file("json-patch-tests/spec_tests.json");
-    cJSON *test = NULL;
+    cjson_t *tests = parse_test_file("json-patch-tests/spec_tests.json");
+    cjson_t *test = NULL;
 
-    cJSON_bool failed = false;
-    cJSON_ArrayForEach(test, tests)
+    cjson_bool_t failed = false;
+    for (test = tests->child; test != NULL; test = test->next)
     {
         failed |= !test_apply_patch(test);
         failed |= !test_generate_test(test);
     }
 
-    cJSON_Delete(tests);
+    cjson_delete(tests);
 
     TEST_ASSERT_FALSE_MESSAGE(failed, "Some tests failed.");
 }
 
 static void cjson_utils_should_pass_json_patch_test_cjson_utils_tests(void)
 {
-    cJSON *tests = parse_test_file("json-patch-tests/cjson-utils-tests.json");
-    cJSON *test = NULL;
+    cjson_t *tests = parse_test_file("json-patch-tests/cjson-utils-tests.json");
+    cjson_t *test = NULL;
 
-    cJSON_bool failed = false;
-    cJSON_ArrayForEach(test, tests)
+    cjson_bool_t failed = false;
+    for (test = tests->child; test != NULL; test = test->next)
     {
         failed |= !test_apply_patch(test);
         failed |= !test_generate_test(test);
     }
 
-    cJSON_Delete(tests);
+    cjson_delete(tests);
 
     TEST_ASSERT_FALSE_MESSAGE(failed, "Some tests failed.");
 }
@@ -221,7 +221,7 @@ static void cjson_should_not_parse_to_deeply_nested_jsons(void)
 
 static void cjson_set_number_value_should_set_numbers(void)
 {
-    cjson_t number[1] = {{NULL, NULL, NULL, CJSON_NUMBER, NULL, 0, 0, NULL}};
+    cjson_t number[1] = {{NULL, NULL, NULL, CJSON_NUMBER, NULL, 0, 0, 0, NULL, 0, NULL, NULL, 0}};
 
     CJSON_SET_NUMBER_VALUE(number, 1.5);
     TEST_ASSERT_EQUAL(1, number->valueint);
@@ -246,6 +246,7 @@ static void cjson_detach_item_via_pointer_should_detach_items(void)
     cjson_t parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -328,7 +329,7 @@ static void cjson_replace_item_via_pointer_should_replace_items(void)
 
 static void cjson_replace_item_in_object_should_preserve_name(void)
 {
-    cjson_t root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, NULL}};
+    cjson_t root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, 0, NULL, 0, NULL, NULL, 0}};
     cjson_t *child = NULL;
     cjson_t *replacement = NULL;
     cjson_bool_t flag = false;
@@ -348,6 +349,205 @@ static void cjson_replace_item_in_object_should_preserve_name(void)
     cjson_delete(replacement);
 }
 
+static void cjson_print_size_should_be_exact(void)
+{
+    const char *const documents[] = {
+        "null",
+        "[]",
+        "{}",
+        "[1, -2.5, 1e+300, 9007199254740993, true, false, null]",
+        "{\"a\": {\"b\": [{}, [], {\"c\": \"\\u0001\\n\\\"\"}]}, \"\": \"\", \"d\": [[[{\"e\": 0.1}]]]}",
+        "[{\"nested\": {\"deeper\": {\"deepest\": [1, {\"x\": null}]}}}, \"tail\"]"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(documents) / sizeof(documents[0])); i++)
+    {
+        cjson_t *item = cjson_parse(documents[i]);
+        int format = 0;
+        TEST_ASSERT_NOT_NULL(item);
+
+        for (format = 0; format < 2; format++)
+        {
+            char *printed = format ? cjson_print(item) : cjson_print_unformatted(item);
+            size_t size = cjson_print_size(item, format);
+            char *exact = NULL;
+            TEST_ASSERT_NOT_NULL(printed);
+            TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(printed), size, documents[i]);
+
+            /* the exact size is enough for cjson_print_preallocated, one byte less isn't */
+            exact = (char*)malloc(size + 1);
+            TEST_ASSERT_NOT_NULL(exact);
+            TEST_ASSERT_FALSE(cjson_print_preallocated(item, exact, (int)size, format));
+            TEST_ASSERT_TRUE(cjson_print_preallocated(item, exact, (int)size + 1, format));
+            TEST_ASSERT_EQUAL_STRING(printed, exact);
+
+            free(exact);
+            cjson_free(printed);
+        }
+        cjson_delete(item);
+    }
+}
+
+static int allocations = 0;
+static void *CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL counting_free(void *pointer)
+{
+    free(pointer);
+}
+
+static void *CJSON_CDECL failing_malloc(size_t size)
+{
+    (void)size;
+    return NULL;
+}
+
+static void cjson_print_should_allocate_once(void)
+{
+    cjson_hooks_t hooks = { counting_malloc, counting_free };
+    cjson_t *item = cjson_parse("{\"key\": [\"a long enough string to need more than the old 256 byte default buffer ...........................................................................................................................................................................\", 1, 2, 3]}");
+    char *printed = NULL;
+    TEST_ASSERT_NOT_NULL(item);
+
+    cjson_init_hooks(&hooks);
+    allocations = 0;
+    printed = cjson_print(item);
+    TEST_ASSERT_NOT_NULL(printed);
+    TEST_ASSERT_EQUAL_INT(1, allocations);
+    cjson_free(printed);
+    cjson_init_hooks(NULL);
+
+    cjson_delete(item);
+}
+
+static void *CJSON_CDECL counting_allocator_malloc(size_t size, void *user)
+{
+    (void)user;
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL counting_allocator_free(void *pointer, void *user)
+{
+    (void)user;
+    free(pointer);
+}
+
+static void *CJSON_CDECL counting_allocator_realloc(void *pointer, size_t size, void *user)
+{
+    (*(int*)user)++;
+    return realloc(pointer, size);
+}
+
+static void cjson_init_allocator_should_use_realloc_fn(void)
+{
+    cjson_allocator_t allocator = { counting_allocator_malloc, counting_allocator_free, counting_allocator_realloc, NULL };
+    cjson_hooks_t hooks = { counting_malloc, counting_free };
+    int reallocations = 0;
+    cjson_t *item = cjson_parse("[\"a string that doesn't fit into the initial buffer\"]");
+    char *printed = NULL;
+    TEST_ASSERT_NOT_NULL(item);
+    allocator.user = &reallocations;
+
+    TEST_ASSERT_TRUE(cjson_init_allocator(&allocator));
+    allocations = 0;
+    printed = cjson_print_buffered(item, 1, false);
+    TEST_ASSERT_EQUAL_STRING("[\"a string that doesn't fit into the initial buffer\"]", printed);
+    TEST_ASSERT_EQUAL_INT(1, allocations);
+    TEST_ASSERT_TRUE(reallocations > 0);
+    cjson_free(printed);
+
+    /* cjson_init_hooks replaces the allocator and can't realloc with custom functions */
+    cjson_init_hooks(&hooks);
+    allocations = 0;
+    reallocations = 0;
+    printed = cjson_print_buffered(item, 1, false);
+    TEST_ASSERT_NOT_NULL(printed);
+    TEST_ASSERT_TRUE(allocations > 1);
+    TEST_ASSERT_EQUAL_INT(0, reallocations);
+    cjson_free(printed);
+
+    allocator.free_fn = NULL;
+    TEST_ASSERT_FALSE(cjson_init_allocator(&allocator));
+    TEST_ASSERT_TRUE(cjson_init_allocator(NULL));
+
+    cjson_delete(item);
+}
+
+typedef struct
+{
+    int allocations;
+    int live;
+} allocator_statistics;
+
+static void *CJSON_CDECL statistics_malloc(size_t size, void *user)
+{
+    ((allocator_statistics*)user)->allocations++;
+    ((allocator_statistics*)user)->live++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL statistics_free(void *pointer, void *user)
+{
+    if (pointer != NULL)
+    {
+        ((allocator_statistics*)user)->live--;
+    }
+    free(pointer);
+}
+
+static void *CJSON_CDECL statistics_realloc(void *pointer, size_t size, void *user)
+{
+    (void)user;
+    return realloc(pointer, size);
+}
+
+static void cjson_allocator_should_be_used_instead_of_hooks(void)
+{
+    const char json[] = "{\"name\": \"value\", \"list\": [1, 2.5, \"three\", {\"four\": null}]}";
+    /* everything going through the global hooks would fail */
+    cjson_hooks_t hooks = { failing_malloc, counting_free };
+    allocator_statistics statistics = { 0, 0 };
+    cjson_allocator_t allocator = { statistics_malloc, statistics_free, statistics_realloc, NULL };
+    cjson_t *item = NULL;
+    char *printed = NULL;
+    allocator.user = &statistics;
+
+    cjson_init_hooks(&hooks);
+    item = cjson_parse_with_allocator(json, sizeof(json), &allocator, NULL);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE(statistics.allocations > 0);
+
+    printed = cjson_print_with_allocator(item, false, &allocator);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"value\",\"list\":[1,2.5,\"three\",{\"four\":null}]}", printed);
+    statistics_free(printed, &statistics);
+
+    cjson_delete_with_allocator(item, &allocator);
+    TEST_ASSERT_EQUAL_INT(0, statistics.live);
+
+    /* the partial result of a failed parse is released with the allocator too */
+    TEST_ASSERT_NULL(cjson_parse_with_allocator("[\"one\", \"two\", ", 15, &allocator, NULL));
+    TEST_ASSERT_EQUAL_INT(0, statistics.live);
+    cjson_init_hooks(NULL);
+
+    /* without realloc_fn and with the global hooks */
+    allocator.realloc_fn = NULL;
+    item = cjson_parse_with_allocator(json, sizeof(json), NULL, NULL);
+    printed = cjson_print_with_allocator(item, true, &allocator);
+    TEST_ASSERT_NOT_NULL(printed);
+    statistics_free(printed, &statistics);
+    cjson_delete_with_allocator(item, NULL);
+    TEST_ASSERT_EQUAL_INT(0, statistics.live);
+
+    allocator.malloc_fn = NULL;
+    TEST_ASSERT_NULL(cjson_parse_with_allocator(json, sizeof(json), &allocator, NULL));
+}
+
 static void cjson_functions_should_not_crash_with_null_pointers(void)
 {
     char buffer[10];
@@ -361,6 +561,7 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     TEST_ASSERT_NULL(cjson_print_buffered(NULL, 10, true));
     TEST_ASSERT_FALSE(cjson_print_preallocated(NULL, buffer, sizeof(buffer), true));
     TEST_ASSERT_FALSE(cjson_print_preallocated(item, NULL, 1, true));
+    TEST_ASSERT_EQUAL_UINT(0, cjson_print_size(NULL, true));
     cjson_delete(NULL);
     cjson_get_array_size(NULL);
     TEST_ASSERT_NULL(cjson_get_array_item(NULL, 0));
@@ -434,16 +635,17 @@ static void cjson_functions_should_not_crash_with_null_pointers(void)
     cjson_delete(item);
 }
 
-static void *CJSON_CDECL failing_realloc(void *pointer, size_t size)
+static void *CJSON_CDECL failing_realloc(void *pointer, size_t size, void *user)
 {
     (void)size;
     (void)pointer;
+    (void)user;
     return NULL;
 }
 
 static void ensure_should_fail_on_failed_realloc(void)
 {
-    printbuffer buffer = {NULL, 10, 0, 0, false, false, {&malloc, &free, &failing_realloc}};
+    printbuffer buffer = {NULL, 10, 0, 0, false, false, {&global_allocate, &global_deallocate, &failing_realloc, &global_functions}, NULL, NULL};
     buffer.buffer = (unsigned char *)malloc(100);
     TEST_ASSERT_NOT_NULL(buffer.buffer);
 
@@ -453,7 +655,7 @@ static void ensure_should_fail_on_failed_realloc(void)
 static void skip_utf8_bom_should_skip_bom(void)
 {
     const unsigned char string[] = "\xEF\xBB\xBF{}";
-    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0}};
+    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0, 0}, 0, CJSON_ERROR_NONE, 0, 0};
     buffer.content = string;
     buffer.length = sizeof(string);
     buffer.hooks = global_hooks;
@@ -465,7 +667,7 @@ static void skip_utf8_bom_should_skip_bom(void)
 static void skip_utf8_bom_should_not_skip_bom_if_not_at_beginning(void)
 {
     const unsigned char string[] = " \xEF\xBB\xBF{}";
-    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0}};
+    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0, 0}, 0, CJSON_ERROR_NONE, 0, 0};
     buffer.content = string;
     buffer.length = sizeof(string);
     buffer.hooks = global_hooks;
@@ -474,6 +676,35 @@ static void skip_utf8_bom_should_not_skip_bom_if_not_at_beginning(void)
     TEST_ASSERT_NULL(skip_utf8_bom(&buffer));
 }
 
+static void buffer_skip_whitespace_should_skip_long_runs(void)
+{
+    unsigned char string[100];
+    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0, 0}, 0, CJSON_ERROR_NONE, 0, 0};
+    size_t run = 0;
+
+    buffer.content = string;
+    buffer.hooks = global_hooks;
+
+    /* runs crossing the 16 and 32 byte blocks of the vectorized scanner */
+    for (run = 0; run < (sizeof(string) - 1); run++)
+    {
+        memset(string, ' ', run);
+        string[run] = (unsigned char)((run % 2) ? '[' : 0x80);
+        memset(string + run + 1, '\n', sizeof(string) - run - 1);
+
+        buffer.length = sizeof(string);
+        buffer.offset = 0;
+        TEST_ASSERT_TRUE(buffer_skip_whitespace(&buffer) == &buffer);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)run, (unsigned int)buffer.offset);
+
+        /* whitespace up to the end of the buffer leaves the offset on the last byte */
+        buffer.length = run;
+        buffer.offset = 0;
+        buffer_skip_whitespace(&buffer);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)((run > 0) ? (run - 1) : 0), (unsigned int)buffer.offset);
+    }
+}
+
 static void cjson_get_string_value_should_get_a_string(void)
 {
     cjson_t *string = cjson_create_string("test");
@@ -500,6 +731,49 @@ static void cjson_get_number_value_should_get_a_number(void)
     cjson_delete(string);
 }
 
+static void cjson_get_int64_should_get_integers(void)
+{
+    cjson_t *string = cjson_create_string("test");
+    cjson_t *integral = cjson_create_number(-4096);
+    cjson_t *fraction = cjson_create_number(1.5);
+    cjson_t *huge = cjson_create_number(1e300);
+    cjson_t *unsigned_integer = cjson_create_uint64(~(cjson_uint64_t)0);
+    cjson_int64_t signed_value = 0;
+    cjson_uint64_t unsigned_value = 0;
+
+    TEST_ASSERT_TRUE(cjson_get_int64(integral, &signed_value));
+    TEST_ASSERT_TRUE(signed_value == -4096);
+    TEST_ASSERT_FALSE(cjson_get_uint64(integral, &unsigned_value));
+    TEST_ASSERT_FALSE(cjson_get_int64(fraction, &signed_value));
+    TEST_ASSERT_FALSE(cjson_get_int64(huge, &signed_value));
+    TEST_ASSERT_FALSE(cjson_get_uint64(huge, &unsigned_value));
+    TEST_ASSERT_FALSE(cjson_get_int64(unsigned_integer, &signed_value));
+    TEST_ASSERT_TRUE(cjson_get_uint64(unsigned_integer, &unsigned_value));
+    TEST_ASSERT_TRUE(unsigned_value == ~(cjson_uint64_t)0);
+    TEST_ASSERT_FALSE(cjson_get_int64(string, &signed_value));
+    TEST_ASSERT_FALSE(cjson_get_int64(NULL, &signed_value));
+
+    cjson_delete(string);
+    cjson_delete(integral);
+    cjson_delete(fraction);
+    cjson_delete(huge);
+    cjson_delete(unsigned_integer);
+}
+
+static void cjson_compare_should_compare_64bit_integers_exactly(void)
+{
+    cjson_t *a = cjson_parse("[9007199254740993]");
+    cjson_t *b = cjson_parse("[9007199254740992]");
+    cjson_t *copy = cjson_duplicate(a, true);
+
+    TEST_ASSERT_FALSE(cjson_compare(a, b, true));
+    TEST_ASSERT_TRUE(cjson_compare(a, copy, true));
+
+    cjson_delete(a);
+    cjson_delete(b);
+    cjson_delete(copy);
+}
+
 static void cjson_create_string_reference_should_create_a_string_reference(void)
 {
     const char *string = "I am a string!";
@@ -730,8 +1004,11 @@ int CJSON_CDECL main(void)
     RUN_TEST(ensure_should_fail_on_failed_realloc);
     RUN_TEST(skip_utf8_bom_should_skip_bom);
     RUN_TEST(skip_utf8_bom_should_not_skip_bom_if_not_at_beginning);
+    RUN_TEST(buffer_skip_whitespace_should_skip_long_runs);
     RUN_TEST(cjson_get_string_value_should_get_a_string);
     RUN_TEST(cjson_get_number_value_should_get_a_number);
+    RUN_TEST(cjson_get_int64_should_get_integers);
+    RUN_TEST(cjson_compare_should_compare_64bit_integers_exactly);
     RUN_TEST(cjson_create_string_reference_should_create_a_string_reference);
     RUN_TEST(cjson_create_object_reference_should_create_an_object_reference);
     RUN_TEST(cjson_create_array_reference_should_create_an_array_reference);
@@ -740,6 +1017,10 @@ int CJSON_CDECL main(void)
     RUN_TEST(cjson_delete_item_from_array_should_not_broken_list_structure);
     RUN_TEST(cjson_set_valuestring_to_object_should_not_leak_memory);
     RUN_TEST(cjson_set_bool_value_must_not_break_objects);
+    RUN_TEST(cjson_print_size_should_be_exact);
+    RUN_TEST(cjson_print_should_allocate_once);
+    RUN_TEST(cjson_init_allocator_should_use_realloc_fn);
+    RUN_TEST(cjson_allocator_should_be_used_instead_of_hooks);
 
     return UNITY_END();
 }
@@ -31,7 +31,7 @@
 
 static void cjson_utils_functions_shouldnt_crash_with_null_pointers(void)
 {
-    cJSON *item = cJSON_CreateString("item");
+    cjson_t *item = cjson_create_string("item");
     TEST_ASSERT_NOT_NULL(item);
 
     TEST_ASSERT_NULL(cJSONUtils_GetPointer(item, NULL));
@@ -51,9 +51,9 @@ static void cjson_utils_functions_shouldnt_crash_with_null_pointers(void)
     cJSONUtils_ApplyPatchesCaseSensitive(item, NULL);
     cJSONUtils_ApplyPatchesCaseSensitive(NULL, item);
     TEST_ASSERT_NULL(cJSONUtils_MergePatch(item, NULL));
-    item = cJSON_CreateString("item");
+    item = cjson_create_string("item");
     TEST_ASSERT_NULL(cJSONUtils_MergePatchCaseSensitive(item, NULL));
-    item = cJSON_CreateString("item");
+    item = cjson_create_string("item");
     /* these calls are actually valid */
     /* cJSONUtils_MergePatch(NULL, item); */
     /* cJSONUtils_MergePatchCaseSensitive(NULL, item);*/
@@ -67,7 +67,40 @@ static void cjson_utils_functions_shouldnt_crash_with_null_pointers(void)
     cJSONUtils_SortObject(NULL);
     cJSONUtils_SortObjectCaseSensitive(NULL);
 
-    cJSON_Delete(item);
+    cjson_delete(item);
+}
+
+static void cjson_utils_should_resolve_projected_paths(void)
+{
+    const char json[] = "{\"items\": [{\"name\": \"one\", \"tags\": [1, 2]}, {\"name\": \"two\"}], \"a/b\": {\"m~n\": true, \"other\": 1}, \"dropped\": {\"name\": null}}";
+    const char *paths[] = { "/items/1/name", "/a~1b/m~0n" };
+    cjson_t *projected = cjson_parse_projected(json, sizeof(json), paths, 2);
+    cjson_t *item = NULL;
+    char *pointer = NULL;
+    TEST_ASSERT_NOT_NULL(projected);
+
+    item = cJSONUtils_GetPointerCaseSensitive(projected, paths[0]);
+    TEST_ASSERT_TRUE(cjson_is_string(item));
+    TEST_ASSERT_EQUAL_STRING("two", item->valuestring);
+    pointer = cJSONUtils_FindPointerFromObjectTo(projected, item);
+    TEST_ASSERT_EQUAL_STRING(paths[0], pointer);
+    cjson_free(pointer);
+
+    /* keys with escaped '/' and '~' */
+    item = cJSONUtils_GetPointer(projected, paths[1]);
+    TEST_ASSERT_TRUE(cjson_is_true(item));
+    pointer = cJSONUtils_FindPointerFromObjectTo(projected, item);
+    TEST_ASSERT_EQUAL_STRING(paths[1], pointer);
+    cjson_free(pointer);
+
+    /* the element in front of a kept one is null, everything else is gone */
+    TEST_ASSERT_TRUE(cjson_is_null(cJSONUtils_GetPointer(projected, "/items/0")));
+    TEST_ASSERT_NULL(cJSONUtils_GetPointer(projected, "/items/0/name"));
+    TEST_ASSERT_NULL(cJSONUtils_GetPointer(projected, "/a~1b/other"));
+    TEST_ASSERT_NULL(cJSONUtils_GetPointer(projected, "/dropped"));
+    TEST_ASSERT_NULL(cJSONUtils_GetPointer(projected, "/dropped/name"));
+
+    cjson_delete(projected);
 }
 
 int main(void)
@@ -75,6 +108,7 @@ int main(void)
     UNITY_BEGIN();
 
     RUN_TEST(cjson_utils_functions_shouldnt_crash_with_null_pointers);
+    RUN_TEST(cjson_utils_should_resolve_projected_paths);
 
     return UNITY_END();
 }
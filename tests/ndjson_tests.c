@@ -0,0 +1,489 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static void ndjson_should_read_every_record(void)
+{
+    const char records[] = "{\"id\": 1}\n\n{\"id\": 2}\r\n  [3]\n\"four\" 5{\"id\": 6}\n";
+    const char *expected[] = { "{\"id\":1}", "{\"id\":2}", "[3]", "\"four\"", "5", "{\"id\":6}" };
+    cjson_ndjson_iter_t iter;
+    cjson_error_t error;
+    cjson_t *item = NULL;
+    size_t count = 0;
+
+    cjson_ndjson_iter_init(&iter, records, sizeof(records) - 1, NULL);
+    while (cjson_ndjson_next(&iter, &item, &error))
+    {
+        char *printed = NULL;
+
+        TEST_ASSERT_NOT_NULL(item);
+        TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, error.kind);
+        TEST_ASSERT_TRUE(count < (sizeof(expected) / sizeof(expected[0])));
+        printed = cjson_print_unformatted(item);
+        TEST_ASSERT_EQUAL_STRING(expected[count], printed);
+        cjson_free(printed);
+        cjson_delete(item);
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT(6, (unsigned int)count);
+    TEST_ASSERT_NULL(item);
+
+    /* the iterator stays at the end */
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, &error));
+}
+
+static void ndjson_should_report_invalid_records_and_continue(void)
+{
+    const char records[] = "{\"id\": 1}\n{\"id\": 2,, \"x\": 0}\n  {\"id\": 3}\n[1, 2\n";
+    cjson_ndjson_iter_t iter;
+    cjson_error_t error;
+    cjson_t *item = NULL;
+
+    cjson_ndjson_iter_init(&iter, records, sizeof(records) - 1, NULL);
+
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_UINT(9, (unsigned int)error.offset);
+    cjson_delete(item);
+
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_CHARACTER, error.kind);
+    TEST_ASSERT_EQUAL_UINT(20, (unsigned int)error.offset);
+    TEST_ASSERT_EQUAL_UINT(2, (unsigned int)error.line);
+    TEST_ASSERT_EQUAL_UINT(11, (unsigned int)error.column);
+
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(3, cjson_get_object_item(item, "id")->valueint);
+    cjson_delete(item);
+
+    /* the last record is cut off */
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_TRUE(error.kind != CJSON_ERROR_NONE);
+    TEST_ASSERT_EQUAL_UINT(4, (unsigned int)error.line);
+
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, &error));
+}
+
+static void ndjson_should_limit_records_to_their_line(void)
+{
+    const char records[] = "{\"a\":1}\n{\"b\":\n{\"c\":3}\n{\n}\n";
+    cjson_ndjson_iter_t iter;
+    cjson_error_t error;
+    cjson_t *item = NULL;
+
+    cjson_ndjson_iter_init(&iter, records, sizeof(records) - 1, NULL);
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NOT_NULL(item);
+    cjson_delete(item);
+
+    /* a cut off record doesn't take the next line along */
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_EQUAL_UINT(2, (unsigned int)error.line);
+    TEST_ASSERT_EQUAL_UINT(6, (unsigned int)error.column);
+
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(3, cjson_get_object_item(item, "c")->valueint);
+    cjson_delete(item);
+
+    /* neither can a record that spans lines */
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_EQUAL_UINT(4, (unsigned int)error.line);
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, &error));
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_EQUAL_UINT(5, (unsigned int)error.line);
+    TEST_ASSERT_EQUAL_UINT(1, (unsigned int)error.column);
+
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, &error));
+}
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void ndjson_should_reuse_the_arena(void)
+{
+    cjson_hooks_t hooks = { counting_malloc, free };
+    char records[4096];
+    cjson_ndjson_iter_t iter;
+    cjson_arena_t *arena = NULL;
+    cjson_t *item = NULL;
+    size_t length = 0;
+    int i = 0;
+    int count = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        length += (size_t)sprintf(records + length, "{\"id\": %d, \"name\": \"record %d\"}\n", i, i);
+    }
+
+    cjson_init_hooks(&hooks);
+    arena = cjson_arena_create(0);
+    TEST_ASSERT_NOT_NULL(arena);
+
+    cjson_ndjson_iter_init(&iter, records, length, arena);
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, &item, NULL));
+    allocations = 0;
+    while (item != NULL)
+    {
+        count++;
+        TEST_ASSERT_EQUAL_INT(count - 1, cjson_get_object_item(item, "id")->valueint);
+        cjson_ndjson_next(&iter, &item, NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(100, count);
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)allocations);
+
+    cjson_arena_delete(arena);
+    cjson_init_hooks(NULL);
+}
+
+static void ndjson_should_handle_edge_cases(void)
+{
+    cjson_ndjson_iter_t iter;
+    cjson_t *item = NULL;
+
+    cjson_ndjson_iter_init(&iter, "", 0, NULL);
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, NULL));
+
+    cjson_ndjson_iter_init(&iter, " \n\r\n\t", 5, NULL);
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, NULL));
+
+    cjson_ndjson_iter_init(&iter, NULL, 10, NULL);
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, &item, NULL));
+
+    /* without an item the record is only validated */
+    cjson_ndjson_iter_init(&iter, "[1] [2", 6, NULL);
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, NULL, NULL));
+    TEST_ASSERT_TRUE(cjson_ndjson_next(&iter, NULL, NULL));
+    TEST_ASSERT_FALSE(cjson_ndjson_next(&iter, NULL, NULL));
+
+    TEST_ASSERT_FALSE(cjson_ndjson_next(NULL, &item, NULL));
+    cjson_ndjson_iter_init(NULL, "1", 1, NULL);
+}
+
+/* fixed width lines, so the line of a record can be told from its offset */
+#define LINE_WIDTH 16
+#define LINE_COUNT 20000
+
+typedef struct
+{
+    char *records;
+    unsigned char seen[LINE_COUNT];
+    size_t calls;
+    size_t next_line;
+    cjson_bool_t in_order;
+    size_t stop_after;
+} parallel_result;
+
+static char *create_lines(void)
+{
+    char *records = (char*)malloc((LINE_COUNT * LINE_WIDTH) + 1);
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(records);
+    for (i = 0; i < LINE_COUNT; i++)
+    {
+        if ((i % 1000) == 999)
+        {
+            sprintf(records + (i * LINE_WIDTH), "{\"id\": %06d,}\n", i);
+        }
+        else
+        {
+            sprintf(records + (i * LINE_WIDTH), "{\"id\": %06d }\n", i);
+        }
+    }
+
+    return records;
+}
+
+static cjson_bool_t check_record(cjson_t *item, const cjson_error_t *error, void *user)
+{
+    parallel_result *result = (parallel_result*)user;
+    size_t line = (error->offset - ((item != NULL) ? 1 : 0)) / LINE_WIDTH;
+
+    if (line >= LINE_COUNT)
+    {
+        result->in_order = false;
+        return false;
+    }
+    if (item != NULL)
+    {
+        if ((error->kind != CJSON_ERROR_NONE) || ((size_t)cjson_get_object_item(item, "id")->valueint != line))
+        {
+            result->in_order = false;
+        }
+    }
+    else if (((line % 1000) != 999) || (error->kind != CJSON_ERROR_UNEXPECTED_CHARACTER) || ((error->line != 0) && (error->line != (line + 1))))
+    {
+        result->in_order = false;
+    }
+    result->seen[line] = 1;
+
+    return true;
+}
+
+static cjson_bool_t check_ordered_record(cjson_t *item, const cjson_error_t *error, void *user)
+{
+    parallel_result *result = (parallel_result*)user;
+
+    result->calls++;
+    if (!check_record(item, error, user) || (result->seen[result->next_line] != 1))
+    {
+        result->in_order = false;
+    }
+    /* invalid records have their line */
+    if ((item == NULL) && (error->line != (result->next_line + 1)))
+    {
+        result->in_order = false;
+    }
+    result->next_line++;
+
+    return result->calls != result->stop_after;
+}
+
+static void ndjson_parallel_should_deliver_records_in_order(void)
+{
+    parallel_result *result = (parallel_result*)calloc(1, sizeof(parallel_result));
+    int threads[] = { 1, 2, 4, 0 };
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(result);
+    result->records = create_lines();
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        memset(result->seen, 0, sizeof(result->seen));
+        result->calls = 0;
+        result->next_line = 0;
+        result->in_order = true;
+        result->stop_after = 0;
+
+        TEST_ASSERT_TRUE(cjson_parse_ndjson_parallel(result->records, LINE_COUNT * LINE_WIDTH, threads[i], check_ordered_record, result, 0));
+        TEST_ASSERT_TRUE(result->in_order);
+        TEST_ASSERT_EQUAL_UINT(LINE_COUNT, (unsigned int)result->calls);
+    }
+
+    free(result->records);
+    free(result);
+}
+
+static void ndjson_parallel_should_deliver_every_record_unordered(void)
+{
+    parallel_result *result = (parallel_result*)calloc(1, sizeof(parallel_result));
+    size_t line = 0;
+
+    TEST_ASSERT_NOT_NULL(result);
+    result->records = create_lines();
+    result->in_order = true;
+
+    /* called from several threads, but every call writes a different byte of seen */
+    TEST_ASSERT_TRUE(cjson_parse_ndjson_parallel(result->records, LINE_COUNT * LINE_WIDTH, 4, check_record, result, CJSON_NDJSON_UNORDERED));
+    TEST_ASSERT_TRUE(result->in_order);
+    for (line = 0; line < LINE_COUNT; line++)
+    {
+        TEST_ASSERT_EQUAL_UINT(1, result->seen[line]);
+    }
+
+    free(result->records);
+    free(result);
+}
+
+static void ndjson_parallel_should_stop_when_asked(void)
+{
+    parallel_result *result = (parallel_result*)calloc(1, sizeof(parallel_result));
+
+    TEST_ASSERT_NOT_NULL(result);
+    result->records = create_lines();
+    result->in_order = true;
+    result->stop_after = 5000;
+
+    TEST_ASSERT_FALSE(cjson_parse_ndjson_parallel(result->records, LINE_COUNT * LINE_WIDTH, 4, check_ordered_record, result, 0));
+    TEST_ASSERT_TRUE(result->in_order);
+    TEST_ASSERT_EQUAL_UINT(5000, (unsigned int)result->calls);
+
+    TEST_ASSERT_FALSE(cjson_parse_ndjson_parallel(NULL, 0, 4, check_record, result, 0));
+    TEST_ASSERT_FALSE(cjson_parse_ndjson_parallel(result->records, 10, 4, NULL, result, 0));
+
+    free(result->records);
+    free(result);
+}
+
+/* how the iterator reads a record: where it ends (or the error is), whether it is valid and the line of an error */
+typedef struct
+{
+    size_t offset;
+    cjson_bool_t valid;
+    size_t line;
+} record_outcome;
+
+typedef struct
+{
+    const record_outcome *expected;
+    size_t expected_count;
+    size_t calls;
+    cjson_bool_t same;
+    unsigned char *marks; /* per offset in unordered mode: bit 1 for a valid record, bit 2 for an invalid one */
+} outcome_check;
+
+#define MIXED_LINE_COUNT 20000
+
+/* lines of different widths, some cut off and some records spread over two lines, which the next line could complete */
+static char *create_mixed_lines(size_t *length)
+{
+    char *records = (char*)malloc(MIXED_LINE_COUNT * 80);
+    char padding[50];
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(records);
+    memset(padding, 'x', sizeof(padding));
+    *length = 0;
+    for (i = 0; i < MIXED_LINE_COUNT; i++)
+    {
+        int width = i % (int)sizeof(padding);
+        if ((i % 13) == 12)
+        {
+            *length += (size_t)sprintf(records + *length, "{\"id\": %d, \"pad\":\n", i);
+        }
+        else if ((i % 29) == 28)
+        {
+            *length += (size_t)sprintf(records + *length, "{\n\"id\": %d}\n", i);
+        }
+        else
+        {
+            *length += (size_t)sprintf(records + *length, "{\"id\": %d, \"pad\": \"%.*s\"}\n", i, width, padding);
+        }
+    }
+
+    return records;
+}
+
+static cjson_bool_t check_ordered_outcome(cjson_t *item, const cjson_error_t *error, void *user)
+{
+    outcome_check *check = (outcome_check*)user;
+    const record_outcome *expected = check->expected + check->calls;
+
+    if ((check->calls >= check->expected_count) || (expected->offset != error->offset) || (expected->valid != (item != NULL))
+        || ((item == NULL) && (expected->line != error->line)))
+    {
+        check->same = false;
+    }
+    check->calls++;
+
+    return true;
+}
+
+static cjson_bool_t mark_outcome(cjson_t *item, const cjson_error_t *error, void *user)
+{
+    outcome_check *check = (outcome_check*)user;
+
+    /* called from several threads, but only records of the same line can share an offset */
+    check->marks[error->offset] |= (item != NULL) ? 1 : 2;
+
+    return true;
+}
+
+static void ndjson_parallel_should_read_invalid_lines_like_the_iterator(void)
+{
+    int threads[] = { 2, 4, 0 };
+    record_outcome *expected = NULL;
+    outcome_check check;
+    cjson_ndjson_iter_t iter;
+    cjson_error_t error;
+    cjson_t *item = NULL;
+    size_t expected_count = 0;
+    size_t length = 0;
+    size_t marked = 0;
+    size_t i = 0;
+    char *records = create_mixed_lines(&length);
+
+    expected = (record_outcome*)malloc(MIXED_LINE_COUNT * 2 * sizeof(record_outcome));
+    TEST_ASSERT_NOT_NULL(expected);
+    cjson_ndjson_iter_init(&iter, records, length, NULL);
+    while (cjson_ndjson_next(&iter, &item, &error))
+    {
+        TEST_ASSERT_TRUE(expected_count < (MIXED_LINE_COUNT * 2));
+        expected[expected_count].offset = error.offset;
+        expected[expected_count].valid = (item != NULL);
+        expected[expected_count].line = error.line;
+        expected_count++;
+        cjson_delete(item);
+    }
+
+    /* the batches start at different lines for each number of threads */
+    for (i = 0; i < (sizeof(threads) / sizeof(threads[0])); i++)
+    {
+        memset(&check, 0, sizeof(check));
+        check.expected = expected;
+        check.expected_count = expected_count;
+        check.same = true;
+        TEST_ASSERT_TRUE(cjson_parse_ndjson_parallel(records, length, threads[i], check_ordered_outcome, &check, 0));
+        TEST_ASSERT_TRUE(check.same);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)expected_count, (unsigned int)check.calls);
+    }
+
+    memset(&check, 0, sizeof(check));
+    check.marks = (unsigned char*)calloc(length, 1);
+    TEST_ASSERT_NOT_NULL(check.marks);
+    TEST_ASSERT_TRUE(cjson_parse_ndjson_parallel(records, length, 4, mark_outcome, &check, CJSON_NDJSON_UNORDERED));
+    for (i = 0; i < expected_count; i++)
+    {
+        TEST_ASSERT_TRUE(check.marks[expected[i].offset] & (expected[i].valid ? 1 : 2));
+    }
+    for (i = 0; i < length; i++)
+    {
+        marked += (size_t)(check.marks[i] & 1) + (size_t)(check.marks[i] >> 1);
+    }
+    TEST_ASSERT_EQUAL_UINT((unsigned int)expected_count, (unsigned int)marked);
+
+    free(check.marks);
+    free(expected);
+    free(records);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(ndjson_should_read_every_record);
+    RUN_TEST(ndjson_should_report_invalid_records_and_continue);
+    RUN_TEST(ndjson_should_limit_records_to_their_line);
+    RUN_TEST(ndjson_should_reuse_the_arena);
+    RUN_TEST(ndjson_should_handle_edge_cases);
+    RUN_TEST(ndjson_parallel_should_deliver_records_in_order);
+    RUN_TEST(ndjson_parallel_should_deliver_every_record_unordered);
+    RUN_TEST(ndjson_parallel_should_stop_when_asked);
+    RUN_TEST(ndjson_parallel_should_read_invalid_lines_like_the_iterator);
+
+    return UNITY_END();
+}
@@ -0,0 +1,311 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* what a lookup without index finds */
+static cjson_t *linear_lookup(const cjson_t *object, const char *name, cjson_bool_t case_sensitive)
+{
+    cjson_t *child = NULL;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        if (case_sensitive ? (strcmp(name, child->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)child->string) == 0))
+        {
+            return child;
+        }
+    }
+
+    return NULL;
+}
+
+static void assert_lookups_match_list(const cjson_t *object, const char *extra_key)
+{
+    cjson_t *child = NULL;
+
+    TEST_ASSERT_NOT_NULL(object->index);
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        TEST_ASSERT_EQUAL_PTR(linear_lookup(object, child->string, true), cjson_get_object_item_case_sensitive(object, child->string));
+        TEST_ASSERT_EQUAL_PTR(linear_lookup(object, child->string, false), cjson_get_object_item(object, child->string));
+    }
+    TEST_ASSERT_EQUAL_PTR(linear_lookup(object, extra_key, true), cjson_get_object_item_case_sensitive(object, extra_key));
+    TEST_ASSERT_EQUAL_PTR(linear_lookup(object, extra_key, false), cjson_get_object_item(object, extra_key));
+}
+
+static cjson_t *create_large_object(int count)
+{
+    cjson_t *object = cjson_create_object();
+    char key[32];
+    int i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        sprintf(key, "key%d", i);
+        cjson_add_number_to_object(object, key, i);
+    }
+
+    return object;
+}
+
+static void index_should_be_built_for_large_parsed_objects_on_request(void)
+{
+    const char json[] = "{\"a\": 1, \"b\": 2, \"c\": 3, \"d\": 4, \"e\": 5, \"f\": 6, \"g\": 7, \"h\": 8, \"i\": 9, \"j\": 10, \"k\": 11, \"l\": 12, \"m\": 13, \"n\": 14, \"o\": 15, \"p\": 16, \"A\": 17, \"q\": 18, \"a\": 19, \"small\": {\"x\": 1}}";
+    cjson_t *object = cjson_parse(json);
+
+    TEST_ASSERT_NOT_NULL(object);
+    /* plain parsing leaves indexing to the caller */
+    TEST_ASSERT_NULL(object->index);
+    TEST_ASSERT_TRUE(cjson_build_indexes(object));
+    TEST_ASSERT_NULL(cjson_get_object_item(object, "small")->index);
+    assert_lookups_match_list(object, "missing");
+    TEST_ASSERT_TRUE(cjson_build_indexes(object));
+
+    /* duplicate keys find the first member, with and without case */
+    TEST_ASSERT_EQUAL_INT(1, cjson_get_object_item_case_sensitive(object, "a")->valueint);
+    TEST_ASSERT_EQUAL_INT(17, cjson_get_object_item_case_sensitive(object, "A")->valueint);
+    TEST_ASSERT_EQUAL_INT(1, cjson_get_object_item(object, "A")->valueint);
+    TEST_ASSERT_EQUAL_INT(5, cjson_get_object_item(object, "E")->valueint);
+    TEST_ASSERT_NULL(cjson_get_object_item_case_sensitive(object, "E"));
+
+    cjson_delete(object);
+}
+
+static void index_should_be_built_when_objects_grow(void)
+{
+    cjson_t *object = create_large_object(CJSON_OBJECT_INDEX_THRESHOLD);
+    cjson_t *item = NULL;
+    char key[32];
+    int i = 0;
+
+    TEST_ASSERT_NULL(object->index);
+    cjson_add_item_to_object_cs(object, "constant", cjson_create_true());
+    TEST_ASSERT_NOT_NULL(object->index);
+    cjson_delete(object);
+
+    object = create_large_object(100);
+    TEST_ASSERT_NOT_NULL(object->index);
+    TEST_ASSERT_EQUAL_UINT(100, (unsigned int)object->index->count);
+    assert_lookups_match_list(object, "key100");
+
+    /* adding, inserting, replacing and removing keep it up to date */
+    cjson_add_item_reference_to_object(object, "reference", cjson_get_object_item(object, "key1"));
+    item = cjson_create_number(-1);
+    item->string = (char*)cJSON_strdup((const unsigned char*)"inserted", &global_hooks);
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(object, 50, item));
+    TEST_ASSERT_TRUE(cjson_replace_item_in_object_case_sensitive(object, "key20", cjson_create_string("twenty")));
+    for (i = 0; i < 100; i += 3)
+    {
+        sprintf(key, "key%d", i);
+        cjson_delete_item_from_object_case_sensitive(object, key);
+    }
+    TEST_ASSERT_NOT_NULL(object->index);
+    assert_lookups_match_list(object, "key3");
+    TEST_ASSERT_EQUAL_PTR(item, cjson_get_object_item(object, "inserted"));
+    TEST_ASSERT_EQUAL_STRING("twenty", cjson_get_string_value(cjson_get_object_item(object, "key20")));
+    TEST_ASSERT_NULL(cjson_get_object_item(object, "key99"));
+    TEST_ASSERT_EQUAL_INT(98, cjson_get_object_item(object, "key98")->valueint);
+
+    cjson_delete(object);
+}
+
+static void index_should_follow_mutations(void)
+{
+    cjson_t *object = create_large_object(10);
+    cjson_t *item = NULL;
+    char key[32];
+    int i = 0;
+
+    TEST_ASSERT_NULL(object->index);
+    TEST_ASSERT_TRUE(cjson_object_build_index(object));
+    assert_lookups_match_list(object, "key10");
+
+    /* adding grows the index */
+    for (i = 10; i < 100; i++)
+    {
+        sprintf(key, "key%d", i);
+        cjson_add_number_to_object(object, key, i);
+    }
+    cjson_add_number_to_object(object, "KEY5", 1000);
+    assert_lookups_match_list(object, "key100");
+    TEST_ASSERT_EQUAL_INT(99, cjson_get_object_item(object, "key99")->valueint);
+
+    /* removing */
+    cjson_delete_item_from_object(object, "key5");
+    TEST_ASSERT_EQUAL_INT(1000, cjson_get_object_item(object, "key5")->valueint);
+    item = cjson_detach_item_from_object_case_sensitive(object, "key50");
+    TEST_ASSERT_NOT_NULL(item);
+    cjson_delete(item);
+    TEST_ASSERT_NULL(cjson_get_object_item(object, "key50"));
+    assert_lookups_match_list(object, "key50");
+
+    /* replacing with the same key and a different one */
+    TEST_ASSERT_TRUE(cjson_replace_item_in_object(object, "key7", cjson_create_string("seven")));
+    TEST_ASSERT_EQUAL_STRING("seven", cjson_get_string_value(cjson_get_object_item(object, "key7")));
+    item = cjson_create_string("renamed");
+    item->string = (char*)cJSON_strdup((const unsigned char*)"renamed", &global_hooks);
+    TEST_ASSERT_TRUE(cjson_replace_item_via_pointer(object, cjson_get_object_item(object, "key8"), item));
+    TEST_ASSERT_NULL(cjson_get_object_item(object, "key8"));
+    TEST_ASSERT_EQUAL_PTR(item, cjson_get_object_item(object, "renamed"));
+    assert_lookups_match_list(object, "key8");
+
+    /* inserting in front of a duplicate key */
+    item = cjson_create_number(-1);
+    item->string = (char*)cJSON_strdup((const unsigned char*)"key3", &global_hooks);
+    TEST_ASSERT_TRUE(cjson_insert_item_in_array(object, 0, item));
+    TEST_ASSERT_EQUAL_INT(-1, cjson_get_object_item(object, "key3")->valueint);
+    assert_lookups_match_list(object, "key3");
+
+    /* a member without a key drops the index */
+    cjson_add_item_to_array(object, cjson_create_null());
+    TEST_ASSERT_NULL(object->index);
+    TEST_ASSERT_EQUAL_INT(99, cjson_get_object_item(object, "key99")->valueint);
+    TEST_ASSERT_FALSE(cjson_object_build_index(object));
+
+    cjson_delete(object);
+}
+
+static void index_should_be_copied_but_not_referenced(void)
+{
+    cjson_t *object = create_large_object(100);
+    cjson_t *copy = NULL;
+    cjson_t *container = cjson_create_array();
+
+    TEST_ASSERT_TRUE(cjson_object_build_index(object));
+    copy = cjson_duplicate(object, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    assert_lookups_match_list(copy, "missing");
+
+    TEST_ASSERT_TRUE(cjson_add_item_reference_to_array(container, object));
+    TEST_ASSERT_NULL(container->child->index);
+    TEST_ASSERT_FALSE(cjson_object_build_index(container->child));
+    TEST_ASSERT_EQUAL_INT(42, cjson_get_object_item(container->child, "key42")->valueint);
+
+    cjson_delete(container);
+    cjson_delete(copy);
+    cjson_delete(object);
+}
+
+static void index_should_work_in_arenas(void)
+{
+    cjson_t *object = create_large_object(100);
+    char *json = cjson_print_unformatted(object);
+    cjson_arena_t *arena = cjson_arena_create(0);
+    cjson_t *parsed = NULL;
+
+    parsed = cjson_parse_into_arena(arena, json, strlen(json) + 1);
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_TRUE(cjson_build_indexes(parsed));
+    TEST_ASSERT_TRUE(parsed->index->in_arena);
+    assert_lookups_match_list(parsed, "missing");
+    TEST_ASSERT_FALSE(cjson_object_build_index(parsed));
+
+    /* growing an arena index drops it */
+    cjson_add_item_to_object(parsed, "new", cjson_create_null());
+    cjson_add_item_to_object(parsed, "newer", cjson_create_null());
+    TEST_ASSERT_NOT_NULL(cjson_get_object_item(parsed, "newer"));
+    cjson_delete(cjson_detach_item_from_object(parsed, "new"));
+    cjson_delete(cjson_detach_item_from_object(parsed, "newer"));
+
+    cjson_arena_delete(arena);
+    cjson_free(json);
+    cjson_delete(object);
+}
+
+static void assert_keys_match_lookups(const cjson_t *object, const char *extra_key)
+{
+    cjson_t *child = NULL;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        TEST_ASSERT_EQUAL_PTR(cjson_get_object_item_case_sensitive(object, child->string), cjson_get_object_item_by_key(object, cjson_key_make(child->string)));
+    }
+    TEST_ASSERT_EQUAL_PTR(cjson_get_object_item_case_sensitive(object, extra_key), cjson_get_object_item_by_key(object, cjson_key_make(extra_key)));
+}
+
+static void keys_should_find_members(void)
+{
+    const char json[] = "{\"id\": 1, \"Id\": 2, \"ts\": 3, \"id\": 4, \"payload\": {\"id\": 5}}";
+    cjson_t *object = cjson_parse(json);
+    cjson_t *large = create_large_object(100);
+    const cjson_key_t id = cjson_key_make("id");
+
+    TEST_ASSERT_EQUAL_STRING("id", id.string);
+    TEST_ASSERT_EQUAL_UINT(2, (unsigned int)id.length);
+    TEST_ASSERT_EQUAL_UINT(key_hash((const unsigned char*)"id"), id.hash);
+
+    /* parsing stores the hashes */
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_UINT(id.hash, object->child->string_hash);
+    TEST_ASSERT_EQUAL_INT(1, cjson_get_object_item_by_key(object, id)->valueint);
+    TEST_ASSERT_EQUAL_INT(2, cjson_get_object_item_by_key(object, cjson_key_make("Id"))->valueint);
+    TEST_ASSERT_EQUAL_INT(5, cjson_get_object_item_by_key(cjson_get_object_item(object, "payload"), id)->valueint);
+    TEST_ASSERT_NULL(cjson_get_object_item_by_key(object, cjson_key_make("ID")));
+    assert_keys_match_lookups(object, "missing");
+
+    /* members with an unknown hash are compared by their key */
+    object->child->string_hash = 0;
+    TEST_ASSERT_EQUAL_INT(1, cjson_get_object_item_by_key(object, id)->valueint);
+
+    /* adding and replacing members stores the hashes of their keys */
+    TEST_ASSERT_TRUE(cjson_replace_item_in_object_case_sensitive(object, "ts", cjson_create_string("replaced")));
+    TEST_ASSERT_EQUAL_STRING("replaced", cjson_get_object_item_by_key(object, cjson_key_make("ts"))->valuestring);
+    assert_keys_match_lookups(large, "key1000");
+    cjson_object_build_index(large);
+    assert_keys_match_lookups(large, "KEY1");
+
+    cjson_delete(large);
+    cjson_delete(object);
+}
+
+static void index_functions_should_handle_invalid_input(void)
+{
+    cjson_t *array = cjson_create_array();
+
+    TEST_ASSERT_FALSE(cjson_object_build_index(NULL));
+    TEST_ASSERT_FALSE(cjson_object_build_index(array));
+    TEST_ASSERT_FALSE(cjson_build_indexes(NULL));
+    TEST_ASSERT_TRUE(cjson_build_indexes(array));
+    TEST_ASSERT_NULL(cjson_key_make(NULL).string);
+    TEST_ASSERT_NULL(cjson_get_object_item_by_key(NULL, cjson_key_make("a")));
+    TEST_ASSERT_NULL(cjson_get_object_item_by_key(array, cjson_key_make(NULL)));
+
+    cjson_delete(array);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(index_should_be_built_for_large_parsed_objects_on_request);
+    RUN_TEST(index_should_be_built_when_objects_grow);
+    RUN_TEST(index_should_follow_mutations);
+    RUN_TEST(index_should_be_copied_but_not_referenced);
+    RUN_TEST(index_should_work_in_arenas);
+    RUN_TEST(keys_should_find_members);
+    RUN_TEST(index_functions_should_handle_invalid_input);
+
+    return UNITY_END();
+}
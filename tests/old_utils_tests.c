@@ -51,7 +51,7 @@ static const char *merges[15][3] =
 
 static void json_pointer_tests(void)
 {
-    cJSON *root = NULL;
+    cjson_t *root = NULL;
     const char *json=
         "{"
         "\"foo\": [\"bar\", \"baz\"],"
@@ -66,43 +66,43 @@ static void json_pointer_tests(void)
         "\"m~n\": 8"
         "}";
 
-    root = cJSON_Parse(json);
+    root = cjson_parse(json);
 
     TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, ""), root);
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo"), cJSON_GetObjectItem(root, "foo"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo/0"), cJSON_GetObjectItem(root, "foo")->child);
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo/0"), cJSON_GetObjectItem(root, "foo")->child);
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/"), cJSON_GetObjectItem(root, ""));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/a~1b"), cJSON_GetObjectItem(root, "a/b"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c%d"), cJSON_GetObjectItem(root, "c%d"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c^f"), cJSON_GetObjectItem(root, "c^f"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c|f"), cJSON_GetObjectItem(root, "c|f"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/i\\j"), cJSON_GetObjectItem(root, "i\\j"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/k\"l"), cJSON_GetObjectItem(root, "k\"l"));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/ "), cJSON_GetObjectItem(root, " "));
-    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/m~0n"), cJSON_GetObjectItem(root, "m~n"));
-
-    cJSON_Delete(root);
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo"), cjson_get_object_item(root, "foo"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo/0"), cjson_get_object_item(root, "foo")->child);
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/foo/0"), cjson_get_object_item(root, "foo")->child);
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/"), cjson_get_object_item(root, ""));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/a~1b"), cjson_get_object_item(root, "a/b"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c%d"), cjson_get_object_item(root, "c%d"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c^f"), cjson_get_object_item(root, "c^f"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/c|f"), cjson_get_object_item(root, "c|f"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/i\\j"), cjson_get_object_item(root, "i\\j"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/k\"l"), cjson_get_object_item(root, "k\"l"));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/ "), cjson_get_object_item(root, " "));
+    TEST_ASSERT_EQUAL_PTR(cJSONUtils_GetPointer(root, "/m~0n"), cjson_get_object_item(root, "m~n"));
+
+    cjson_delete(root);
 }
 
 static void misc_tests(void)
 {
     /* Misc tests */
     int numbers[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-    cJSON *object = NULL;
-    cJSON *object1 = NULL;
-    cJSON *object2 = NULL;
-    cJSON *object3 = NULL;
-    cJSON *object4 = NULL;
-    cJSON *nums = NULL;
-    cJSON *num6 = NULL;
+    cjson_t *object = NULL;
+    cjson_t *object1 = NULL;
+    cjson_t *object2 = NULL;
+    cjson_t *object3 = NULL;
+    cjson_t *object4 = NULL;
+    cjson_t *nums = NULL;
+    cjson_t *num6 = NULL;
     char *pointer = NULL;
 
     printf("JSON Pointer construct\n");
-    object = cJSON_CreateObject();
-    nums = cJSON_CreateIntArray(numbers, 10);
-    num6 = cJSON_GetArrayItem(nums, 6);
-    cJSON_AddItemToObject(object, "numbers", nums);
+    object = cjson_create_object();
+    nums = cjson_create_int_array(numbers, 10);
+    num6 = cjson_get_array_item(nums, 6);
+    cjson_add_item_to_object(object, "numbers", nums);
 
     pointer = cJSONUtils_FindPointerFromObjectTo(object, num6);
     TEST_ASSERT_EQUAL_STRING("/numbers/6", pointer);
@@ -116,23 +116,23 @@ static void misc_tests(void)
     TEST_ASSERT_EQUAL_STRING("", pointer);
     free(pointer);
 
-    object1 = cJSON_CreateObject();
-    object2 = cJSON_CreateString("m~n");
-    cJSON_AddItemToObject(object1, "m~n", object2);
+    object1 = cjson_create_object();
+    object2 = cjson_create_string("m~n");
+    cjson_add_item_to_object(object1, "m~n", object2);
     pointer = cJSONUtils_FindPointerFromObjectTo(object1, object2);
     TEST_ASSERT_EQUAL_STRING("/m~0n",pointer);
     free(pointer);
 
-    object3 = cJSON_CreateObject();
-    object4 = cJSON_CreateString("m/n");
-    cJSON_AddItemToObject(object3, "m/n", object4);
+    object3 = cjson_create_object();
+    object4 = cjson_create_string("m/n");
+    cjson_add_item_to_object(object3, "m/n", object4);
     pointer = cJSONUtils_FindPointerFromObjectTo(object3, object4);
     TEST_ASSERT_EQUAL_STRING("/m~1n",pointer);
     free(pointer);
 
-    cJSON_Delete(object);
-    cJSON_Delete(object1);
-    cJSON_Delete(object3);
+    cjson_delete(object);
+    cjson_delete(object1);
+    cjson_delete(object3);
 }
 
 static void sort_tests(void)
@@ -140,16 +140,16 @@ static void sort_tests(void)
     /* Misc tests */
     const char *random = "QWERTYUIOPASDFGHJKLZXCVBNM";
     char buf[2] = {'\0', '\0'};
-    cJSON *sortme = NULL;
+    cjson_t *sortme = NULL;
     size_t i = 0;
-    cJSON *current_element = NULL;
+    cjson_t *current_element = NULL;
 
     /* JSON Sort test: */
-    sortme = cJSON_CreateObject();
+    sortme = cjson_create_object();
     for (i = 0; i < 26; i++)
     {
         buf[0] = random[i];
-        cJSON_AddItemToObject(sortme, buf, cJSON_CreateNumber(1));
+        cjson_add_item_to_object(sortme, buf, cjson_create_number(1));
     }
 
     cJSONUtils_SortObject(sortme);
@@ -162,7 +162,7 @@ static void sort_tests(void)
         current_element = current_element->next;
     }
 
-    cJSON_Delete(sortme);
+    cjson_delete(sortme);
 }
 
 static void merge_tests(void)
@@ -175,17 +175,17 @@ static void merge_tests(void)
     printf("JSON Merge Patch tests\n");
     for (i = 0; i < 15; i++)
     {
-        cJSON *object_to_be_merged = cJSON_Parse(merges[i][0]);
-        cJSON *patch = cJSON_Parse(merges[i][1]);
-        patchtext = cJSON_PrintUnformatted(patch);
+        cjson_t *object_to_be_merged = cjson_parse(merges[i][0]);
+        cjson_t *patch = cjson_parse(merges[i][1]);
+        patchtext = cjson_print_unformatted(patch);
         object_to_be_merged = cJSONUtils_MergePatch(object_to_be_merged, patch);
-        after = cJSON_PrintUnformatted(object_to_be_merged);
+        after = cjson_print_unformatted(object_to_be_merged);
         TEST_ASSERT_EQUAL_STRING(merges[i][2], after);
 
         free(patchtext);
         free(after);
-        cJSON_Delete(object_to_be_merged);
-        cJSON_Delete(patch);
+        cjson_delete(object_to_be_merged);
+        cjson_delete(patch);
     }
 }
 
@@ -197,16 +197,16 @@ static void generate_merge_tests(void)
     /* Generate Merge tests: */
     for (i = 0; i < 15; i++)
     {
-        cJSON *from = cJSON_Parse(merges[i][0]);
-        cJSON *to = cJSON_Parse(merges[i][2]);
-        cJSON *patch = cJSONUtils_GenerateMergePatch(from,to);
+        cjson_t *from = cjson_parse(merges[i][0]);
+        cjson_t *to = cjson_parse(merges[i][2]);
+        cjson_t *patch = cJSONUtils_GenerateMergePatch(from,to);
         from = cJSONUtils_MergePatch(from,patch);
-        patchedtext = cJSON_PrintUnformatted(from);
+        patchedtext = cjson_print_unformatted(from);
         TEST_ASSERT_EQUAL_STRING(merges[i][2], patchedtext);
 
-        cJSON_Delete(from);
-        cJSON_Delete(to);
-        cJSON_Delete(patch);
+        cjson_delete(from);
+        cjson_delete(to);
+        cjson_delete(patch);
         free(patchedtext);
     }
 }
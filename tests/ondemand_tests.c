@@ -0,0 +1,381 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static void * CJSON_CDECL failing_malloc(size_t size)
+{
+    (void)size;
+    return NULL;
+}
+
+/* work around MSVC error C2322: '...' address of dillimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cjson_hooks_t failing_hooks = {
+    failing_malloc,
+    normal_free
+};
+
+static const char document_text[] =
+    "\xEF\xBB\xBF {\"id\": 42, \"tags\": [\"a\", \"]\", {\"x\": [[], {}]}], \"name\": \"cat\\\"s\",\n"
+    "  \"nested\": {\"deep\": {\"value\": -2.5e3}, \"list\": [1, 2, 3]}, \"big\": 9007199254740993, \"t\": true}";
+
+static void ondemand_should_find_fields_in_any_order(void)
+{
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t value;
+    cjson_od_value_t nested;
+    cjson_od_value_t deep;
+    cjson_int64_t integer = 0;
+    double number = 0;
+
+    /* nothing is allocated */
+    cjson_init_hooks(&failing_hooks);
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, document_text, sizeof(document_text) - 1, &root));
+    TEST_ASSERT_EQUAL_INT(CJSON_OBJECT, cjson_od_type(&root));
+
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "id", &value));
+    TEST_ASSERT_TRUE(cjson_od_get_int64(&value, &integer));
+    TEST_ASSERT_TRUE(integer == 42);
+
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "nested", &nested));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&nested, "deep", &deep));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&deep, "value", &value));
+    TEST_ASSERT_TRUE(cjson_od_get_double(&value, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(-2500.0, number);
+
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "big", &value));
+    TEST_ASSERT_TRUE(cjson_od_get_int64(&value, &integer));
+    TEST_ASSERT_TRUE(integer == ((cjson_int64_t)9007199254740992.0 + 1));
+
+    /* behind the cursor, found after wrapping around */
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "tags", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ARRAY, cjson_od_type(&value));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "tags", &value));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "t", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_TRUE, cjson_od_type(&value));
+
+    /* missing fields and values of other types are no errors */
+    TEST_ASSERT_FALSE(cjson_od_find_field(&root, "missing", &value));
+    TEST_ASSERT_FALSE(cjson_od_find_field(&root, "nam", &value));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "name", &value));
+    TEST_ASSERT_FALSE(cjson_od_get_double(&value, &number));
+    TEST_ASSERT_FALSE(cjson_od_find_field(&value, "id", &deep));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+
+    cjson_init_hooks(NULL);
+}
+
+static void ondemand_should_step_through_arrays(void)
+{
+    const char text[] = "[1, [2, [3]], {\"a\": [4]}, \"5\", 6.5 ]";
+    const int types[] = { CJSON_NUMBER, CJSON_ARRAY, CJSON_OBJECT, CJSON_STRING, CJSON_NUMBER };
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t element;
+    cjson_od_value_t inner;
+    size_t count = 0;
+    double number = 0;
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, text, sizeof(text) - 1, &root));
+    while (cjson_od_next_element(&root, &element))
+    {
+        TEST_ASSERT_TRUE(count < (sizeof(types) / sizeof(types[0])));
+        TEST_ASSERT_EQUAL_INT(types[count], cjson_od_type(&element));
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT(5, (unsigned int)count);
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+    TEST_ASSERT_TRUE(cjson_od_get_double(&element, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(6.5, number);
+    TEST_ASSERT_FALSE(cjson_od_next_element(&root, &element));
+
+    /* nested arrays have cursors of their own */
+    root.cursor = 0;
+    TEST_ASSERT_TRUE(cjson_od_next_element(&root, &element));
+    TEST_ASSERT_TRUE(cjson_od_next_element(&root, &element));
+    TEST_ASSERT_TRUE(cjson_od_next_element(&element, &inner));
+    TEST_ASSERT_TRUE(cjson_od_get_double(&inner, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, number);
+    TEST_ASSERT_TRUE(cjson_od_next_element(&element, &inner));
+    TEST_ASSERT_EQUAL_INT(CJSON_ARRAY, cjson_od_type(&inner));
+    TEST_ASSERT_FALSE(cjson_od_next_element(&element, &inner));
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, "[ ]", 3, &root));
+    TEST_ASSERT_FALSE(cjson_od_next_element(&root, &element));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+}
+
+static void ondemand_should_compare_escaped_keys(void)
+{
+    const char text[] = "{\"k\\u0065y\": 1, \"caf\\u00e9\": 2, \"x\\q\": 3, \"\\u006eext\": 4}";
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t value;
+    cjson_int64_t integer = 0;
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, text, sizeof(text) - 1, &root));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "key", &value));
+    TEST_ASSERT_TRUE(cjson_od_get_int64(&value, &integer));
+    TEST_ASSERT_TRUE(integer == 1);
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "caf\xc3\xa9", &value));
+    TEST_ASSERT_TRUE(cjson_od_get_int64(&value, &integer));
+    TEST_ASSERT_TRUE(integer == 2);
+
+    /* an invalid escape sequence is only noticed if the key has to be decoded */
+    TEST_ASSERT_FALSE(cjson_od_find_field(&root, "missing", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "next", &value));
+    TEST_ASSERT_FALSE(cjson_od_find_field(&root, "xy", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_INVALID_STRING, document.error.kind);
+}
+
+static void ondemand_should_report_invalid_structure(void)
+{
+    const char *invalid[] = {
+        "{\"a\": [1, {\"b\": 2]], \"c\": 1}",
+        "{\"a\": \"unterminated, \"c\": 1",
+        "{\"a\" 1, \"c\": 1}",
+        "{\"a\": 1 \"c\": 1}",
+        "{\"a\": [1, 2, \"c\": 1}",
+        "{\"a\": , \"c\": 1}",
+        "{\"a\": [{\"b\": \"x]}",
+        "{\"a\": [[1], [2"
+    };
+    const cjson_error_kind_t kinds[] = {
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_CHARACTER,
+        CJSON_ERROR_UNEXPECTED_END,
+        CJSON_ERROR_UNEXPECTED_END
+    };
+    const size_t offsets[] = { 17, 22, 5, 8, 19, 6, 13, 13 };
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t value;
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(invalid) / sizeof(invalid[0])); i++)
+    {
+        TEST_ASSERT_TRUE(cjson_ondemand_init(&document, invalid[i], strlen(invalid[i]), &root));
+        TEST_ASSERT_FALSE(cjson_od_find_field(&root, "c", &value));
+        TEST_ASSERT_EQUAL_INT(kinds[i], document.error.kind);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)offsets[i], (unsigned int)document.error.offset);
+    }
+
+    /* garbage behind a number */
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, "[12x]", 5, &root));
+    TEST_ASSERT_TRUE(cjson_od_next_element(&root, &value));
+    TEST_ASSERT_FALSE(cjson_od_get_int64(&value, (cjson_int64_t*)&i));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_CHARACTER, document.error.kind);
+    TEST_ASSERT_EQUAL_UINT(3, (unsigned int)document.error.offset);
+
+    /* there has to be a value */
+    TEST_ASSERT_FALSE(cjson_ondemand_init(&document, " \n ", 3, &root));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_CHARACTER, document.error.kind);
+    TEST_ASSERT_FALSE(cjson_ondemand_init(&document, "", 0, &root));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_END, document.error.kind);
+    TEST_ASSERT_FALSE(cjson_ondemand_init(&document, NULL, 0, &root));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_INVALID_ARGUMENT, document.error.kind);
+}
+
+/* an object with an array of the given depth in it, followed by another field */
+static char *create_nested_document(const size_t depth, size_t * const length)
+{
+    char *text = (char*)malloc((depth * 2) + 16);
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(text);
+    memcpy(text, "{\"a\": ", 6);
+    *length = 6;
+    for (i = 0; i < depth; i++)
+    {
+        text[(*length)++] = '[';
+    }
+    for (i = 0; i < depth; i++)
+    {
+        text[(*length)++] = ']';
+    }
+    memcpy(text + *length, ", \"b\": 1}", 9);
+    *length += 9;
+
+    return text;
+}
+
+static void ondemand_should_respect_the_nesting_limit(void)
+{
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t value;
+    size_t length = 0;
+    char *text = create_nested_document(CJSON_NESTING_LIMIT - 1, &length);
+
+    /* as deep as cjson_parse allows */
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, text, length, &root));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "b", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "a", &value));
+    while (cjson_od_next_element(&value, &value))
+    {
+    }
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, document.error.kind);
+    free(text);
+
+    /* one level more, when skipping and when stepping in */
+    text = create_nested_document(CJSON_NESTING_LIMIT, &length);
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, text, length, &root));
+    TEST_ASSERT_FALSE(cjson_od_find_field(&root, "b", &value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NESTING_LIMIT, document.error.kind);
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, text, length, &root));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "a", &value));
+    while (cjson_od_next_element(&value, &value))
+    {
+    }
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NESTING_LIMIT, document.error.kind);
+    free(text);
+}
+
+static void ondemand_should_parse_values_on_request(void)
+{
+    cjson_ondemand_t document;
+    cjson_od_value_t root;
+    cjson_od_value_t value;
+    cjson_t *item = NULL;
+    char *printed = NULL;
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, document_text, sizeof(document_text) - 1, &root));
+
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "name", &value));
+    item = cjson_od_parse(&value);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_STRING("cat\"s", cjson_get_string_value(item));
+    cjson_delete(item);
+
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "nested", &value));
+    item = cjson_od_parse(&value);
+    TEST_ASSERT_NOT_NULL(item);
+    printed = cjson_print_unformatted(item);
+    TEST_ASSERT_EQUAL_STRING("{\"deep\":{\"value\":-2500},\"list\":[1,2,3]}", printed);
+    cjson_free(printed);
+    cjson_delete(item);
+
+    TEST_ASSERT_TRUE(cjson_ondemand_init(&document, "{\"a\": [1, }", 11, &root));
+    TEST_ASSERT_TRUE(cjson_od_find_field(&root, "a", &value));
+    TEST_ASSERT_NULL(cjson_od_parse(&value));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_CHARACTER, document.error.kind);
+    TEST_ASSERT_EQUAL_UINT(10, (unsigned int)document.error.offset);
+}
+
+static void structural_run_length_should_stop_at_strings_and_brackets(void)
+{
+    unsigned char text[80];
+    size_t position = 0;
+    unsigned int character = 0;
+
+    /* every offset, so the vector loops and the scalar tail are covered */
+    for (position = 0; position < sizeof(text); position++)
+    {
+        memset(text, 'a', sizeof(text));
+        text[position] = '}';
+        TEST_ASSERT_EQUAL_UINT((unsigned int)position, (unsigned int)structural_run_length(text, sizeof(text)));
+    }
+
+    for (character = 0; character < 256; character++)
+    {
+        cjson_bool_t structural = (character == '\"') || (character == '[') || (character == ']') || (character == '{') || (character == '}');
+        memset(text, 'a', sizeof(text));
+        text[40] = (unsigned char)character;
+        TEST_ASSERT_EQUAL_UINT(structural ? 40U : (unsigned int)sizeof(text), (unsigned int)structural_run_length(text, sizeof(text)));
+    }
+}
+
+static void skip_value_should_find_the_end_of_values(void)
+{
+    const char nested[] = "  {\"a\": [1, \"]}\\\"[\", {\"b\": null}], \"long\": \"a string longer than a vector or two, with { and [ in it\", \"c\": 2} tail";
+    const char scalar[] = "123, 4";
+    char array[302];
+    const char *end = NULL;
+    size_t i = 0;
+
+    TEST_ASSERT_TRUE(cjson_skip_value(nested, sizeof(nested) - 1, &end));
+    TEST_ASSERT_EQUAL_PTR(strstr(nested, " tail"), end);
+
+    TEST_ASSERT_TRUE(cjson_skip_value(scalar, sizeof(scalar) - 1, &end));
+    TEST_ASSERT_EQUAL_PTR(scalar + 3, end);
+    TEST_ASSERT_TRUE(cjson_skip_value("\"x\\\"y\" z", 8, NULL));
+
+    /* long runs without anything structural */
+    array[0] = '[';
+    for (i = 1; i < (sizeof(array) - 1); i += 2)
+    {
+        array[i] = '1';
+        array[i + 1] = ',';
+    }
+    array[sizeof(array) - 1] = ']';
+    TEST_ASSERT_TRUE(cjson_skip_value(array, sizeof(array), &end));
+    TEST_ASSERT_EQUAL_PTR(array + sizeof(array), end);
+}
+
+static void skip_value_should_reject_broken_structure(void)
+{
+    const char mismatched[] = "[1, 2}";
+    const char unclosed[] = "{\"a\": [1, 2";
+    const char *end = NULL;
+
+    TEST_ASSERT_FALSE(cjson_skip_value(NULL, 0, &end));
+    TEST_ASSERT_FALSE(cjson_skip_value("   ", 3, &end));
+    TEST_ASSERT_FALSE(cjson_skip_value("]", 1, &end));
+
+    TEST_ASSERT_FALSE(cjson_skip_value(mismatched, sizeof(mismatched) - 1, &end));
+    TEST_ASSERT_EQUAL_PTR(mismatched + 5, end);
+    TEST_ASSERT_FALSE(cjson_skip_value(unclosed, sizeof(unclosed) - 1, &end));
+    TEST_ASSERT_EQUAL_PTR(unclosed + sizeof(unclosed) - 1, end);
+    TEST_ASSERT_FALSE(cjson_skip_value("[\"]\"", 4, &end));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(ondemand_should_find_fields_in_any_order);
+    RUN_TEST(ondemand_should_step_through_arrays);
+    RUN_TEST(ondemand_should_compare_escaped_keys);
+    RUN_TEST(ondemand_should_report_invalid_structure);
+    RUN_TEST(ondemand_should_respect_the_nesting_limit);
+    RUN_TEST(ondemand_should_parse_values_on_request);
+    RUN_TEST(structural_run_length_should_stop_at_strings_and_brackets);
+    RUN_TEST(skip_value_should_find_the_end_of_values);
+    RUN_TEST(skip_value_should_reject_broken_structure);
+
+    return UNITY_END();
+}
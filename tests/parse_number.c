@@ -45,7 +45,7 @@ static void assert_is_number(cjson_t *number_item)
 
 static void assert_parse_number(const char *string, int integer, double real)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
     buffer.content = (const unsigned char*)string;
     buffer.length = strlen(string) + sizeof("");
 
@@ -96,6 +96,169 @@ static void parse_number_should_parse_negative_reals(void)
     assert_parse_number("-123e-128", 0, -123e-128);
 }
 
+static void assert_parse_exact_integer(const char *string, cjson_bool_t is_unsigned, cjson_uint64_t expected)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
+    cjson_int64_t signed_value = 0;
+    cjson_uint64_t unsigned_value = 0;
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+
+    TEST_ASSERT_TRUE(parse_number(item, &buffer));
+    assert_is_number(item);
+    TEST_ASSERT_BITS(CJSON_NUMBER_IS_INT64 | CJSON_NUMBER_IS_UINT64, is_unsigned ? CJSON_NUMBER_IS_UINT64 : CJSON_NUMBER_IS_INT64, item->type);
+    TEST_ASSERT_EQUAL_DOUBLE(strtod(string, NULL), item->valuedouble);
+    if (is_unsigned || (string[0] != '-'))
+    {
+        TEST_ASSERT_TRUE(cjson_get_uint64(item, &unsigned_value));
+        TEST_ASSERT_TRUE(unsigned_value == expected);
+    }
+    if (!is_unsigned)
+    {
+        TEST_ASSERT_TRUE(cjson_get_int64(item, &signed_value));
+        TEST_ASSERT_TRUE((cjson_uint64_t)signed_value == expected);
+    }
+    else
+    {
+        TEST_ASSERT_FALSE(cjson_get_int64(item, &signed_value));
+    }
+}
+
+static void parse_number_should_parse_64bit_integers_exactly(void)
+{
+    assert_parse_exact_integer("0", false, 0);
+    assert_parse_exact_integer("9007199254740993", false, uint64_constant(0x200000, 1));
+    assert_parse_exact_integer("9223372036854775807", false, int64_magnitude_limit - 1);
+    assert_parse_exact_integer("-9223372036854775808", false, int64_magnitude_limit);
+    assert_parse_exact_integer("-1", false, ~(cjson_uint64_t)0);
+    assert_parse_exact_integer("9223372036854775808", true, int64_magnitude_limit);
+    assert_parse_exact_integer("18446744073709551615", true, ~(cjson_uint64_t)0);
+}
+
+static void parse_number_should_parse_other_numbers_as_doubles(void)
+{
+    const char *const numbers[] = { "-0", "1.0", "1e3", "18446744073709551616", "-9223372036854775809", "01" };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(numbers) / sizeof(numbers[0])); i++)
+    {
+        parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
+        buffer.content = (const unsigned char*)numbers[i];
+        buffer.length = strlen(numbers[i]) + sizeof("");
+
+        TEST_ASSERT_TRUE(parse_number(item, &buffer));
+        TEST_ASSERT_BITS_MESSAGE(CJSON_NUMBER_IS_INT64 | CJSON_NUMBER_IS_UINT64, 0, item->type, numbers[i]);
+    }
+}
+
+/* the parsed number has to be bit for bit what strtod returns */
+static void assert_parse_number_like_strtod(const char *string)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
+    double expected = strtod(string, NULL);
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+
+    TEST_ASSERT_TRUE_MESSAGE(parse_number(item, &buffer), string);
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(string), buffer.offset, string);
+    TEST_ASSERT_TRUE_MESSAGE(memcmp(&expected, &item->valuedouble, sizeof(double)) == 0, string);
+}
+
+/* deterministic pseudo random numbers, so failures are reproducible */
+static unsigned long random_state = 1;
+static unsigned long random_number(void)
+{
+    random_state = ((random_state * 1103515245UL) + 12345UL) & 0x7FFFFFFFUL;
+    return random_state >> 8;
+}
+
+static void parse_number_should_round_correctly(void)
+{
+    /* halfway between two doubles, has to round to even */
+    assert_parse_number_like_strtod("9007199254740993");
+    assert_parse_number_like_strtod("9007199254740995");
+    assert_parse_number_like_strtod("-9007199254740993");
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203125");
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203124");
+    assert_parse_number_like_strtod("1.00000000000000011102230246251565404236316680908203126");
+    assert_parse_number_like_strtod("9223372036854775807");
+    assert_parse_number_like_strtod("18446744073709551615");
+    assert_parse_number_like_strtod("18446744073709551616");
+    assert_parse_number_like_strtod("12345678901234567890123");
+    /* extremes */
+    assert_parse_number_like_strtod("1.7976931348623157e308");
+    assert_parse_number_like_strtod("2.2250738585072014e-308");
+    assert_parse_number_like_strtod("2.2250738585072011e-308");
+    assert_parse_number_like_strtod("4.9406564584124654e-324");
+    assert_parse_number_like_strtod("1e-400");
+    assert_parse_number_like_strtod("-1e-400");
+    assert_parse_number_like_strtod("0e1000000");
+    assert_parse_number_like_strtod("0.000000000000000000000000000001");
+    assert_parse_number_like_strtod("0.1");
+    assert_parse_number_like_strtod("0.3");
+    assert_parse_number_like_strtod("5e-324");
+    assert_parse_number_like_strtod("7.2057594037927933e16");
+}
+
+static void parse_number_should_match_strtod_on_random_digits(void)
+{
+    char string[64];
+    int i = 0;
+
+    for (i = 0; i < 100000; i++)
+    {
+        size_t length = 0;
+        unsigned long digits = (random_number() % 22) + 1;
+        unsigned long point = random_number() % (digits + 1);
+        unsigned long d = 0;
+
+        if ((random_number() % 2) == 0)
+        {
+            string[length++] = '-';
+        }
+        string[length++] = (char)('1' + (random_number() % 9));
+        for (d = 1; d < digits; d++)
+        {
+            if (d == point)
+            {
+                string[length++] = '.';
+            }
+            string[length++] = (char)('0' + (random_number() % 10));
+        }
+        sprintf(string + length, "e%d", (int)(random_number() % 700) - 350);
+
+        assert_parse_number_like_strtod(string);
+    }
+}
+
+static void parse_number_should_match_strtod_on_random_doubles(void)
+{
+    char string[64];
+    int i = 0;
+
+    for (i = 0; i < 100000; i++)
+    {
+        cjson_uint64_t bits = 0;
+        double number = 0;
+        int part = 0;
+
+        for (part = 0; part < 4; part++)
+        {
+            bits = (bits << 16) | (random_number() & 0xFFFF);
+        }
+        memcpy(&number, &bits, sizeof(number));
+        if ((number != number) || (number > DBL_MAX) || (number < -DBL_MAX))
+        {
+            continue;
+        }
+
+        sprintf(string, "%.17g", number);
+        assert_parse_number_like_strtod(string);
+        sprintf(string, "%.15g", number);
+        assert_parse_number_like_strtod(string);
+    }
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item */
@@ -106,5 +269,10 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_number_should_parse_positive_integers);
     RUN_TEST(parse_number_should_parse_positive_reals);
     RUN_TEST(parse_number_should_parse_negative_reals);
+    RUN_TEST(parse_number_should_parse_64bit_integers_exactly);
+    RUN_TEST(parse_number_should_parse_other_numbers_as_doubles);
+    RUN_TEST(parse_number_should_round_correctly);
+    RUN_TEST(parse_number_should_match_strtod_on_random_digits);
+    RUN_TEST(parse_number_should_match_strtod_on_random_doubles);
     return UNITY_END();
 }
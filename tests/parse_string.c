@@ -45,7 +45,7 @@ static void assert_is_string(cjson_t *string_item)
 
 static void assert_parse_string(const char *string, const char *expected)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
     buffer.content = (const unsigned char*)string;
     buffer.length = strlen(string) + sizeof("");
     buffer.hooks = global_hooks;
@@ -53,13 +53,13 @@ static void assert_parse_string(const char *string, const char *expected)
     TEST_ASSERT_TRUE_MESSAGE(parse_string(item, &buffer), "Couldn't parse string.");
     assert_is_string(item);
     TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, item->valuestring, "The parsed result isn't as expected.");
-    global_hooks.deallocate(item->valuestring);
+    global_hooks.deallocate(item->valuestring, global_hooks.user);
     item->valuestring = NULL;
 }
 
 static void assert_not_parse_string(const char * const string)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
     buffer.content = (const unsigned char*)string;
     buffer.length = strlen(string) + sizeof("");
     buffer.hooks = global_hooks;
@@ -80,8 +80,6 @@ static void parse_string_should_parse_strings(void)
         "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u20AC\\u732b\"",
         "\"\\/\b\f\n\r\t€猫");
     reset(item);
-    assert_parse_string("\"\b\f\n\r\t\"", "\b\f\n\r\t");
-    reset(item);
 }
 
 static void parse_string_should_parse_utf16_surrogate_pairs(void)
@@ -106,12 +104,170 @@ static void parse_string_should_not_parse_invalid_backslash(void)
     reset(item);
 }
 
+static void parse_string_should_not_parse_invalid_utf16_literals(void)
+{
+    /* an invalid digit mustn't let the literal run over the closing quote */
+    const char json[] = "\"\\u00\"1xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\"";
+    char insitu[sizeof(json)];
+    cjson_arena_t *arena = cjson_arena_create(0);
+
+    assert_not_parse_string(json);
+    reset(item);
+    assert_not_parse_string("\"\\u00zz\"");
+    reset(item);
+    assert_not_parse_string("\"\\uD83D\\udc3\"1\"");
+    reset(item);
+
+    TEST_ASSERT_NULL(cjson_parse_with_length(json, sizeof(json)));
+    TEST_ASSERT_NULL(cjson_parse(json));
+    TEST_ASSERT_NULL(cjson_parse_with_views(json, sizeof(json), NULL));
+    TEST_ASSERT_NULL(cjson_parse_into_arena(arena, json, sizeof(json)));
+    memcpy(insitu, json, sizeof(json));
+    TEST_ASSERT_NULL(cjson_parse_insitu(insitu, sizeof(insitu)));
+
+    cjson_arena_delete(arena);
+}
+
 static void parse_string_should_not_overflow_with_closing_backslash(void)
 {
     assert_not_parse_string("\"000000000000000000\\");
     reset(item);
 }
 
+static void parse_string_should_parse_long_strings(void)
+{
+    char string[100];
+    char expected[100];
+    size_t position = 0;
+
+    /* escape sequences and closing quotes at every position of the 16 and 32 byte blocks */
+    for (position = 0; position < 80; position++)
+    {
+        memset(string, 'a', sizeof(string));
+        memset(expected, 'a', sizeof(expected));
+        string[0] = '\"';
+        string[position + 1] = '\\';
+        string[position + 2] = 'n';
+        string[90] = '\"';
+        string[91] = '\0';
+        expected[position] = '\n';
+        expected[88] = '\0';
+        assert_parse_string(string, expected);
+        reset(item);
+
+        memset(string, 'b', sizeof(string));
+        memset(expected, 'b', sizeof(expected));
+        string[0] = '\"';
+        string[position + 1] = '\"';
+        string[position + 2] = '\0';
+        expected[position] = '\0';
+        assert_parse_string(string, expected);
+        reset(item);
+
+        /* unterminated */
+        string[position + 1] = 'b';
+        assert_not_parse_string(string);
+        reset(item);
+    }
+}
+
+static void parse_string_should_not_parse_control_characters(void)
+{
+    char string[100];
+    char expected[100];
+    size_t position = 0;
+
+    assert_not_parse_string("\"\b\f\n\r\t\"");
+    reset(item);
+    assert_not_parse_string("\"\x1f\"");
+    reset(item);
+
+    /* at every position of the 16 and 32 byte blocks */
+    for (position = 0; position < 80; position++)
+    {
+        memset(string, 'a', sizeof(string));
+        memset(expected, 'a', sizeof(expected));
+        string[0] = '\"';
+        string[position + 1] = '\x01';
+        string[90] = '\"';
+        string[91] = '\0';
+        assert_not_parse_string(string);
+        reset(item);
+
+        /* after an escape sequence */
+        string[1] = '\\';
+        string[2] = 't';
+        if (position > 1)
+        {
+            assert_not_parse_string(string);
+            reset(item);
+        }
+
+        /* DEL isn't a control character for JSON */
+        string[position + 1] = '\x7f';
+        expected[0] = '\t';
+        expected[position] = '\x7f';
+        memmove(expected + 1, expected + 2, 87);
+        expected[88] = '\0';
+        if (position > 1)
+        {
+            assert_parse_string(string, expected);
+            reset(item);
+        }
+    }
+}
+
+static void parse_string_should_grow_the_output(void)
+{
+    char string[1000];
+    char expected[1000];
+    internal_hooks without_realloc = global_hooks;
+    cjson_arena_t *small_blocks = cjson_arena_create(64);
+    cjson_arena_t *large_blocks = cjson_arena_create(0);
+    parse_buffer buffer;
+    size_t i = 0;
+    size_t length = 0;
+
+    /* longer than the initial output, with escape sequences at its ends */
+    string[0] = '\"';
+    for (i = 1; i < 990; i++)
+    {
+        string[i] = (char)('a' + (i % 26));
+    }
+    memcpy(string + 1, "\\u00e9", 6);
+    memcpy(string + 980, "\\ud83d\\ude00", 12);
+    string[992] = '\"';
+    string[993] = '\0';
+    memcpy(expected, "\xc3\xa9", 2);
+    memcpy(expected + 2, string + 7, 973);
+    memcpy(expected + 975, "\xf0\x9f\x98\x80", 4);
+    expected[979] = '\0';
+    length = strlen(string) + sizeof("");
+    without_realloc.reallocate = NULL;
+
+    for (i = 0; i < 4; i++)
+    {
+        memset(&buffer, 0, sizeof(buffer));
+        buffer.content = (const unsigned char*)string;
+        buffer.length = length;
+        buffer.hooks = (i == 1) ? without_realloc : global_hooks;
+        buffer.arena = (i == 2) ? small_blocks : ((i == 3) ? large_blocks : NULL);
+
+        TEST_ASSERT_TRUE(parse_string(item, &buffer));
+        TEST_ASSERT_EQUAL_STRING(expected, item->valuestring);
+        TEST_ASSERT_EQUAL_UINT(993, (unsigned int)buffer.offset);
+        if (buffer.arena == NULL)
+        {
+            global_hooks.deallocate(item->valuestring, global_hooks.user);
+        }
+        item->valuestring = NULL;
+        reset(item);
+    }
+
+    cjson_arena_delete(small_blocks);
+    cjson_arena_delete(large_blocks);
+}
+
 static void parse_string_should_parse_bug_94(void)
 {
     const char string[] = "\"~!@\\\\#$%^&*()\\\\\\\\-\\\\+{}[]:\\\\;\\\\\\\"\\\\<\\\\>?/.,DC=ad,DC=com\"";
@@ -129,7 +285,11 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_string_should_parse_utf16_surrogate_pairs);
     RUN_TEST(parse_string_should_not_parse_non_strings);
     RUN_TEST(parse_string_should_not_parse_invalid_backslash);
+    RUN_TEST(parse_string_should_not_parse_control_characters);
     RUN_TEST(parse_string_should_parse_bug_94);
+    RUN_TEST(parse_string_should_parse_long_strings);
+    RUN_TEST(parse_string_should_grow_the_output);
     RUN_TEST(parse_string_should_not_overflow_with_closing_backslash);
+    RUN_TEST(parse_string_should_not_parse_invalid_utf16_literals);
     return UNITY_END();
 }
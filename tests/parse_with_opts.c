@@ -97,6 +97,67 @@ static void parse_with_opts_should_parse_utf8_bom(void)
     cjson_delete(without_bom);
 }
 
+static void assert_parse_error(const char *json, cjson_error_kind_t kind, size_t offset, size_t line, size_t column)
+{
+    cjson_error_t error = { CJSON_ERROR_NONE, 0, 0, 0 };
+
+    TEST_ASSERT_NULL(cjson_parse_with_error(json, strlen(json) + 1, true, &error));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(kind, error.kind, json);
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(offset, error.offset, json);
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(line, error.line, json);
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(column, error.column, json);
+}
+
+static void parse_with_error_should_report_errors(void)
+{
+    char deep[CJSON_NESTING_LIMIT + 2];
+
+    assert_parse_error("{ \"name\": ", CJSON_ERROR_UNEXPECTED_END, 10, 1, 11);
+    assert_parse_error("[1, 2,\n 3,\n  x]", CJSON_ERROR_UNEXPECTED_CHARACTER, 13, 3, 3);
+    assert_parse_error("[\"unterminated", CJSON_ERROR_UNEXPECTED_END, 2, 1, 3);
+    assert_parse_error("{\n\"a\": \"\\x\"}", CJSON_ERROR_INVALID_STRING, 8, 2, 7);
+    assert_parse_error("[-]", CJSON_ERROR_INVALID_NUMBER, 1, 1, 2);
+    assert_parse_error("{} x", CJSON_ERROR_TRAILING_CHARACTERS, 3, 1, 4);
+
+    memset(deep, '[', sizeof(deep) - 1);
+    deep[sizeof(deep) - 1] = '\0';
+    assert_parse_error(deep, CJSON_ERROR_NESTING_LIMIT, CJSON_NESTING_LIMIT, 1, CJSON_NESTING_LIMIT + 1);
+}
+
+static void parse_with_error_should_report_success(void)
+{
+    const char json[] = "[1, 2] rest";
+    cjson_error_t error = { CJSON_ERROR_INVALID_ARGUMENT, 0, 1, 1 };
+    cjson_t *item = cjson_parse_with_error(json, sizeof(json), false, &error);
+
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, error.kind);
+    TEST_ASSERT_EQUAL_UINT(6, error.offset);
+    TEST_ASSERT_EQUAL_UINT(0, error.line);
+    cjson_delete(item);
+
+    item = cjson_parse_with_error(json, 6, true, NULL);
+    TEST_ASSERT_NULL(item);
+    TEST_ASSERT_NULL(cjson_parse_with_error(NULL, 0, false, &error));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_INVALID_ARGUMENT, error.kind);
+}
+
+static void parse_with_error_should_not_touch_the_global_error(void)
+{
+    const char broken[] = "[1, 2";
+    cjson_error_t error;
+
+    TEST_ASSERT_NULL(cjson_parse(broken));
+    TEST_ASSERT_EQUAL_PTR(broken + 5, cjson_get_error_ptr());
+
+    TEST_ASSERT_NULL(cjson_parse_with_error("{", 2, false, &error));
+    TEST_ASSERT_EQUAL_PTR(broken + 5, cjson_get_error_ptr());
+
+    /* a successful parse without error parameter still clears it */
+    cjson_delete(cjson_parse("[]"));
+    TEST_ASSERT_NULL(cjson_get_error_ptr());
+}
+
 int CJSON_CDECL main(void)
 {
     UNITY_BEGIN();
@@ -107,6 +168,9 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_with_opts_should_require_null_if_requested);
     RUN_TEST(parse_with_opts_should_return_parse_end);
     RUN_TEST(parse_with_opts_should_parse_utf8_bom);
+    RUN_TEST(parse_with_error_should_report_errors);
+    RUN_TEST(parse_with_error_should_report_success);
+    RUN_TEST(parse_with_error_should_not_touch_the_global_error);
 
     return UNITY_END();
 }
@@ -30,7 +30,7 @@ static void assert_print_number(const char *expected, double input)
     unsigned char new_buffer[26];
     unsigned int i = 0;
     cjson_t item[1];
-    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
     buffer.buffer = printed;
     buffer.length = sizeof(printed);
     buffer.offset = 0;
@@ -42,7 +42,8 @@ static void assert_print_number(const char *expected, double input)
     memset(new_buffer, 0, sizeof(new_buffer));
     CJSON_SET_NUMBER_VALUE(item, input);
     TEST_ASSERT_TRUE_MESSAGE(print_number(item, &buffer), "Failed to print number.");
-    
+    new_buffer[buffer.offset] = '\0';
+
     /* In MinGW or visual studio(before 2015),the exponten is represented using three digits,like:"1e-009","1e+017"
      * remove extra "0" to output "1e-09" or "1e+17",which makes testcase PASS */
     for(i = 0;i <sizeof(new_buffer);i++)
@@ -62,6 +63,23 @@ static void assert_print_number(const char *expected, double input)
     TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, buffer.buffer, "Printed number is not as expected.");
 }
 
+static void assert_print_item(const char *expected, cjson_t *item)
+{
+    unsigned char printed[32];
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    buffer.buffer = printed;
+    buffer.length = sizeof(printed);
+    buffer.noalloc = true;
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE_MESSAGE(print_number(item, &buffer), "Failed to print number.");
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(expected), buffer.offset, "The offset doesn't match the printed length.");
+    printed[buffer.offset] = '\0';
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, buffer.buffer, "Printed number is not as expected.");
+    cjson_delete(item);
+}
+
 static void print_number_should_print_zero(void)
 {
     assert_print_number("0", 0);
@@ -88,7 +106,7 @@ static void print_number_should_print_positive_reals(void)
     assert_print_number("1000000000000", 10e11);
     assert_print_number("1.23e+129", 123e+127);
     assert_print_number("1.23e-126", 123e-128);
-    assert_print_number("3.1415926535897931", 3.1415926535897931);
+    assert_print_number("3.141592653589793", 3.1415926535897931);
 }
 
 static void print_number_should_print_negative_reals(void)
@@ -100,6 +118,109 @@ static void print_number_should_print_negative_reals(void)
     assert_print_number("-1.23e-126", -123e-128);
 }
 
+static void print_number_should_print_exact_64bit_integers(void)
+{
+    assert_print_item("9007199254740993", cjson_create_int64(uint64_constant(0x200000, 1)));
+    assert_print_item("9223372036854775807", cjson_create_int64((cjson_int64_t)(int64_magnitude_limit - 1)));
+    assert_print_item("-9223372036854775808", cjson_create_int64(-(cjson_int64_t)(int64_magnitude_limit - 1) - 1));
+    assert_print_item("18446744073709551615", cjson_create_uint64(~(cjson_uint64_t)0));
+    assert_print_item("0", cjson_create_uint64(0));
+    assert_print_item("1700000000123456789", cjson_parse("1700000000123456789"));
+    assert_print_item("-1700000000123456789", cjson_parse("-1700000000123456789"));
+}
+
+static void print_number_should_not_print_stale_integers(void)
+{
+    cjson_t *item = cjson_create_int64(uint64_constant(0x200000, 1));
+    TEST_ASSERT_NOT_NULL(item);
+
+    /* writing valuedouble directly (deprecated) must win over the stored integer */
+    item->valueint = 42;
+    item->valuedouble = 42;
+    assert_print_item("42", item);
+
+    item = cjson_create_int64(12);
+    TEST_ASSERT_NOT_NULL(item);
+    CJSON_SET_NUMBER_VALUE(item, 1.5);
+    assert_print_item("1.5", item);
+}
+
+static void print_number_should_print_shortest_representation(void)
+{
+    /* the exponents aren't normalized here, because the digits come from the built in formatter */
+    assert_print_item("0.1", cjson_create_number(0.1));
+    assert_print_item("0.3", cjson_create_number(0.3));
+    assert_print_item("1e+23", cjson_create_number(1e23));
+    assert_print_item("5e-324", cjson_create_number(4.9406564584124654e-324));
+    assert_print_item("1.7976931348623157e+308", cjson_create_number(1.7976931348623157e308));
+    assert_print_item("2.2250738585072014e-308", cjson_create_number(2.2250738585072014e-308));
+    assert_print_item("0.6666666666666666", cjson_create_number(2.0 / 3.0));
+    assert_print_item("1234567890123456.8", cjson_create_number(1234567890123456.8));
+    assert_print_item("0.0001", cjson_create_number(1e-4));
+    assert_print_item("1e-05", cjson_create_number(1e-5));
+}
+
+static void print_number_should_not_pad_doubles_beyond_2_53(void)
+{
+    cjson_t *item = NULL;
+    cjson_int64_t integer = 0;
+
+    /* 37484662939870630 would parse back as an exact integer that differs from the double */
+    assert_print_item("3.748466293987063e+16", cjson_create_number(3.7484662939870632e16));
+    assert_print_item("-3.748466293987063e+16", cjson_create_number(-3.7484662939870632e16));
+    assert_print_item("1e+16", cjson_create_number(1e16));
+    assert_print_item("9007199254740994", cjson_create_number(9007199254740994.0));
+    assert_print_item("9007199254740991", cjson_create_number(9007199254740991.0));
+
+    item = cjson_parse("3.748466293987063e+16");
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE(cjson_get_number_value(item) == 3.7484662939870632e16);
+    TEST_ASSERT_TRUE(cjson_get_int64(item, &integer));
+    TEST_ASSERT_TRUE(integer == (cjson_int64_t)3.7484662939870632e16);
+    cjson_delete(item);
+}
+
+/* printed doubles have to parse back to the same bits */
+static void print_number_should_round_trip_random_doubles(void)
+{
+    unsigned long state = 1;
+    int i = 0;
+
+    for (i = 0; i < 100000; i++)
+    {
+        unsigned char printed[32];
+        printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+        cjson_t item[1];
+        cjson_uint64_t bits = 0;
+        double number = 0;
+        double parsed = 0;
+        int part = 0;
+
+        for (part = 0; part < 4; part++)
+        {
+            state = ((state * 1103515245UL) + 12345UL) & 0x7FFFFFFFUL;
+            bits = (bits << 16) | ((state >> 8) & 0xFFFF);
+        }
+        memcpy(&number, &bits, sizeof(number));
+        if ((number != number) || (number > DBL_MAX) || (number < -DBL_MAX))
+        {
+            continue;
+        }
+
+        memset(item, 0, sizeof(item));
+        CJSON_SET_NUMBER_VALUE(item, number);
+        buffer.buffer = printed;
+        buffer.length = sizeof(printed);
+        buffer.noalloc = true;
+        buffer.hooks = global_hooks;
+        TEST_ASSERT_TRUE(print_number(item, &buffer));
+        printed[buffer.offset] = '\0';
+
+        parsed = strtod((const char*)printed, NULL);
+        TEST_ASSERT_TRUE_MESSAGE((parsed == number) || ((parsed == 0) && (number == 0)), (const char*)printed);
+    }
+}
+
 static void print_number_should_print_non_number(void)
 {
     TEST_IGNORE();
@@ -119,6 +240,11 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_number_should_print_positive_integers);
     RUN_TEST(print_number_should_print_positive_reals);
     RUN_TEST(print_number_should_print_negative_reals);
+    RUN_TEST(print_number_should_print_shortest_representation);
+    RUN_TEST(print_number_should_not_pad_doubles_beyond_2_53);
+    RUN_TEST(print_number_should_round_trip_random_doubles);
+    RUN_TEST(print_number_should_print_exact_64bit_integers);
+    RUN_TEST(print_number_should_not_print_stale_integers);
     RUN_TEST(print_number_should_print_non_number);
 
     return UNITY_END();
@@ -31,9 +31,9 @@ static void assert_print_object(const char * const expected, const char * const
 
     cjson_t item[1];
 
-    printbuffer formatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-    printbuffer unformatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer formatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    printbuffer unformatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
 
     /* buffer for parsing */
     parsebuffer.content = (const unsigned char*)input;
@@ -59,10 +59,14 @@ static void assert_print_object(const char * const expected, const char * const
 
     unformatted_buffer.format = false;
     TEST_ASSERT_TRUE_MESSAGE(print_object(item, &unformatted_buffer), "Failed to print unformatted string.");
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(input), unformatted_buffer.offset, "The offset doesn't match the printed length.");
+    printed_unformatted[unformatted_buffer.offset] = '\0';
     TEST_ASSERT_EQUAL_STRING_MESSAGE(input, printed_unformatted, "Unformatted object is not correct.");
 
     formatted_buffer.format = true;
     TEST_ASSERT_TRUE_MESSAGE(print_object(item, &formatted_buffer), "Failed to print formatted string.");
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(expected), formatted_buffer.offset, "The offset doesn't match the printed length.");
+    printed_formatted[formatted_buffer.offset] = '\0';
     TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, printed_formatted, "Formatted ojbect is not correct.");
 
     reset(item);
@@ -27,14 +27,16 @@
 static void assert_print_string(const char *expected, const char *input)
 {
     unsigned char printed[1024];
-    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
     buffer.buffer = printed;
     buffer.length = sizeof(printed);
     buffer.offset = 0;
     buffer.noalloc = true;
     buffer.hooks = global_hooks;
 
-    TEST_ASSERT_TRUE_MESSAGE(print_string_ptr((const unsigned char*)input, &buffer), "Failed to print string.");
+    TEST_ASSERT_TRUE_MESSAGE(print_string_ptr((const unsigned char*)input, (input == NULL) ? 0 : strlen(input), &buffer), "Failed to print string.");
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(expected), buffer.offset, "The offset doesn't match the printed length.");
+    printed[buffer.offset] = '\0';
     TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, printed, "The printed string isn't as expected.");
 }
 
@@ -65,6 +67,22 @@ static void print_string_should_print_utf8(void)
     assert_print_string("\"ü猫慕\"", "ü猫慕");
 }
 
+static void print_string_should_only_print_the_given_length(void)
+{
+    unsigned char printed[32];
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    buffer.buffer = printed;
+    buffer.length = sizeof(printed);
+    buffer.noalloc = true;
+    buffer.hooks = global_hooks;
+
+    /* strings that aren't terminated, like string views */
+    TEST_ASSERT_TRUE(print_string_ptr((const unsigned char*)"abc\"def", 3, &buffer));
+    TEST_ASSERT_TRUE(print_string_ptr((const unsigned char*)"\n\"xyz", 2, &buffer));
+    printed[buffer.offset] = '\0';
+    TEST_ASSERT_EQUAL_STRING("\"abc\"\"\\n\\\"\"", printed);
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item */
@@ -73,6 +91,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_string_should_print_empty_strings);
     RUN_TEST(print_string_should_print_ascii);
     RUN_TEST(print_string_should_print_utf8);
+    RUN_TEST(print_string_should_only_print_the_given_length);
 
     return UNITY_END();
 }
@@ -32,8 +32,8 @@ static void assert_print_value(const char *input)
 {
     unsigned char printed[1024];
     cjson_t item[1];
-    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, CJSON_ERROR_NONE, 0, 0 };
     buffer.buffer = printed;
     buffer.length = sizeof(printed);
     buffer.offset = 0;
@@ -49,6 +49,8 @@ static void assert_print_value(const char *input)
     TEST_ASSERT_TRUE_MESSAGE(parse_value(item, &parsebuffer), "Failed to parse value.");
 
     TEST_ASSERT_TRUE_MESSAGE(print_value(item, &buffer), "Failed to print value.");
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(strlen(input), buffer.offset, "The offset doesn't match the printed length.");
+    printed[buffer.offset] = '\0';
     TEST_ASSERT_EQUAL_STRING_MESSAGE(input, buffer.buffer, "Printed value is not as expected.");
 
     reset(item);
@@ -0,0 +1,104 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static const char document_text[] = "{\"id\": 7, \"user\": {\"name\": \"cat\", \"tags\": [\"a\", \"b\"], \"secret\": {\"x\": \"]\\\"\"}},"
+    " \"items\": [{\"p\": 1}, {\"p\": 2, \"q\": 3}, {\"p\": 4}], \"a/b\": true, \"m~n\": false, \"esc\\u0061ped\": 1, \"noise\": [[[]], {}]}";
+
+static void assert_projection(const char **paths, const size_t count, const char * const expected)
+{
+    cjson_t *item = cjson_parse_projected(document_text, sizeof(document_text) - 1, paths, count);
+    char *printed = NULL;
+
+    TEST_ASSERT_NOT_NULL(item);
+    printed = cjson_print_unformatted(item);
+    TEST_ASSERT_EQUAL_STRING(expected, printed);
+    cjson_free(printed);
+    cjson_delete(item);
+}
+
+static void projected_parse_should_keep_only_the_paths(void)
+{
+    const char *paths[] = { "/id", "/user/name", "/items/1/q", "/a~1b", "/m~0n", "/escaped", "/missing/x", "/user/tags/5", "/items/01" };
+    cjson_t *item = cjson_parse_projected(document_text, sizeof(document_text) - 1, paths, sizeof(paths) / sizeof(paths[0]));
+
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(7, cjson_get_object_item(item, "id")->valueint);
+    TEST_ASSERT_EQUAL_STRING("cat", cjson_get_string_value(cjson_get_object_item(cjson_get_object_item(item, "user"), "name")));
+    TEST_ASSERT_EQUAL_INT(3, cjson_get_object_item(cjson_get_array_item(cjson_get_object_item(item, "items"), 1), "q")->valueint);
+    TEST_ASSERT_NULL(cjson_get_object_item(item, "missing"));
+    cjson_delete(item);
+
+    assert_projection(paths, sizeof(paths) / sizeof(paths[0]),
+        "{\"id\":7,\"user\":{\"name\":\"cat\"},\"items\":[null,{\"q\":3}],\"a/b\":true,\"m~n\":false,\"escaped\":1}");
+}
+
+static void projected_parse_should_keep_whole_values(void)
+{
+    const char *root[] = { "" };
+    const char *user[] = { "/user/name", "/user", "/noise/0" };
+    cjson_t *expected = cjson_parse(document_text);
+    char *printed = cjson_print_unformatted(expected);
+
+    assert_projection(root, 1, printed);
+    cjson_free(printed);
+    cjson_delete(expected);
+
+    assert_projection(user, 3, "{\"user\":{\"name\":\"cat\",\"tags\":[\"a\",\"b\"],\"secret\":{\"x\":\"]\\\"\"}},\"noise\":[[[]]]}");
+    assert_projection(NULL, 0, "{}");
+}
+
+static void projected_parse_should_fail_on_invalid_input(void)
+{
+    const char *paths[] = { "/a" };
+    const char *invalid_path[] = { "a" };
+    cjson_t *item = NULL;
+
+    TEST_ASSERT_NULL(cjson_parse_projected(document_text, sizeof(document_text) - 1, invalid_path, 1));
+    TEST_ASSERT_NULL(cjson_parse_projected(document_text, sizeof(document_text) - 1, NULL, 1));
+    TEST_ASSERT_NULL(cjson_parse_projected("{\"a\": tru}", 10, paths, 1));
+    /* skipped values are checked for their structure */
+    TEST_ASSERT_NULL(cjson_parse_projected("{\"b\": [1, }, \"a\": 1}", 20, paths, 1));
+    TEST_ASSERT_NULL(cjson_parse_projected("{\"b\": \"open, \"a\": 1}", 21, paths, 1));
+    TEST_ASSERT_NULL(cjson_parse_projected("{\"a\": 1", 7, paths, 1));
+
+    /* a scalar root is returned as it is */
+    item = cjson_parse_projected("5", 1, paths, 1);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(5, item->valueint);
+    cjson_delete(item);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(projected_parse_should_keep_only_the_paths);
+    RUN_TEST(projected_parse_should_keep_whole_values);
+    RUN_TEST(projected_parse_should_fail_on_invalid_input);
+
+    return UNITY_END();
+}
@@ -0,0 +1,267 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static const char *documents[] = {
+    "{\"name\": \"Jack (\\\"Bee\\\") Nimble\", \"format\": {\"type\": \"rect\", \"width\": 1920, \"height\": 1080, \"interlace\": false, \"frame rate\": 24}}",
+    "[\"\\u20AC \\ud83d\\ude00 \\\\ \\/ \\b\\f\\n\\r\\t\", \"\", \"plain\"]",
+    "[0, -0, 1.5, -2.5e-3, 1E10, 9007199254740993, -9223372036854775808, 18446744073709551615, 123456789012345678901234567890]",
+    "[true, false, null, [], {}, [[]], {\"a\": {}}]",
+    " \t\r\n {\"a\" : [ 1 , 2 ] , \"b\":null } \n",
+    "\xEF\xBB\xBF{\"bom\": true}",
+    "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]",
+    "{\"k0\": 0, \"k1\": 1, \"k2\": 2, \"k3\": 3, \"k4\": 4, \"k5\": 5, \"k6\": 6, \"k7\": 7, \"k8\": 8, \"k9\": 9, \"k10\": 10, \"k11\": 11, \"k12\": 12, \"k13\": 13, \"k14\": 14, \"k15\": 15, \"k16\": 16, \"k17\": 17}",
+    "\"top level string\"",
+    "-12.5e+2",
+    "42",
+    "true"
+};
+
+/* feed json in chunks of chunk_size bytes, the first chunk is first_chunk bytes */
+static cjson_t *push_parse(cjson_push_parser_t *parser, const char *json, size_t first_chunk, size_t chunk_size, cjson_error_t *error)
+{
+    const size_t length = strlen(json);
+    size_t offset = (first_chunk < length) ? first_chunk : length;
+
+    cjson_push_parser_feed(parser, json, offset);
+    while (offset < length)
+    {
+        const size_t chunk = ((length - offset) < chunk_size) ? (length - offset) : chunk_size;
+        if (!cjson_push_parser_feed(parser, json + offset, chunk))
+        {
+            break;
+        }
+        offset += chunk;
+    }
+
+    return cjson_push_parser_finish(parser, error);
+}
+
+static void assert_same_tree(const cjson_t *expected, const cjson_t *actual)
+{
+    char *expected_text = cjson_print_unformatted(expected);
+    char *actual_text = cjson_print_unformatted(actual);
+
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_TRUE(cjson_compare(expected, actual, true));
+    TEST_ASSERT_EQUAL_STRING(expected_text, actual_text);
+
+    cjson_free(expected_text);
+    cjson_free(actual_text);
+}
+
+static void push_parser_should_build_the_same_tree_for_any_split(void)
+{
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(parser);
+    for (i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        cjson_t *expected = cjson_parse(documents[i]);
+        const size_t length = strlen(documents[i]);
+        size_t split = 0;
+
+        TEST_ASSERT_NOT_NULL(expected);
+        /* every split into two chunks, this cuts every string, escape sequence, number and literal */
+        for (split = 0; split <= length; split++)
+        {
+            cjson_t *actual = push_parse(parser, documents[i], split, length, NULL);
+            assert_same_tree(expected, actual);
+            cjson_delete(actual);
+        }
+        /* one byte at a time */
+        {
+            cjson_t *actual = push_parse(parser, documents[i], 0, 1, NULL);
+            assert_same_tree(expected, actual);
+            cjson_delete(actual);
+        }
+
+        cjson_delete(expected);
+    }
+
+    cjson_push_parser_delete(parser);
+}
+
+static void push_parser_should_keep_exact_integers(void)
+{
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    cjson_t *parsed = push_parse(parser, "[9007199254740993]", 0, 3, NULL);
+    cjson_int64_t value = 0;
+
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_TRUE(cjson_get_int64(parsed->child, &value));
+    TEST_ASSERT_TRUE(value == (cjson_int64_t)uint64_constant(0x200000, 1));
+
+    cjson_delete(parsed);
+    cjson_push_parser_delete(parser);
+}
+
+static void push_parser_should_link_like_parse(void)
+{
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    cjson_t *array = push_parse(parser, documents[6], 0, 5, NULL);
+    cjson_t *object = push_parse(parser, documents[7], 0, 5, NULL);
+
+    TEST_ASSERT_NOT_NULL(array);
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_NULL(array->index);
+    TEST_ASSERT_NULL(object->index);
+    TEST_ASSERT_TRUE(cjson_build_indexes(array));
+    TEST_ASSERT_TRUE(cjson_build_indexes(object));
+    TEST_ASSERT_NOT_NULL(array->index);
+    TEST_ASSERT_NOT_NULL(object->index);
+    TEST_ASSERT_EQUAL_INT(20, cjson_get_array_size(array));
+    TEST_ASSERT_EQUAL_INT(19, cjson_get_array_item(array, 19)->valueint);
+    TEST_ASSERT_EQUAL_INT(17, cjson_get_object_item(object, "K17")->valueint);
+    TEST_ASSERT_TRUE(array->child->prev == cjson_get_array_item(array, 19));
+    TEST_ASSERT_TRUE(cjson_get_array_item(array, 5)->parent == array);
+    TEST_ASSERT_NULL(array->parent);
+
+    cjson_delete(array);
+    cjson_delete(object);
+    cjson_push_parser_delete(parser);
+}
+
+static void push_parser_should_report_errors(void)
+{
+    const char *invalid[] = {
+        "",
+        "[1, 2",
+        "{\"a\" 1}",
+        "[\"\\x\"]",
+        "[\"abc",
+        "[\"a\x01\"]",
+        "[-]",
+        "[nul]",
+        "[1 2]",
+        "{\"a\": 1]"
+    };
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        cjson_error_t push_error;
+        cjson_error_t parse_error;
+
+        TEST_ASSERT_NULL(push_parse(parser, invalid[i], 0, 1, &push_error));
+        TEST_ASSERT_NULL(cjson_parse_with_error(invalid[i], strlen(invalid[i]), false, &parse_error));
+        TEST_ASSERT_EQUAL_INT(parse_error.kind, push_error.kind);
+        /* where the input ends is only known when the push parser is finished, parse reports the last byte instead */
+        if (parse_error.kind != CJSON_ERROR_UNEXPECTED_END)
+        {
+            TEST_ASSERT_EQUAL_UINT((unsigned int)parse_error.offset, (unsigned int)push_error.offset);
+        }
+    }
+
+    cjson_push_parser_delete(parser);
+}
+
+static void push_parser_should_reject_trailing_characters(void)
+{
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    cjson_error_t error;
+
+    TEST_ASSERT_TRUE(cjson_push_parser_feed(parser, "{} ", 3));
+    TEST_ASSERT_FALSE(cjson_push_parser_feed(parser, " x", 2));
+    TEST_ASSERT_FALSE(cjson_push_parser_feed(parser, " ", 1));
+    TEST_ASSERT_NULL(cjson_push_parser_finish(parser, &error));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_TRAILING_CHARACTERS, error.kind);
+    TEST_ASSERT_EQUAL_UINT(4, (unsigned int)error.offset);
+
+    TEST_ASSERT_NULL(push_parse(parser, "1-2", 0, 1, &error));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_TRAILING_CHARACTERS, error.kind);
+    TEST_ASSERT_EQUAL_UINT(1, (unsigned int)error.offset);
+
+    cjson_push_parser_delete(parser);
+}
+
+static void push_parser_should_limit_nesting(void)
+{
+    char deep[CJSON_NESTING_LIMIT + 2];
+    cjson_push_parser_t *parser = cjson_push_parser_create(NULL);
+    cjson_error_t error;
+
+    memset(deep, '[', sizeof(deep));
+    TEST_ASSERT_FALSE(cjson_push_parser_feed(parser, deep, sizeof(deep)));
+    TEST_ASSERT_NULL(cjson_push_parser_finish(parser, &error));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NESTING_LIMIT, error.kind);
+    TEST_ASSERT_EQUAL_UINT(CJSON_NESTING_LIMIT, (unsigned int)error.offset);
+
+    cjson_push_parser_delete(parser);
+}
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size, void *user)
+{
+    (void)user;
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL plain_free(void *pointer, void *user)
+{
+    (void)user;
+    free(pointer);
+}
+
+static void push_parser_should_use_the_allocator(void)
+{
+    const cjson_allocator_t allocator = { counting_malloc, plain_free, NULL, NULL };
+    cjson_push_parser_t *parser = cjson_push_parser_create(&allocator);
+    cjson_t *parsed = NULL;
+
+    allocations = 0;
+    parsed = push_parse(parser, documents[0], 0, 7, NULL);
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_TRUE(allocations > 0);
+    cjson_delete_with_allocator(parsed, &allocator);
+
+    /* a failed parse frees the partial tree */
+    TEST_ASSERT_NULL(push_parse(parser, "{\"a\": [1, 2, {\"b\": \"c\"", 0, 4, NULL));
+    cjson_push_parser_delete(parser);
+
+    TEST_ASSERT_NULL(cjson_push_parser_finish(NULL, NULL));
+    TEST_ASSERT_FALSE(cjson_push_parser_feed(NULL, "1", 1));
+    cjson_push_parser_delete(NULL);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(push_parser_should_build_the_same_tree_for_any_split);
+    RUN_TEST(push_parser_should_keep_exact_integers);
+    RUN_TEST(push_parser_should_link_like_parse);
+    RUN_TEST(push_parser_should_report_errors);
+    RUN_TEST(push_parser_should_reject_trailing_characters);
+    RUN_TEST(push_parser_should_limit_nesting);
+    RUN_TEST(push_parser_should_use_the_allocator);
+
+    return UNITY_END();
+}
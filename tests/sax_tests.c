@@ -0,0 +1,304 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* the events are written to a string, one character per structural event */
+typedef struct
+{
+    char events[256];
+    size_t length;
+    int stop_after;
+    cjson_int64_t integers[4];
+    size_t integer_count;
+} recorder;
+
+static void record_value(recorder *r, const char *prefix, const char *value, size_t length)
+{
+    TEST_ASSERT_TRUE((r->length + strlen(prefix) + length + 2) < sizeof(r->events));
+    if (r->length > 0)
+    {
+        r->events[r->length++] = ' ';
+    }
+    memcpy(r->events + r->length, prefix, strlen(prefix));
+    r->length += strlen(prefix);
+    memcpy(r->events + r->length, value, length);
+    r->length += length;
+    r->events[r->length] = '\0';
+}
+
+static void record(recorder *r, const char *event)
+{
+    record_value(r, event, "", 0);
+}
+
+static cjson_bool_t keep_going(recorder *r)
+{
+    if (r->stop_after == 0)
+    {
+        return true;
+    }
+    return --r->stop_after > 0;
+}
+
+static cjson_bool_t on_start_object(void *user)
+{
+    record((recorder*)user, "{");
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_end_object(void *user)
+{
+    record((recorder*)user, "}");
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_start_array(void *user)
+{
+    record((recorder*)user, "[");
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_end_array(void *user)
+{
+    record((recorder*)user, "]");
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_key(const char *string, size_t length, void *user)
+{
+    record_value((recorder*)user, "k:", string, length);
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_string(const char *string, size_t length, void *user)
+{
+    record_value((recorder*)user, "s:", string, length);
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_number(const cjson_t *number, void *user)
+{
+    recorder *r = (recorder*)user;
+    char text[32];
+
+    TEST_ASSERT_TRUE(cjson_is_number(number));
+    TEST_ASSERT_TRUE(r->integer_count < (sizeof(r->integers) / sizeof(r->integers[0])));
+    if (cjson_get_int64(number, &r->integers[r->integer_count]))
+    {
+        r->integer_count++;
+        record(r, "i");
+    }
+    else
+    {
+        sprintf(text, "d:%g", cjson_get_number_value(number));
+        record(r, text);
+    }
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_boolean(cjson_bool_t value, void *user)
+{
+    record((recorder*)user, value ? "t" : "f");
+    return keep_going((recorder*)user);
+}
+
+static cjson_bool_t on_null(void *user)
+{
+    record((recorder*)user, "n");
+    return keep_going((recorder*)user);
+}
+
+static const cjson_sax_handler_t handler = {
+    on_start_object,
+    on_end_object,
+    on_start_array,
+    on_end_array,
+    on_key,
+    on_string,
+    on_number,
+    on_boolean,
+    on_null
+};
+
+static const char *events_of(recorder *r, const char *json)
+{
+    memset(r, '\0', sizeof(*r));
+    TEST_ASSERT_TRUE(cjson_sax_parse(json, strlen(json), &handler, r));
+
+    return r->events;
+}
+
+static void sax_parse_should_report_events(void)
+{
+    recorder r;
+
+    TEST_ASSERT_EQUAL_STRING("{ k:a i k:b [ s:x t f n d:1.5 ] k:c { } k:d [ ] }", events_of(&r, " {\"a\": 1, \"b\": [\"x\", true, false, null, 1.5], \"c\": {}, \"d\": []} "));
+    TEST_ASSERT_EQUAL_STRING("s:", events_of(&r, "\"\""));
+    TEST_ASSERT_EQUAL_STRING("d:-0.25", events_of(&r, "-0.25"));
+    TEST_ASSERT_EQUAL_STRING("[ [ [ ] ] ]", events_of(&r, "[[[]]]"));
+}
+
+static void sax_parse_should_unescape_strings(void)
+{
+    recorder r;
+
+    TEST_ASSERT_EQUAL_STRING("{ k:a\"b s:\xE2\x82\xAC\n\xF0\x9F\x98\x80 }", events_of(&r, "{\"a\\\"b\": \"\\u20AC\\n\\ud83d\\ude00\"}"));
+    TEST_ASSERT_EQUAL_STRING("[ s:a\\b s:plain s:/ ]", events_of(&r, "[\"a\\\\b\", \"plain\", \"\\/\"]"));
+}
+
+static void sax_parse_should_keep_integers_exact(void)
+{
+    recorder r;
+
+    TEST_ASSERT_EQUAL_STRING("[ i i ]", events_of(&r, "[9007199254740993, -9223372036854775808]"));
+    TEST_ASSERT_TRUE(r.integers[0] == (cjson_int64_t)uint64_constant(0x200000, 1));
+    TEST_ASSERT_TRUE(r.integers[1] == -(cjson_int64_t)uint64_constant(0x7FFFFFFF, 0xFFFFFFFF) - 1);
+}
+
+static void sax_parse_should_stop_when_a_callback_fails(void)
+{
+    const char json[] = "[1, [2, 3], 4]";
+    cjson_error_t error;
+    recorder r;
+
+    memset(&r, '\0', sizeof(r));
+    r.stop_after = 4;
+    TEST_ASSERT_FALSE(cjson_sax_parse_with_error(json, sizeof(json) - 1, &handler, &r, &error));
+    TEST_ASSERT_EQUAL_STRING("[ i [ i", r.events);
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_ABORTED, error.kind);
+}
+
+static void sax_parse_should_report_errors_like_parse(void)
+{
+    const char *invalid[] = {
+        "",
+        "[1, 2",
+        "{\"a\" 1}",
+        "[\"\\x\"]",
+        "[\"abc",
+        "[\"a\x01\"]",
+        "[-]",
+        "nul"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        cjson_error_t sax_error;
+        cjson_error_t parse_error;
+        recorder r;
+
+        memset(&r, '\0', sizeof(r));
+        TEST_ASSERT_FALSE(cjson_sax_parse_with_error(invalid[i], strlen(invalid[i]), &handler, &r, &sax_error));
+        TEST_ASSERT_NULL(cjson_parse_with_error(invalid[i], strlen(invalid[i]), false, &parse_error));
+        TEST_ASSERT_EQUAL_INT(parse_error.kind, sax_error.kind);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)parse_error.offset, (unsigned int)sax_error.offset);
+    }
+
+    {
+        const char trailing_comma[] = "{\"a\": 1,}";
+        cjson_error_t error;
+        recorder r;
+
+        memset(&r, '\0', sizeof(r));
+        TEST_ASSERT_FALSE(cjson_sax_parse_with_error(trailing_comma, sizeof(trailing_comma) - 1, &handler, &r, &error));
+        TEST_ASSERT_EQUAL_INT(CJSON_ERROR_UNEXPECTED_CHARACTER, error.kind);
+        TEST_ASSERT_EQUAL_UINT(8, (unsigned int)error.offset);
+        TEST_ASSERT_EQUAL_STRING("{ k:a i", r.events);
+    }
+}
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void sax_parse_should_not_allocate_per_value(void)
+{
+    cjson_hooks_t hooks = { counting_malloc, free };
+    recorder r;
+    cjson_t *parsed = NULL;
+    const char plain[] = "{\"a\": [\"x\", \"y\", 1, 2.5], \"b\": {\"c\": null}}";
+    const char escaped[] = "[\"\\n\", \"a\\tb\", \"\\u00e9\", \"\\\\\"]";
+
+    cjson_init_hooks(&hooks);
+
+    allocations = 0;
+    events_of(&r, plain);
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)allocations);
+
+    /* one scratch buffer for all of the escaped strings */
+    allocations = 0;
+    events_of(&r, escaped);
+    TEST_ASSERT_EQUAL_UINT(1, (unsigned int)allocations);
+
+    allocations = 0;
+    parsed = cjson_parse(escaped);
+    TEST_ASSERT_TRUE(allocations > 1);
+    cjson_delete(parsed);
+
+    cjson_init_hooks(NULL);
+}
+
+static void sax_parse_should_allow_missing_callbacks(void)
+{
+    const cjson_sax_handler_t empty = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    const char json[] = "{\"a\": [1, \"\\n\", true, null]}";
+
+    TEST_ASSERT_TRUE(cjson_sax_parse(json, sizeof(json) - 1, &empty, NULL));
+    TEST_ASSERT_FALSE(cjson_sax_parse(NULL, 0, &empty, NULL));
+    TEST_ASSERT_FALSE(cjson_sax_parse(json, sizeof(json) - 1, NULL, NULL));
+}
+
+static void sax_parse_should_limit_nesting(void)
+{
+    char deep[CJSON_NESTING_LIMIT + 2];
+    const cjson_sax_handler_t empty = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    cjson_error_t error;
+
+    memset(deep, '[', sizeof(deep));
+    TEST_ASSERT_FALSE(cjson_sax_parse_with_error(deep, sizeof(deep), &empty, NULL, &error));
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NESTING_LIMIT, error.kind);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(sax_parse_should_report_events);
+    RUN_TEST(sax_parse_should_unescape_strings);
+    RUN_TEST(sax_parse_should_keep_integers_exact);
+    RUN_TEST(sax_parse_should_stop_when_a_callback_fails);
+    RUN_TEST(sax_parse_should_report_errors_like_parse);
+    RUN_TEST(sax_parse_should_not_allocate_per_value);
+    RUN_TEST(sax_parse_should_allow_missing_callbacks);
+    RUN_TEST(sax_parse_should_limit_nesting);
+
+    return UNITY_END();
+}
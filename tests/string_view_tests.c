@@ -0,0 +1,137 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* not '\0' terminated, views must not read past the closing quotes */
+static const char text[] = { '{', '"', 'n', 'a', 'm', 'e', '"', ':', '"', 'c', 'a', 't', '"', ',',
+    '"', 'e', '"', ':', '"', 'a', '\\', 'n', 'b', '"', ',', '"', 'l', '"', ':', '[', '"', '"', ',', '1', ']', '}' };
+
+static void string_views_should_point_into_the_text(void)
+{
+    cjson_error_t error;
+    cjson_t *item = cjson_parse_with_views(text, sizeof(text), &error);
+    cjson_t *name = NULL;
+    const char *view = NULL;
+    size_t length = 0;
+
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(CJSON_ERROR_NONE, error.kind);
+
+    name = cjson_get_object_item(item, "name");
+    TEST_ASSERT_NOT_NULL(name);
+    TEST_ASSERT_BITS_HIGH(CJSON_STRING_IS_VIEW, name->type);
+    TEST_ASSERT_TRUE(cjson_is_string(name));
+    view = cjson_get_string_view(name, &length);
+    TEST_ASSERT_TRUE(view == (text + 9));
+    TEST_ASSERT_EQUAL_UINT(3, (unsigned int)length);
+    TEST_ASSERT_NULL(cjson_get_string_value(name));
+
+    /* keys are copies, escaped values are decoded */
+    TEST_ASSERT_EQUAL_STRING("name", name->string);
+    TEST_ASSERT_BITS_LOW(CJSON_STRING_IS_VIEW, cjson_get_object_item(item, "e")->type);
+    TEST_ASSERT_EQUAL_STRING("a\nb", cjson_get_string_value(cjson_get_object_item(item, "e")));
+    view = cjson_get_string_view(cjson_get_object_item(item, "e"), &length);
+    TEST_ASSERT_EQUAL_UINT(3, (unsigned int)length);
+    TEST_ASSERT_EQUAL_MEMORY("a\nb", view, 3);
+
+    view = cjson_get_string_view(cjson_get_array_item(cjson_get_object_item(item, "l"), 0), &length);
+    TEST_ASSERT_TRUE(view == (text + 31));
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)length);
+
+    TEST_ASSERT_NULL(cjson_get_string_view(cjson_get_array_item(cjson_get_object_item(item, "l"), 1), &length));
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)length);
+    TEST_ASSERT_NULL(cjson_get_string_view(NULL, NULL));
+
+    cjson_delete(item);
+}
+
+static void string_views_should_work_like_strings(void)
+{
+    cjson_t *views = cjson_parse_with_views(text, sizeof(text), NULL);
+    cjson_t *strings = cjson_parse_with_length(text, sizeof(text));
+    cjson_t *copy = NULL;
+    char *printed = NULL;
+    size_t length = 0;
+
+    TEST_ASSERT_NOT_NULL(views);
+    TEST_ASSERT_NOT_NULL(strings);
+
+    printed = cjson_print_unformatted(views);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"cat\",\"e\":\"a\\nb\",\"l\":[\"\",1]}", printed);
+    cjson_free(printed);
+    printed = cjson_print(views);
+    TEST_ASSERT_NOT_NULL(printed);
+    cjson_free(printed);
+
+    TEST_ASSERT_TRUE(cjson_compare(views, strings, true));
+    TEST_ASSERT_TRUE(cjson_compare(strings, views, true));
+    TEST_ASSERT_TRUE(cjson_hash(views, 0).low == cjson_hash(strings, 0).low);
+
+    /* duplicates are ordinary strings */
+    copy = cjson_duplicate(views, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_BITS_LOW(CJSON_STRING_IS_VIEW | CJSON_IS_REFERENCE, cjson_get_object_item(copy, "name")->type);
+    TEST_ASSERT_EQUAL_STRING("cat", cjson_get_string_value(cjson_get_object_item(copy, "name")));
+    cjson_delete(copy);
+
+    /* setting a view replaces it by a copy, even if the new string is shorter */
+    TEST_ASSERT_EQUAL_STRING("ox", cjson_set_value_string(cjson_get_object_item(views, "name"), "ox"));
+    TEST_ASSERT_BITS_LOW(CJSON_STRING_IS_VIEW | CJSON_IS_REFERENCE, cjson_get_object_item(views, "name")->type);
+    TEST_ASSERT_EQUAL_STRING("ox", cjson_get_string_view(cjson_get_object_item(views, "name"), &length));
+    TEST_ASSERT_EQUAL_UINT(2, (unsigned int)length);
+    TEST_ASSERT_EQUAL_MEMORY("cat", text + 9, 3);
+    TEST_ASSERT_FALSE(cjson_compare(views, strings, true));
+
+    cjson_delete(views);
+    cjson_delete(strings);
+}
+
+static void string_views_should_report_errors_like_the_parser(void)
+{
+    const char *invalid[] = { "[\"abc\", \"def", "{\"a\": \"b\" \"c\"}", "[\"\\x\"]", "[\"abc\", tru]" };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(invalid) / sizeof(invalid[0])); i++)
+    {
+        cjson_error_t expected;
+        cjson_error_t error;
+
+        TEST_ASSERT_NULL(cjson_parse_with_error(invalid[i], strlen(invalid[i]), false, &expected));
+        TEST_ASSERT_NULL(cjson_parse_with_views(invalid[i], strlen(invalid[i]), &error));
+        TEST_ASSERT_EQUAL_INT(expected.kind, error.kind);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)expected.offset, (unsigned int)error.offset);
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(string_views_should_point_into_the_text);
+    RUN_TEST(string_views_should_work_like_strings);
+    RUN_TEST(string_views_should_report_errors_like_the_parser);
+
+    return UNITY_END();
+}
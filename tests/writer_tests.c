@@ -0,0 +1,283 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+/* fileno for the file descriptor writer test */
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+typedef struct
+{
+    char data[4096];
+    size_t length;
+    size_t largest_chunk;
+    size_t calls;
+    size_t fail_after;
+} collected_output;
+
+static size_t collect_output(const char *data, size_t length, void *user)
+{
+    collected_output *output = (collected_output*)user;
+
+    output->calls++;
+    if ((output->fail_after != 0) && (output->calls > output->fail_after))
+    {
+        return 0;
+    }
+    if (length > output->largest_chunk)
+    {
+        output->largest_chunk = length;
+    }
+    TEST_ASSERT_TRUE_MESSAGE((output->length + length) < sizeof(output->data), "Collected output is too long.");
+    memcpy(output->data + output->length, data, length);
+    output->length += length;
+    output->data[output->length] = '\0';
+
+    return length;
+}
+
+static size_t count_output(const char *data, size_t length, void *user)
+{
+    (void)data;
+    *(size_t*)user += length;
+    return length;
+}
+
+static size_t largest_allocation = 0;
+
+static void * CJSON_CDECL recording_malloc(size_t size)
+{
+    if (size > largest_allocation)
+    {
+        largest_allocation = size;
+    }
+    return malloc(size);
+}
+
+static void CJSON_CDECL recording_free(void *pointer)
+{
+    free(pointer);
+}
+
+static void assert_writer_matches_print(const char *json, size_t chunk_size)
+{
+    cjson_t *root = cjson_parse(json);
+    collected_output output;
+    char *printed = NULL;
+    cjson_bool_t format = false;
+
+    TEST_ASSERT_NOT_NULL(root);
+    for (format = false; format <= true; format++)
+    {
+        memset(&output, 0, sizeof(output));
+        printed = format ? cjson_print(root) : cjson_print_unformatted(root);
+        TEST_ASSERT_NOT_NULL(printed);
+
+        TEST_ASSERT_TRUE(cjson_print_to_writer(root, format, collect_output, &output, chunk_size));
+        TEST_ASSERT_EQUAL_STRING(printed, output.data);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)strlen(printed), (unsigned int)output.length);
+        /* the buffer keeps one byte for the terminator, anything longer is passed on in pieces */
+        TEST_ASSERT_TRUE(output.largest_chunk < ((chunk_size == 0) ? 4096 : ((chunk_size < 2) ? 2 : chunk_size)));
+
+        cjson_free(printed);
+    }
+
+    cjson_delete(root);
+}
+
+static void writer_should_produce_the_same_output_as_print(void)
+{
+    const char json[] = "{\"name\": \"Awesome 4K\", \"escaped\": \"\\\"quotes\\\" and \\\\ \\n \\t \\u0001\", \"resolutions\": [{\"width\": 1280, \"height\": 720.5}, {\"width\": 3840, \"height\": 2160}], \"empty\": {}, \"none\": [], \"values\": [true, false, null, -1e-300, 18446744073709551615]}";
+    const size_t chunk_sizes[] = { 0, 1, 2, 3, 7, 16, 64, 4096 };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); i++)
+    {
+        assert_writer_matches_print(json, chunk_sizes[i]);
+    }
+}
+
+static void writer_should_split_long_strings_and_raw_values(void)
+{
+    char long_string[1000];
+    cjson_t *root = cjson_create_array();
+    collected_output output;
+    char *printed = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(long_string) - 1); i++)
+    {
+        long_string[i] = ((i % 100) == 0) ? '\n' : (char)('a' + (i % 26));
+    }
+    long_string[sizeof(long_string) - 1] = '\0';
+    cjson_add_item_to_array(root, cjson_create_string(long_string));
+    cjson_add_item_to_array(root, cjson_create_raw("[\"a raw value that is longer than the buffer\"]"));
+
+    memset(&output, 0, sizeof(output));
+    TEST_ASSERT_TRUE(cjson_print_to_writer(root, false, collect_output, &output, 32));
+    printed = cjson_print_unformatted(root);
+    TEST_ASSERT_EQUAL_STRING(printed, output.data);
+    TEST_ASSERT_TRUE(output.largest_chunk < 32);
+
+    cjson_free(printed);
+    cjson_delete(root);
+}
+
+static void writer_should_not_grow_the_buffer_for_long_tokens(void)
+{
+    const char json[] = "{\"a string that is longer than the buffer\": [\"with \\\"escapes\\\" \\u0001\", -1.2345678901234567e-300, 18446744073709551615, [[[[[[[[[[{\"deep\": false}]]]]]]]]]]]}";
+    cjson_hooks_t hooks = { recording_malloc, recording_free };
+    cjson_t *root = cjson_parse(json);
+    collected_output output;
+    char *printed = NULL;
+    cjson_bool_t format = false;
+
+    TEST_ASSERT_NOT_NULL(root);
+    for (format = false; format <= true; format++)
+    {
+        printed = format ? cjson_print(root) : cjson_print_unformatted(root);
+        TEST_ASSERT_NOT_NULL(printed);
+
+        memset(&output, 0, sizeof(output));
+        cjson_init_hooks(&hooks);
+        largest_allocation = 0;
+        TEST_ASSERT_TRUE(cjson_print_to_writer(root, format, collect_output, &output, 8));
+        cjson_init_hooks(NULL);
+
+        TEST_ASSERT_EQUAL_STRING(printed, output.data);
+        TEST_ASSERT_EQUAL_UINT(8, (unsigned int)largest_allocation);
+        TEST_ASSERT_TRUE(output.largest_chunk < 8);
+
+        cjson_free(printed);
+    }
+
+    cjson_delete(root);
+}
+
+static void writer_should_keep_memory_bounded(void)
+{
+    cjson_hooks_t hooks = { recording_malloc, recording_free };
+    char value[10000];
+    cjson_t *root = NULL;
+    size_t length = 0;
+    size_t i = 0;
+
+    memset(value, 'x', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+    root = cjson_create_array();
+    for (i = 0; i < 1000; i++)
+    {
+        cjson_add_item_to_array(root, cjson_create_string(value));
+    }
+    TEST_ASSERT_EQUAL_INT(1000, cjson_get_array_size(root));
+
+    cjson_init_hooks(&hooks);
+    largest_allocation = 0;
+    TEST_ASSERT_TRUE(cjson_print_to_writer(root, true, count_output, &length, 256));
+    cjson_init_hooks(NULL);
+
+    TEST_ASSERT_EQUAL_UINT((unsigned int)cjson_print_size(root, true), (unsigned int)length);
+    TEST_ASSERT_EQUAL_UINT(256, (unsigned int)largest_allocation);
+
+    cjson_delete(root);
+}
+
+static void writer_should_stop_when_the_writer_fails(void)
+{
+    cjson_t *root = cjson_parse("[\"one\", \"two\", \"three\", \"four\"]");
+    collected_output output;
+
+    memset(&output, 0, sizeof(output));
+    output.fail_after = 1;
+    TEST_ASSERT_FALSE(cjson_print_to_writer(root, false, collect_output, &output, 8));
+    TEST_ASSERT_EQUAL_UINT(2, (unsigned int)output.calls);
+
+    cjson_delete(root);
+}
+
+static void writer_should_write_to_files(void)
+{
+    cjson_t *root = cjson_parse("{\"file\": [1, 2, 3]}");
+    char *printed = cjson_print(root);
+    char content[64];
+    size_t length = 0;
+    FILE *file = tmpfile();
+
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_TRUE(cjson_print_to_writer(root, true, cjson_write_to_file, file, 4));
+    rewind(file);
+    length = fread(content, 1, sizeof(content) - 1, file);
+    content[length] = '\0';
+    TEST_ASSERT_EQUAL_STRING(printed, content);
+    fclose(file);
+
+#ifdef CJSON_FD_WRITE_POSIX
+    {
+        int fd = 0;
+        file = tmpfile();
+        TEST_ASSERT_NOT_NULL(file);
+        fd = fileno(file);
+        TEST_ASSERT_TRUE(cjson_print_to_writer(root, true, cjson_write_to_fd, &fd, 4));
+        rewind(file);
+        length = fread(content, 1, sizeof(content) - 1, file);
+        content[length] = '\0';
+        TEST_ASSERT_EQUAL_STRING(printed, content);
+        fclose(file);
+    }
+#endif
+
+    cjson_free(printed);
+    cjson_delete(root);
+}
+
+static void writer_should_handle_null(void)
+{
+    cjson_t *root = cjson_create_null();
+    size_t length = 0;
+
+    TEST_ASSERT_FALSE(cjson_print_to_writer(NULL, false, count_output, &length, 0));
+    TEST_ASSERT_FALSE(cjson_print_to_writer(root, false, NULL, &length, 0));
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)cjson_write_to_file("null", 4, NULL));
+    TEST_ASSERT_EQUAL_UINT(0, (unsigned int)cjson_write_to_fd("null", 4, NULL));
+
+    cjson_delete(root);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(writer_should_produce_the_same_output_as_print);
+    RUN_TEST(writer_should_split_long_strings_and_raw_values);
+    RUN_TEST(writer_should_not_grow_the_buffer_for_long_tokens);
+    RUN_TEST(writer_should_keep_memory_bounded);
+    RUN_TEST(writer_should_stop_when_the_writer_fails);
+    RUN_TEST(writer_should_write_to_files);
+    RUN_TEST(writer_should_handle_null);
+
+    return UNITY_END();
+}